@@ -108,6 +108,8 @@ USE_LITE_OP(while)
 USE_LITE_OP(lod_reset)
 USE_LITE_OP(lookup_table)
 USE_LITE_OP(multiclass_nms)
+USE_LITE_OP(fusion_box_coder_nms)
+USE_LITE_OP(fusion_squeeze_excitation)
 USE_LITE_OP(graph_op)
 USE_LITE_OP(sequence_expand)
 USE_LITE_OP(sequence_pool)
@@ -128,4 +130,5 @@ USE_LITE_OP(roi_align)
 USE_LITE_OP(box_clip)
 USE_LITE_OP(assign_value)
 USE_LITE_OP(hard_sigmoid)
+USE_LITE_OP(hard_swish)
 USE_LITE_OP(rsqrt)
@@ -13,9 +13,13 @@
 // limitations under the License.
 
 #include <gflags/gflags.h>
+#include <sys/resource.h>
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/api/paddle_use_kernels.h"
@@ -35,6 +39,13 @@ DEFINE_bool(run_model_optimize,
             "if set true, apply model_optimize_tool to model, use optimized "
             "model to test");
 DEFINE_bool(is_quantized_model, false, "if set true, test the quantized model");
+DEFINE_string(concurrency,
+              "",
+              "numbers of the predictors running concurrently, separated by "
+              "comma, each number is tested in turn, e.g. 1,2,4");
+DEFINE_string(json_result_filename,
+              "",
+              "save test result as one json object per line");
 
 namespace paddle {
 namespace lite_api {
@@ -67,12 +78,62 @@ void OutputOptModel(const std::string& load_model_dir,
 }
 
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
-void Run(const std::vector<std::vector<int64_t>>& input_shapes,
-         const std::string& model_dir,
-         const int repeat,
-         const int thread_num,
-         const int warmup_times,
-         const std::string model_name) {
+// Read a field in kB from /proc/self/status, e.g. VmRSS or VmHWM.
+double ReadProcStatusMB(const std::string& field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size() + 1, field + ":") == 0) {
+      return atof(line.c_str() + field.size() + 1) / 1024.0;
+    }
+  }
+  return -1.0;
+}
+
+double GetCurrentRSSMB() { return ReadProcStatusMB("VmRSS"); }
+
+double GetPeakRSSMB() {
+  double peak = ReadProcStatusMB("VmHWM");
+  if (peak < 0) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    peak = usage.ru_maxrss / 1024.0;
+  }
+  return peak;
+}
+
+struct LatencyStats {
+  double avg{0.};
+  double min{0.};
+  double p50{0.};
+  double p90{0.};
+  double p99{0.};
+  double max{0.};
+};
+
+LatencyStats ComputeLatencyStats(std::vector<double> latencies) {
+  LatencyStats stats;
+  if (latencies.empty()) return stats;
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    size_t pos = static_cast<size_t>(p * (latencies.size() - 1) + 0.5);
+    return latencies[pos];
+  };
+  double sum = 0.;
+  for (auto latency : latencies) sum += latency;
+  stats.avg = sum / latencies.size();
+  stats.min = latencies.front();
+  stats.p50 = percentile(0.5);
+  stats.p90 = percentile(0.9);
+  stats.p99 = percentile(0.99);
+  stats.max = latencies.back();
+  return stats;
+}
+
+std::shared_ptr<PaddlePredictor> CreatePredictor(
+    const std::vector<std::vector<int64_t>>& input_shapes,
+    const std::string& model_dir,
+    const int thread_num) {
   lite_api::MobileConfig config;
   config.set_threads(thread_num);
   config.set_power_mode(LITE_POWER_NO_BIND);
@@ -92,16 +153,109 @@ void Run(const std::vector<std::vector<int64_t>>& input_shapes,
       input_data[i] = 1.f;
     }
   }
+  return predictor;
+}
+
+// The results of running `concurrency` predictors at the same time.
+struct ConcurrencyResult {
+  int concurrency{1};
+  LatencyStats latency;
+  double throughput{0.};
+  double memory_per_predictor_mb{0.};
+};
+
+ConcurrencyResult RunConcurrently(
+    const std::vector<std::vector<int64_t>>& input_shapes,
+    const std::string& model_dir,
+    const int concurrency,
+    const int repeat,
+    const int thread_num,
+    const int warmup_times) {
+  ConcurrencyResult result;
+  result.concurrency = concurrency;
+  // The memory of a predictor is what it takes after the first run.
+  double rss_before = GetCurrentRSSMB();
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors;
+  for (int i = 0; i < concurrency; ++i) {
+    predictors.push_back(CreatePredictor(input_shapes, model_dir, thread_num));
+    predictors.back()->Run();
+  }
+  result.memory_per_predictor_mb =
+      (GetCurrentRSSMB() - rss_before) / concurrency;
+
+  std::vector<std::vector<double>> latencies(concurrency);
+  auto worker = [&](int id) {
+    auto& predictor = predictors[id];
+    for (int i = 0; i < warmup_times; ++i) {
+      predictor->Run();
+    }
+    for (int i = 0; i < repeat; ++i) {
+      auto start = lite::GetCurrentUS();
+      predictor->Run();
+      latencies[id].push_back((lite::GetCurrentUS() - start) / 1000.0);
+    }
+  };
+  auto start = lite::GetCurrentUS();
+  std::vector<std::thread> workers;
+  for (int i = 0; i < concurrency; ++i) {
+    workers.emplace_back(worker, i);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  double seconds = (lite::GetCurrentUS() - start) / 1e6;
+
+  std::vector<double> all_latencies;
+  for (auto& l : latencies) {
+    all_latencies.insert(all_latencies.end(), l.begin(), l.end());
+  }
+  result.latency = ComputeLatencyStats(all_latencies);
+  result.throughput = all_latencies.size() / seconds;
+  return result;
+}
+
+void Run(const std::vector<std::vector<int64_t>>& input_shapes,
+         const std::string& model_dir,
+         const int repeat,
+         const int thread_num,
+         const int warmup_times,
+         const std::string model_name,
+         const std::vector<int>& concurrencies,
+         const double optimize_ms) {
+  // Cold start: loading the model, and the first run which also prepares the
+  // kernels.
+  double rss_before = GetCurrentRSSMB();
+  auto load_start = lite::GetCurrentUS();
+  auto predictor = CreatePredictor(input_shapes, model_dir, thread_num);
+  double load_ms = (lite::GetCurrentUS() - load_start) / 1000.0;
+  auto first_run_start = lite::GetCurrentUS();
+  predictor->Run();
+  double first_run_ms = (lite::GetCurrentUS() - first_run_start) / 1000.0;
+  double predictor_memory_mb = GetCurrentRSSMB() - rss_before;
 
   for (int i = 0; i < warmup_times; ++i) {
     predictor->Run();
   }
 
-  auto start = lite::GetCurrentUS();
+  std::vector<double> latencies;
   for (int i = 0; i < repeat; ++i) {
+    auto start = lite::GetCurrentUS();
     predictor->Run();
+    latencies.push_back((lite::GetCurrentUS() - start) / 1000.0);
+  }
+  auto stats = ComputeLatencyStats(latencies);
+  predictor = nullptr;
+
+  std::vector<ConcurrencyResult> concurrency_results;
+  for (auto concurrency : concurrencies) {
+    concurrency_results.push_back(RunConcurrently(input_shapes,
+                                                  model_dir,
+                                                  concurrency,
+                                                  repeat,
+                                                  thread_num,
+                                                  warmup_times));
   }
-  auto end = lite::GetCurrentUS();
+  double peak_rss_mb = GetPeakRSSMB();
 
   std::FILE* pf = std::fopen(FLAGS_result_filename.c_str(), "a");
   if (nullptr == pf) {
@@ -109,10 +263,85 @@ void Run(const std::vector<std::vector<int64_t>>& input_shapes,
     exit(0);
   }
   fprintf(pf,
-          "-- %-18s    avg = %5.4f ms\n",
+          "-- %-18s    avg = %5.4f ms, min = %5.4f ms, p50 = %5.4f ms, "
+          "p90 = %5.4f ms, p99 = %5.4f ms, max = %5.4f ms\n",
           model_name.c_str(),
-          (end - start) / repeat / 1000.0);
+          stats.avg,
+          stats.min,
+          stats.p50,
+          stats.p90,
+          stats.p99,
+          stats.max);
+  fprintf(pf,
+          "   %-18s    optimize = %5.4f ms, load = %5.4f ms, "
+          "first run = %5.4f ms, predictor memory = %5.2f MB, "
+          "peak rss = %5.2f MB\n",
+          "",
+          optimize_ms,
+          load_ms,
+          first_run_ms,
+          predictor_memory_mb,
+          peak_rss_mb);
+  for (auto& r : concurrency_results) {
+    fprintf(pf,
+            "   %-18s    concurrency = %d, throughput = %5.2f /s, "
+            "p50 = %5.4f ms, p99 = %5.4f ms, "
+            "memory per predictor = %5.2f MB\n",
+            "",
+            r.concurrency,
+            r.throughput,
+            r.latency.p50,
+            r.latency.p99,
+            r.memory_per_predictor_mb);
+  }
   std::fclose(pf);
+
+  if (FLAGS_json_result_filename.empty()) return;
+  std::FILE* jf = std::fopen(FLAGS_json_result_filename.c_str(), "a");
+  if (nullptr == jf) {
+    LOG(INFO) << "create json result file error";
+    exit(0);
+  }
+  fprintf(jf,
+          "{\"model\": \"%s\", \"threads\": %d, \"repeats\": %d, "
+          "\"latency_ms\": {\"avg\": %f, \"min\": %f, \"p50\": %f, "
+          "\"p90\": %f, \"p99\": %f, \"max\": %f}, "
+          "\"cold_start_ms\": {\"optimize\": %f, \"load\": %f, "
+          "\"first_run\": %f}, "
+          "\"predictor_memory_mb\": %f, \"peak_rss_mb\": %f, "
+          "\"concurrency\": [",
+          model_name.c_str(),
+          thread_num,
+          repeat,
+          stats.avg,
+          stats.min,
+          stats.p50,
+          stats.p90,
+          stats.p99,
+          stats.max,
+          optimize_ms,
+          load_ms,
+          first_run_ms,
+          predictor_memory_mb,
+          peak_rss_mb);
+  for (size_t i = 0; i < concurrency_results.size(); ++i) {
+    auto& r = concurrency_results[i];
+    fprintf(jf,
+            "%s{\"predictors\": %d, \"throughput\": %f, "
+            "\"latency_ms\": {\"avg\": %f, \"p50\": %f, \"p90\": %f, "
+            "\"p99\": %f, \"max\": %f}, \"memory_per_predictor_mb\": %f}",
+            i ? ", " : "",
+            r.concurrency,
+            r.throughput,
+            r.latency.avg,
+            r.latency.p50,
+            r.latency.p90,
+            r.latency.p99,
+            r.latency.max,
+            r.memory_per_predictor_mb);
+  }
+  fprintf(jf, "]}\n");
+  std::fclose(jf);
 }
 #endif
 
@@ -171,21 +400,30 @@ int main(int argc, char** argv) {
   }
 
   // Output optimized model
+  double optimize_ms = 0.;
   if (FLAGS_run_model_optimize) {
+    auto start = paddle::lite::GetCurrentUS();
     paddle::lite_api::OutputOptModel(
         FLAGS_model_dir, save_optimized_model_dir, input_shapes);
+    optimize_ms = (paddle::lite::GetCurrentUS() - start) / 1000.0;
   }
 
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
   // Run inference using optimized model
   std::string run_model_dir =
       FLAGS_run_model_optimize ? save_optimized_model_dir : FLAGS_model_dir;
+  std::vector<int> concurrencies;
+  for (auto& str : paddle::lite::Split(FLAGS_concurrency, ",")) {
+    if (!str.empty()) concurrencies.push_back(atoi(str.c_str()));
+  }
   paddle::lite_api::Run(input_shapes,
                         run_model_dir,
                         FLAGS_repeats,
                         FLAGS_threads,
                         FLAGS_warmup,
-                        model_name);
+                        model_name,
+                        concurrencies,
+                        optimize_ms);
 #endif
   return 0;
 }
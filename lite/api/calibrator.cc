@@ -0,0 +1,228 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/calibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+const int kNumBins = 2048;
+const int kNumLevels = 128;
+
+// The ops whose inputs are quantized, and the arguments of the activations.
+const std::map<std::string, std::vector<std::string>>& ActivationArgs() {
+  static const std::map<std::string, std::vector<std::string>> args{
+      {"conv2d", {"Input"}},
+      {"depthwise_conv2d", {"Input"}},
+      {"fc", {"Input"}},
+      {"mul", {"X"}},
+      {"pool2d", {"X"}},
+      {"elementwise_add", {"X", "Y"}},
+      {"fusion_elementwise_add_activation", {"X", "Y"}}};
+  return args;
+}
+
+// Call `collect` for the float activations read by the op of `inst`.
+void ForEachActivation(
+    const Predictor& predictor,
+    const Instruction& inst,
+    const std::function<void(const std::string&, const Tensor&)>& collect) {
+  auto* op_info = inst.op()->op_info();
+  auto it = ActivationArgs().find(op_info->Type());
+  if (it == ActivationArgs().end()) return;
+  for (auto& arg : it->second) {
+    // The precision of a tensor is only set for the persistable ones, that of
+    // the activation is the one declared by the kernel.
+    if (!op_info->HasInput(arg) ||
+        inst.kernel()->GetInputDeclType(arg)->precision() !=
+            PRECISION(kFloat)) {
+      continue;
+    }
+    for (auto& name : op_info->Input(arg)) {
+      auto* tensor = predictor.GetTensor(name);
+      if (tensor->persistable() || !tensor->IsInitialized()) continue;
+      collect(name, *tensor);
+    }
+  }
+}
+
+}  // namespace
+
+Calibrator::Calibrator(Method method, float percentile)
+    : method_(method), percentile_(percentile) {
+  CHECK(percentile_ > 0.f && percentile_ <= 100.f) << "bad percentile "
+                                                   << percentile_;
+}
+
+Calibrator::Method Calibrator::ParseMethod(const std::string& repr) {
+  if (repr == "abs_max") return Method::kAbsMax;
+  if (repr == "kl") return Method::kKL;
+  if (repr == "percentile") return Method::kPercentile;
+  LOG(FATAL) << "Unsupported calibration method " << repr
+             << ", should be one of (abs_max, kl, percentile)";
+  return Method::kAbsMax;
+}
+
+void Calibrator::Run(Predictor* predictor,
+                     int num_samples,
+                     const std::function<void(int, Predictor*)>& feed) {
+  CHECK_GT(num_samples, 0) << "the calibration dataset is empty";
+  stats_.clear();
+  for (int i = 0; i < num_samples; ++i) {
+    feed(i, predictor);
+    predictor->Run([&](const Instruction& inst) {
+      ForEachActivation(
+          *predictor, inst, [&](const std::string& name, const Tensor& x) {
+            auto& abs_max = stats_[name].abs_max;
+            const float* data = x.data<float>();
+            for (int64_t j = 0; j < x.numel(); ++j) {
+              abs_max = std::max(abs_max, std::fabs(data[j]));
+            }
+          });
+    });
+  }
+  if (method_ == Method::kAbsMax) return;
+
+  for (auto& item : stats_) {
+    item.second.histogram.assign(kNumBins, 0);
+  }
+  for (int i = 0; i < num_samples; ++i) {
+    feed(i, predictor);
+    predictor->Run([&](const Instruction& inst) {
+      ForEachActivation(
+          *predictor, inst, [&](const std::string& name, const Tensor& x) {
+            auto& stats = stats_.at(name);
+            if (stats.abs_max == 0.f) return;
+            const float bins_per_unit = kNumBins / stats.abs_max;
+            const float* data = x.data<float>();
+            for (int64_t j = 0; j < x.numel(); ++j) {
+              int bin = static_cast<int>(std::fabs(data[j]) * bins_per_unit);
+              ++stats.histogram[std::min(bin, kNumBins - 1)];
+            }
+          });
+    });
+  }
+}
+
+int Calibrator::KLThresholdBin(const std::vector<int64_t>& hist) {
+  const int num_bins = static_cast<int>(hist.size());
+  CHECK_GE(num_bins, kNumLevels);
+  int best_bin = num_bins;
+  double best_kl = std::numeric_limits<double>::max();
+  std::vector<double> p(num_bins);
+  std::vector<double> q(num_bins);
+  for (int i = kNumLevels; i <= num_bins; ++i) {
+    // The reference distribution, the outliers are clipped to the last bin.
+    double outliers = 0.;
+    for (int j = i; j < num_bins; ++j) outliers += hist[j];
+    std::copy(hist.begin(), hist.begin() + i, p.begin());
+    p[i - 1] += outliers;
+    // Merge the i bins into kNumLevels levels, and expand them back over the
+    // non-empty bins.
+    std::fill(q.begin(), q.begin() + i, 0.);
+    for (int level = 0; level < kNumLevels; ++level) {
+      int start = level * i / kNumLevels;
+      int end = (level + 1) * i / kNumLevels;
+      double sum = 0.;
+      int nonzeros = 0;
+      for (int j = start; j < end; ++j) {
+        sum += hist[j];
+        nonzeros += hist[j] != 0;
+      }
+      for (int j = start; j < end; ++j) {
+        if (hist[j] != 0) q[j] = sum / nonzeros;
+      }
+    }
+    double p_sum = 0.;
+    double q_sum = 0.;
+    for (int j = 0; j < i; ++j) {
+      p_sum += p[j];
+      q_sum += q[j];
+    }
+    if (p_sum == 0. || q_sum == 0.) continue;
+    double kl = 0.;
+    for (int j = 0; j < i; ++j) {
+      if (p[j] == 0.) continue;
+      // The outliers may fall in an empty bin of q.
+      double qj = std::max(q[j] / q_sum, 1e-10);
+      double pj = p[j] / p_sum;
+      kl += pj * std::log(pj / qj);
+    }
+    if (kl < best_kl) {
+      best_kl = kl;
+      best_bin = i;
+    }
+  }
+  return best_bin;
+}
+
+int Calibrator::PercentileBin(const std::vector<int64_t>& hist,
+                              float percentile) {
+  const int num_bins = static_cast<int>(hist.size());
+  int64_t total = 0;
+  for (auto x : hist) total += x;
+  double target = static_cast<double>(total) * percentile / 100.;
+  int64_t cumulative = 0;
+  for (int i = 0; i < num_bins; ++i) {
+    cumulative += hist[i];
+    if (cumulative >= target) return i + 1;
+  }
+  return num_bins;
+}
+
+float Calibrator::Threshold(const Statistics& stats) const {
+  if (method_ == Method::kAbsMax || stats.histogram.empty()) {
+    return stats.abs_max;
+  }
+  const float bin_width = stats.abs_max / kNumBins;
+  if (method_ == Method::kPercentile) {
+    return PercentileBin(stats.histogram, percentile_) * bin_width;
+  }
+  return KLThresholdBin(stats.histogram) * bin_width;
+}
+
+std::map<std::string, float> Calibrator::Scales() const {
+  std::map<std::string, float> scales;
+  for (auto& item : stats_) {
+    float threshold = std::min(Threshold(item.second), item.second.abs_max);
+    if (threshold > 0.f) scales[item.first] = threshold / 127.f;
+  }
+  return scales;
+}
+
+bool Calibrator::SaveTable(const std::string& path) const {
+  std::ofstream fout(path);
+  if (!fout.is_open()) {
+    LOG(WARNING) << "failed to open the calibration table " << path;
+    return false;
+  }
+  fout << "# <var name> <scale>\n";
+  fout.precision(9);
+  for (auto& item : Scales()) {
+    fout << item.first << " " << item.second << "\n";
+  }
+  return static_cast<bool>(fout);
+}
+
+}  // namespace lite
+}  // namespace paddle
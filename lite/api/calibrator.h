@@ -0,0 +1,88 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Calibrator collects the activation scales of the post training
+ * quantization, see PostTrainingQuantPass. It runs a float model over a
+ * calibration dataset, and records the inputs of the conv2d, fc, mul, pool2d
+ * and elementwise_add ops. The threshold of an activation is
+ *  - kAbsMax: the max absolute value;
+ *  - kKL: the one minimizing the KL divergence between the histogram of the
+ *    absolute values and its quantization to 128 levels;
+ *  - kPercentile: the percentile of the absolute values.
+ * The histograms have 2048 bins over [0, abs max], so kKL and kPercentile run
+ * the dataset twice.
+ *
+ * The predictor must run with the real kernels, so the calibration table can't
+ * be collected by the model_optimize_tool with the faked kernels.
+ */
+class Calibrator {
+ public:
+  enum class Method { kAbsMax, kKL, kPercentile };
+
+  // `percentile` is used by kPercentile only, in (0, 100].
+  explicit Calibrator(Method method, float percentile = 99.99f);
+
+  // Parse "abs_max", "kl" or "percentile".
+  static Method ParseMethod(const std::string& repr);
+
+  // Run the float `predictor` over `num_samples` samples, `feed` fills the
+  // inputs of the predictor with the i-th sample.
+  void Run(Predictor* predictor,
+           int num_samples,
+           const std::function<void(int, Predictor*)>& feed);
+
+  // The scale, threshold / 127, of the activations which are not all zeros.
+  std::map<std::string, float> Scales() const;
+
+  // Save the scales in a calibration table, returns false if the file can't
+  // be written.
+  bool SaveTable(const std::string& path) const;
+
+  // The threshold bin, in [128, hist.size()], minimizing the KL divergence
+  // between the histogram clipped at it and its quantization to 128 levels.
+  static int KLThresholdBin(const std::vector<int64_t>& hist);
+
+  // The bin, in [1, hist.size()], where the cumulative histogram reaches
+  // `percentile`.
+  static int PercentileBin(const std::vector<int64_t>& hist, float percentile);
+
+ private:
+  struct Statistics {
+    float abs_max{0.f};
+    // The counts would stop increasing at 2^24 in float.
+    std::vector<int64_t> histogram;
+  };
+
+  float Threshold(const Statistics& stats) const;
+
+  Method method_;
+  float percentile_;
+  std::map<std::string, Statistics> stats_;
+};
+
+}  // namespace lite
+}  // namespace paddle
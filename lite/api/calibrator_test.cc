@@ -0,0 +1,105 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/calibrator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(Calibrator, percentile_bin) {
+  std::vector<int64_t> hist(2048, 0);
+  hist[0] = 900;
+  hist[9] = 99;
+  hist[2047] = 1;
+  EXPECT_EQ(Calibrator::PercentileBin(hist, 90.f), 1);
+  EXPECT_EQ(Calibrator::PercentileBin(hist, 99.8f), 10);
+  EXPECT_EQ(Calibrator::PercentileBin(hist, 100.f), 2048);
+}
+
+TEST(Calibrator, percentile_bin_large_counts) {
+  // Far more than 2^24 values in a bin, where float counts stop increasing.
+  std::vector<int64_t> hist(2048, 0);
+  hist[0] = int64_t(1) << 40;
+  hist[100] = int64_t(1) << 30;
+  hist[2047] = 1;
+  EXPECT_EQ(Calibrator::PercentileBin(hist, 99.99f), 101);
+}
+
+TEST(Calibrator, kl_threshold_bin) {
+  // A uniform histogram is not clipped.
+  std::vector<int64_t> uniform(2048, 10);
+  EXPECT_EQ(Calibrator::KLThresholdBin(uniform), 2048);
+
+  // A half normal distribution with a few far outliers is clipped before
+  // them.
+  std::vector<int64_t> hist(2048, 0);
+  for (int i = 0; i < 512; ++i) {
+    hist[i] = static_cast<int64_t>(1e6 * std::exp(-0.5 * (i / 128.) *
+                                                  (i / 128.)));
+  }
+  hist[2047] = 3;
+  int bin = Calibrator::KLThresholdBin(hist);
+  EXPECT_GE(bin, 128);
+  EXPECT_LE(bin, 600);
+
+  // The threshold only depends on the distribution, not on the number of the
+  // values counted.
+  std::vector<int64_t> scaled(hist);
+  for (auto& x : scaled) x <<= 20;
+  EXPECT_EQ(Calibrator::KLThresholdBin(scaled), bin);
+}
+
+TEST(Calibrator, run) {
+  // feed(x) -> fc -> fetch, the input of the fc is collected.
+  mir::PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("w", {8, 4});
+  helper.AddOp("fc", {{"Input", {"x"}}, {"W", {"w"}}}, {{"Out", {"out"}}})
+      ->SetAttr("in_num_col_dims", 1);
+  helper.AddFetch("out", 0);
+
+  Predictor predictor(helper.scope());
+  predictor.Build(helper.desc(), {Place{TARGET(kX86), PRECISION(kFloat)}});
+  auto feed = [](int i, Predictor* predictor) {
+    auto* x = predictor->GetInput(0);
+    x->Resize({2, 8});
+    auto* data = x->mutable_data<float>();
+    for (int j = 0; j < 16; ++j) {
+      data[j] = (i + 1) * (j - 8) * 0.25f;
+    }
+  };
+
+  Calibrator abs_max(Calibrator::Method::kAbsMax);
+  abs_max.Run(&predictor, 3, feed);
+  auto scales = abs_max.Scales();
+  ASSERT_EQ(scales.size(), 1UL);
+  ASSERT_TRUE(scales.count("x"));
+  EXPECT_NEAR(scales.at("x"), 3 * 8 * 0.25f / 127.f, 1e-6);
+
+  Calibrator percentile(Calibrator::Method::kPercentile, 50.f);
+  percentile.Run(&predictor, 3, feed);
+  ASSERT_TRUE(percentile.Scales().count("x"));
+  EXPECT_LT(percentile.Scales().at("x"), scales.at("x"));
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -19,6 +19,11 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/core/device_info.h"
+#include "lite/core/mir/pass_manager.h"
+#include "lite/core/mir/post_training_quant_pass.h"
+#include "lite/core/mir/static_kernel_pick_pass.h"
+#include "lite/core/mir/weight_only_quant_pass.h"
 #include "lite/utils/io.h"
 
 namespace paddle {
@@ -201,6 +206,14 @@ void Predictor::Build(const lite_api::CxxConfig &config,
   const std::string &param_file = config.param_file();
   const bool model_from_memory = config.model_from_memory();
   LOG(INFO) << "load from memory " << model_from_memory;
+  fp16_weights_ = config.fp16_weights();
+  weight_only_quant_bits_ = config.weight_only_quant_bits();
+  dynamic_quant_ = config.dynamic_quant();
+  kernel_cost_profile_ = config.kernel_cost_profile();
+  kernel_pick_by_cost_ =
+      config.kernel_pick_by_cost() || !kernel_cost_profile_.empty();
+  calibration_table_ = config.calibration_table();
+  constant_folding_ = config.constant_folding();
 
   Build(model_path,
         model_file,
@@ -256,11 +269,63 @@ void Predictor::Build(const cpp::ProgramDesc &desc,
   factor.ConsiderTarget();
   factor.ConsiderPrecision();
   factor.ConsiderDataLayout();
+  // The pass is shared by all the predictors, so always reset its cost model.
+  std::shared_ptr<mir::KernelCostModel> cost_model;
+  if (kernel_pick_by_cost_) {
+    cost_model = std::make_shared<mir::KernelCostModel>();
+    if (!kernel_cost_profile_.empty()) {
+      CHECK(cost_model->LoadProfile(kernel_cost_profile_));
+    }
+  }
+  auto* pick_pass =
+      mir::PassManager::Global().LookUp<mir::StaticKernelPickPass>(
+          "static_kernel_pick_pass");
+  CHECK(pick_pass);
+  pick_pass->SetCostModel(cost_model);
+  // Also shared, the scales are cleared if no calibration table is set.
+  auto* quant_pass =
+      mir::PassManager::Global().LookUp<mir::PostTrainingQuantPass>(
+          "post_training_quant_pass");
+  CHECK(quant_pass);
+  quant_pass->SetScales({});
+  if (!calibration_table_.empty()) {
+    CHECK(quant_pass->LoadScales(calibration_table_));
+  }
+  optimizer_.set_constant_folding(constant_folding_);
   optimizer_.Run(std::move(program), inner_places, factor, passes);
+  if (weight_only_quant_bits_ || dynamic_quant_) {
+    auto* pass = mir::PassManager::Global().LookUp<mir::WeightOnlyQuantPass>(
+        "weight_only_quant_pass");
+    CHECK(pass);
+    pass->SetQuantBits(dynamic_quant_ ? 8 : weight_only_quant_bits_);
+    pass->SetDynamicQuant(dynamic_quant_);
+    optimizer_.RunPasses({"weight_only_quant_pass"});
+  }
+  if (fp16_weights_) {
+    optimizer_.RunPasses({"fp16_weights_pass"});
+  }
   exec_scope_ = optimizer_.exec_scope();
   PrepareFeedFetch();
 }
 
+#ifdef LITE_WITH_X86
+void Predictor::BindWeightsToNumaNode() {
+  size_t moved = 0;
+  for (auto &name : scope_->LocalVarNames()) {
+    auto *var = scope_->FindVar(name);
+    if (!var || !var->IsType<lite::Tensor>()) continue;
+    const auto &tensor = var->Get<lite::Tensor>();
+    if (!tensor.IsInitialized()) continue;
+    if (DeviceInfo::Global().BindToNumaNode(tensor.raw_data(),
+                                            tensor.memory_size())) {
+      moved += tensor.memory_size();
+    }
+  }
+  VLOG(3) << "moved " << moved << " bytes of weights to NUMA node "
+          << DeviceInfo::Global().numa_node();
+}
+#endif
+
 void Predictor::GenRuntimeProgram() {
   program_ = optimizer_.GenRuntimeProgram();
   CHECK_EQ(exec_scope_, program_->exec_scope());
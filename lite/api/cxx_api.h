@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>  //NOLINT
@@ -20,6 +21,7 @@
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/core/device_info.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer.h"
 #include "lite/core/program.h"
@@ -69,6 +71,13 @@ class LITE_API Predictor {
     }
     program_->Run();
   }
+  // Run and call `observer` after each instruction, see RuntimeProgram::Run.
+  void Run(const std::function<void(const Instruction&)>& observer) {
+    if (!program_generated_) {
+      GenRuntimeProgram();
+    }
+    program_->Run(observer);
+  }
 
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
@@ -88,12 +97,20 @@ class LITE_API Predictor {
   const RuntimeProgram& runtime_program() const;
 
   // This method is disabled in mobile, for unnecessary dependencies required.
+  // If the predictor has run, the weights prepared by the kernels (such as the
+  // winograd and packed gemm weights of conv) are saved too, so that the light
+  // predictor can skip the transformation on the same device.
   void SaveModel(
       const std::string& dir,
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false);
   void SaveOpKernelInfo(const std::string& model_dir);
 
+#ifdef LITE_WITH_X86
+  // Move the weights to the NUMA node of the threads bound by DeviceInfo.
+  void BindWeightsToNumaNode();
+#endif
+
 #ifdef LITE_WITH_TRAIN
   void Run(const std::vector<framework::Tensor>& tensors) {
     FeedVars(tensors);
@@ -110,6 +127,13 @@ class LITE_API Predictor {
   const Scope* exec_scope_;
   std::unique_ptr<RuntimeProgram> program_;
   bool program_generated_{false};
+  bool fp16_weights_{false};
+  int weight_only_quant_bits_{0};
+  bool dynamic_quant_{false};
+  bool kernel_pick_by_cost_{false};
+  std::string kernel_cost_profile_;
+  std::string calibration_table_;
+  bool constant_folding_{false};
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
 };
@@ -151,6 +175,11 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
   Predictor raw_predictor_;
   lite_api::CxxConfig config_;
   std::mutex mutex_;
+  // X86 only, see CxxConfig::set_cpu_set.
+  bool bind_threads_{false};
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+  RunModeContext run_mode_;
+#endif
 };
 
 /*
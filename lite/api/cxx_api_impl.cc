@@ -27,12 +27,38 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   config_ = config;
 #ifdef LITE_WITH_CUDA
   Env<TARGET(kCUDA)>::Init();
+#endif
+#ifdef LITE_WITH_X86
+  // Bind the caller before loading the model, so that the weights are first
+  // touched on the NUMA node of the threads.
+  bind_threads_ = config.power_mode() != lite_api::LITE_POWER_NO_BIND ||
+                  !config.cpu_set().empty();
+  if (bind_threads_) {
+    lite::DeviceInfo::Init();
+    run_mode_.Set(config.power_mode(), config.threads(), config.cpu_set());
+    run_mode_.Apply();
+  }
 #endif
   auto places = config.valid_places();
   raw_predictor_.Build(config, places);
+#ifdef LITE_WITH_X86
+  // The node of the weights is the node of the bound threads, the unbound
+  // threads may run anywhere.
+  if (config.numa_bind()) {
+    if (bind_threads_) {
+      raw_predictor_.BindWeightsToNumaNode();
+    } else {
+      LOG(WARNING) << "numa_bind needs the threads bound by the power mode or "
+                      "the cpu set, the weights are not moved";
+    }
+  }
+#endif
 
   mode_ = config.power_mode();
   threads_ = config.threads();
+#ifdef LITE_WITH_ARM
+  run_mode_.Set(mode_, threads_);
+#endif
 }
 
 std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInput(int i) {
@@ -56,7 +82,9 @@ std::vector<std::string> CxxPaddleApiImpl::GetOutputNames() {
 
 void CxxPaddleApiImpl::Run() {
 #ifdef LITE_WITH_ARM
-  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+  run_mode_.Apply();
+#elif defined(LITE_WITH_X86)
+  if (bind_threads_) run_mode_.Apply();
 #endif
   raw_predictor_.Run();
 }
@@ -22,7 +22,29 @@ void LightPredictor::Build(const std::string& model_dir,
                            const std::string& model_buffer,
                            const std::string& param_buffer,
                            lite_api::LiteModelType model_type,
-                           bool model_from_memory) {
+                           bool model_from_memory,
+                           bool async_load_params) {
+  if (async_load_params &&
+      model_type == lite_api::LiteModelType::kNaiveBuffer) {
+    // Only the program is loaded here, the params are loaded in the
+    // background and the instructions wait for their own params to arrive.
+    if (model_from_memory) {
+      LoadProgramNaiveFromMemory(model_buffer, &cpp_program_desc_);
+      params_loader_.reset(new AsyncParamsLoader(
+          param_buffer, scope_.get(), cpp_program_desc_, true));
+    } else {
+      LoadProgramNaive(model_dir, &cpp_program_desc_);
+      params_loader_.reset(new AsyncParamsLoader(model_dir + "/param.nb",
+                                                 scope_.get(),
+                                                 cpp_program_desc_,
+                                                 false));
+    }
+    BuildRuntimeProgram(cpp_program_desc_);
+    program_->set_params_loader(params_loader_.get());
+    PrepareFeedFetch();
+    return;
+  }
+
   switch (model_type) {
 #ifndef LITE_ON_TINY_PUBLISH
     case lite_api::LiteModelType::kProtobuf:
@@ -142,6 +164,7 @@ void LightPredictor::BuildRuntimeProgram(const cpp::ProgramDesc& prog) {
 
   CHECK(program.exec_scope());
   program_->set_exec_scope(program.exec_scope());
+  program_->RestorePreparedWeights();
 }
 
 }  // namespace lite
@@ -25,6 +25,7 @@
 #include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/core/context.h"
+#include "lite/core/device_info.h"
 #include "lite/core/program.h"
 #include "lite/core/tensor.h"
 #include "lite/core/types.h"
@@ -44,9 +45,15 @@ class LITE_API LightPredictor {
       const std::string& model_buffer = "",
       const std::string& param_buffer = "",
       bool model_from_memory = false,
-      lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf) {
+      lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
+      bool async_load_params = false) {
     scope_ = std::make_shared<Scope>();
-    Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
+    Build(model_dir,
+          model_buffer,
+          param_buffer,
+          model_type,
+          model_from_memory,
+          async_load_params);
   }
 
   void Run() { program_->Run(); }
@@ -74,12 +81,15 @@ class LITE_API LightPredictor {
       const std::string& model_buffer,
       const std::string& param_buffer,
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
-      bool model_from_memory = false);
+      bool model_from_memory = false,
+      bool async_load_params = false);
 
   void BuildRuntimeProgram(const cpp::ProgramDesc& prog);
 
  private:
   std::shared_ptr<Scope> scope_;
+  // Declared before program_ so that it is joined after the program is gone.
+  std::unique_ptr<AsyncParamsLoader> params_loader_;
   std::unique_ptr<RuntimeProgram> program_;
   cpp::ProgramDesc cpp_program_desc_;
   std::vector<std::string> input_names_;
@@ -112,6 +122,9 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
 
  private:
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+#ifdef LITE_WITH_ARM
+  RunModeContext run_mode_;
+#endif
 };
 
 }  // namespace lite
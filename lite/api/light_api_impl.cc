@@ -28,10 +28,14 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                          config.model_buffer(),
                          config.param_buffer(),
                          config.model_from_memory(),
-                         lite_api::LiteModelType::kNaiveBuffer));
+                         lite_api::LiteModelType::kNaiveBuffer,
+                         config.async_load_params()));
 
   mode_ = config.power_mode();
   threads_ = config.threads();
+#ifdef LITE_WITH_ARM
+  run_mode_.Set(mode_, threads_);
+#endif
 }
 
 std::unique_ptr<lite_api::Tensor> LightPredictorImpl::GetInput(int i) {
@@ -47,7 +51,7 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
 
 void LightPredictorImpl::Run() {
 #ifdef LITE_WITH_ARM
-  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+  run_mode_.Apply();
 #endif
   raw_predictor_->Run();
 }
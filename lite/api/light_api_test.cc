@@ -98,5 +98,42 @@ TEST(LightAPI, loadNaiveBuffer) {
   }
 }
 
+TEST(LightAPI, loadNaiveBufferAsync) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+
+  auto model_path = std::string(FLAGS_optimized_model) + "/__model__.nb";
+  auto params_path = std::string(FLAGS_optimized_model) + "/param.nb";
+  std::string model_buffer = lite::ReadFile(model_path);
+  std::string params_buffer = lite::ReadFile(params_path);
+
+  auto run = [&](bool async_load_params) {
+    LightPredictor predictor("",
+                             model_buffer,
+                             params_buffer,
+                             true,
+                             lite_api::LiteModelType::kNaiveBuffer,
+                             async_load_params);
+    auto* input_tensor = predictor.GetInput(0);
+    input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i;
+    }
+    predictor.Run();
+    const auto* output = predictor.GetOutput(0);
+    return std::vector<float>(output->data<float>(),
+                              output->data<float>() + output->numel());
+  };
+
+  auto sync_out = run(false);
+  auto async_out = run(true);
+  ASSERT_EQ(sync_out.size(), async_out.size());
+  for (size_t i = 0; i < sync_out.size(); i++) {
+    EXPECT_NEAR(sync_out[i], async_out[i], 1e-6);
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle
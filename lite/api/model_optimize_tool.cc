@@ -16,15 +16,25 @@
 #ifdef PADDLE_WITH_TESTING
 #include <gtest/gtest.h>
 #endif
+#include <fstream>
+#include <string>
+#include <vector>
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
 // "all_kernel_faked.cc" and "kernel_src_map.h" are created automatically during
 // model_optimize_tool's compiling period
 #include "all_kernel_faked.cc"  // NOLINT
 #include "kernel_src_map.h"     // NOLINT
+#else
+// model_calibrate_tool, which runs the real kernels.
+#include "lite/api/calibrator.h"
+#include "lite/api/paddle_use_kernels.h"
+#endif
 #include "lite/api/paddle_api.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/api/paddle_use_passes.h"
 #include "lite/core/op_registry.h"
 #include "lite/utils/cp_logging.h"
+#include "lite/utils/io.h"
 #include "lite/utils/string.h"
 
 DEFINE_string(model_dir,
@@ -49,6 +59,45 @@ DEFINE_string(valid_targets,
               "The targets this model optimized for, should be one of (arm, "
               "opencl, x86), splitted by space");
 DEFINE_bool(prefer_int8_kernel, false, "Prefer to run model with int8 kernels");
+DEFINE_bool(fp16_weights,
+            false,
+            "Store the weights of the x86 fc/conv/lookup_table in FP16");
+DEFINE_int32(weight_only_quant_bits,
+             0,
+             "Store the weights of fc/mul/lookup_table in int8 or int4, should "
+             "be one of (0, 8, 4), 0 to disable it");
+DEFINE_bool(dynamic_quant,
+            false,
+            "Store the weights of fc/mul/matmul in int8 and quantize their "
+            "activations at runtime");
+DEFINE_bool(kernel_pick_by_cost,
+            false,
+            "Pick the kernels by their estimated latency and the latency of "
+            "the io_copy/calib/layout casts between them");
+DEFINE_string(kernel_cost_profile,
+              "",
+              "The measured kernel latencies used by kernel_pick_by_cost");
+DEFINE_string(calibration_table,
+              "",
+              "The activation scales to quantize the ARM conv/fc ops of a "
+              "float model to int8. It is written first if "
+              "calibration_data_dir is set");
+DEFINE_string(calibration_data_dir,
+              "",
+              "The calibration dataset, a raw float32 file per sample of the "
+              "first input. Only model_calibrate_tool, which is built with "
+              "the real X86 kernels, can run it");
+DEFINE_string(calibration_input_shape,
+              "",
+              "The shape of the calibration samples, such as 1,3,224,224");
+DEFINE_string(calibration_method,
+              "kl",
+              "The threshold of the activations, should be one of (abs_max, "
+              "kl, percentile)");
+DEFINE_double(calibration_percentile,
+              99.99,
+              "The percentile of the activations kept by the percentile "
+              "calibration method");
 
 namespace paddle {
 namespace lite_api {
@@ -58,6 +107,53 @@ void DisplayKernels() {
   LOG(INFO) << ::paddle::lite::KernelRegistry::Global().DebugString();
 }
 
+//! Run the float model over the calibration dataset, and save the scales of
+//! the activations in the calibration table.
+void Calibrate() {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+  LOG(FATAL) << "The kernels of model_optimize_tool are faked, use "
+                "model_calibrate_tool to write the calibration table";
+#else
+  CHECK(!FLAGS_calibration_table.empty())
+      << "calibration_table should be set to save the scales";
+  std::vector<int64_t> shape;
+  for (auto& dim : lite::Split(FLAGS_calibration_input_shape, ",")) {
+    shape.push_back(std::stoll(dim));
+  }
+  CHECK(!shape.empty()) << "calibration_input_shape should be set";
+  auto files = lite::ListDir(FLAGS_calibration_data_dir);
+
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_model_file(FLAGS_model_file);
+  config.set_param_file(FLAGS_param_file);
+  lite::Predictor fp32_predictor;
+#ifdef LITE_WITH_X86
+  fp32_predictor.Build(config, {Place{TARGET(kX86), PRECISION(kFloat)}});
+#else
+  fp32_predictor.Build(config, {Place{TARGET(kARM), PRECISION(kFloat)}});
+#endif
+
+  lite::Calibrator calibrator(
+      lite::Calibrator::ParseMethod(FLAGS_calibration_method),
+      FLAGS_calibration_percentile);
+  auto feed = [&](int i, lite::Predictor* predictor) {
+    auto path = FLAGS_calibration_data_dir + "/" + files[i];
+    auto* input = predictor->GetInput(0);
+    input->Resize(shape);
+    std::ifstream fin(path, std::ios::binary);
+    auto size = input->numel() * sizeof(float);
+    fin.read(reinterpret_cast<char*>(input->mutable_data<float>()), size);
+    CHECK(fin && fin.peek() == EOF) << "the size of " << path
+                                    << " doesn't match the input shape";
+  };
+  calibrator.Run(&fp32_predictor, files.size(), feed);
+  CHECK(calibrator.SaveTable(FLAGS_calibration_table));
+  LOG(INFO) << "Save the calibration table of " << files.size()
+            << " samples into :" << FLAGS_calibration_table;
+#endif  // LITE_ON_MODEL_OPTIMIZE_TOOL
+}
+
 void Main() {
   if (!FLAGS_model_file.empty() && !FLAGS_param_file.empty()) {
     LOG(WARNING)
@@ -75,10 +171,12 @@ void Main() {
   config.set_param_file(FLAGS_param_file);
 
   std::vector<Place> valid_places;
+  bool arm_target = false;
   auto target_reprs = lite::Split(FLAGS_valid_targets, " ");
   for (auto& target_repr : target_reprs) {
     if (target_repr == "arm") {
       valid_places.emplace_back(TARGET(kARM));
+      arm_target = true;
     } else if (target_repr == "opencl") {
       valid_places.emplace_back(TARGET(kOpenCL));
     } else if (target_repr == "x86") {
@@ -95,12 +193,32 @@ void Main() {
       << "At least one target should be set, should set the "
          "command argument 'valid_targets'";
 
-  if (FLAGS_prefer_int8_kernel) {
+  if (!FLAGS_calibration_data_dir.empty()) {
+    Calibrate();
+#ifndef LITE_ON_MODEL_OPTIMIZE_TOOL
+    // model_calibrate_tool is linked with the X86 kernels only, the model is
+    // optimized by model_optimize_tool with the table.
+    LOG(INFO) << "Run model_optimize_tool with --calibration_table="
+              << FLAGS_calibration_table << " to optimize the model";
+    return;
+#endif
+  }
+  if (!FLAGS_calibration_table.empty()) {
+    config.set_calibration_table(FLAGS_calibration_table);
+  }
+
+  if (FLAGS_prefer_int8_kernel ||
+      (arm_target && !FLAGS_calibration_table.empty())) {
     LOG(WARNING) << "Int8 mode is only support by ARM target";
     valid_places.insert(valid_places.begin(),
                         Place{TARGET(kARM), PRECISION(kInt8)});
   }
   config.set_valid_places(valid_places);
+  config.set_fp16_weights(FLAGS_fp16_weights);
+  config.set_weight_only_quant_bits(FLAGS_weight_only_quant_bits);
+  config.set_dynamic_quant(FLAGS_dynamic_quant);
+  config.set_kernel_pick_by_cost(FLAGS_kernel_pick_by_cost);
+  config.set_kernel_cost_profile(FLAGS_kernel_cost_profile);
 
   auto predictor = lite_api::CreatePaddlePredictor(config);
 
@@ -112,7 +230,9 @@ void Main() {
   } else {
     LOG(FATAL) << "Unsupported Model type :" << FLAGS_optimize_out_type;
   }
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
   OpKernelInfoCollector::Global().SetKernel2path(kernel2path_map);
+#endif
 
   predictor->SaveOptimizedModel(
       FLAGS_optimize_out, model_type, FLAGS_record_tailoring_info);
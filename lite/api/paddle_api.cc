@@ -170,6 +170,9 @@ ConfigBase::ConfigBase(PowerMode mode, int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  mode_ = mode;
+  threads_ = threads;
 #endif
 }
 
@@ -178,6 +181,9 @@ void ConfigBase::set_power_mode(paddle::lite_api::PowerMode mode) {
   lite::DeviceInfo::Global().SetRunMode(mode, threads_);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  // Applied by the predictor.
+  mode_ = mode;
 #endif
 }
 
@@ -186,6 +192,8 @@ void ConfigBase::set_threads(int threads) {
   lite::DeviceInfo::Global().SetRunMode(mode_, threads);
   mode_ = lite::DeviceInfo::Global().mode();
   threads_ = lite::DeviceInfo::Global().threads();
+#else
+  threads_ = threads;
 #endif
 }
 
@@ -133,6 +133,15 @@ class LITE_API CxxConfig : public ConfigBase {
   std::string model_file_;
   std::string param_file_;
   bool model_from_memory_{false};
+  bool fp16_weights_{false};
+  int weight_only_quant_bits_{0};
+  bool dynamic_quant_{false};
+  bool kernel_pick_by_cost_{false};
+  std::string kernel_cost_profile_;
+  std::string calibration_table_;
+  bool constant_folding_{false};
+  std::vector<int> cpu_set_;
+  bool numa_bind_{false};
 
  public:
   void set_valid_places(const std::vector<Place>& x) { valid_places_ = x; }
@@ -151,6 +160,55 @@ class LITE_API CxxConfig : public ConfigBase {
   std::string model_file() const { return model_file_; }
   std::string param_file() const { return param_file_; }
   bool model_from_memory() const { return model_from_memory_; }
+  // Store the weights of the X86 fc/conv/lookup_table in FP16, the kernels
+  // convert them back to float when computing.
+  void set_fp16_weights(bool x) { fp16_weights_ = x; }
+  bool fp16_weights() const { return fp16_weights_; }
+  // Store the weights of the X86/ARM fc/mul/lookup_table in int8 or packed
+  // int4 with per channel scales, 0 to disable it.
+  void set_weight_only_quant_bits(int x) { weight_only_quant_bits_ = x; }
+  int weight_only_quant_bits() const { return weight_only_quant_bits_; }
+  // Store the weights of the X86/ARM fc/mul/matmul in int8, and quantize the
+  // activations per row at runtime to run them in int8 GEMMs.
+  void set_dynamic_quant(bool x) { dynamic_quant_ = x; }
+  bool dynamic_quant() const { return dynamic_quant_; }
+  // Pick the kernels by their estimated latency and the latency of the casts
+  // between them instead of by the order of valid_places.
+  void set_kernel_pick_by_cost(bool x) { kernel_pick_by_cost_ = x; }
+  bool kernel_pick_by_cost() const { return kernel_pick_by_cost_; }
+  // The measured kernel latencies overriding the estimated ones, see
+  // `lite/core/mir/kernel_cost_model.h` for the format. Setting it enables
+  // kernel_pick_by_cost.
+  void set_kernel_cost_profile(const std::string& path) {
+    kernel_cost_profile_ = path;
+  }
+  const std::string& kernel_cost_profile() const {
+    return kernel_cost_profile_;
+  }
+  // ARM only. Quantize the conv/fc ops of a float model to int8 with the
+  // activation scales of a calibration table, see
+  // `lite/core/mir/post_training_quant_pass.h` for the format. Place
+  // {kARM, kInt8} should be in the valid places.
+  void set_calibration_table(const std::string& path) {
+    calibration_table_ = path;
+  }
+  const std::string& calibration_table() const { return calibration_table_; }
+  // Run the ops whose inputs are all weights once when the model is
+  // optimized, see `lite/core/mir/constant_folding_pass.cc`. Only the ops
+  // with host, X86 or ARM kernels runnable on this machine are folded.
+  void set_constant_folding(bool x) { constant_folding_ = x; }
+  bool constant_folding() const { return constant_folding_; }
+  // X86 only. Bind the worker threads to the cpus `x` instead of the cores
+  // picked by the power mode. On X86 the threads and power mode only take
+  // effect if the power mode is not LITE_POWER_NO_BIND or a cpu set is given,
+  // otherwise the OpenMP defaults are kept.
+  void set_cpu_set(const std::vector<int>& x) { cpu_set_ = x; }
+  const std::vector<int>& cpu_set() const { return cpu_set_; }
+  // X86 only. Move the weights to the NUMA node of the bound threads, which
+  // also first touch, and so allocate locally, the activations. It has no
+  // effect unless the threads are bound, see set_cpu_set.
+  void set_numa_bind(bool x) { numa_bind_ = x; }
+  bool numa_bind() const { return numa_bind_; }
 };
 
 /// MobileConfig is the config for the light weight predictor, it will skip
@@ -159,6 +217,7 @@ class LITE_API MobileConfig : public ConfigBase {
   std::string model_buffer_;
   std::string param_buffer_;
   bool model_from_memory_{false};
+  bool async_load_params_{false};
 
  public:
   void set_model_buffer(const char* model_buffer,
@@ -173,6 +232,11 @@ class LITE_API MobileConfig : public ConfigBase {
   bool model_from_memory() const { return model_from_memory_; }
   const std::string& model_buffer() const { return model_buffer_; }
   const std::string& param_buffer() const { return param_buffer_; }
+
+  // Load the params in a background thread, the predictor is created once the
+  // program is loaded and `Run` starts as soon as the first params arrive.
+  void set_async_load_params(bool x) { async_load_params_ = x; }
+  bool async_load_params() const { return async_load_params_; }
 };
 
 template <typename ConfigT>
@@ -92,7 +92,9 @@ enum class ActivationType : int {
   kLeakyRelu = 4,
   kSigmoid = 5,
   kTanh = 6,
-  kSwish = 7
+  kSwish = 7,
+  kHardSigmoid = 8,
+  kHardSwish = 9
 };
 
 static size_t PrecisionTypeLength(PrecisionType type) {
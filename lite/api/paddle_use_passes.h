@@ -32,11 +32,21 @@ USE_MIR_PASS(lite_fc_fuse_pass);
 USE_MIR_PASS(lite_shuffle_channel_fuse_pass);
 USE_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass);
 USE_MIR_PASS(lite_interpolate_fuse_pass);
+USE_MIR_PASS(lite_box_coder_nms_fuse_pass);
 USE_MIR_PASS(identity_scale_eliminate_pass);
+USE_MIR_PASS(dead_code_elimination_pass);
 USE_MIR_PASS(lite_conv_elementwise_fuse_pass);
 USE_MIR_PASS(lite_conv_activation_fuse_pass);
 USE_MIR_PASS(lite_elementwise_add_activation_fuse_pass);
+USE_MIR_PASS(lite_residual_activation_fuse_pass);
+USE_MIR_PASS(lite_squeeze_excitation_fuse_pass);
 USE_MIR_PASS(lite_quant_dequant_fuse_pass);
 USE_MIR_PASS(type_precision_cast_pass);
 USE_MIR_PASS(type_layout_cast_pass);
 USE_MIR_PASS(memory_optimize_pass);
+USE_MIR_PASS(fp16_weights_pass);
+USE_MIR_PASS(weight_only_quant_pass);
+USE_MIR_PASS(buffer_view_pass);
+USE_MIR_PASS(constant_folding_pass);
+USE_MIR_PASS(int8_propagation_pass);
+USE_MIR_PASS(post_training_quant_pass);
@@ -0,0 +1,198 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/light_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
+#include "lite/model_parser/model_parser.h"
+
+namespace paddle {
+namespace lite {
+
+// An fc kernel that packs W in blocks of `hblock` columns, like the prepacked
+// gemm whose blocking depends on the CPU, and counts the packings.
+class FakePreparedFcCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FcParam;
+  static int hblock;
+  static int transform_count;
+
+  void PrepareForRun() override {
+    auto& param = Param<param_t>();
+    hblock_ = hblock;
+    auto it = prepared_weights_.find("W");
+    if (prepared_key_ == PreparedWeightsKey() &&
+        it != prepared_weights_.end()) {
+      weights_.ShareDataWith(*it->second);
+      return;
+    }
+    int k = param.w->dims()[0];
+    int n = param.w->dims()[1];
+    int n_round = (n + hblock_ - 1) / hblock_ * hblock_;
+    weights_.Resize({n_round, k});
+    weights_.set_precision(PRECISION(kFloat));
+    auto* w = param.w->data<float>();
+    auto* w_packed = weights_.mutable_data<float>();
+    for (int i = 0; i < k; i++) {
+      for (int j = 0; j < n; j++) {
+        w_packed[Offset(i, j, k)] = w[i * n + j];
+      }
+    }
+    transform_count++;
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    int m = param.input->dims()[0];
+    int k = param.w->dims()[0];
+    int n = param.w->dims()[1];
+    auto* x = param.input->data<float>();
+    auto* w_packed = weights_.data<float>();
+    auto* out = param.output->mutable_data<float>();
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        float sum = 0.f;
+        for (int l = 0; l < k; l++) {
+          sum += x[i * k + l] * w_packed[Offset(l, j, k)];
+        }
+        out[i * n + j] = sum;
+      }
+    }
+  }
+
+  std::map<std::string, const Tensor*> PreparedWeights() const override {
+    if (!weights_.IsInitialized()) return {};
+    return {{"W", &weights_}};
+  }
+
+  std::string PreparedWeightsKey() const override {
+    return "packed/hblock_" + std::to_string(hblock_);
+  }
+
+  void SetPreparedWeights(
+      const std::string& key,
+      const std::map<std::string, const Tensor*>& weights) override {
+    prepared_key_ = key;
+    prepared_weights_ = weights;
+  }
+
+ private:
+  // The offset of W(i, j) in the packed weights.
+  int Offset(int i, int j, int k) const {
+    return (j / hblock_) * hblock_ * k + i * hblock_ + j % hblock_;
+  }
+
+  int hblock_{1};
+  Tensor weights_;
+  std::string prepared_key_;
+  std::map<std::string, const Tensor*> prepared_weights_;
+};
+
+int FakePreparedFcCompute::hblock = 1;
+int FakePreparedFcCompute::transform_count = 0;
+
+namespace {
+
+void Feed(Tensor* x) {
+  x->Resize({2, 4});
+  auto* data = x->mutable_data<float>();
+  for (int i = 0; i < 8; i++) data[i] = i - 3.f;
+}
+
+// Runs feed(x) -> fc -> fetch with the packing of `save_hblock`, saves the
+// optimized model, then loads and runs it with the packing of `load_hblock`.
+void TestSaveAndLoad(const std::string& dir, int save_hblock, int load_hblock) {
+  mir::PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  auto* w = helper.AddWeight("w", {4, 3}, 0.5f, -0.25f)->data<float>();
+  helper.AddOp("fc", {{"Input", {"x"}}, {"W", {"w"}}}, {{"Out", {"out"}}})
+      ->SetAttr("in_num_col_dims", 1);
+  helper.AddFetch("out", 0);
+  std::vector<float> expected(6, 0.f);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int l = 0; l < 4; l++) {
+        expected[i * 3 + j] += (i * 4 + l - 3.f) * w[l * 3 + j];
+      }
+    }
+  }
+
+  FakePreparedFcCompute::hblock = save_hblock;
+  FakePreparedFcCompute::transform_count = 0;
+  Predictor predictor(helper.scope());
+  predictor.Build(helper.desc(), {Place{TARGET(kHost), PRECISION(kFloat)}});
+  Feed(predictor.GetInput(0));
+  predictor.Run();
+  ASSERT_EQ(FakePreparedFcCompute::transform_count, 1);
+  predictor.SaveModel(dir, lite_api::LiteModelType::kNaiveBuffer);
+
+  // The original weights are kept for the devices with another packing.
+  Scope scope;
+  cpp::ProgramDesc desc;
+  LoadModelNaive(dir, &scope, &desc);
+  auto& saved_w = scope.FindVar("w")->Get<Tensor>();
+  ASSERT_EQ(saved_w.dims(), DDim({4, 3}));
+  for (int i = 0; i < 12; i++) {
+    EXPECT_EQ(saved_w.data<float>()[i], w[i]);
+  }
+
+  FakePreparedFcCompute::hblock = load_hblock;
+  LightPredictor light(
+      dir, "", "", false, lite_api::LiteModelType::kNaiveBuffer);
+  Feed(light.GetInput(0));
+  light.Run();
+  EXPECT_EQ(FakePreparedFcCompute::transform_count,
+            save_hblock == load_hblock ? 1 : 2);
+  auto* out = light.GetOutput(0);
+  ASSERT_EQ(out->dims(), DDim({2, 3}));
+  for (int i = 0; i < 6; i++) {
+    EXPECT_NEAR(out->data<float>()[i], expected[i], 1e-5);
+  }
+}
+
+}  // namespace
+
+TEST(PreparedWeights, reuse_on_the_same_device) {
+  TestSaveAndLoad("prepared_weights_same_hblock", 2, 2);
+}
+
+TEST(PreparedWeights, fall_back_on_another_hblock) {
+  TestSaveAndLoad("prepared_weights_other_hblock", 2, 4);
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fc,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::FakePreparedFcCompute,
+                     prepared)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/activation.h"
+#include <algorithm>
 #include <string>
 #include "lite/backends/arm/math/funcs.h"
 
@@ -97,6 +98,39 @@ void act_relu<float>(const float* din, float* dout, int size, int threads) {
   }
 }
 
+// The relu of int8 keeps the scale, so it is the max with zero.
+template <>
+void act_relu<int8_t>(const int8_t* din, int8_t* dout, int size, int threads) {
+  int nums_per_thread = size / threads;
+  int remain = size - threads * nums_per_thread;
+  int neon_loop_cnt = nums_per_thread >> 4;
+  int neon_loop_remain = nums_per_thread - (neon_loop_cnt << 4);
+  int8x16_t vzero = vdupq_n_s8(0);
+#pragma omp parallel for
+  for (int i = 0; i < threads; ++i) {
+    const int8_t* ptr_in_thread = din + i * nums_per_thread;
+    int8_t* ptr_out_thread = dout + i * nums_per_thread;
+    for (int num = 0; num < neon_loop_cnt; ++num) {
+      int8x16_t vr0 = vld1q_s8(ptr_in_thread);
+      ptr_in_thread += 16;
+      vst1q_s8(ptr_out_thread, vmaxq_s8(vr0, vzero));
+      ptr_out_thread += 16;
+    }
+    for (int j = 0; j < neon_loop_remain; ++j) {
+      ptr_out_thread[0] = ptr_in_thread[0] > 0 ? ptr_in_thread[0] : 0;
+      ptr_in_thread++;
+      ptr_out_thread++;
+    }
+  }
+  int8_t* out_ptr_remain = dout + threads * nums_per_thread;
+  const int8_t* in_ptr_remain = din + threads * nums_per_thread;
+  for (int j = 0; j < remain; ++j) {
+    out_ptr_remain[0] = in_ptr_remain[0] > 0 ? in_ptr_remain[0] : 0;
+    in_ptr_remain++;
+    out_ptr_remain++;
+  }
+}
+
 template <>
 void act_relu_neg<float>(const float* din,
                          float* dout,
@@ -689,6 +723,55 @@ void act_hard_sigmoid<float>(const float* din,
   }
 }
 
+// dout = din * min(max(din + offset, 0), threshold) / scale
+template <>
+void act_hard_swish<float>(const float* din,
+                           float* dout,
+                           int size,
+                           float threshold,
+                           float scale,
+                           float offset,
+                           int threads) {
+  int nums_per_thread = size / threads;
+  int remain = size - threads * nums_per_thread;
+  int neon_loop_cnt_dim4 = nums_per_thread >> 2;
+  int neon_loop_remain_dim4 = nums_per_thread - (neon_loop_cnt_dim4 << 2);
+  const float scale_r = 1.f / scale;
+
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  float32x4_t vthreshold = vdupq_n_f32(threshold);
+  float32x4_t voffset = vdupq_n_f32(offset);
+  float32x4_t vscale_r = vdupq_n_f32(scale_r);
+#pragma omp parallel for
+  for (int i = 0; i < threads; ++i) {
+    const float* ptr_in_thread = din + i * nums_per_thread;
+    float* ptr_out_thread = dout + i * nums_per_thread;
+    for (int k = 0; k < neon_loop_cnt_dim4; ++k) {
+      float32x4_t vin = vld1q_f32(ptr_in_thread);
+      float32x4_t vclip = vminq_f32(
+          vmaxq_f32(vaddq_f32(vin, voffset), vzero), vthreshold);
+      vst1q_f32(ptr_out_thread, vmulq_f32(vmulq_f32(vin, vclip), vscale_r));
+      ptr_out_thread += 4;
+      ptr_in_thread += 4;
+    }
+    for (int j = 0; j < neon_loop_remain_dim4; ++j) {
+      float clip =
+          std::min(std::max(ptr_in_thread[0] + offset, 0.f), threshold);
+      ptr_out_thread[0] = ptr_in_thread[0] * clip * scale_r;
+      ptr_in_thread++;
+      ptr_out_thread++;
+    }
+  }
+  float* ptr_out = dout + threads * nums_per_thread;
+  const float* ptr_in = din + threads * nums_per_thread;
+  for (int j = 0; j < remain; ++j) {
+    float clip = std::min(std::max(ptr_in[0] + offset, 0.f), threshold);
+    ptr_out[0] = ptr_in[0] * clip * scale_r;
+    ptr_in++;
+    ptr_out++;
+  }
+}
+
 template <>
 void act_rsqrt<float>(const float* din, float* dout, int size, int threads) {
   const float* ptr_in = din;
@@ -66,6 +66,15 @@ void act_hard_sigmoid(const T* din,
                       const float offset,
                       int threads);
 
+template <typename T>
+void act_hard_swish(const T* din,
+                    T* dout,
+                    int size,
+                    float threshold,
+                    float scale,
+                    float offset,
+                    int threads);
+
 template <typename T>
 void act_rsqrt(const T* din, T* dout, int size, int threads);
 
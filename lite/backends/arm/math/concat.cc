@@ -23,6 +23,7 @@ namespace lite {
 namespace arm {
 namespace math {
 
+template <typename T>
 void concat_func(const std::vector<lite::Tensor *> &input,
                  const int axis,
                  lite::Tensor *output) {
@@ -43,17 +44,24 @@ void concat_func(const std::vector<lite::Tensor *> &input,
 
   // computation
   for (int k = 0; k < out_rows; ++k) {
-    float *dst_ptr = output->mutable_data<float>() + k * out_cols;
+    T *dst_ptr = output->mutable_data<T>() + k * out_cols;
     int col_idx = 0;
     for (int j = 0; j < num; ++j) {
       int col_len = input_cols[j];
-      const float *src_prt = input[j]->data<float>() + k * col_len;
-      std::memcpy(dst_ptr + col_idx, src_prt, sizeof(float) * col_len);
+      const T *src_prt = input[j]->data<T>() + k * col_len;
+      std::memcpy(dst_ptr + col_idx, src_prt, sizeof(T) * col_len);
       col_idx += col_len;
     }
   }
 }
 
+template void concat_func<float>(const std::vector<lite::Tensor *> &input,
+                                 const int axis,
+                                 lite::Tensor *output);
+template void concat_func<int8_t>(const std::vector<lite::Tensor *> &input,
+                                  const int axis,
+                                  lite::Tensor *output);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
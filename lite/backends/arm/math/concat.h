@@ -25,6 +25,7 @@ namespace lite {
 namespace arm {
 namespace math {
 
+template <typename T>
 void concat_func(const std::vector<lite::Tensor *> &input,
                  const int axis,
                  lite::Tensor *output);
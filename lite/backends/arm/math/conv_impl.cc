@@ -28,6 +28,82 @@ namespace lite {
 namespace arm {
 namespace math {
 
+namespace {
+
+// The epilogue of the fused conv for the group of output channels which starts
+// at `offset` of the output, `bias` is the bias of its first channel.
+host::math::GemmEpilogue conv_group_epilogue(const operators::ConvParam& param,
+                                             const float* bias,
+                                             int64_t offset,
+                                             int channel_size) {
+  host::math::GemmEpilogue epilogue;
+  epilogue.bias = bias;
+  if (param.residualData) {
+    epilogue.residual = param.residualData->data<float>() + offset;
+    epilogue.ldr = channel_size;
+  }
+  if (param.fuse_relu) {
+    epilogue.act = lite_api::ActivationType::kRelu;
+  } else if (param.activation_param.has_active) {
+    host::math::set_epilogue_act(param.activation_param, &epilogue);
+  }
+  return epilogue;
+}
+
+// dout = weights * din for a group of the conv, followed by its epilogue.
+void conv_gemm_group(const float* weights,
+                     const float* din,
+                     float* dout,
+                     int m,
+                     int n,
+                     int k,
+                     const host::math::GemmEpilogue& epilogue,
+                     ARMContext* ctx) {
+  if (n > 1) {
+    sgemm_prepack(
+        false, m, n, k, weights, din, n, 0.f, dout, n, epilogue, ctx);
+    return;
+  }
+  //! use gemv when the output channel size = 1, it fuses the bias and relu
+  host::math::GemmEpilogue rest = epilogue;
+  rest.bias = nullptr;
+  bool flag_relu =
+      rest.act == lite_api::ActivationType::kRelu && !rest.residual;
+  if (flag_relu) {
+    rest.act = lite_api::ActivationType::kIndentity;
+  }
+  sgemv(weights,
+        din,
+        dout,
+        false,
+        m,
+        k,
+        epilogue.bias != nullptr,
+        epilogue.bias,
+        flag_relu);
+  if (!rest.empty()) {
+    host::math::apply_gemm_epilogue(rest, 0, m, 0, 1, dout, 1);
+  }
+}
+
+}  // namespace
+
+void conv_residual_act(const operators::ConvParam& param) {
+  if (param.residualData) {
+    CHECK_EQ(param.residualData->dims(), param.output->dims());
+  }
+  auto o_dims = param.output->dims();
+  int channel_size = o_dims[2] * o_dims[3];
+  auto epilogue = conv_group_epilogue(param, nullptr, 0, channel_size);
+  host::math::apply_gemm_epilogue(epilogue,
+                                  0,
+                                  o_dims[0] * o_dims[1],
+                                  0,
+                                  channel_size,
+                                  param.output->mutable_data<float>(),
+                                  channel_size);
+}
+
 /**
  * \brief neon implementation to add bias
  * @param tensor
@@ -171,8 +247,10 @@ void conv1x1s1_gemm(const float* i_data,
   const int n = oh * ow;
   const int k = ic / group;
 
-  bool flag_relu = param.fuse_relu;
   bool flag_bias = param.bias != nullptr;
+  if (param.residualData) {
+    CHECK_EQ(param.residualData->dims(), param.output->dims());
+  }
 
   int hblock = get_hblock(ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
@@ -181,44 +259,21 @@ void conv1x1s1_gemm(const float* i_data,
     weights_size_per_group = ((m_roundup * k + 15) / 16) * 16;
   }
 
-  //! use gemv when the output channel size = 1
   for (int b = 0; b < num; ++b) {
     // dC
     for (int g = 0; g < group; ++g) {
-      float* dout_group =
-          static_cast<float*>(o_data) + (b * oc + g * m) * channel_size_out;
+      int64_t out_offset = (b * oc + g * m) * channel_size_out;
+      float* dout_group = static_cast<float*>(o_data) + out_offset;
       const float* din_group = static_cast<const float*>(i_data) +
                                (b * ic + g * k) * channel_size_in;
       const float* weights_group =
           static_cast<const float*>(weights) + g * weights_size_per_group;
-      const float* bias_group = static_cast<const float*>(bias) + g * m;
-
-      if (n == 1) {
-        sgemv(weights_group,
-              din_group,
-              dout_group,
-              false,
-              m,
-              k,
-              flag_bias,
-              bias_group,
-              flag_relu);
-      } else {
-        sgemm_prepack(false,
-                      m,
-                      n,
-                      k,
-                      weights_group,
-                      din_group,
-                      n,
-                      0.f,
-                      dout_group,
-                      n,
-                      bias_group,
-                      flag_bias,
-                      flag_relu,
-                      ctx);
-      }
+      const float* bias_group =
+          flag_bias ? static_cast<const float*>(bias) + g * m : nullptr;
+      auto epilogue =
+          conv_group_epilogue(param, bias_group, out_offset, channel_size_out);
+      conv_gemm_group(
+          weights_group, din_group, dout_group, m, n, k, epilogue, ctx);
     }
   }
 }
@@ -349,8 +404,10 @@ void conv_im2col_gemm(const float* i_data,
   const int chin_per_group = ic / group;
   int channel_size_out = ow * oh;
   int channel_size_in = win * ih;
-  bool flag_relu = param.fuse_relu;
   bool flag_bias = param.bias != nullptr;
+  if (param.residualData) {
+    CHECK_EQ(param.residualData->dims(), param.output->dims());
+  }
   int hblock = get_hblock(ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
   int weights_size_per_group = m * k;
@@ -361,15 +418,15 @@ void conv_im2col_gemm(const float* i_data,
   float* tmp_work_space =
       ctx->workspace_data<float>() + ctx->llc_size() / sizeof(float);
 
-  //! use gemv when the output channel size = 1
   for (int b = 0; b < num; ++b) {
     // dC
     for (int g = 0; g < group; ++g) {
-      float* dout_group = o_data + (b * oc + g * m) * channel_size_out;
+      int64_t out_offset = (b * oc + g * m) * channel_size_out;
+      float* dout_group = o_data + out_offset;
       const float* din_group =
           i_data + (b * ic + g * chin_per_group) * channel_size_in;
       const float* weights_group = weights + g * weights_size_per_group;
-      const float* bias_group = bias + g * m;
+      const float* bias_group = flag_bias ? bias + g * m : nullptr;
       float* dB = tmp_work_space;
 
       im2col(din_group,
@@ -386,33 +443,9 @@ void conv_im2col_gemm(const float* i_data,
              param.dilations[1],
              dB);
 
-      if (n == 1) {
-        sgemv(weights_group,
-              dB,
-              dout_group,
-              false,
-              m,
-              k,
-              flag_bias,
-              bias_group,
-              flag_relu);
-      } else {
-        int ldb = n;
-        sgemm_prepack(false,
-                      m,
-                      n,
-                      k,
-                      weights_group,
-                      dB,
-                      ldb,
-                      0.f,
-                      dout_group,
-                      n,
-                      bias_group,
-                      flag_bias,
-                      flag_relu,
-                      ctx);
-      }
+      auto epilogue =
+          conv_group_epilogue(param, bias_group, out_offset, channel_size_out);
+      conv_gemm_group(weights_group, dB, dout_group, m, n, k, epilogue, ctx);
     }
   }
 }
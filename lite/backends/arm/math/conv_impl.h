@@ -183,6 +183,10 @@ void conv_im2col_gemm(const float* din,
                       const operators::ConvParam& param,
                       ARMContext* ctx);
 
+// Apply the residual add and the activation of a fused conv to its output, for
+// the conv impls which only fuse the bias and relu.
+void conv_residual_act(const operators::ConvParam& param);
+
 template <typename Dtype>
 void conv_im2col_gemm_int8(const int8_t* din,
                            Dtype* dout,
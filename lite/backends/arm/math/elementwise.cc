@@ -15,6 +15,7 @@
 #include "lite/backends/arm/math/elementwise.h"
 #include <algorithm>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/arm/math/saturate.h"
 
 namespace paddle {
 namespace lite {
@@ -1284,6 +1285,152 @@ void elementwise_div_relu_broadcast<float>(const float* dinx,
   }
 }
 
+// Widens 8 int8 values to two vectors of float.
+inline void int8x8_to_fp32(int8x8_t vin, float32x4_t* lo, float32x4_t* hi) {
+  int16x8_t v16 = vmovl_s8(vin);
+  *lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v16)));
+  *hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v16)));
+}
+
+// Rounds 8 floats half away from zero and narrows them to int8 with
+// saturation, the same as fp32_to_int8.
+inline int8x8_t fp32_to_int8x8(float32x4_t lo, float32x4_t hi) {
+#ifdef __aarch64__
+  int32x4_t ilo = vcvtaq_s32_f32(lo);
+  int32x4_t ihi = vcvtaq_s32_f32(hi);
+#else
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  float32x4_t vpoff = vdupq_n_f32(0.5f);
+  float32x4_t vnoff = vdupq_n_f32(-0.5f);
+  int32x4_t ilo = vcvtq_s32_f32(
+      vaddq_f32(lo, vbslq_f32(vcgtq_f32(lo, vzero), vpoff, vnoff)));
+  int32x4_t ihi = vcvtq_s32_f32(
+      vaddq_f32(hi, vbslq_f32(vcgtq_f32(hi, vzero), vpoff, vnoff)));
+#endif
+  return vqmovn_s16(vcombine_s16(vqmovn_s32(ilo), vqmovn_s32(ihi)));
+}
+
+// out = x * x_ratio + bias + y * y_ratio, y is skipped if it is null.
+inline void add_int8_requant(const int8_t* dinx,
+                             const int8_t* diny,
+                             int8_t* dout,
+                             int num,
+                             float x_ratio,
+                             float y_ratio,
+                             float bias,
+                             bool relu) {
+  int cnt = num >> 3;
+  int remain = num & 7;
+  float32x4_t vxr = vdupq_n_f32(x_ratio);
+  float32x4_t vyr = vdupq_n_f32(y_ratio);
+  float32x4_t vbias = vdupq_n_f32(bias);
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  for (int i = 0; i < cnt; ++i) {
+    float32x4_t x_lo, x_hi;
+    int8x8_to_fp32(vld1_s8(dinx), &x_lo, &x_hi);
+    float32x4_t r_lo = vmlaq_f32(vbias, x_lo, vxr);
+    float32x4_t r_hi = vmlaq_f32(vbias, x_hi, vxr);
+    if (diny) {
+      float32x4_t y_lo, y_hi;
+      int8x8_to_fp32(vld1_s8(diny), &y_lo, &y_hi);
+      r_lo = vmlaq_f32(r_lo, y_lo, vyr);
+      r_hi = vmlaq_f32(r_hi, y_hi, vyr);
+      diny += 8;
+    }
+    if (relu) {
+      r_lo = vmaxq_f32(r_lo, vzero);
+      r_hi = vmaxq_f32(r_hi, vzero);
+    }
+    vst1_s8(dout, fp32_to_int8x8(r_lo, r_hi));
+    dinx += 8;
+    dout += 8;
+  }
+  for (int i = 0; i < remain; ++i) {
+    float r = dinx[i] * x_ratio + bias;
+    if (diny) r += diny[i] * y_ratio;
+    if (relu) r = r > 0.f ? r : 0.f;
+    dout[i] = saturate_cast<int8_t>(r);
+  }
+}
+
+void elementwise_add_int8(const int8_t* dinx,
+                          const int8_t* diny,
+                          int8_t* dout,
+                          int num,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale,
+                          bool relu) {
+  if (x_scale == out_scale && y_scale == out_scale) {
+    // No requantization, it is the saturating add.
+    int cnt = num >> 4;
+    int remain = num & 15;
+    int8x16_t vzero = vdupq_n_s8(0);
+#pragma omp parallel for
+    for (int i = 0; i < cnt; ++i) {
+      int8x16_t vx = vld1q_s8(dinx + i * 16);
+      int8x16_t vy = vld1q_s8(diny + i * 16);
+      int8x16_t vr = vqaddq_s8(vx, vy);
+      if (relu) vr = vmaxq_s8(vr, vzero);
+      vst1q_s8(dout + i * 16, vr);
+    }
+    const int8_t* x_remain = dinx + cnt * 16;
+    const int8_t* y_remain = diny + cnt * 16;
+    int8_t* out_remain = dout + cnt * 16;
+    for (int i = 0; i < remain; ++i) {
+      int r = static_cast<int>(x_remain[i]) + y_remain[i];
+      if (relu) r = r > 0 ? r : 0;
+      out_remain[i] = saturate_cast<int8_t>(r);
+    }
+    return;
+  }
+  const float x_ratio = x_scale / out_scale;
+  const float y_ratio = y_scale / out_scale;
+  const int block = 1024;
+  int blocks = (num + block - 1) / block;
+#pragma omp parallel for
+  for (int i = 0; i < blocks; ++i) {
+    int offset = i * block;
+    int len = std::min(block, num - offset);
+    add_int8_requant(dinx + offset,
+                     diny + offset,
+                     dout + offset,
+                     len,
+                     x_ratio,
+                     y_ratio,
+                     0.f,
+                     relu);
+  }
+}
+
+void elementwise_add_int8_broadcast(const int8_t* dinx,
+                                    const int8_t* diny,
+                                    int8_t* dout,
+                                    int batch,
+                                    int channels,
+                                    int num,
+                                    float x_scale,
+                                    float y_scale,
+                                    float out_scale,
+                                    bool relu) {
+  const float x_ratio = x_scale / out_scale;
+  const float y_ratio = y_scale / out_scale;
+#pragma omp parallel for collapse(2)
+  for (int i = 0; i < batch; ++i) {
+    for (int j = 0; j < channels; ++j) {
+      int offset = (i * channels + j) * num;
+      add_int8_requant(dinx + offset,
+                       nullptr,
+                       dout + offset,
+                       num,
+                       x_ratio,
+                       0.f,
+                       diny[j] * y_ratio,
+                       relu);
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
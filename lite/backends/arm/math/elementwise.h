@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace paddle {
 namespace lite {
 namespace arm {
@@ -89,6 +91,28 @@ template <typename T>
 void elementwise_div_relu_broadcast(
     const T* dinx, const T* diny, T* dout, int batch, int channels, int num);
 
+// The int8 add requantizes the inputs to the scale of the output, that is
+// out = (x * x_scale + y * y_scale) / out_scale, saturated to int8.
+void elementwise_add_int8(const int8_t* dinx,
+                          const int8_t* diny,
+                          int8_t* dout,
+                          int num,
+                          float x_scale,
+                          float y_scale,
+                          float out_scale,
+                          bool relu);
+
+void elementwise_add_int8_broadcast(const int8_t* dinx,
+                                    const int8_t* diny,
+                                    int8_t* dout,
+                                    int batch,
+                                    int channels,
+                                    int num,
+                                    float x_scale,
+                                    float y_scale,
+                                    float out_scale,
+                                    bool relu);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
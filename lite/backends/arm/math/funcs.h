@@ -54,6 +54,7 @@
 #include "lite/backends/arm/math/sequence_pool.h"
 #include "lite/backends/arm/math/sequence_softmax.h"
 #include "lite/backends/arm/math/sgemm.h"
+#include "lite/backends/arm/math/sgemm_weight_only_quant.h"
 #include "lite/backends/arm/math/sgemv.h"
 #include "lite/backends/arm/math/shuffle_channel.h"
 #include "lite/backends/arm/math/slice.h"
@@ -52,6 +52,7 @@ void sgemm_prepacked_8x12(bool is_transB,
                           const float *bias,
                           bool has_bias,
                           bool has_relu,
+                          const host::math::GemmEpilogue *epilogue,
                           ARMContext *ctx);
 #else
 // for kA72
@@ -105,6 +106,7 @@ void sgemm_prepacked_6x8(bool is_transB,
                          const float *bias,
                          bool has_bias,
                          bool has_relu,
+                         const host::math::GemmEpilogue *epilogue,
                          ARMContext *ctx);
 // for kA73, 4x8
 void sgemm_prepacked_4x8(bool is_transB,
@@ -120,6 +122,7 @@ void sgemm_prepacked_4x8(bool is_transB,
                          const float *bias,
                          bool has_bias,
                          bool has_relu,
+                         const host::math::GemmEpilogue *epilogue,
                          ARMContext *ctx);
 #endif  // __aarch64__
 
@@ -196,21 +199,23 @@ void prepackA(TensorLite *tout,
   }
 }
 
-/// a: m*k  b: k*n  c: m*n
-void sgemm_prepack(bool is_transB,
-                   int M,
-                   int N,
-                   int K,
-                   const float *A_packed,
-                   const float *B,
-                   int ldb,
-                   float beta,
-                   float *C,
-                   int ldc,
-                   const float *bias,
-                   bool has_bias,
-                   bool has_relu,
-                   ARMContext *ctx) {
+namespace {
+
+void sgemm_prepacked(bool is_transB,
+                     int M,
+                     int N,
+                     int K,
+                     const float *A_packed,
+                     const float *B,
+                     int ldb,
+                     float beta,
+                     float *C,
+                     int ldc,
+                     const float *bias,
+                     bool has_bias,
+                     bool has_relu,
+                     const host::math::GemmEpilogue *epilogue,
+                     ARMContext *ctx) {
 #ifdef __aarch64__
   sgemm_prepacked_8x12(is_transB,
                        M,
@@ -225,6 +230,7 @@ void sgemm_prepack(bool is_transB,
                        bias,
                        has_bias,
                        has_relu,
+                       epilogue,
                        ctx);
 #else   // armv7
   if (ctx->arch() == kA73) {
@@ -241,6 +247,7 @@ void sgemm_prepack(bool is_transB,
                         bias,
                         has_bias,
                         has_relu,
+                        epilogue,
                         ctx);
   } else {
     sgemm_prepacked_6x8(is_transB,
@@ -256,11 +263,88 @@ void sgemm_prepack(bool is_transB,
                         bias,
                         has_bias,
                         has_relu,
+                        epilogue,
                         ctx);
   }
 #endif  // arm64
 }
 
+}  // namespace
+
+/// a: m*k  b: k*n  c: m*n
+void sgemm_prepack(bool is_transB,
+                   int M,
+                   int N,
+                   int K,
+                   const float *A_packed,
+                   const float *B,
+                   int ldb,
+                   float beta,
+                   float *C,
+                   int ldc,
+                   const float *bias,
+                   bool has_bias,
+                   bool has_relu,
+                   ARMContext *ctx) {
+  sgemm_prepacked(is_transB,
+                  M,
+                  N,
+                  K,
+                  A_packed,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  bias,
+                  has_bias,
+                  has_relu,
+                  nullptr,
+                  ctx);
+}
+
+void sgemm_prepack(bool is_transB,
+                   int M,
+                   int N,
+                   int K,
+                   const float *A_packed,
+                   const float *B,
+                   int ldb,
+                   float beta,
+                   float *C,
+                   int ldc,
+                   const host::math::GemmEpilogue &epilogue,
+                   ARMContext *ctx) {
+  // The inner kernels add the bias of the rows and apply relu, if no scale
+  // comes before them and nothing comes between them.
+  host::math::GemmEpilogue rest = epilogue;
+  const bool has_bias =
+      epilogue.bias && epilogue.channel_is_row && !epilogue.scale;
+  if (has_bias) {
+    rest.bias = nullptr;
+  }
+  const bool has_relu = rest.act == lite_api::ActivationType::kRelu &&
+                        !rest.scale && !rest.bias && !rest.residual;
+  if (has_relu) {
+    rest.act = lite_api::ActivationType::kIndentity;
+  }
+  sgemm_prepacked(is_transB,
+                  M,
+                  N,
+                  K,
+                  A_packed,
+                  B,
+                  ldb,
+                  beta,
+                  C,
+                  ldc,
+                  has_bias ? epilogue.bias : nullptr,
+                  has_bias,
+                  has_relu,
+                  rest.empty() ? nullptr : &rest,
+                  ctx);
+}
+
 #ifdef __aarch64__
 /*
  * The following function prepackA_8x12 is base on
@@ -1964,6 +2048,7 @@ void sgemm_prepacked_8x12(bool is_transB,
                           const float *bias,
                           bool has_bias,
                           bool has_relu,
+                          const host::math::GemmEpilogue *epilogue,
                           ARMContext *ctx) {
   size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
   auto workspace = ctx->workspace_data<float>();
@@ -2589,6 +2674,9 @@ void sgemm_prepacked_8x12(bool is_transB,
           }
         }
       }
+      if (epilogue) {
+        host::math::apply_gemm_epilogue(*epilogue, y, ymax, x0, xmax, C, ldc);
+      }
     }
   }
 }
@@ -2617,6 +2705,7 @@ void sgemm_prepacked_6x8(bool is_transB,
                          const float* bias,
                          bool has_bias,
                          bool has_relu,
+                         const host::math::GemmEpilogue* epilogue,
                          ARMContext* ctx) {
   size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
   auto* workspace = ctx->workspace_data<float>();
@@ -3046,6 +3135,9 @@ void sgemm_prepacked_6x8(bool is_transB,
           }
         }
       }
+      if (epilogue) {
+        host::math::apply_gemm_epilogue(*epilogue, y, ymax, x0, xmax, C, ldc);
+      }
     }
   }
 }
@@ -3063,6 +3155,7 @@ void sgemm_prepacked_4x8(bool is_transB,
                          const float* bias,
                          bool has_bias,
                          bool has_relu,
+                         const host::math::GemmEpilogue* epilogue,
                          ARMContext* ctx) {
   size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
   auto* workspace = ctx->workspace_data<float>();
@@ -3387,6 +3480,9 @@ void sgemm_prepacked_4x8(bool is_transB,
           }
         }
       }
+      if (epilogue) {
+        host::math::apply_gemm_epilogue(*epilogue, y, ymax, x0, xmax, C, ldc);
+      }
     }
   }
 }
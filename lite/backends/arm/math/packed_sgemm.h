@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cmath>
+#include "lite/backends/host/math/gemm_epilogue.h"
 #include "lite/core/context.h"
 #include "lite/core/tensor.h"
 
@@ -77,6 +78,22 @@ void sgemm_prepack(bool is_transB,
                    bool has_relu,
                    ARMContext* ctx);
 
+// C = A * B followed by the `epilogue`, which is applied to each block of C
+// right after it is computed. The bias of the rows and relu are fused into the
+// inner kernels when they can be.
+void sgemm_prepack(bool is_transB,
+                   int M,
+                   int N,
+                   int K,
+                   const float* A_packed,
+                   const float* B,
+                   int ldb,
+                   float beta,
+                   float* C,
+                   int ldc,
+                   const host::math::GemmEpilogue& epilogue,
+                   ARMContext* ctx);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <limits>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/arm/math/saturate.h"
 
 namespace paddle {
 namespace lite {
@@ -151,6 +152,97 @@ void pooling_basic(const float* din,
   }
 }
 
+void pooling_basic_int8(const int8_t* din,
+                        int8_t* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        const std::string& pooling_type,
+                        float in_scale,
+                        float out_scale) {
+  int kernel_h = ksize[0];
+  int kernel_w = ksize[1];
+  int stride_h = strides[0];
+  int stride_w = strides[1];
+  int pad_h = paddings[0];
+  int pad_w = paddings[1];
+  int size_channel_in = win * hin;
+  int size_channel_out = wout * hout;
+  bool is_max = pooling_type == "max";
+  if (!is_max && pooling_type != "avg") {
+    LOG(FATAL) << "unsupported pooling type: " << pooling_type;
+  }
+  const float ratio = in_scale / out_scale;
+  for (int ind_n = 0; ind_n < num; ++ind_n) {
+#pragma omp parallel for
+    for (int ind_c = 0; ind_c < chin; ++ind_c) {
+      const int8_t* din_ch = din + (ind_n * chin + ind_c) * size_channel_in;
+      int8_t* dout_ch = dout + (ind_n * chout + ind_c) * size_channel_out;
+      for (int ind_h = 0; ind_h < hout; ++ind_h) {
+        int sh = ind_h * stride_h;
+        int eh = sh + kernel_h;
+        sh = (sh - pad_h) < 0 ? 0 : sh - pad_h;
+        eh = (eh - pad_h) > hin ? hin : eh - pad_h;
+        for (int ind_w = 0; ind_w < wout; ++ind_w) {
+          int sw = ind_w * stride_w;
+          int ew = sw + kernel_w;
+          sw = (sw - pad_w) < 0 ? 0 : sw - pad_w;
+          ew = (ew - pad_w) > win ? win : ew - pad_w;
+          // The max is taken on int8 directly, the avg sums in int32.
+          int result = is_max && eh > sh && ew > sw ? -128 : 0;
+          for (int kh = sh; kh < eh; ++kh) {
+            const int8_t* din_row = din_ch + kh * win;
+            for (int kw = sw; kw < ew; ++kw) {
+              if (is_max) {
+                result = result >= din_row[kw] ? result : din_row[kw];
+              } else {
+                result += din_row[kw];
+              }
+            }
+          }
+          float div = 1.f;
+          if (!is_max) {
+            if (exclusive) {
+              int area = (ew - sw) * (eh - sh);
+              div = area > 0 ? area : 1;
+            } else {
+              int bh = kernel_h;
+              int bw = kernel_w;
+              if (ew == win) {
+                bw = sw + kernel_w >= win + pad_w ? win + pad_w
+                                                  : sw + kernel_w;
+                bw -= sw;
+                if (sw - pad_w < 0 && sw + kernel_w > win + pad_w) {
+                  bw += pad_w;
+                }
+              }
+              if (eh == hin) {
+                bh = sh + kernel_h >= hin + pad_h ? hin + pad_h
+                                                  : sh + kernel_h;
+                bh -= sh;
+                if (sh - pad_h < 0 && sh + kernel_h > hin + pad_h) {
+                  bh += pad_h;
+                }
+              }
+              div = bh * bw;
+            }
+          }
+          dout_ch[ind_h * wout + ind_w] =
+              saturate_cast<int8_t>(result * ratio / div);
+        }
+      }
+    }
+  }
+}
+
 #ifdef __aarch64__
 #define GLOBAL_INIT                                    \
   "ld1 {v0.4s-v1.4s}, [%[data_in_channel]], #32    \n" \
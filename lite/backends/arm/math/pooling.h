@@ -15,6 +15,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "lite/utils/cp_logging.h"
@@ -44,6 +45,25 @@ void pooling_basic(const float* din,
                    bool use_quantizer,
                    const std::string& pooling_type);
 
+// !pooling int8 Op, din is quantized with in_scale and dout with out_scale.
+// The global pooling is done with ksize of the whole feature map.
+void pooling_basic_int8(const int8_t* din,
+                        int8_t* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        const std::string& pooling_type,
+                        float in_scale,
+                        float out_scale);
+
 void pooling_global_max(const float* din,
                         float* dout,
                         int num,
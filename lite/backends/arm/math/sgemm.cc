@@ -61,6 +61,34 @@ void sgemm(bool is_transA,
   TargetFree(TargetType::kARM, packed_A);
 }
 
+void sgemm(bool is_transA,
+           bool is_transB,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc,
+           const host::math::GemmEpilogue& epilogue,
+           ARMContext* ctx) {
+  int hblock = get_hblock(ctx);
+  int m_roundup = hblock * ((M + hblock - 1) / hblock);
+
+  auto packed_A = static_cast<float*>(
+      TargetMalloc(TargetType::kARM, m_roundup * K * sizeof(float)));
+
+  prepackA(packed_A, A, alpha, lda, 0, M, 0, K, is_transA, ctx);
+
+  sgemm_prepack(
+      is_transB, M, N, K, packed_A, B, ldb, beta, C, ldc, epilogue, ctx);
+  TargetFree(TargetType::kARM, packed_A);
+}
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -42,6 +42,23 @@ void sgemm(bool is_transA,
            bool is_relu,
            ARMContext* ctx);
 
+// C = alpha * A * B + beta * C followed by the `epilogue`, see sgemm_prepack.
+void sgemm(bool is_transA,
+           bool is_transB,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc,
+           const host::math::GemmEpilogue& epilogue,
+           ARMContext* ctx);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
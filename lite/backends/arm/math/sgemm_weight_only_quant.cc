@@ -0,0 +1,139 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sgemm_weight_only_quant.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/arm/math/gemm_s8.h"
+#include "lite/backends/arm/math/sgemm.h"
+#include "lite/backends/arm/math/type_trans.h"
+#include "lite/backends/host/math/weight_only_quant.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The number of the dequantized weights in a block, which fits in L2 cache.
+static constexpr int kWeightBlockSize = 16384;
+
+void sgemm_weight_only_quant(int M,
+                             int N,
+                             int K,
+                             const float* A,
+                             const int8_t* B,
+                             const float* scale,
+                             int bits,
+                             float* C,
+                             std::vector<float>* buffer,
+                             ARMContext* ctx) {
+  const int packed_n = bits == 4 ? N / 2 : N;
+  const int block =
+      std::min(K, std::max(16, kWeightBlockSize / std::max(N, 1)));
+  buffer->resize(static_cast<size_t>(block) * N);
+  for (int k0 = 0; k0 < K; k0 += block) {
+    int kb = std::min(block, K - k0);
+    lite::host::math::dequantize_weight_rows(
+        B + static_cast<int64_t>(k0) * packed_n,
+        kb,
+        N,
+        bits,
+        scale,
+        buffer->data());
+    sgemm(false,
+          false,
+          M,
+          N,
+          kb,
+          1.f,
+          A + k0,
+          K,
+          buffer->data(),
+          N,
+          k0 == 0 ? 0.f : 1.f,
+          C,
+          N,
+          nullptr,
+          false,
+          false,
+          ctx);
+  }
+}
+
+static float abs_max(const float* x, int n) {
+  float32x4_t vmax = vdupq_n_f32(0.f);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vmax = vmaxq_f32(vmax, vabsq_f32(vld1q_f32(x + i)));
+  }
+  float lanes[4];
+  vst1q_f32(lanes, vmax);
+  float res = 0.f;
+  for (int j = 0; j < 4; ++j) {
+    res = std::max(res, lanes[j]);
+  }
+  for (; i < n; ++i) {
+    res = std::max(res, std::fabs(x[i]));
+  }
+  return res;
+}
+
+void sgemm_dynamic_quant(int M,
+                         int N,
+                         int K,
+                         const float* A,
+                         const int8_t* B,
+                         const float* scale,
+                         const host::math::GemmEpilogue& epilogue,
+                         float* C,
+                         std::vector<int8_t>* buffer,
+                         ARMContext* ctx) {
+  CHECK(epilogue.scale == nullptr);
+  buffer->resize(static_cast<size_t>(M) * K);
+  std::vector<float> row_scale(M);
+#pragma omp parallel for
+  for (int i = 0; i < M; ++i) {
+    float max = abs_max(A + static_cast<int64_t>(i) * K, K);
+    row_scale[i] = max > 0.f ? max / 127.f : 1.f;
+  }
+  fp32_to_int8(A, buffer->data(), row_scale.data(), M, 1, K);
+  gemm_s8(false,
+          false,
+          M,
+          N,
+          K,
+          buffer->data(),
+          B,
+          C,
+          nullptr,
+          false,
+          false,
+          row_scale.data(),
+          ctx);
+
+  // The scales of the columns go with the rest of the epilogue.
+  host::math::GemmEpilogue rest = epilogue;
+  rest.scale = scale;
+  rest.channel_is_row = false;
+#pragma omp parallel for
+  for (int i = 0; i < M; ++i) {
+    host::math::apply_gemm_epilogue(rest, i, i + 1, 0, N, C, N);
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,62 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/backends/host/math/gemm_epilogue.h"
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// C = A * B, where A is [M, K] and B is the weight of [K, N] stored in int8 or
+// packed int4 with a scale per column, see
+// `lite/backends/host/math/weight_only_quant.h`. A block of the rows of B is
+// dequantized into `buffer` at a time, and the partial products are
+// accumulated to C, so the float weight is never fully materialized.
+void sgemm_weight_only_quant(int M,
+                             int N,
+                             int K,
+                             const float* A,
+                             const int8_t* B,
+                             const float* scale,
+                             int bits,
+                             float* C,
+                             std::vector<float>* buffer,
+                             ARMContext* ctx);
+
+// C = epilogue(A * B) for the dynamic quantization, B is the int8 weight with
+// a scale per column as above. Each row of A is quantized to int8 into
+// `buffer` at runtime with its own scale abs_max / 127, the int8 GEMM
+// dequantizes the int32 sums with the scale of the row, and the scales of the
+// columns are applied in a last pass together with the epilogue, whose
+// channels are the columns and which must not carry a scale of its own.
+void sgemm_dynamic_quant(int M,
+                         int N,
+                         int K,
+                         const float* A,
+                         const int8_t* B,
+                         const float* scale,
+                         const host::math::GemmEpilogue& epilogue,
+                         float* C,
+                         std::vector<int8_t>* buffer,
+                         ARMContext* ctx);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
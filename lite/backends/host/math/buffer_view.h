@@ -0,0 +1,140 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The concat, split and slice along the outermost non-trivial axis, that is
+// all the dims before the axis are 1, read or write a contiguous block for
+// each tensor. They are done without copies by making the tensors views of a
+// block of another tensor with `ShareExternalMemory`, see `BufferViewPass`.
+// These functions return false if the axis is not the outermost one, then the
+// kernels fall back to the copies.
+//
+// A view does not own the memory. If its producer needs more memory, it gets
+// its own buffer and is no longer a view.
+
+// Make the inputs views of `out`, so their producers write to `out` directly
+// since the next run. The inputs which are not in place, such as in the first
+// run, are copied.
+template <typename T>
+bool concat_as_view(const std::vector<Tensor*>& inputs, int axis, Tensor* out) {
+#ifdef LITE_WITH_FPGA
+  return false;
+#else
+  if (axis < 0) axis += out->dims().size();
+  if (out->dims().Slice(0, axis).production() != 1) return false;
+  const int64_t numel = out->numel();
+  bool in_place = false;
+  bool misplaced = false;
+  if (out->IsInitialized()) {
+    const T* out_begin = out->data<T>();
+    const T* out_end = out_begin + out->capacity() / sizeof(T);
+    int64_t offset = 0;
+    for (auto* in : inputs) {
+      const T* in_data = in->data<T>();
+      if (in_data == out_begin + offset) {
+        in_place = true;
+      } else if (in_data >= out_begin && in_data < out_end) {
+        misplaced = true;
+      }
+      offset += in->numel();
+    }
+  }
+  // Copying the misplaced inputs may overwrite the others, and reallocating
+  // `out` frees the inputs in place, so copy all the inputs to a new buffer.
+  // `old_out` keeps the old buffer alive until the copies are done.
+  Tensor old_out;
+  if (misplaced || (in_place && out->capacity() < numel * sizeof(T))) {
+    old_out = *out;
+    Tensor buffer;
+    buffer.Resize(out->dims());
+    buffer.mutable_data<T>(out->target());
+    auto lod = out->lod();
+    out->ShareDataWith(buffer);
+    out->set_lod(lod);
+  }
+  auto* out_data = out->mutable_data<T>();
+  int64_t offset = 0;
+  for (auto* in : inputs) {
+    const int64_t size = in->numel();
+    if (in->data<T>() != out_data + offset) {
+      std::memcpy(out_data + offset, in->data<T>(), size * sizeof(T));
+      in->ShareExternalMemory(
+          out_data + offset, size * sizeof(T), out->target());
+    }
+    offset += size;
+  }
+  CHECK_EQ(offset, numel);
+  return true;
+#endif
+}
+
+// Make the outputs views of `in`.
+template <typename T>
+bool split_as_view(const Tensor& in,
+                   int axis,
+                   const std::vector<Tensor*>& outputs) {
+#ifdef LITE_WITH_FPGA
+  return false;
+#else
+  if (axis < 0) axis += in.dims().size();
+  if (in.dims().Slice(0, axis).production() != 1) return false;
+  auto* in_data = const_cast<T*>(in.data<T>());
+  int64_t offset = 0;
+  for (auto* out : outputs) {
+    out->ShareExternalMemory(
+        in_data + offset, out->numel() * sizeof(T), in.target());
+    offset += out->numel();
+  }
+  CHECK_EQ(offset, in.numel());
+  return true;
+#endif
+}
+
+// Make `out` a view of `in` from `start` along `axis`.
+template <typename T>
+bool slice_as_view(const Tensor& in, int axis, int start, Tensor* out) {
+#ifdef LITE_WITH_FPGA
+  return false;
+#else
+  const auto& in_dims = in.dims();
+  if (axis < 0) axis += in_dims.size();
+  if (in_dims.Slice(0, axis).production() != 1) return false;
+  const int dim = in_dims[axis];
+  start = start < 0 ? start + dim : start;
+  start = std::min(std::max(start, 0), dim);
+  const int64_t offset =
+      start * in_dims.Slice(axis + 1, in_dims.size()).production();
+  CHECK_LE(offset + out->numel(), in.numel());
+  auto* in_data = const_cast<T*>(in.data<T>());
+  out->ShareExternalMemory(
+      in_data + offset, out->numel() * sizeof(T), in.target());
+  return true;
+#endif
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,240 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include "lite/api/paddle_place.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The element-wise ops fused after a GEMM. The kernels apply them to each
+// block of the output while it is still in cache, instead of running separate
+// kernels which go through the whole output again. Each output value v is
+// replaced by
+//   act(v * scale + bias + residual)
+// and the parts left nullptr are skipped.
+struct GemmEpilogue {
+  // The scale and the bias of each channel. The channels are the rows of the
+  // output in the convolutions, and its columns in fc and mul.
+  const float* scale{nullptr};
+  const float* bias{nullptr};
+  bool channel_is_row{true};
+  // Added before the activation, as the shortcut of a residual block. It has
+  // the layout of the output, and `ldr` is its leading dimension.
+  const float* residual{nullptr};
+  int ldr{0};
+  lite_api::ActivationType act{lite_api::ActivationType::kIndentity};
+  // The slope of kLeakyRelu, and the upper bound of kRelu6.
+  float leaky_alpha{0.f};
+  float relu6_threshold{6.f};
+  // kSwish is v * sigmoid(swish_beta * v), kHardSigmoid is
+  // clip(v * slope + offset, 0, 1), and kHardSwish is
+  // v * clip(v + offset, 0, threshold) / scale.
+  float swish_beta{1.f};
+  float hard_sigmoid_slope{0.2f};
+  float hard_sigmoid_offset{0.5f};
+  float hard_swish_threshold{6.f};
+  float hard_swish_scale{6.f};
+  float hard_swish_offset{3.f};
+
+  bool empty() const {
+    return scale == nullptr && bias == nullptr && residual == nullptr &&
+           act == lite_api::ActivationType::kIndentity;
+  }
+};
+
+// The activation named `type` in the attrs of the fused ops, "" for none.
+inline lite_api::ActivationType epilogue_act_type(const std::string& type) {
+  using lite_api::ActivationType;
+  if (type.empty()) return ActivationType::kIndentity;
+  if (type == "relu") return ActivationType::kRelu;
+  if (type == "relu6") return ActivationType::kRelu6;
+  if (type == "leaky_relu") return ActivationType::kLeakyRelu;
+  if (type == "sigmoid") return ActivationType::kSigmoid;
+  if (type == "swish") return ActivationType::kSwish;
+  if (type == "hard_sigmoid") return ActivationType::kHardSigmoid;
+  if (type == "hard_swish") return ActivationType::kHardSwish;
+  LOG(FATAL) << "unsupported epilogue activation " << type;
+  return ActivationType::kIndentity;
+}
+
+// Copy the activation of an ActivationParam, as fused into the conv ops.
+template <typename ActParam>
+inline void set_epilogue_act(const ActParam& param, GemmEpilogue* ep) {
+  ep->act = param.active_type;
+  ep->leaky_alpha = param.Leaky_relu_alpha;
+  ep->relu6_threshold = param.Relu_clipped_coef;
+  ep->swish_beta = param.Swish_beta;
+  ep->hard_sigmoid_slope = param.hard_sigmoid_slope;
+  ep->hard_sigmoid_offset = param.hard_sigmoid_offset;
+  ep->hard_swish_threshold = param.hard_swish_threshold;
+  ep->hard_swish_scale = param.hard_swish_scale;
+  ep->hard_swish_offset = param.hard_swish_offset;
+}
+
+namespace detail {
+
+template <lite_api::ActivationType Act>
+inline float epilogue_act(float v, const GemmEpilogue& ep) {
+  return v;
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kRelu>(
+    float v, const GemmEpilogue& ep) {
+  return std::max(v, 0.f);
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kRelu6>(
+    float v, const GemmEpilogue& ep) {
+  return std::min(std::max(v, 0.f), ep.relu6_threshold);
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kLeakyRelu>(
+    float v, const GemmEpilogue& ep) {
+  return v > 0.f ? v : v * ep.leaky_alpha;
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kSigmoid>(
+    float v, const GemmEpilogue& ep) {
+  return 1.f / (1.f + std::exp(-v));
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kSwish>(
+    float v, const GemmEpilogue& ep) {
+  return v / (1.f + std::exp(-ep.swish_beta * v));
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kHardSigmoid>(
+    float v, const GemmEpilogue& ep) {
+  return std::min(
+      std::max(v * ep.hard_sigmoid_slope + ep.hard_sigmoid_offset, 0.f), 1.f);
+}
+
+template <>
+inline float epilogue_act<lite_api::ActivationType::kHardSwish>(
+    float v, const GemmEpilogue& ep) {
+  return v *
+         std::min(std::max(v + ep.hard_swish_offset, 0.f),
+                  ep.hard_swish_threshold) /
+         ep.hard_swish_scale;
+}
+
+// The activation is a template argument, so that the inner loops have no
+// branch and are vectorized by the compiler.
+template <lite_api::ActivationType Act>
+inline void apply_gemm_epilogue(const GemmEpilogue& ep,
+                                int m0,
+                                int m1,
+                                int n0,
+                                int n1,
+                                float* c,
+                                int ldc) {
+  for (int i = m0; i < m1; ++i) {
+    float* row = c + static_cast<int64_t>(i) * ldc;
+    const float* res =
+        ep.residual ? ep.residual + static_cast<int64_t>(i) * ep.ldr : nullptr;
+    if (ep.channel_is_row) {
+      const float s = ep.scale ? ep.scale[i] : 1.f;
+      const float b = ep.bias ? ep.bias[i] : 0.f;
+      if (res) {
+        for (int j = n0; j < n1; ++j) {
+          row[j] = epilogue_act<Act>(row[j] * s + b + res[j], ep);
+        }
+      } else {
+        for (int j = n0; j < n1; ++j) {
+          row[j] = epilogue_act<Act>(row[j] * s + b, ep);
+        }
+      }
+    } else {
+      for (int j = n0; j < n1; ++j) {
+        float v = row[j];
+        if (ep.scale) v *= ep.scale[j];
+        if (ep.bias) v += ep.bias[j];
+        if (res) v += res[j];
+        row[j] = epilogue_act<Act>(v, ep);
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// Apply `ep` to the rows [m0, m1) and the columns [n0, n1) of C, whose leading
+// dimension is ldc. The channels and the residual are indexed by the same rows
+// and columns as C.
+inline void apply_gemm_epilogue(const GemmEpilogue& ep,
+                                int m0,
+                                int m1,
+                                int n0,
+                                int n1,
+                                float* c,
+                                int ldc) {
+  using lite_api::ActivationType;
+  switch (ep.act) {
+    case ActivationType::kIndentity:
+      detail::apply_gemm_epilogue<ActivationType::kIndentity>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kRelu:
+      detail::apply_gemm_epilogue<ActivationType::kRelu>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kRelu6:
+      detail::apply_gemm_epilogue<ActivationType::kRelu6>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kLeakyRelu:
+      detail::apply_gemm_epilogue<ActivationType::kLeakyRelu>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kSigmoid:
+      detail::apply_gemm_epilogue<ActivationType::kSigmoid>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kSwish:
+      detail::apply_gemm_epilogue<ActivationType::kSwish>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kHardSigmoid:
+      detail::apply_gemm_epilogue<ActivationType::kHardSigmoid>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    case ActivationType::kHardSwish:
+      detail::apply_gemm_epilogue<ActivationType::kHardSwish>(
+          ep, m0, m1, n0, n1, c, ldc);
+      break;
+    default:
+      LOG(FATAL) << "unsupported epilogue activation "
+                 << static_cast<int>(ep.act);
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,87 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "lite/core/tensor.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// Get the offsets of the matrices of x and y multiplied into each matrix of
+// out, the batch dims of x and y are broadcast as in numpy. Returns the batch
+// size of out.
+inline int matmul_batch_offsets(const DDim& x_dims,
+                                const DDim& y_dims,
+                                std::vector<int64_t>* x_offsets,
+                                std::vector<int64_t>* y_offsets) {
+  int x_rank = static_cast<int>(x_dims.size()) - 2;
+  int y_rank = static_cast<int>(y_dims.size()) - 2;
+  int rank = std::max(x_rank, y_rank);
+  std::vector<int64_t> x_batch(rank, 1);
+  std::vector<int64_t> y_batch(rank, 1);
+  std::vector<int64_t> out_batch(rank, 1);
+  for (int i = 0; i < x_rank; ++i) x_batch[rank - x_rank + i] = x_dims[i];
+  for (int i = 0; i < y_rank; ++i) y_batch[rank - y_rank + i] = y_dims[i];
+  int batch = 1;
+  for (int i = 0; i < rank; ++i) {
+    CHECK(x_batch[i] == y_batch[i] || x_batch[i] == 1 || y_batch[i] == 1)
+        << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
+        << ")";
+    out_batch[i] = std::max(x_batch[i], y_batch[i]);
+    batch *= out_batch[i];
+  }
+  // The strides of the batch dims, 0 for the broadcast ones.
+  std::vector<int64_t> x_strides(rank, 0);
+  std::vector<int64_t> y_strides(rank, 0);
+  int64_t x_stride = x_dims[x_dims.size() - 2] * x_dims[x_dims.size() - 1];
+  int64_t y_stride = y_dims[y_dims.size() - 2] * y_dims[y_dims.size() - 1];
+  for (int i = rank - 1; i >= 0; --i) {
+    x_strides[i] = x_batch[i] == 1 ? 0 : x_stride;
+    y_strides[i] = y_batch[i] == 1 ? 0 : y_stride;
+    x_stride *= x_batch[i];
+    y_stride *= y_batch[i];
+  }
+  x_offsets->resize(batch);
+  y_offsets->resize(batch);
+  std::vector<int64_t> index(rank, 0);
+  int64_t x_offset = 0;
+  int64_t y_offset = 0;
+  for (int b = 0; b < batch; ++b) {
+    (*x_offsets)[b] = x_offset;
+    (*y_offsets)[b] = y_offset;
+    for (int i = rank - 1; i >= 0; --i) {
+      if (++index[i] < out_batch[i]) {
+        x_offset += x_strides[i];
+        y_offset += y_strides[i];
+        break;
+      }
+      index[i] = 0;
+      x_offset -= x_strides[i] * (out_batch[i] - 1);
+      y_offset -= y_strides[i] * (out_batch[i] - 1);
+    }
+  }
+  return batch;
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,287 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+enum class ReduceType { kSum, kMean, kMax, kMin, kProd };
+
+// The reductions on the scalars, and on the AVX vectors for float.
+template <typename T, ReduceType Type>
+struct Reducer;
+
+template <typename T>
+struct Reducer<T, ReduceType::kSum> {
+  static T initial() { return static_cast<T>(0); }
+  static T reduce(T a, T b) { return a + b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+#endif
+};
+
+template <typename T>
+struct Reducer<T, ReduceType::kMean> : Reducer<T, ReduceType::kSum> {};
+
+template <typename T>
+struct Reducer<T, ReduceType::kMax> {
+  static T initial() { return std::numeric_limits<T>::lowest(); }
+  static T reduce(T a, T b) { return a > b ? a : b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+#endif
+};
+
+template <typename T>
+struct Reducer<T, ReduceType::kMin> {
+  static T initial() { return std::numeric_limits<T>::max(); }
+  static T reduce(T a, T b) { return a < b ? a : b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+#endif
+};
+
+template <typename T>
+struct Reducer<T, ReduceType::kProd> {
+  static T initial() { return static_cast<T>(1); }
+  static T reduce(T a, T b) { return a * b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+#endif
+};
+
+// The two loops of the reduction:
+// - `contiguous` reduces `size` contiguous elements to one,
+// - `strided` reduces `rows` rows of `size` elements, `stride` apart, to one
+//   row, vectorized along the row.
+template <typename T, ReduceType Type>
+struct ReduceLoops {
+  using R = Reducer<T, Type>;
+
+  static T contiguous(const T* in, int64_t size) {
+    T acc = R::initial();
+    for (int64_t i = 0; i < size; ++i) {
+      acc = R::reduce(acc, in[i]);
+    }
+    return acc;
+  }
+
+  static void strided(
+      const T* in, int64_t rows, int64_t size, int64_t stride, T* out) {
+    if (rows == 0) {
+      std::fill(out, out + size, R::initial());
+      return;
+    }
+    std::copy(in, in + size, out);
+    for (int64_t r = 1; r < rows; ++r) {
+      const T* row = in + r * stride;
+      for (int64_t i = 0; i < size; ++i) {
+        out[i] = R::reduce(out[i], row[i]);
+      }
+    }
+  }
+};
+
+#ifdef __AVX__
+template <ReduceType Type>
+struct ReduceLoops<float, Type> {
+  using R = Reducer<float, Type>;
+
+  static float contiguous(const float* in, int64_t size) {
+    float acc = R::initial();
+    int64_t i = 0;
+    if (size >= 32) {
+      // Four accumulators to hide the latency of the instructions.
+      __m256 acc0 = _mm256_loadu_ps(in);
+      __m256 acc1 = _mm256_loadu_ps(in + 8);
+      __m256 acc2 = _mm256_loadu_ps(in + 16);
+      __m256 acc3 = _mm256_loadu_ps(in + 24);
+      for (i = 32; i + 32 <= size; i += 32) {
+        acc0 = R::reduce(acc0, _mm256_loadu_ps(in + i));
+        acc1 = R::reduce(acc1, _mm256_loadu_ps(in + i + 8));
+        acc2 = R::reduce(acc2, _mm256_loadu_ps(in + i + 16));
+        acc3 = R::reduce(acc3, _mm256_loadu_ps(in + i + 24));
+      }
+      acc0 = R::reduce(R::reduce(acc0, acc1), R::reduce(acc2, acc3));
+      float lanes[8];
+      _mm256_storeu_ps(lanes, acc0);
+      for (int j = 0; j < 8; ++j) {
+        acc = R::reduce(acc, lanes[j]);
+      }
+    }
+    for (; i < size; ++i) {
+      acc = R::reduce(acc, in[i]);
+    }
+    return acc;
+  }
+
+  static void strided(
+      const float* in, int64_t rows, int64_t size, int64_t stride, float* out) {
+    if (rows == 0) {
+      std::fill(out, out + size, R::initial());
+      return;
+    }
+    int64_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      __m256 acc = _mm256_loadu_ps(in + i);
+      for (int64_t r = 1; r < rows; ++r) {
+        acc = R::reduce(acc, _mm256_loadu_ps(in + r * stride + i));
+      }
+      _mm256_storeu_ps(out + i, acc);
+    }
+    for (; i < size; ++i) {
+      float acc = in[i];
+      for (int64_t r = 1; r < rows; ++r) {
+        acc = R::reduce(acc, in[r * stride + i]);
+      }
+      out[i] = acc;
+    }
+  }
+};
+#endif
+
+// Reduce the shape [outer, rows, inner] to [outer, inner], threaded across
+// `outer`, or across blocks of `inner` if `outer` is 1.
+template <typename T, ReduceType Type>
+void reduce_middle(
+    const T* in, int64_t outer, int64_t rows, int64_t inner, T* out) {
+  using Loops = ReduceLoops<T, Type>;
+  if (inner == 1) {
+#ifdef _OPENMP
+#pragma omp parallel for if (outer > 1)
+#endif
+    for (int64_t o = 0; o < outer; ++o) {
+      out[o] = Loops::contiguous(in + o * rows, rows);
+    }
+  } else if (outer > 1) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int64_t o = 0; o < outer; ++o) {
+      Loops::strided(
+          in + o * rows * inner, rows, inner, inner, out + o * inner);
+    }
+  } else {
+    const int64_t kBlock = 1024;
+    const int64_t blocks = (inner + kBlock - 1) / kBlock;
+#ifdef _OPENMP
+#pragma omp parallel for if (blocks > 1)
+#endif
+    for (int64_t b = 0; b < blocks; ++b) {
+      int64_t begin = b * kBlock;
+      int64_t size = std::min(kBlock, inner - begin);
+      Loops::strided(in + begin, rows, size, inner, out + begin);
+    }
+  }
+}
+
+// Reduce `in` with the shape `dims` along `axes`, all the axes if `axes` is
+// empty. The output has the kept dims in order, whether they are kept as 1
+// or removed does not change the layout.
+//
+// The dims of 1 are dropped and the adjacent reduced or kept dims are
+// merged, then the reduced groups are reduced one by one from the innermost,
+// each as [outer, rows, inner], where the rows are contiguous if `inner` is
+// 1, or strided otherwise.
+template <typename T, ReduceType Type>
+void reduce(const T* in,
+            const std::vector<int64_t>& dims,
+            const std::vector<int>& axes,
+            T* out) {
+  const int rank = static_cast<int>(dims.size());
+  std::vector<bool> reduced(rank, axes.empty());
+  for (auto axis : axes) {
+    reduced[axis < 0 ? axis + rank : axis] = true;
+  }
+  int64_t numel = 1;
+  int64_t reduced_numel = 1;
+  // The merged dims as (size, reduced).
+  std::vector<std::pair<int64_t, bool>> groups;
+  for (int i = 0; i < rank; ++i) {
+    numel *= dims[i];
+    if (reduced[i]) reduced_numel *= dims[i];
+    if (dims[i] == 1) continue;
+    if (!groups.empty() && groups.back().second == reduced[i]) {
+      groups.back().first *= dims[i];
+    } else {
+      groups.emplace_back(dims[i], reduced[i]);
+    }
+  }
+
+  if (numel == 0) {
+    // Empty reductions give the initial values.
+    int64_t out_numel = 1;
+    for (int i = 0; i < rank; ++i) {
+      if (!reduced[i]) out_numel *= dims[i];
+    }
+    std::fill(out, out + out_numel, Reducer<T, Type>::initial());
+    return;
+  }
+
+  // Reduce the groups from the innermost, through the buffers if more than
+  // one is reduced. A reduction is not done in place, since the threads may
+  // write the rows another thread has not read.
+  std::vector<T> buffers[2];
+  const T* src = in;
+  int64_t size = numel;
+  int remaining = 0;
+  for (auto& group : groups) {
+    if (group.second) remaining++;
+  }
+  if (remaining == 0) {
+    std::copy(in, in + numel, out);
+  }
+  int64_t inner = 1;
+  for (int g = static_cast<int>(groups.size()) - 1; g >= 0; --g) {
+    if (!groups[g].second) {
+      inner *= groups[g].first;
+      continue;
+    }
+    int64_t rows = groups[g].first;
+    int64_t outer = size / (rows * inner);
+    T* dst = out;
+    if (--remaining > 0) {
+      auto& buffer = buffers[remaining % 2];
+      buffer.resize(outer * inner);
+      dst = buffer.data();
+    }
+    reduce_middle<T, Type>(src, outer, rows, inner, dst);
+    src = dst;
+    size = outer * inner;
+  }
+
+  if (Type == ReduceType::kMean) {
+    int64_t out_numel = numel / reduced_numel;
+    for (int64_t i = 0; i < out_numel; ++i) {
+      out[i] /= static_cast<T>(reduced_numel);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,129 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "lite/backends/host/math/gemm_epilogue.h"
+#include "lite/backends/host/math/reduce.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+namespace detail {
+
+// out[n] = in[k] * w, where w is [n, k] if `transposed`, and [k, n]
+// otherwise.
+inline void se_gemv(const float* in,
+                    const float* w,
+                    int k,
+                    int n,
+                    bool transposed,
+                    float* out) {
+  if (transposed) {
+    for (int j = 0; j < n; ++j) {
+      const float* row = w + static_cast<int64_t>(j) * k;
+      float acc = 0.f;
+      for (int i = 0; i < k; ++i) {
+        acc += row[i] * in[i];
+      }
+      out[j] = acc;
+    }
+  } else {
+    std::fill(out, out + n, 0.f);
+    for (int i = 0; i < k; ++i) {
+      const float* row = w + static_cast<int64_t>(i) * n;
+      const float v = in[i];
+      for (int j = 0; j < n; ++j) {
+        out[j] += v * row[j];
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// The squeeze-excitation block of MobileNetV3 and EfficientNet, for x and out
+// of shape [batch, channels, size]:
+//   squeeze = act(mean(x[c]) * squeeze_weight + bias), with `hidden` outputs
+//   gate = act(squeeze * excite_weight + bias), with `channels` outputs
+//   out[c] = x[c] * gate[c]
+// The biases and the activations are in the epilogues, whose channels are
+// the columns. The weights are [out, in] with `conv_weight`, as the filters
+// of the 1x1 convs, and [in, out] otherwise, as the weights of fc. Only the
+// pooling and the scaling go through x, the rest is on the pooled vectors.
+inline void squeeze_excitation(const float* x,
+                               int batch,
+                               int channels,
+                               int64_t size,
+                               const float* squeeze_weight,
+                               int hidden,
+                               const GemmEpilogue& squeeze_epilogue,
+                               const float* excite_weight,
+                               const GemmEpilogue& excite_epilogue,
+                               bool conv_weight,
+                               float* out) {
+  using Loops = ReduceLoops<float, ReduceType::kSum>;
+  std::vector<float> pooled(channels);
+  std::vector<float> squeeze(hidden);
+  std::vector<float> gate(channels);
+  const float size_r = 1.f / size;
+  for (int b = 0; b < batch; ++b) {
+    const int64_t offset = static_cast<int64_t>(b) * channels * size;
+    const float* x_batch = x + offset;
+    float* out_batch = out + offset;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < channels; ++c) {
+      pooled[c] = Loops::contiguous(x_batch + c * size, size) * size_r;
+    }
+    detail::se_gemv(pooled.data(),
+                    squeeze_weight,
+                    channels,
+                    hidden,
+                    conv_weight,
+                    squeeze.data());
+    apply_gemm_epilogue(
+        squeeze_epilogue, 0, 1, 0, hidden, squeeze.data(), hidden);
+    detail::se_gemv(squeeze.data(),
+                    excite_weight,
+                    hidden,
+                    channels,
+                    conv_weight,
+                    gate.data());
+    apply_gemm_epilogue(
+        excite_epilogue, 0, 1, 0, channels, gate.data(), channels);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < channels; ++c) {
+      const float* in = x_batch + c * size;
+      float* o = out_batch + c * size;
+      const float g = gate[c];
+      for (int64_t i = 0; i < size; ++i) {
+        o[i] = in[i] * g;
+      }
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
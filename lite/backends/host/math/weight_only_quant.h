@@ -0,0 +1,120 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The weight-only quantization stores a float weight of shape [rows, cols] in
+// int8, or in packed int4 if `bits` is 4: two values in a byte, the lower
+// nibble first, so the packed weight has the shape [rows, cols / 2]. Each row
+// or each column has a float scale, and the weight is dequantized by
+// w = q * scale. Only the weights are quantized, the kernels compute in float.
+
+// Sign-extend the lower and the upper nibble of a packed int4 byte.
+inline int8_t int4_low(int8_t q) {
+  return static_cast<int8_t>(((static_cast<uint8_t>(q) & 0x0f) ^ 8) - 8);
+}
+
+inline int8_t int4_high(int8_t q) {
+  return static_cast<int8_t>(((static_cast<uint8_t>(q) >> 4) ^ 8) - 8);
+}
+
+// Quantize `w` symmetrically, `scale` has `rows` elements if `per_row` is set,
+// otherwise `cols` elements.
+inline void quantize_weight(const float* w,
+                            int rows,
+                            int cols,
+                            int bits,
+                            bool per_row,
+                            int8_t* q,
+                            float* scale) {
+  const float max_q = bits == 4 ? 7.f : 127.f;
+  const int scale_size = per_row ? rows : cols;
+  std::fill(scale, scale + scale_size, 0.f);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      float& s = scale[per_row ? i : j];
+      s = std::max(s, std::abs(w[i * cols + j]));
+    }
+  }
+  for (int i = 0; i < scale_size; ++i) {
+    scale[i] = scale[i] > 0.f ? scale[i] / max_q : 1.f;
+  }
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      float v = std::round(w[i * cols + j] / scale[per_row ? i : j]);
+      auto qv = static_cast<int8_t>(std::min(std::max(v, -max_q), max_q));
+      if (bits == 4) {
+        auto& packed = q[(i * cols + j) / 2];
+        if (j % 2 == 0) {
+          packed = static_cast<int8_t>(qv & 0x0f);
+        } else {
+          packed = static_cast<int8_t>(static_cast<uint8_t>(packed) |
+                                       (static_cast<uint8_t>(qv) << 4));
+        }
+      } else {
+        q[i * cols + j] = qv;
+      }
+    }
+  }
+}
+
+// Dequantize a row of `cols` values which share the `scale`.
+inline void dequantize_weight_row(
+    const int8_t* q, int cols, int bits, float scale, float* out) {
+  if (bits == 4) {
+    for (int j = 0; j < cols / 2; ++j) {
+      out[2 * j] = int4_low(q[j]);
+      out[2 * j + 1] = int4_high(q[j]);
+    }
+  } else {
+    for (int j = 0; j < cols; ++j) {
+      out[j] = q[j];
+    }
+  }
+  for (int j = 0; j < cols; ++j) {
+    out[j] *= scale;
+  }
+}
+
+// Dequantize `rows` rows of `cols` values, each column has its own scale.
+inline void dequantize_weight_rows(const int8_t* q,
+                                   int rows,
+                                   int cols,
+                                   int bits,
+                                   const float* col_scale,
+                                   float* out) {
+  const int packed_cols = bits == 4 ? cols / 2 : cols;
+  for (int i = 0; i < rows; ++i) {
+    float* out_row = out + static_cast<int64_t>(i) * cols;
+    dequantize_weight_row(
+        q + static_cast<int64_t>(i) * packed_cols, cols, bits, 1.f, out_row);
+    for (int j = 0; j < cols; ++j) {
+      out_row[j] *= col_scale[j];
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
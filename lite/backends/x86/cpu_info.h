@@ -70,6 +70,7 @@ typedef enum {
   avx512_core_vnni,
   avx512_mic,
   avx512_mic_4ops,
+  f16c,
 } cpu_isa_t;  // Instruction set architecture
 
 // May I use some instruction
@@ -256,6 +256,26 @@ class Blas {
                    int64_t strideA,
                    int64_t strideB) const;
 
+  /**
+   * Batched GEMM whose GEMM i multiplies A + a_offsets[i] by B + b_offsets[i]
+   * into C + i * M * N. The offsets can repeat, e.g. for the broadcast batch
+   * dims of matmul.
+   */
+  template <typename T>
+  void BatchedGEMM(CBLAS_TRANSPOSE transA,
+                   CBLAS_TRANSPOSE transB,
+                   int M,
+                   int N,
+                   int K,
+                   T alpha,
+                   const T* A,
+                   const int64_t* a_offsets,
+                   const T* B,
+                   const int64_t* b_offsets,
+                   T beta,
+                   T* C,
+                   int batchCount) const;
+
   template <typename T>
   void MatMul(const lite::TensorLite& mat_a,
               const MatDescriptor& dim_a,
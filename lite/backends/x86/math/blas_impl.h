@@ -16,6 +16,7 @@
 #include <limits>
 #include <vector>
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/math/packed_sgemm.h"
 
 namespace paddle {
 namespace lite {
@@ -240,9 +241,73 @@ struct CBlas<double> {
 
 template <>
 struct CBlas<float> {
-  template <typename... ARGS>
-  static void GEMM(ARGS... args) {
-    cblas_sgemm(args...);
+  // Without MKL the lite packed SGEMM is used instead of the cblas one.
+  static void GEMM(CBLAS_ORDER order,
+                   CBLAS_TRANSPOSE trans_a,
+                   CBLAS_TRANSPOSE trans_b,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float *A,
+                   int lda,
+                   const float *B,
+                   int ldb,
+                   float beta,
+                   float *C,
+                   int ldc) {
+    CHECK_EQ(order, CblasRowMajor);
+    sgemm(trans_a != CblasNoTrans,
+          trans_b != CblasNoTrans,
+          M,
+          N,
+          K,
+          alpha,
+          A,
+          lda,
+          B,
+          ldb,
+          beta,
+          C,
+          ldc);
+  }
+
+  // The GEMM i of the batch multiplies A + a_offsets[i] by B + b_offsets[i]
+  // into C + i * stride_c.
+  static void GEMM_OFFSET_BATCH(CBLAS_TRANSPOSE trans_a,
+                                CBLAS_TRANSPOSE trans_b,
+                                int M,
+                                int N,
+                                int K,
+                                float alpha,
+                                const float *A,
+                                int lda,
+                                const int64_t *a_offsets,
+                                const float *B,
+                                int ldb,
+                                const int64_t *b_offsets,
+                                float beta,
+                                float *C,
+                                int ldc,
+                                int64_t stride_c,
+                                int batch) {
+    sgemm_batched(trans_a != CblasNoTrans,
+                  trans_b != CblasNoTrans,
+                  M,
+                  N,
+                  K,
+                  alpha,
+                  A,
+                  lda,
+                  a_offsets,
+                  B,
+                  ldb,
+                  b_offsets,
+                  beta,
+                  C,
+                  ldc,
+                  stride_c,
+                  batch);
   }
 
   template <typename... ARGS>
@@ -268,6 +333,41 @@ struct CBlas<double> {
     cblas_dgemm(args...);
   }
 
+  static void GEMM_OFFSET_BATCH(CBLAS_TRANSPOSE trans_a,
+                                CBLAS_TRANSPOSE trans_b,
+                                int M,
+                                int N,
+                                int K,
+                                double alpha,
+                                const double *A,
+                                int lda,
+                                const int64_t *a_offsets,
+                                const double *B,
+                                int ldb,
+                                const int64_t *b_offsets,
+                                double beta,
+                                double *C,
+                                int ldc,
+                                int64_t stride_c,
+                                int batch) {
+    for (int i = 0; i < batch; ++i) {
+      cblas_dgemm(CblasRowMajor,
+                  trans_a,
+                  trans_b,
+                  M,
+                  N,
+                  K,
+                  alpha,
+                  A + a_offsets[i],
+                  lda,
+                  B + b_offsets[i],
+                  ldb,
+                  beta,
+                  C + i * stride_c,
+                  ldc);
+    }
+  }
+
   template <typename... ARGS>
   static void AXPY(ARGS... args) {
     cblas_daxpy(args...);
@@ -304,6 +404,10 @@ struct CBlas<lite::fluid::float16> {
   static void GEMM_BATCH(...) {
     PADDLE_THROW("float16 GEMM_BATCH not supported on CPU");
   }
+#else
+  static void GEMM_OFFSET_BATCH(...) {
+    PADDLE_THROW("float16 GEMM_OFFSET_BATCH not supported on CPU");
+  }
 #endif
 };
 
@@ -640,16 +744,52 @@ void Blas<lite::TargetType::kX86>::BatchedGEMM(CBLAS_TRANSPOSE transA,
                                                int batchCount,
                                                int64_t strideA,
                                                int64_t strideB) const {
-#ifdef PADDLE_WITH_MKLML
+  std::vector<int64_t> a_offsets(batchCount);
+  std::vector<int64_t> b_offsets(batchCount);
+  for (int k = 0; k < batchCount; ++k) {
+    a_offsets[k] = k * strideA;
+    b_offsets[k] = k * strideB;
+  }
+  this->template BatchedGEMM<T>(transA,
+                                transB,
+                                M,
+                                N,
+                                K,
+                                alpha,
+                                A,
+                                a_offsets.data(),
+                                B,
+                                b_offsets.data(),
+                                beta,
+                                C,
+                                batchCount);
+}
+
+template <>
+template <typename T>
+void Blas<lite::TargetType::kX86>::BatchedGEMM(CBLAS_TRANSPOSE transA,
+                                               CBLAS_TRANSPOSE transB,
+                                               int M,
+                                               int N,
+                                               int K,
+                                               T alpha,
+                                               const T *A,
+                                               const int64_t *a_offsets,
+                                               const T *B,
+                                               const int64_t *b_offsets,
+                                               T beta,
+                                               T *C,
+                                               int batchCount) const {
   int lda = (transA == CblasNoTrans) ? K : M;
   int ldb = (transB == CblasNoTrans) ? N : K;
   int ldc = N;
+#ifdef PADDLE_WITH_MKLML
   auto a_array = std::vector<const T *>(batchCount);
   auto b_array = std::vector<const T *>(batchCount);
   auto c_array = std::vector<T *>(batchCount);
   for (int k = 0; k < batchCount; ++k) {
-    a_array[k] = &A[k * strideA];
-    b_array[k] = &B[k * strideB];
+    a_array[k] = A + a_offsets[k];
+    b_array[k] = B + b_offsets[k];
     c_array[k] = &C[k * M * N];
   }
 
@@ -670,12 +810,23 @@ void Blas<lite::TargetType::kX86>::BatchedGEMM(CBLAS_TRANSPOSE transA,
                        1 /* group_count */,
                        &batchCount);
 #else
-  for (int k = 0; k < batchCount; ++k) {
-    auto *Ak = &A[k * strideA];
-    auto *Bk = &B[k * strideB];
-    auto *Ck = &C[k * M * N];
-    this->template GEMM<T>(transA, transB, M, N, K, alpha, Ak, Bk, beta, Ck);
-  }
+  CBlas<T>::GEMM_OFFSET_BATCH(transA,
+                              transB,
+                              M,
+                              N,
+                              K,
+                              alpha,
+                              A,
+                              lda,
+                              a_offsets,
+                              B,
+                              ldb,
+                              b_offsets,
+                              beta,
+                              C,
+                              ldc,
+                              static_cast<int64_t>(M) * N,
+                              batchCount);
 #endif
 }
 
@@ -0,0 +1,90 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/fp16.h"
+#include <immintrin.h>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/fluid/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#if defined(__GNUC__) && !defined(_WIN32)
+// The library is not built with -mf16c, so only these functions are compiled
+// for F16C and they are dispatched at runtime.
+#define LITE_WITH_F16C_DISPATCH
+#define F16C_TARGET __attribute__((target("avx,f16c")))
+
+F16C_TARGET static void fp16_to_fp32_f16c(const uint16_t* in,
+                                          float* out,
+                                          int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+  for (; i < n; ++i) {
+    out[i] = _cvtsh_ss(in[i]);
+  }
+}
+
+F16C_TARGET static void fp32_to_fp16_f16c(const float* in,
+                                          uint16_t* out,
+                                          int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), 0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+  }
+  for (; i < n; ++i) {
+    out[i] = _cvtss_sh(in[i], 0);
+  }
+}
+
+#undef F16C_TARGET
+#endif
+
+void fp16_to_fp32(const uint16_t* in, float* out, int64_t n) {
+#ifdef LITE_WITH_F16C_DISPATCH
+  static const bool has_f16c = MayIUse(f16c);
+  if (has_f16c) {
+    fp16_to_fp32_f16c(in, out, n);
+    return;
+  }
+#endif
+  auto* h = reinterpret_cast<const lite::fluid::float16*>(in);
+  for (int64_t i = 0; i < n; ++i) {
+    out[i] = static_cast<float>(h[i]);
+  }
+}
+
+void fp32_to_fp16(const float* in, uint16_t* out, int64_t n) {
+#ifdef LITE_WITH_F16C_DISPATCH
+  static const bool has_f16c = MayIUse(f16c);
+  if (has_f16c) {
+    fp32_to_fp16_f16c(in, out, n);
+    return;
+  }
+#endif
+  for (int64_t i = 0; i < n; ++i) {
+    out[i] = lite::fluid::float16(in[i]).x;
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,38 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The number of the FP16 weights converted to float at a time by the kernels,
+// the converted block should stay in the cache.
+constexpr int kFP16BlockSize = 16384;
+
+// Convert `n` IEEE half precision values (stored as the raw bits) to float.
+// The F16C instructions are used if the CPU supports them.
+void fp16_to_fp32(const uint16_t* in, float* out, int64_t n);
+
+// Convert `n` floats to IEEE half precision, rounding to the nearest even.
+void fp32_to_fp16(const float* in, uint16_t* out, int64_t n);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
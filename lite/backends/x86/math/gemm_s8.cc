@@ -0,0 +1,281 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_s8.h"
+#include <immintrin.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The rows and columns of y computed at a time by a thread.
+constexpr int kTileM = 4;
+constexpr int kTileN = 16;
+// Below this number of multiply-adds the threads are not worth starting.
+constexpr int64_t kMinWorkPerThread = 32768;
+
+// Compute acc[r][j] = xrows[r] * W[:, j] for r < kTileM and j < 8 * nv. The
+// rows of x are int8 pairs widened to int16 and packed in int32, the lower
+// half is the even element. w points to the strip of the tile, whose packed
+// rows have ldw int16.
+typedef void (*TileKernel)(const int32_t* const* xrows,
+                           const int16_t* w,
+                           int64_t ldw,
+                           int kp,
+                           int nv,
+                           int32_t* acc);
+
+void TileKernelRef(const int32_t* const* xrows,
+                   const int16_t* w,
+                   int64_t ldw,
+                   int kp,
+                   int nv,
+                   int32_t* acc) {
+  std::fill(acc, acc + kTileM * kTileN, 0);
+  for (int p = 0; p < kp; ++p) {
+    const int16_t* wp = w + p * ldw;
+    for (int r = 0; r < kTileM; ++r) {
+      int32_t xv = xrows[r][p];
+      int32_t x0 = static_cast<int16_t>(xv & 0xffff);
+      int32_t x1 = static_cast<int16_t>(xv >> 16);
+      for (int j = 0; j < 8 * nv; ++j) {
+        acc[r * kTileN + j] += x0 * wp[2 * j] + x1 * wp[2 * j + 1];
+      }
+    }
+  }
+}
+
+float AbsMaxRef(const float* x, int n) {
+  float res = 0.f;
+  for (int i = 0; i < n; ++i) {
+    res = std::max(res, std::fabs(x[i]));
+  }
+  return res;
+}
+
+#if defined(__GNUC__) && !defined(_WIN32)
+// The library is only built with -mavx at most, so the AVX2 kernels are
+// picked at runtime.
+#define LITE_WITH_GEMM_S8_DISPATCH
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+template <int NV>
+AVX2_TARGET void TileKernelAvx2N(const int32_t* const* xrows,
+                                 const int16_t* w,
+                                 int64_t ldw,
+                                 int kp,
+                                 int32_t* acc) {
+  __m256i sum[kTileM][NV];
+#pragma GCC unroll 4
+  for (int r = 0; r < kTileM; ++r) {
+#pragma GCC unroll 2
+    for (int v = 0; v < NV; ++v) {
+      sum[r][v] = _mm256_setzero_si256();
+    }
+  }
+  for (int p = 0; p < kp; ++p) {
+    const int16_t* wp = w + p * ldw;
+    __m256i wv[NV];
+#pragma GCC unroll 2
+    for (int v = 0; v < NV; ++v) {
+      wv[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(wp + 16 * v));
+    }
+#pragma GCC unroll 4
+    for (int r = 0; r < kTileM; ++r) {
+      // Both int16 of the pair are multiplied by the two rows of W, and
+      // summed into the int32 of the column.
+      __m256i xv = _mm256_set1_epi32(xrows[r][p]);
+#pragma GCC unroll 2
+      for (int v = 0; v < NV; ++v) {
+        sum[r][v] = _mm256_add_epi32(sum[r][v], _mm256_madd_epi16(xv, wv[v]));
+      }
+    }
+  }
+  for (int r = 0; r < kTileM; ++r) {
+    for (int v = 0; v < NV; ++v) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * kTileN + 8 * v),
+                          sum[r][v]);
+    }
+  }
+}
+
+AVX2_TARGET void TileKernelAvx2(const int32_t* const* xrows,
+                                const int16_t* w,
+                                int64_t ldw,
+                                int kp,
+                                int nv,
+                                int32_t* acc) {
+  if (nv == 2) {
+    TileKernelAvx2N<2>(xrows, w, ldw, kp, acc);
+  } else {
+    TileKernelAvx2N<1>(xrows, w, ldw, kp, acc);
+  }
+}
+
+AVX2_TARGET float AbsMaxAvx2(const float* x, int n) {
+  const __m256 sign = _mm256_set1_ps(-0.f);
+  __m256 vmax = _mm256_setzero_ps();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    vmax = _mm256_max_ps(vmax, _mm256_andnot_ps(sign, _mm256_loadu_ps(x + i)));
+  }
+  float lanes[8];
+  _mm256_storeu_ps(lanes, vmax);
+  float res = AbsMaxRef(x + i, n - i);
+  for (int j = 0; j < 8; ++j) {
+    res = std::max(res, lanes[j]);
+  }
+  return res;
+}
+
+#undef AVX2_TARGET
+#endif
+
+bool UseAvx2() {
+#ifdef LITE_WITH_GEMM_S8_DISPATCH
+  static const bool has_avx2 = MayIUse(avx2);
+  return has_avx2;
+#else
+  return false;
+#endif
+}
+
+// Quantize the row x of K elements into kp int16 pairs, returns the scale.
+float QuantizeRow(const float* x, int K, int kp, int32_t* q) {
+#ifdef LITE_WITH_GEMM_S8_DISPATCH
+  float abs_max = UseAvx2() ? AbsMaxAvx2(x, K) : AbsMaxRef(x, K);
+#else
+  float abs_max = AbsMaxRef(x, K);
+#endif
+  float scale = abs_max > 0.f ? abs_max / 127.f : 1.f;
+  float inv_scale = 1.f / scale;
+  for (int p = 0; p < kp; ++p) {
+    int k = 2 * p;
+    uint32_t lo = static_cast<uint16_t>(
+        static_cast<int16_t>(std::round(x[k] * inv_scale)));
+    uint32_t hi = k + 1 < K ? static_cast<uint16_t>(static_cast<int16_t>(
+                                  std::round(x[k + 1] * inv_scale)))
+                            : 0;
+    q[p] = static_cast<int32_t>(lo | (hi << 16));
+  }
+  return scale;
+}
+
+}  // namespace
+
+void pack_weight_s8(const int8_t* w, int K, int N, std::vector<int16_t>* out) {
+  const int kp = (K + 1) / 2;
+  const int np = (N + 7) / 8 * 8;
+  out->assign(static_cast<size_t>(kp) * np * 2, 0);
+  for (int j0 = 0; j0 < np; j0 += kTileN) {
+    // The strip of the columns j0 + [0, width) is stored contiguously.
+    const int width = std::min(kTileN, np - j0);
+    int16_t* strip = out->data() + static_cast<int64_t>(j0) * kp * 2;
+    for (int k = 0; k < K; ++k) {
+      int16_t* row = strip + (k / 2) * width * 2 + k % 2;
+      for (int j = 0; j < width && j0 + j < N; ++j) {
+        row[2 * j] = w[static_cast<int64_t>(k) * N + j0 + j];
+      }
+    }
+  }
+}
+
+void gemm_s8_dynamic(const float* x,
+                     int M,
+                     int K,
+                     int N,
+                     const int16_t* packed_w,
+                     const float* col_scale,
+                     const host::math::GemmEpilogue& epilogue,
+                     float* y) {
+  CHECK(epilogue.scale == nullptr);
+  if (M <= 0 || N <= 0) return;
+  const int kp = (K + 1) / 2;
+  const int np = (N + 7) / 8 * 8;
+  host::math::GemmEpilogue ep = epilogue;
+  ep.channel_is_row = false;
+  const bool parallel =
+      static_cast<int64_t>(M) * K * N >= 2 * kMinWorkPerThread;
+
+  std::vector<int32_t> qx(static_cast<size_t>(M) * kp);
+  std::vector<float> row_scale(M);
+#ifdef _OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+  for (int i = 0; i < M; ++i) {
+    row_scale[i] = QuantizeRow(x + static_cast<int64_t>(i) * K,
+                               K,
+                               kp,
+                               qx.data() + static_cast<int64_t>(i) * kp);
+  }
+
+#ifdef LITE_WITH_GEMM_S8_DISPATCH
+  const TileKernel kernel = UseAvx2() ? TileKernelAvx2 : TileKernelRef;
+#else
+  const TileKernel kernel = TileKernelRef;
+#endif
+  const int m_tiles = (M + kTileM - 1) / kTileM;
+  const int n_tiles = (np + kTileN - 1) / kTileN;
+  // The tiles of a column strip are taken one after another, so the strip of
+  // W stays in cache while the rows of x go through it.
+#ifdef _OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+  for (int t = 0; t < m_tiles * n_tiles; ++t) {
+    const int i0 = (t % m_tiles) * kTileM;
+    const int j0 = (t / m_tiles) * kTileN;
+    const int nb = std::min(kTileN, np - j0);
+    // The rows past M repeat the last one, and are not stored.
+    const int32_t* xrows[kTileM];
+    for (int r = 0; r < kTileM; ++r) {
+      xrows[r] = qx.data() + static_cast<int64_t>(std::min(i0 + r, M - 1)) * kp;
+    }
+    int32_t acc[kTileM * kTileN];
+    kernel(xrows,
+           packed_w + static_cast<int64_t>(j0) * kp * 2,
+           nb * 2,
+           kp,
+           nb / 8,
+           acc);
+
+    const int mb = std::min(kTileM, M - i0);
+    const int nc = std::min(nb, N - j0);
+    for (int r = 0; r < mb; ++r) {
+      float* y_row = y + static_cast<int64_t>(i0 + r) * N + j0;
+      const float s = row_scale[i0 + r];
+      for (int j = 0; j < nc; ++j) {
+        y_row[j] = acc[r * kTileN + j] * s * col_scale[j0 + j];
+      }
+    }
+    if (!ep.empty()) {
+      host::math::apply_gemm_epilogue(ep, i0, i0 + mb, j0, j0 + nc, y, N);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,56 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lite/backends/host/math/gemm_epilogue.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The int8 GEMM of the dynamic quantization of the fc, mul and matmul. The
+// weight W [K, N] is quantized to int8 with a scale per column, see
+// lite/backends/host/math/weight_only_quant.h, and each row of the activation
+// is quantized at runtime with its own scale abs_max / 127.
+
+// Pack W for gemm_s8_dynamic: the pairs of rows are interleaved and widened to
+// int16, so that a multiply-add of two int16 pairs covers two rows, and the
+// strips of 16 columns are stored one after another. K is padded to even and N
+// to a multiple of 8 with zeros.
+void pack_weight_s8(const int8_t* w, int K, int N, std::vector<int16_t>* out);
+
+// y = epilogue(x * W). x is [M, K] and y is [M, N] in float, W is packed by
+// pack_weight_s8. The int32 sums are dequantized with the scales of their row
+// and column, and the epilogue is applied to each tile after it. The channels
+// of the epilogue are the columns of y, and it must not carry a scale.
+//
+// The tiles of 4 rows and 16 columns are split over the OpenMP threads, and
+// computed with AVX2 if the CPU has it.
+void gemm_s8_dynamic(const float* x,
+                     int M,
+                     int K,
+                     int N,
+                     const int16_t* packed_w,
+                     const float* col_scale,
+                     const host::math::GemmEpilogue& epilogue,
+                     float* y);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,376 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemv.h"
+#include <immintrin.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/host/math/weight_only_quant.h"
+#include "lite/backends/x86/math/fp16.h"
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The number of the columns of W computed at a time by a thread.
+constexpr int kBlockN = 64;
+// Below this number of multiply-adds a thread is not worth starting.
+constexpr int64_t kMinWorkPerThread = 32768;
+
+// Compute acc[j] = x[k0:k1] * W[k0:k1, n0 + j] for j < nb <= kBlockN. W has
+// ldw elements per row, or ldw bytes for the packed int4 weight.
+typedef void (*BlockKernel)(const float* x,
+                            const void* w,
+                            int64_t ldw,
+                            int k0,
+                            int k1,
+                            int n0,
+                            int nb,
+                            float* acc);
+
+struct LoadFloat {
+  typedef float T;
+  static float At(const float* p) { return *p; }
+};
+
+struct LoadInt8 {
+  typedef int8_t T;
+  static float At(const int8_t* p) { return *p; }
+};
+
+template <typename Load>
+void BlockKernelRef(const float* x,
+                    const void* w,
+                    int64_t ldw,
+                    int k0,
+                    int k1,
+                    int n0,
+                    int nb,
+                    float* acc) {
+  auto* wt = static_cast<const typename Load::T*>(w);
+  std::fill(acc, acc + nb, 0.f);
+  for (int k = k0; k < k1; ++k) {
+    const auto* row = wt + k * ldw + n0;
+    float xk = x[k];
+    for (int j = 0; j < nb; ++j) {
+      acc[j] += xk * Load::At(row + j);
+    }
+  }
+}
+
+// The FP16 rows are converted by fp16_to_fp32, which uses F16C if it can.
+void BlockKernelFP16(const float* x,
+                     const void* w,
+                     int64_t ldw,
+                     int k0,
+                     int k1,
+                     int n0,
+                     int nb,
+                     float* acc) {
+  auto* wt = static_cast<const uint16_t*>(w);
+  float row[kBlockN];
+  std::fill(acc, acc + nb, 0.f);
+  for (int k = k0; k < k1; ++k) {
+    fp16_to_fp32(wt + k * ldw + n0, row, nb);
+    float xk = x[k];
+    for (int j = 0; j < nb; ++j) {
+      acc[j] += xk * row[j];
+    }
+  }
+}
+
+// Two int4 values are packed in a byte, the lower nibble first. n0 is even.
+void BlockKernelInt4(const float* x,
+                     const void* w,
+                     int64_t ldw,
+                     int k0,
+                     int k1,
+                     int n0,
+                     int nb,
+                     float* acc) {
+  auto* wt = static_cast<const int8_t*>(w);
+  std::fill(acc, acc + nb, 0.f);
+  for (int k = k0; k < k1; ++k) {
+    const int8_t* row = wt + k * ldw + n0 / 2;
+    float xk = x[k];
+    for (int j = 0; j < nb; ++j) {
+      int8_t q = row[j / 2];
+      acc[j] += xk * (j % 2 == 0 ? lite::host::math::int4_low(q)
+                                 : lite::host::math::int4_high(q));
+    }
+  }
+}
+
+#if defined(__GNUC__) && !defined(_WIN32)
+// The library is only built with -mavx at most, so only the block kernels are
+// compiled for AVX2/FMA and they are picked at runtime.
+#define LITE_WITH_GEMV_DISPATCH
+#define AVX2_TARGET __attribute__((target("avx2,fma,f16c")))
+
+struct LoadFloatAvx2 {
+  typedef float T;
+  AVX2_TARGET static __m256 Load8(const float* p) { return _mm256_loadu_ps(p); }
+  AVX2_TARGET static float At(const float* p) { return *p; }
+};
+
+struct LoadFP16Avx2 {
+  typedef uint16_t T;
+  AVX2_TARGET static __m256 Load8(const uint16_t* p) {
+    return _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+  }
+  AVX2_TARGET static float At(const uint16_t* p) { return _cvtsh_ss(*p); }
+};
+
+struct LoadInt8Avx2 {
+  typedef int8_t T;
+  AVX2_TARGET static __m256 Load8(const int8_t* p) {
+    __m128i q = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(q));
+  }
+  AVX2_TARGET static float At(const int8_t* p) { return *p; }
+};
+
+template <typename Load>
+AVX2_TARGET void BlockKernelAvx2(const float* x,
+                                 const void* w,
+                                 int64_t ldw,
+                                 int k0,
+                                 int k1,
+                                 int n0,
+                                 int nb,
+                                 float* acc) {
+  auto* wt = static_cast<const typename Load::T*>(w) + n0;
+  if (nb == kBlockN) {
+    // The full block keeps its 64 sums in 8 registers.
+    __m256 sum[8];
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+      sum[i] = _mm256_setzero_ps();
+    }
+    for (int k = k0; k < k1; ++k) {
+      const auto* row = wt + k * ldw;
+      __m256 xk = _mm256_set1_ps(x[k]);
+#pragma GCC unroll 8
+      for (int i = 0; i < 8; ++i) {
+        sum[i] = _mm256_fmadd_ps(xk, Load::Load8(row + 8 * i), sum[i]);
+      }
+    }
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+      _mm256_storeu_ps(acc + 8 * i, sum[i]);
+    }
+    return;
+  }
+  int j = 0;
+  for (; j + 8 <= nb; j += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    for (int k = k0; k < k1; ++k) {
+      sum = _mm256_fmadd_ps(
+          _mm256_set1_ps(x[k]), Load::Load8(wt + k * ldw + j), sum);
+    }
+    _mm256_storeu_ps(acc + j, sum);
+  }
+  for (; j < nb; ++j) {
+    float sum = 0.f;
+    for (int k = k0; k < k1; ++k) {
+      sum += x[k] * Load::At(wt + k * ldw + j);
+    }
+    acc[j] = sum;
+  }
+}
+
+#undef AVX2_TARGET
+#endif
+
+enum class WeightType { kFloat, kFP16, kInt8, kInt4 };
+
+BlockKernel PickKernel(WeightType type) {
+#ifdef LITE_WITH_GEMV_DISPATCH
+  static const bool has_avx2 = MayIUse(avx2) && MayIUse(f16c);
+  if (has_avx2) {
+    switch (type) {
+      case WeightType::kFloat:
+        return BlockKernelAvx2<LoadFloatAvx2>;
+      case WeightType::kFP16:
+        return BlockKernelAvx2<LoadFP16Avx2>;
+      case WeightType::kInt8:
+        return BlockKernelAvx2<LoadInt8Avx2>;
+      default:
+        break;
+    }
+  }
+#endif
+  switch (type) {
+    case WeightType::kFloat:
+      return BlockKernelRef<LoadFloat>;
+    case WeightType::kFP16:
+      return BlockKernelFP16;
+    case WeightType::kInt8:
+      return BlockKernelRef<LoadInt8>;
+    default:
+      return BlockKernelInt4;
+  }
+}
+
+// y[n0 + j] = act(acc[j] * scale[n0 + j] + bias[n0 + j]).
+void Epilogue(const float* acc,
+              int n0,
+              int nb,
+              const float* scale,
+              const float* bias,
+              lite_api::ActivationType act,
+              float* y) {
+  for (int j = 0; j < nb; ++j) {
+    float v = acc[j];
+    if (scale) v *= scale[n0 + j];
+    if (bias) v += bias[n0 + j];
+    switch (act) {
+      case lite_api::ActivationType::kRelu:
+        v = std::max(v, 0.f);
+        break;
+      case lite_api::ActivationType::kRelu6:
+        v = std::min(std::max(v, 0.f), 6.f);
+        break;
+      default:
+        break;
+    }
+    y[n0 + j] = v;
+  }
+}
+
+void Gemv(WeightType type,
+          const float* x,
+          const void* w,
+          int64_t ldw,
+          const float* scale,
+          int K,
+          int N,
+          const float* bias,
+          lite_api::ActivationType act,
+          float* y) {
+  CHECK(act == lite_api::ActivationType::kIndentity ||
+        act == lite_api::ActivationType::kRelu ||
+        act == lite_api::ActivationType::kRelu6)
+      << "unsupported activation " << static_cast<int>(act);
+  if (N <= 0) return;
+  const BlockKernel kernel = PickKernel(type);
+  const int n_blocks = (N + kBlockN - 1) / kBlockN;
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#endif
+  int64_t work = static_cast<int64_t>(K) * N;
+  if (work / kMinWorkPerThread < threads) {
+    threads = static_cast<int>(std::max<int64_t>(1, work / kMinWorkPerThread));
+  }
+
+  if (threads == 1 || n_blocks >= threads) {
+    // Each thread computes whole blocks of y.
+#ifdef _OPENMP
+#pragma omp parallel for if (threads > 1) num_threads(threads)
+#endif
+    for (int b = 0; b < n_blocks; ++b) {
+      float acc[kBlockN];
+      int n0 = b * kBlockN;
+      int nb = std::min(kBlockN, N - n0);
+      kernel(x, w, ldw, 0, K, n0, nb, acc);
+      Epilogue(acc, n0, nb, scale, bias, act, y);
+    }
+    return;
+  }
+
+  // y is too short for the threads, each thread reads a slice of the rows of
+  // W and the partial sums are reduced.
+  const int k_step = (K + threads - 1) / threads;
+  std::vector<float> partial(static_cast<size_t>(threads) * N);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(threads)
+#endif
+  for (int t = 0; t < threads; ++t) {
+    int k0 = std::min(K, t * k_step);
+    int k1 = std::min(K, k0 + k_step);
+    for (int b = 0; b < n_blocks; ++b) {
+      int n0 = b * kBlockN;
+      int nb = std::min(kBlockN, N - n0);
+      kernel(x, w, ldw, k0, k1, n0, nb, partial.data() + t * N + n0);
+    }
+  }
+  for (int b = 0; b < n_blocks; ++b) {
+    float acc[kBlockN];
+    int n0 = b * kBlockN;
+    int nb = std::min(kBlockN, N - n0);
+    std::copy(partial.data() + n0, partial.data() + n0 + nb, acc);
+    for (int t = 1; t < threads; ++t) {
+      const float* p = partial.data() + t * N + n0;
+      for (int j = 0; j < nb; ++j) {
+        acc[j] += p[j];
+      }
+    }
+    Epilogue(acc, n0, nb, scale, bias, act, y);
+  }
+}
+
+}  // namespace
+
+void sgemv(const float* x,
+           const float* w,
+           int K,
+           int N,
+           const float* bias,
+           lite_api::ActivationType act,
+           float* y) {
+  Gemv(WeightType::kFloat, x, w, N, nullptr, K, N, bias, act, y);
+}
+
+void sgemv_fp16(const float* x,
+                const uint16_t* w,
+                int K,
+                int N,
+                const float* bias,
+                lite_api::ActivationType act,
+                float* y) {
+  Gemv(WeightType::kFP16, x, w, N, nullptr, K, N, bias, act, y);
+}
+
+void sgemv_weight_only_quant(const float* x,
+                             const int8_t* w,
+                             int bits,
+                             const float* col_scale,
+                             int K,
+                             int N,
+                             const float* bias,
+                             lite_api::ActivationType act,
+                             float* y) {
+  CHECK(bits == 8 || bits == 4) << "unsupported bits " << bits;
+  if (bits == 4) {
+    CHECK_EQ(N % 2, 0) << "the int4 weight has an odd number of columns";
+    Gemv(WeightType::kInt4, x, w, N / 2, col_scale, K, N, bias, act, y);
+  } else {
+    Gemv(WeightType::kInt8, x, w, N, col_scale, K, N, bias, act, y);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
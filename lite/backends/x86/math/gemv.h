@@ -0,0 +1,64 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The GEMV of the batch-1 fc and mul, y = act(x * W + bias). x has K elements,
+// the weight W is [K, N] row major and y has N elements. bias can be nullptr,
+// act is kIndentity, kRelu or kRelu6.
+//
+// The blocks of the columns of W are split over the OpenMP threads. If N is
+// too small to keep all the threads busy, the rows are split instead and the
+// partial sums are reduced. The inner loops use AVX2/FMA if the CPU has them.
+void sgemv(const float* x,
+           const float* w,
+           int K,
+           int N,
+           const float* bias,
+           lite_api::ActivationType act,
+           float* y);
+
+// The same as sgemv, W is stored in FP16 and converted in the inner loop.
+void sgemv_fp16(const float* x,
+                const uint16_t* w,
+                int K,
+                int N,
+                const float* bias,
+                lite_api::ActivationType act,
+                float* y);
+
+// The same as sgemv, W is weight-only quantized in `bits`, 8 or 4, with a
+// scale per column, see lite/backends/host/math/weight_only_quant.h.
+void sgemv_weight_only_quant(const float* x,
+                             const int8_t* w,
+                             int bits,
+                             const float* col_scale,
+                             int K,
+                             int N,
+                             const float* bias,
+                             lite_api::ActivationType act,
+                             float* y);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
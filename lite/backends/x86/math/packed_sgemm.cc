@@ -0,0 +1,542 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/packed_sgemm.h"
+#include <immintrin.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/core/device_info.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Multiply the packed mr x kc panel `a` by the packed kc x nr panel `b` into
+// the mr x nr tile `c`, c = a * b + beta * c, c is not read if beta is 0.
+typedef void (*MicroKernel)(
+    int kc, const float* a, const float* b, float* c, int ldc, float beta);
+
+struct KernelDesc {
+  int mr;
+  int nr;
+  MicroKernel kernel;
+};
+
+constexpr int kMaxMR = 14;
+constexpr int kMaxNR = 32;
+
+// Below this M * N * K a GEMM is too small to be split over the threads.
+constexpr int64_t kSmallGemm = 128 * 128 * 128;
+
+void kernel_4x8(
+    int kc, const float* a, const float* b, float* c, int ldc, float beta) {
+  float acc[4][8] = {{0.f}};
+  for (int k = 0; k < kc; ++k) {
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 8; ++j) {
+        acc[i][j] += a[i] * b[j];
+      }
+    }
+    a += 4;
+    b += 8;
+  }
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      c[i * ldc + j] =
+          beta == 0.f ? acc[i][j] : acc[i][j] + beta * c[i * ldc + j];
+    }
+  }
+}
+
+#if defined(__GNUC__) && !defined(_WIN32)
+// The library is only built with -mavx at most, so only the micro-kernels are
+// compiled for AVX2/FMA and AVX-512 and they are picked at runtime.
+#define LITE_WITH_SGEMM_DISPATCH
+#define AVX_TARGET __attribute__((target("avx")))
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+AVX_TARGET void kernel_6x16_avx(
+    int kc, const float* a, const float* b, float* c, int ldc, float beta) {
+  __m256 acc[6][2];
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (int k = 0; k < kc; ++k) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_mul_ps(ai, b0));
+      acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_mul_ps(ai, b1));
+    }
+    a += 6;
+    b += 16;
+  }
+  __m256 vbeta = _mm256_set1_ps(beta);
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    float* ci = c + i * ldc;
+    if (beta != 0.f) {
+      acc[i][0] =
+          _mm256_add_ps(acc[i][0], _mm256_mul_ps(vbeta, _mm256_loadu_ps(ci)));
+      acc[i][1] = _mm256_add_ps(acc[i][1],
+                                _mm256_mul_ps(vbeta, _mm256_loadu_ps(ci + 8)));
+    }
+    _mm256_storeu_ps(ci, acc[i][0]);
+    _mm256_storeu_ps(ci + 8, acc[i][1]);
+  }
+}
+
+AVX2_TARGET void kernel_6x16_fma(
+    int kc, const float* a, const float* b, float* c, int ldc, float beta) {
+  __m256 acc[6][2];
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    acc[i][0] = _mm256_setzero_ps();
+    acc[i][1] = _mm256_setzero_ps();
+  }
+  for (int k = 0; k < kc; ++k) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+#pragma GCC unroll 6
+    for (int i = 0; i < 6; ++i) {
+      __m256 ai = _mm256_broadcast_ss(a + i);
+      acc[i][0] = _mm256_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += 6;
+    b += 16;
+  }
+  __m256 vbeta = _mm256_set1_ps(beta);
+#pragma GCC unroll 6
+  for (int i = 0; i < 6; ++i) {
+    float* ci = c + i * ldc;
+    if (beta != 0.f) {
+      acc[i][0] = _mm256_fmadd_ps(vbeta, _mm256_loadu_ps(ci), acc[i][0]);
+      acc[i][1] = _mm256_fmadd_ps(vbeta, _mm256_loadu_ps(ci + 8), acc[i][1]);
+    }
+    _mm256_storeu_ps(ci, acc[i][0]);
+    _mm256_storeu_ps(ci + 8, acc[i][1]);
+  }
+}
+
+AVX512_TARGET void kernel_14x32_avx512(
+    int kc, const float* a, const float* b, float* c, int ldc, float beta) {
+  __m512 acc[14][2];
+#pragma GCC unroll 14
+  for (int i = 0; i < 14; ++i) {
+    acc[i][0] = _mm512_setzero_ps();
+    acc[i][1] = _mm512_setzero_ps();
+  }
+  for (int k = 0; k < kc; ++k) {
+    __m512 b0 = _mm512_loadu_ps(b);
+    __m512 b1 = _mm512_loadu_ps(b + 16);
+#pragma GCC unroll 14
+    for (int i = 0; i < 14; ++i) {
+      __m512 ai = _mm512_set1_ps(a[i]);
+      acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+    }
+    a += 14;
+    b += 32;
+  }
+  __m512 vbeta = _mm512_set1_ps(beta);
+#pragma GCC unroll 14
+  for (int i = 0; i < 14; ++i) {
+    float* ci = c + i * ldc;
+    if (beta != 0.f) {
+      acc[i][0] = _mm512_fmadd_ps(vbeta, _mm512_loadu_ps(ci), acc[i][0]);
+      acc[i][1] = _mm512_fmadd_ps(vbeta, _mm512_loadu_ps(ci + 16), acc[i][1]);
+    }
+    _mm512_storeu_ps(ci, acc[i][0]);
+    _mm512_storeu_ps(ci + 16, acc[i][1]);
+  }
+}
+
+#undef AVX_TARGET
+#undef AVX2_TARGET
+#undef AVX512_TARGET
+#endif  // __GNUC__ && !_WIN32
+
+KernelDesc PickKernel() {
+#ifdef LITE_WITH_SGEMM_DISPATCH
+  if (MayIUse(avx512f)) return {14, 32, kernel_14x32_avx512};
+  if (MayIUse(avx2)) return {6, 16, kernel_6x16_fma};
+  if (MayIUse(avx)) return {6, 16, kernel_6x16_avx};
+#endif
+  return {4, 8, kernel_4x8};
+}
+
+struct Blocking {
+  int mc;
+  int nc;
+  int kc;
+};
+
+int RoundDown(int x, int multiple, int min_value, int max_value) {
+  x = x / multiple * multiple;
+  return std::max(min_value, std::min(max_value, x));
+}
+
+// The mr x kc panel of A and the kc x nr panel of B stay in L1, the mc x kc
+// block of A in L2 and the kc x nc block of B in L3.
+Blocking GetBlocking(const KernelDesc& desc) {
+  DeviceInfo::Init();
+  const auto& device = DeviceInfo::Global();
+  int l1 = device.l1_cache_size();
+  int l2 = device.l2_cache_size();
+  int l3 = device.l3_cache_size() > 0 ? device.l3_cache_size() : l2;
+  Blocking blocking;
+  int panel_bytes = (desc.mr + desc.nr) * sizeof(float);
+  blocking.kc = RoundDown(l1 * 3 / 4 / panel_bytes, 8, 64, 512);
+  int row_bytes = blocking.kc * sizeof(float);
+  blocking.mc = RoundDown(l2 / 2 / row_bytes, desc.mr, desc.mr, 1024);
+  blocking.nc = RoundDown(l3 / 2 / row_bytes, desc.nr, desc.nr, 4096);
+  return blocking;
+}
+
+// Pack the m x k block of alpha * op(A) at (i0, p0) in panels of mr rows,
+// each stored k-major, the missing rows of the last panel are zeros.
+void PackA(const float* A,
+           int lda,
+           bool trans,
+           float alpha,
+           int i0,
+           int p0,
+           int m,
+           int k,
+           int mr,
+           float* dst) {
+  for (int i = 0; i < m; i += mr) {
+    int rows = std::min(mr, m - i);
+    if (trans) {
+      for (int p = 0; p < k; ++p) {
+        const float* src = A + (p0 + p) * lda + i0 + i;
+        for (int r = 0; r < rows; ++r) {
+          dst[p * mr + r] = alpha * src[r];
+        }
+        for (int r = rows; r < mr; ++r) {
+          dst[p * mr + r] = 0.f;
+        }
+      }
+    } else {
+      for (int r = 0; r < mr; ++r) {
+        if (r < rows) {
+          const float* src = A + (i0 + i + r) * lda + p0;
+          for (int p = 0; p < k; ++p) {
+            dst[p * mr + r] = alpha * src[p];
+          }
+        } else {
+          for (int p = 0; p < k; ++p) {
+            dst[p * mr + r] = 0.f;
+          }
+        }
+      }
+    }
+    dst += mr * k;
+  }
+}
+
+// Pack the k x n panel of op(B) at (p0, j0), n <= nr, stored k-major with nr
+// columns, the missing columns are zeros.
+void PackBPanel(const float* B,
+                int ldb,
+                bool trans,
+                int p0,
+                int j0,
+                int k,
+                int n,
+                int nr,
+                float* dst) {
+  if (trans) {
+    for (int j = 0; j < nr; ++j) {
+      if (j < n) {
+        const float* src = B + (j0 + j) * ldb + p0;
+        for (int p = 0; p < k; ++p) {
+          dst[p * nr + j] = src[p];
+        }
+      } else {
+        for (int p = 0; p < k; ++p) {
+          dst[p * nr + j] = 0.f;
+        }
+      }
+    }
+  } else {
+    for (int p = 0; p < k; ++p) {
+      const float* src = B + (p0 + p) * ldb + j0;
+      float* out = dst + p * nr;
+      std::copy(src, src + n, out);
+      std::fill(out + n, out + nr, 0.f);
+    }
+  }
+}
+
+// Compute the m x n tile of C, m <= mr and n <= nr.
+void RunTile(const KernelDesc& desc,
+             int kc,
+             const float* a,
+             const float* b,
+             float* c,
+             int ldc,
+             float beta,
+             int m,
+             int n) {
+  if (m == desc.mr && n == desc.nr) {
+    desc.kernel(kc, a, b, c, ldc, beta);
+    return;
+  }
+  alignas(64) float tile[kMaxMR * kMaxNR];
+  desc.kernel(kc, a, b, tile, desc.nr, 0.f);
+  for (int i = 0; i < m; ++i) {
+    const float* src = tile + i * desc.nr;
+    float* dst = c + i * ldc;
+    for (int j = 0; j < n; ++j) {
+      dst[j] = beta == 0.f ? src[j] : src[j] + beta * dst[j];
+    }
+  }
+}
+
+// Multiply the packed m x kc block of A by the packed kc x n block of B, the
+// panels of B in [p_begin, p_end) only.
+void MultiplyBlock(const KernelDesc& desc,
+                   const float* a_pack,
+                   const float* b_pack,
+                   float* C,
+                   int ldc,
+                   float beta,
+                   int m,
+                   int n,
+                   int kc,
+                   int p_begin,
+                   int p_end) {
+  for (int p = p_begin; p < p_end; ++p) {
+    int j = p * desc.nr;
+    const float* b = b_pack + p * desc.nr * kc;
+    for (int i = 0; i < m; i += desc.mr) {
+      RunTile(desc,
+              kc,
+              a_pack + i * kc,
+              b,
+              C + i * ldc + j,
+              ldc,
+              beta,
+              std::min(desc.mr, m - i),
+              std::min(desc.nr, n - j));
+    }
+  }
+}
+
+void ScaleC(int M, int N, float beta, float* C, int ldc) {
+  for (int i = 0; i < M; ++i) {
+    float* c = C + i * ldc;
+    for (int j = 0; j < N; ++j) {
+      c[j] = beta == 0.f ? 0.f : beta * c[j];
+    }
+  }
+}
+
+}  // namespace
+
+void sgemm(bool trans_a,
+           bool trans_b,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc) {
+  if (M <= 0 || N <= 0) return;
+  if (K <= 0 || alpha == 0.f) {
+    ScaleC(M, N, beta, C, ldc);
+    return;
+  }
+  static const KernelDesc desc = PickKernel();
+  const Blocking blocking = GetBlocking(desc);
+  const int mr = desc.mr;
+  const int nr = desc.nr;
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#endif
+
+  // The buffers are kept by the threads to be reused by the next calls.
+  static thread_local std::vector<float> b_pack;
+  static thread_local std::vector<float> a_shared;
+  int nc_max = (std::min(blocking.nc, N) + nr - 1) / nr * nr;
+  int mc_max = (std::min(blocking.mc, M) + mr - 1) / mr * mr;
+  b_pack.resize(static_cast<size_t>(nc_max) * blocking.kc);
+
+  for (int jc = 0; jc < N; jc += blocking.nc) {
+    int n = std::min(blocking.nc, N - jc);
+    int n_panels = (n + nr - 1) / nr;
+    for (int pc = 0; pc < K; pc += blocking.kc) {
+      int k = std::min(blocking.kc, K - pc);
+      // The first block of K applies beta, the next ones accumulate.
+      float beta_k = pc == 0 ? beta : 1.f;
+      float* b_data = b_pack.data();
+#ifdef _OPENMP
+#pragma omp parallel for if (threads > 1)
+#endif
+      for (int p = 0; p < n_panels; ++p) {
+        PackBPanel(B,
+                   ldb,
+                   trans_b,
+                   pc,
+                   jc + p * nr,
+                   k,
+                   std::min(nr, n - p * nr),
+                   nr,
+                   b_data + p * nr * k);
+      }
+
+      int m_blocks = (M + blocking.mc - 1) / blocking.mc;
+      if (threads == 1 || m_blocks >= threads) {
+        // Split the blocks of M, each thread packs its own block of A.
+#ifdef _OPENMP
+#pragma omp parallel for if (threads > 1) schedule(dynamic)
+#endif
+        for (int ib = 0; ib < m_blocks; ++ib) {
+          static thread_local std::vector<float> a_pack;
+          a_pack.resize(static_cast<size_t>(mc_max) * blocking.kc);
+          int ic = ib * blocking.mc;
+          int m = std::min(blocking.mc, M - ic);
+          PackA(A, lda, trans_a, alpha, ic, pc, m, k, mr, a_pack.data());
+          MultiplyBlock(desc,
+                        a_pack.data(),
+                        b_data,
+                        C + ic * ldc + jc,
+                        ldc,
+                        beta_k,
+                        m,
+                        n,
+                        k,
+                        0,
+                        n_panels);
+        }
+      } else {
+        // M is too small, split the panels of B.
+        a_shared.resize(static_cast<size_t>(mc_max) * blocking.kc);
+        float* a_data = a_shared.data();
+        for (int ic = 0; ic < M; ic += blocking.mc) {
+          int m = std::min(blocking.mc, M - ic);
+          PackA(A, lda, trans_a, alpha, ic, pc, m, k, mr, a_data);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+          for (int p = 0; p < n_panels; ++p) {
+            MultiplyBlock(desc,
+                          a_data,
+                          b_data,
+                          C + ic * ldc + jc,
+                          ldc,
+                          beta_k,
+                          m,
+                          n,
+                          k,
+                          p,
+                          p + 1);
+          }
+        }
+      }
+    }
+  }
+}
+
+void sgemm_batched(bool trans_a,
+                   bool trans_b,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float* A,
+                   int lda,
+                   const int64_t* a_offsets,
+                   const float* B,
+                   int ldb,
+                   const int64_t* b_offsets,
+                   float beta,
+                   float* C,
+                   int ldc,
+                   int64_t stride_c,
+                   int batch) {
+  if (batch <= 0) return;
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+#endif
+  // Splitting the batch needs no synchronization inside the GEMMs, it is
+  // preferred unless the GEMMs are big and the batch leaves threads idle.
+  int64_t size = static_cast<int64_t>(M) * N * K;
+  bool split_batch = threads > 1 && batch > 1 &&
+                     (size < kSmallGemm || batch % threads == 0 ||
+                      batch >= 4 * threads);
+  if (split_batch) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < batch; ++i) {
+      // sgemm runs on the calling thread inside the parallel region.
+      sgemm(trans_a,
+            trans_b,
+            M,
+            N,
+            K,
+            alpha,
+            A + a_offsets[i],
+            lda,
+            B + b_offsets[i],
+            ldb,
+            beta,
+            C + i * stride_c,
+            ldc);
+    }
+  } else {
+    for (int i = 0; i < batch; ++i) {
+      sgemm(trans_a,
+            trans_b,
+            M,
+            N,
+            K,
+            alpha,
+            A + a_offsets[i],
+            lda,
+            B + b_offsets[i],
+            ldb,
+            beta,
+            C + i * stride_c,
+            ldc);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
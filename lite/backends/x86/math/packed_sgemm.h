@@ -0,0 +1,76 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// C = alpha * op(A) * op(B) + beta * C, all the matrices are row major, as in
+// cblas_sgemm. op(A) is M x K and op(B) is K x N.
+//
+// The blocks of op(A) and op(B) are packed in panels sized from the L1/L2/L3
+// caches detected by DeviceInfo, and multiplied by a 14x32 AVX-512, a 6x16
+// AVX2/FMA or a 6x16 AVX micro-kernel picked at runtime. The blocks of M, or
+// of N if M is too small, are split over the OpenMP threads. C is not read
+// if beta is 0.
+void sgemm(bool trans_a,
+           bool trans_b,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc);
+
+// The batched sgemm, the GEMM i of the batch computes
+// C + i * stride_c = alpha * op(A + a_offsets[i]) * op(B + b_offsets[i]) +
+//                    beta * (C + i * stride_c).
+// A broadcast operand repeats its offsets, and a transposed operand is read in
+// place through trans_a/trans_b and lda/ldb.
+//
+// The small GEMMs, as the ones of the attention, are run whole by the OpenMP
+// threads, each thread taking the next GEMM of the batch. The big ones are run
+// one after another, all the threads working on each of them.
+void sgemm_batched(bool trans_a,
+                   bool trans_b,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float* A,
+                   int lda,
+                   const int64_t* a_offsets,
+                   const float* B,
+                   int ldb,
+                   const int64_t* b_offsets,
+                   float beta,
+                   float* C,
+                   int ldc,
+                   int64_t stride_c,
+                   int batch);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
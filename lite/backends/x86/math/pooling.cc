@@ -13,7 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/pooling.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
 #include <algorithm>
+#include <cfloat>
 #include <vector>
 
 namespace paddle {
@@ -100,6 +104,238 @@ class Pool2dFunctor<lite::TargetType::kX86, PoolProcess, T> {
   }
 };
 
+// The reduction of the fast pooling paths, on the scalars and the AVX vectors.
+template <bool IsMax>
+struct PoolReducer {
+  static float initial() { return -FLT_MAX; }
+  static float reduce(float a, float b) { return a > b ? a : b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+#endif
+};
+
+template <>
+struct PoolReducer<false> {
+  static float initial() { return 0.f; }
+  static float reduce(float a, float b) { return a + b; }
+#ifdef __AVX__
+  static __m256 reduce(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+#endif
+};
+
+#ifdef __AVX__
+// The elements 0, 2, ..., 14 of the 16 floats from `x`.
+static inline __m256 LoadEven8(const float* x) {
+  __m256 a = _mm256_loadu_ps(x);
+  __m256 b = _mm256_loadu_ps(x + 8);
+  __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+  __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+  return _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif
+
+// Reduce `rows` rows of `width` floats into `out`.
+template <bool IsMax>
+static void ReduceRows(const float* in, int rows, int width, float* out) {
+  using R = PoolReducer<IsMax>;
+  if (rows <= 0) {
+    std::fill(out, out + width, R::initial());
+    return;
+  }
+  int w = 0;
+#ifdef __AVX__
+  for (; w + 8 <= width; w += 8) {
+    __m256 acc = _mm256_loadu_ps(in + w);
+    for (int r = 1; r < rows; ++r) {
+      acc = R::reduce(acc, _mm256_loadu_ps(in + r * width + w));
+    }
+    _mm256_storeu_ps(out + w, acc);
+  }
+#endif
+  for (; w < width; ++w) {
+    float acc = in[w];
+    for (int r = 1; r < rows; ++r) {
+      acc = R::reduce(acc, in[r * width + w]);
+    }
+    out[w] = acc;
+  }
+}
+
+// Pool one plane. `buffer` holds the rows reduced along the height, it has
+// 16 more floats than a row so the vector loads may run past the row.
+template <bool IsMax>
+static void Pool2dPlane(const float* in,
+                        int in_h,
+                        int in_w,
+                        int out_h,
+                        int out_w,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        float* buffer,
+                        float* out) {
+  using R = PoolReducer<IsMax>;
+  const int ksize_h = ksize[0];
+  const int ksize_w = ksize[1];
+  const int stride_h = strides[0];
+  const int stride_w = strides[1];
+  const int pad_h = paddings[0];
+  const int pad_w = paddings[1];
+  // The outputs in [begin, end) have their windows inside the row.
+  const int begin = std::min((pad_w + stride_w - 1) / stride_w, out_w);
+  int end = begin;
+  if (in_w + pad_w >= ksize_w) {
+    end = std::min((in_w + pad_w - ksize_w) / stride_w + 1, out_w);
+    end = std::max(end, begin);
+  }
+  std::fill(buffer + in_w, buffer + in_w + 16, R::initial());
+
+  for (int oh = 0; oh < out_h; ++oh) {
+    int hstart = oh * stride_h - pad_h;
+    int hend = std::min(hstart + ksize_h, in_h);
+    hstart = std::max(hstart, 0);
+    const int rows = hend - hstart;
+    ReduceRows<IsMax>(in + hstart * in_w, rows, in_w, buffer);
+    float* out_row = out + oh * out_w;
+
+    auto scalar = [&](int ow) {
+      int wstart = ow * stride_w - pad_w;
+      int wend = std::min(wstart + ksize_w, in_w);
+      wstart = std::max(wstart, 0);
+      float acc = R::initial();
+      for (int w = wstart; w < wend; ++w) {
+        acc = R::reduce(acc, buffer[w]);
+      }
+      if (!IsMax) {
+        int pool_size =
+            exclusive ? rows * (wend - wstart) : ksize_h * ksize_w;
+        acc /= static_cast<float>(pool_size);
+      }
+      out_row[ow] = acc;
+    };
+
+    int ow = 0;
+    for (; ow < begin; ++ow) {
+      scalar(ow);
+    }
+#ifdef __AVX__
+    const __m256 scale = _mm256_set1_ps(
+        1.f / static_cast<float>(exclusive ? rows * ksize_w
+                                           : ksize_h * ksize_w));
+    for (; ow + 8 <= end; ow += 8) {
+      const float* x = buffer + ow * stride_w - pad_w;
+      __m256 acc;
+      if (stride_w == 1) {
+        acc = _mm256_loadu_ps(x);
+        for (int k = 1; k < ksize_w; ++k) {
+          acc = R::reduce(acc, _mm256_loadu_ps(x + k));
+        }
+      } else {
+        acc = LoadEven8(x);
+        for (int k = 1; k < ksize_w; ++k) {
+          acc = R::reduce(acc, LoadEven8(x + k));
+        }
+      }
+      if (!IsMax) {
+        acc = _mm256_mul_ps(acc, scale);
+      }
+      _mm256_storeu_ps(out_row + ow, acc);
+    }
+#endif
+    for (; ow < out_w; ++ow) {
+      scalar(ow);
+    }
+  }
+}
+
+bool Pool2dFast(const lite::Tensor* input,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                bool is_max,
+                bool exclusive,
+                bool adaptive,
+                lite::Tensor* output) {
+  if (adaptive || ksize.size() != 2 || strides.size() != 2 ||
+      paddings.size() != 2 || strides[0] < 1 || strides[1] < 1 ||
+      strides[1] > 2) {
+    return false;
+  }
+  const int planes = input->dims()[0] * input->dims()[1];
+  const int in_h = input->dims()[2];
+  const int in_w = input->dims()[3];
+  const int out_h = output->dims()[2];
+  const int out_w = output->dims()[3];
+  const float* in_data = input->data<float>();
+  float* out_data = output->mutable_data<float>(lite::TargetType::kX86);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < planes; ++i) {
+    std::vector<float> buffer(in_w + 16);
+    const float* in = in_data + static_cast<int64_t>(i) * in_h * in_w;
+    float* out = out_data + static_cast<int64_t>(i) * out_h * out_w;
+    auto pool_plane = is_max ? Pool2dPlane<true> : Pool2dPlane<false>;
+    pool_plane(in,
+               in_h,
+               in_w,
+               out_h,
+               out_w,
+               ksize,
+               strides,
+               paddings,
+               exclusive,
+               buffer.data(),
+               out);
+  }
+  return true;
+}
+
+template <bool IsMax>
+static float ReducePlane(const float* in, int size) {
+  using R = PoolReducer<IsMax>;
+  float acc = R::initial();
+  int i = 0;
+#ifdef __AVX__
+  if (size >= 8) {
+    __m256 vacc = _mm256_loadu_ps(in);
+    for (i = 8; i + 8 <= size; i += 8) {
+      vacc = R::reduce(vacc, _mm256_loadu_ps(in + i));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, vacc);
+    for (int j = 0; j < 8; ++j) {
+      acc = R::reduce(acc, lanes[j]);
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    acc = R::reduce(acc, in[i]);
+  }
+  return acc;
+}
+
+void GlobalPool2d(const lite::Tensor* input,
+                  bool is_max,
+                  lite::Tensor* output) {
+  const int planes = input->dims()[0] * input->dims()[1];
+  const int size = input->dims()[2] * input->dims()[3];
+  const float* in_data = input->data<float>();
+  float* out_data = output->mutable_data<float>(lite::TargetType::kX86);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < planes; ++i) {
+    const float* in = in_data + static_cast<int64_t>(i) * size;
+    out_data[i] = is_max ? ReducePlane<true>(in, size)
+                         : ReducePlane<false>(in, size) /
+                               static_cast<float>(size);
+  }
+}
+
 /*
 * All tensors are in NCHW format.
 * Ksize, strides, paddings are two elements. These two elements represent height
@@ -109,6 +109,31 @@ class Pool2dFunctor {
                   lite::Tensor* output);
 };
 
+/*
+ * \brief The vectorized pooling of float NCHW data, threaded across the
+ *        channels. The windows are reduced along the height first, then along
+ *        the width, so every window size is supported with the width strides
+ *        1 and 2, which cover 2x2s2, 3x3s1 and 3x3s2. The windows crossing the
+ *        edges are computed in scalar loops, with the same results as
+ *        Pool2dFunctor for ceil_mode and exclusive.
+ *        Return false if the params are not supported, and the caller should
+ *        use Pool2dFunctor instead.
+ */
+bool Pool2dFast(const lite::Tensor* input,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                bool is_max,
+                bool exclusive,
+                bool adaptive,
+                lite::Tensor* output);
+
+/*
+ * \brief The global pooling of float NCHW data, every plane is reduced to one
+ *        value.
+ */
+void GlobalPool2d(const lite::Tensor* input, bool is_max, lite::Tensor* output);
+
 template <lite::TargetType Target, typename PoolProcess, typename T>
 class Pool2dGradFunctor {
  public:
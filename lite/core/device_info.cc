@@ -51,13 +51,34 @@
 #include <omp.h>
 #endif
 
+#ifdef LITE_WITH_X86
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>  // NOLINT
+#endif  // LITE_WITH_X86
+
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include "lite/core/device_info.h"
 
 namespace paddle {
 namespace lite {
 
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+// The last run_mode_stamp of DeviceInfo given to any thread.
+static std::atomic<int64_t> g_run_mode_stamp{0};
+#endif
+
 #ifdef LITE_WITH_ARM
 thread_local lite_api::PowerMode DeviceInfo::mode_;
 thread_local ARMArch DeviceInfo::arch_;
@@ -65,6 +86,7 @@ thread_local int DeviceInfo::mem_size_;
 thread_local std::vector<int> DeviceInfo::active_ids_;
 thread_local TensorLite DeviceInfo::workspace_;
 thread_local int64_t DeviceInfo::count_ = 0;
+thread_local int64_t DeviceInfo::run_mode_stamp_ = 0;
 
 #ifdef TARGET_IOS
 const int DEFAULT_L1_CACHE_SIZE = 64 * 1024;
@@ -1121,6 +1143,7 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
   workspace_.Resize({llc_size()});
   workspace_.mutable_data<int8_t>();
   arch_ = archs_[active_ids_[0]];
+  run_mode_stamp_ = ++g_run_mode_stamp;
 }
 
 void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
@@ -1129,6 +1152,7 @@ void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
   SetCacheInfo(2, 1, l3size);
   workspace_.Resize({llc_size()});
   workspace_.mutable_data<int8_t>();
+  run_mode_stamp_ = ++g_run_mode_stamp;
 }
 
 bool DeviceInfo::ExtendWorkspace(size_t size) {
@@ -1137,8 +1161,305 @@ bool DeviceInfo::ExtendWorkspace(size_t size) {
   return workspace_.mutable_data<int8_t>() != nullptr;
 }
 
+#elif defined(LITE_WITH_X86)
+thread_local lite_api::PowerMode DeviceInfo::mode_ =
+    lite_api::LITE_POWER_NO_BIND;
+thread_local std::vector<int> DeviceInfo::active_ids_;
+thread_local std::vector<int> DeviceInfo::cpu_set_;
+thread_local int64_t DeviceInfo::run_mode_stamp_ = 0;
+
+const int DEFAULT_L1_CACHE_SIZE = 32 * 1024;
+const int DEFAULT_L2_CACHE_SIZE = 256 * 1024;
+const int DEFAULT_L3_CACHE_SIZE = 0;
+
+namespace {
+
+// Read the first line of a sysfs file, empty if it can't be read.
+std::string read_sysfs(const std::string& path) {
+  std::ifstream fin(path);
+  std::string line;
+  if (fin.is_open()) std::getline(fin, line);
+  return line;
+}
+
+int read_sysfs_int(const std::string& path, int default_value) {
+  auto line = read_sysfs(path);
+  return line.empty() ? default_value : atoi(line.c_str());
+}
+
+// Parse a list such as "0-3,8,10-11".
+std::vector<int> parse_id_list(const std::string& list) {
+  std::vector<int> ids;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    int first = 0;
+    int last = 0;
+    int n = sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (n < 1) continue;
+    if (n == 1) last = first;
+    for (int i = first; i <= last; ++i) {
+      ids.push_back(i);
+    }
+  }
+  return ids;
+}
+
+// Parse a cache size such as "32K" or "8M" in bytes.
+int parse_cache_size(const std::string& size) {
+  int value = atoi(size.c_str());
+  if (size.find('K') != std::string::npos) return value * 1024;
+  if (size.find('M') != std::string::npos) return value * 1024 * 1024;
+  return value;
+}
+
+bool bind_to_cpu(int cpu_id) {
+#ifdef __linux__
+  if (cpu_id < 0 || cpu_id >= CPU_SETSIZE) return false;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu_id, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif  // __linux__
+}
+
+// Bind the i-th OpenMP thread to cpu_ids[i].
+bool bind_threads_to_cpus(const std::vector<int>& cpu_ids) {
+  int thread_num = cpu_ids.size();
+  std::vector<int> rets(thread_num, 0);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(thread_num)
+  {
+    int i = omp_get_thread_num();
+    rets[i] = bind_to_cpu(cpu_ids[i]);
+  }
+#else
+  rets[0] = bind_to_cpu(cpu_ids[0]);
+  thread_num = 1;
+#endif  // _OPENMP
+  for (int i = 0; i < thread_num; ++i) {
+    if (!rets[i]) {
+      LOG(ERROR) << "Set cpu affinity failed, core id: " << cpu_ids[i];
+      return false;
+    }
+  }
+  return true;
+}
+
+// The cpu the calling thread runs on.
+int current_cpu() {
+#ifdef __linux__
+  int cpu = sched_getcpu();
+  return cpu < 0 ? 0 : cpu;
+#else
+  return 0;
+#endif  // __linux__
+}
+
+}  // namespace
+
+int DeviceInfo::Setup() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpus = parse_id_list(read_sysfs("/sys/devices/system/cpu/online"));
+#endif  // __linux__
+  if (cpus.empty()) {
+    int cpu_num = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < cpu_num; ++i) {
+      cpus.push_back(i);
+    }
+  }
+  core_num_ = cpus.size();
+  int id_num = *std::max_element(cpus.begin(), cpus.end()) + 1;
+  socket_ids_.assign(id_num, 0);
+  numa_ids_.assign(id_num, 0);
+  L1_cache_.assign(id_num, DEFAULT_L1_CACHE_SIZE);
+  L2_cache_.assign(id_num, DEFAULT_L2_CACHE_SIZE);
+  L3_cache_.assign(id_num, DEFAULT_L3_CACHE_SIZE);
+  physical_cores_.assign(id_num, {0, 0});
+  std::vector<bool> is_primary(id_num, true);
+
+#ifdef __linux__
+  for (int cpu : cpus) {
+    std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    socket_ids_[cpu] = read_sysfs_int(dir + "/topology/physical_package_id", 0);
+    physical_cores_[cpu] = {socket_ids_[cpu],
+                            read_sysfs_int(dir + "/topology/core_id", cpu)};
+    auto siblings =
+        parse_id_list(read_sysfs(dir + "/topology/thread_siblings_list"));
+    is_primary[cpu] = siblings.empty() || siblings.front() == cpu;
+    for (int i = 0;; ++i) {
+      std::string index = dir + "/cache/index" + std::to_string(i);
+      int level = read_sysfs_int(index + "/level", -1);
+      if (level < 0) break;
+      if (read_sysfs(index + "/type") == "Instruction") continue;
+      int size = parse_cache_size(read_sysfs(index + "/size"));
+      if (size <= 0) continue;
+      if (level == 1) {
+        L1_cache_[cpu] = size;
+      } else if (level == 2) {
+        L2_cache_[cpu] = size;
+      } else if (level == 3) {
+        L3_cache_[cpu] = size;
+      }
+    }
+  }
+  auto nodes = parse_id_list(read_sysfs("/sys/devices/system/node/online"));
+  for (int node : nodes) {
+    auto node_cpus = parse_id_list(read_sysfs(
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+    for (int cpu : node_cpus) {
+      if (cpu < id_num) numa_ids_[cpu] = node;
+    }
+  }
+  numa_node_num_ = std::max<int>(1, nodes.size());
+#endif  // __linux__
+
+  std::set<int> sockets;
+  primary_ids_.clear();
+  sibling_ids_.clear();
+  for (int cpu : cpus) {
+    sockets.insert(socket_ids_[cpu]);
+    (is_primary[cpu] ? primary_ids_ : sibling_ids_).push_back(cpu);
+  }
+  socket_num_ = sockets.size();
+  auto by_node = [&](int a, int b) { return numa_ids_[a] < numa_ids_[b]; };
+  std::stable_sort(primary_ids_.begin(), primary_ids_.end(), by_node);
+  std::stable_sort(sibling_ids_.begin(), sibling_ids_.end(), by_node);
+
+  LOG(INFO) << "CPU num: " << core_num_ << ", physical cores: "
+            << primary_ids_.size() << ", sockets: " << socket_num_
+            << ", NUMA nodes: " << numa_node_num_;
+  LOG(INFO) << "L1 DataCache size is: " << L1_cache_[cpus[0]] / 1024 << " KB"
+            << ", L2 Cache size is: " << L2_cache_[cpus[0]] / 1024 << " KB"
+            << ", L3 Cache size is: " << L3_cache_[cpus[0]] / 1024 << " KB";
+  // Keep the OpenMP defaults until a run mode is set.
+  active_ids_ = {cpus[0]};
+  return 0;
+}
+
+std::vector<int> DeviceInfo::PickCpus(lite_api::PowerMode mode,
+                                      int thread_num) const {
+  std::vector<int> ids;
+  if (!cpu_set_.empty()) {
+    ids = cpu_set_;
+  } else if (mode == lite_api::LITE_POWER_FULL ||
+             mode == lite_api::LITE_POWER_NO_BIND) {
+    ids = primary_ids_;
+    ids.insert(ids.end(), sibling_ids_.begin(), sibling_ids_.end());
+  } else {
+    int node = numa_ids_[current_cpu()];
+    auto on_node = [&](int cpu) { return numa_ids_[cpu] == node; };
+    std::copy_if(primary_ids_.begin(),
+                 primary_ids_.end(),
+                 std::back_inserter(ids),
+                 on_node);
+    std::copy_if(sibling_ids_.begin(),
+                 sibling_ids_.end(),
+                 std::back_inserter(ids),
+                 on_node);
+    if (mode == lite_api::LITE_POWER_LOW ||
+        mode == lite_api::LITE_POWER_RAND_LOW) {
+      // Put the SMT siblings of a physical core next to each other.
+      std::stable_sort(ids.begin(), ids.end(), [&](int a, int b) {
+        return physical_cores_[a] < physical_cores_[b];
+      });
+    }
+  }
+  if (static_cast<int>(ids.size()) > thread_num) ids.resize(thread_num);
+  return ids;
+}
+
+void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
+#ifdef _OPENMP
+  thread_num = std::max(1, std::min(thread_num, core_num_));
+#else
+  thread_num = 1;  // force thread_num to 1 if OpenMP is disabled
+#endif  // _OPENMP
+  mode_ = mode;
+  active_ids_ = PickCpus(mode, thread_num);
+  if (active_ids_.empty()) {
+    active_ids_.push_back(primary_ids_.empty() ? 0 : primary_ids_[0]);
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(active_ids_.size());
+#endif  // _OPENMP
+  if (mode_ != lite_api::LITE_POWER_NO_BIND || !cpu_set_.empty()) {
+    if (!bind_threads_to_cpus(active_ids_)) {
+      LOG(WARNING) << "Failed to bind the threads, switch to NO BIND MODE";
+      mode_ = lite_api::LITE_POWER_NO_BIND;
+    }
+  }
+  run_mode_stamp_ = ++g_run_mode_stamp;
+}
+
+void DeviceInfo::SetCpuSet(const std::vector<int>& cpu_ids) {
+  for (int cpu : cpu_ids) {
+    CHECK(cpu >= 0 && cpu < static_cast<int>(numa_ids_.size()))
+        << "invalid cpu id " << cpu;
+  }
+  cpu_set_ = cpu_ids;
+  run_mode_stamp_ = ++g_run_mode_stamp;
+}
+
+void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
+  std::fill(L1_cache_.begin(), L1_cache_.end(), l1size);
+  std::fill(L2_cache_.begin(), L2_cache_.end(), l2size);
+  std::fill(L3_cache_.begin(), L3_cache_.end(), l3size);
+  run_mode_stamp_ = ++g_run_mode_stamp;
+}
+
+bool DeviceInfo::BindToNumaNode(const void* ptr, size_t size) const {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (numa_node_num_ < 2 || !ptr) return false;
+  const uintptr_t page = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  uintptr_t end = (begin + size) / page * page;
+  begin = (begin + page - 1) / page * page;
+  if (end <= begin) return false;
+  // MPOL_PREFERRED and MPOL_MF_MOVE of <numaif.h>, libnuma is not needed for
+  // the syscall.
+  const int kMpolPreferred = 1;
+  const unsigned kMpolMfMove = 1 << 1;
+  const int kMaskBits = 1024;
+  uint64_t node_mask[kMaskBits / 64] = {0};
+  int node = numa_node();
+  if (node >= kMaskBits - 1) return false;
+  node_mask[node / 64] |= uint64_t(1) << (node % 64);
+  return syscall(SYS_mbind,
+                 begin,
+                 end - begin,
+                 kMpolPreferred,
+                 node_mask,
+                 kMaskBits,
+                 kMpolMfMove) == 0;
+#else
+  return false;
+#endif  // __linux__ && SYS_mbind
+}
+
 #endif  // LITE_WITH_ARM
 
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+void RunModeContext::Apply() {
+  auto& device = DeviceInfo::Global();
+#ifdef LITE_WITH_ARM
+  bool rand_mode = mode_ == lite_api::LITE_POWER_RAND_HIGH ||
+                   mode_ == lite_api::LITE_POWER_RAND_LOW;
+#else
+  bool rand_mode = false;
+#endif
+  if (!rand_mode && stamp_ == device.run_mode_stamp()) return;
+#ifdef LITE_WITH_X86
+  device.SetCpuSet(cpu_set_);
+#endif
+  device.SetRunMode(mode_, threads_);
+  stamp_ = device.run_mode_stamp();
+}
+#endif
+
 #ifdef LITE_WITH_CUDA
 
 void Device<TARGET(kCUDA)>::Init() {
@@ -16,6 +16,7 @@
 
 #include <cstdarg>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lite/core/tensor.h"
 #include "lite/utils/cp_logging.h"
@@ -74,6 +75,9 @@ class DeviceInfo {
     return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
   }
   bool ExtendWorkspace(size_t size);
+  // Changes whenever the run mode or the caches of the calling thread are set,
+  // and is unique across the threads.
+  int64_t run_mode_stamp() const { return run_mode_stamp_; }
 
  private:
   int core_num_;
@@ -102,6 +106,7 @@ class DeviceInfo {
   static thread_local std::vector<int> active_ids_;
   static thread_local TensorLite workspace_;
   static thread_local int64_t count_;
+  static thread_local int64_t run_mode_stamp_;
 
   void SetDotInfo(int argc, ...);
   void SetFP16Info(int argc, ...);
@@ -119,8 +124,121 @@ class DeviceInfo {
 
   DeviceInfo() = default;
 };
+#elif defined(LITE_WITH_X86)
+
+class DeviceInfo {
+ public:
+  static DeviceInfo& Global() {
+    static auto* x = new DeviceInfo;
+    return *x;
+  }
+
+  static int Init() {
+    static int ret = Global().Setup();
+    return ret;
+  }
+
+  // Probe the sockets, NUMA nodes, SMT siblings and caches from sysfs.
+  int Setup();
+
+  // LITE_POWER_HIGH and LITE_POWER_RAND_HIGH bind the threads to the physical
+  // cores of the NUMA node the caller runs on, LITE_POWER_LOW and
+  // LITE_POWER_RAND_LOW pack them on the SMT siblings of the fewest of these
+  // cores, and LITE_POWER_FULL spreads them on the physical cores of all the
+  // nodes. LITE_POWER_NO_BIND only sets the number of threads.
+  void SetRunMode(lite_api::PowerMode mode, int thread_num);
+  // Bind the threads to `cpu_ids` whatever the power mode is, at most one
+  // thread per cpu, empty to use the cores picked by the power mode.
+  void SetCpuSet(const std::vector<int>& cpu_ids);
+  void SetCache(int l1size, int l2size, int l3size);
+
+  lite_api::PowerMode mode() const { return mode_; }
+  int threads() const { return active_ids_.size(); }
+  const std::vector<int>& active_ids() const { return active_ids_; }
+  int core_num() const { return core_num_; }
+  int socket_num() const { return socket_num_; }
+  int numa_node_num() const { return numa_node_num_; }
+  // The NUMA node of the first active cpu.
+  int numa_node() const { return numa_ids_[first_active_id()]; }
+  int l1_cache_size() const { return L1_cache_[first_active_id()]; }
+  int l2_cache_size() const { return L2_cache_[first_active_id()]; }
+  int l3_cache_size() const { return L3_cache_[first_active_id()]; }
+  int llc_size() const {
+    auto size = l3_cache_size() > 0 ? l3_cache_size() : l2_cache_size();
+    return size > 0 ? size : 1024 * 1024;
+  }
+
+  // Move the pages of [ptr, ptr + size) to numa_node(), returns false if it
+  // is not supported. Only the whole pages in the range are moved.
+  bool BindToNumaNode(const void* ptr, size_t size) const;
+  // Changes whenever the run mode, the cpu set or the caches of the calling
+  // thread are set, and is unique across the threads.
+  int64_t run_mode_stamp() const { return run_mode_stamp_; }
+
+ private:
+  int first_active_id() const {
+    return active_ids_.empty() ? 0 : active_ids_[0];
+  }
+  // The cpus picked by the power mode, see SetRunMode.
+  std::vector<int> PickCpus(lite_api::PowerMode mode, int thread_num) const;
+
+  int core_num_{1};
+  int socket_num_{1};
+  int numa_node_num_{1};
+
+  // Indexed by the logical cpu id.
+  std::vector<int> socket_ids_;
+  std::vector<int> numa_ids_;
+  std::vector<int> L1_cache_;
+  std::vector<int> L2_cache_;
+  std::vector<int> L3_cache_;
+  // The physical core of each cpu, as (socket, core id).
+  std::vector<std::pair<int, int>> physical_cores_;
+  // One cpu of each physical core, and the SMT siblings of them, ordered by
+  // NUMA node.
+  std::vector<int> primary_ids_;
+  std::vector<int> sibling_ids_;
+
+  static thread_local lite_api::PowerMode mode_;
+  static thread_local std::vector<int> active_ids_;
+  static thread_local std::vector<int> cpu_set_;
+  static thread_local int64_t run_mode_stamp_;
+
+  DeviceInfo() = default;
+};
 #endif  // LITE_WITH_ARM
 
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+/*
+ * RunModeContext is the run mode of a predictor. The run mode of DeviceInfo
+ * is per thread and shared by the predictors running on it, Apply sets it on
+ * the calling thread only if the thread or the run mode set on it changed
+ * since the last Apply, so the cores are not picked and bound again, and the
+ * workspace not resized, on every run.
+ */
+class RunModeContext {
+ public:
+  void Set(lite_api::PowerMode mode,
+           int threads,
+           const std::vector<int>& cpu_set = std::vector<int>()) {
+    mode_ = mode;
+    threads_ = threads;
+    cpu_set_ = cpu_set;
+    stamp_ = -1;
+  }
+
+  // The RAND modes are applied on every call, for they rotate the cores.
+  void Apply();
+
+ private:
+  lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
+  int threads_{1};
+  std::vector<int> cpu_set_;
+  // The run_mode_stamp of DeviceInfo after the last Apply.
+  int64_t stamp_{-1};
+};
+#endif
+
 template <TargetType Type>
 class Device;
 
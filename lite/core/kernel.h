@@ -57,6 +57,32 @@ class KernelBase {
   /// Run the kernel. Before Run, both the param_ and context_ should be valid.
   virtual void Run() = 0;
 
+  /// The weights transformed in `PrepareForRun` (winograd transform, GEMM
+  /// packing and so on) keyed by the argument of the input they replace, such
+  /// as "Filter". They are saved with the optimized model, along with the
+  /// original weights, to skip the transformation on the next loading. It is
+  /// empty if the kernel has no such weights or is not prepared yet.
+  virtual std::map<std::string, const Tensor*> PreparedWeights() const {
+    return {};
+  }
+  /// Identify the layout of the prepared weights, such as the algorithm and
+  /// the blocking that depends on the CPU.
+  virtual std::string PreparedWeightsKey() const { return ""; }
+  /// Restore the prepared weights saved by a previous run. They are called
+  /// before `PrepareForRun`, and the kernel should use them only if `key`
+  /// matches its own `PreparedWeightsKey`.
+  virtual void SetPreparedWeights(
+      const std::string& key,
+      const std::map<std::string, const Tensor*>& weights) {}
+
+  /// The args whose tensors may become views of the memory of another arg in
+  /// `Run`, as pairs of (view arg, base arg), such as ("Out", "X") for the
+  /// reshape which shares the input. The static code generator does not give
+  /// them memory of their own.
+  virtual std::vector<std::pair<std::string, std::string>> ViewArgs() const {
+    return {};
+  }
+
 #ifdef LITE_WITH_PROFILE
   void SetProfileID(uint32_t id) { profile_id_ = id; }
 #endif
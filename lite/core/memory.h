@@ -80,6 +80,9 @@ class Buffer {
  public:
   Buffer() = default;
   Buffer(TargetType target, size_t size) : space_(size), target_(target) {}
+  // Wrap the memory owned by others, it will not be freed by the buffer.
+  Buffer(void* data, TargetType target, size_t size)
+      : space_(size), data_(data), own_data_(false), target_(target) {}
 
   void* data() const { return data_; }
   TargetType target() const { return target_; }
@@ -89,6 +92,7 @@ class Buffer {
     if (target != target_ || space_ < size) {
       Free();
       data_ = TargetMalloc(target, size);
+      own_data_ = true;
       target_ = target;
       space_ = size;
     }
@@ -116,9 +120,11 @@ class Buffer {
 #endif
 
   void Free() {
-    if (space_ > 0) {
+    if (space_ > 0 && own_data_) {
       TargetFree(target_, data_);
     }
+    data_ = nullptr;
+    own_data_ = true;
     target_ = TargetType::kHost;
     space_ = 0;
   }
@@ -138,6 +144,7 @@ class Buffer {
   size_t cl_image2d_width_{0};   // only used for OpenCL Image2D
   size_t cl_image2d_height_{0};  // only used for OpenCL Image2D
   void* data_{nullptr};
+  bool own_data_{true};
   TargetType target_{TargetType::kHost};
 };
 
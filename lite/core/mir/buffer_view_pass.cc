@@ -0,0 +1,126 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/pass.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * BufferViewPass removes the copies of concat, split and slice along the
+ * outermost non-trivial axis. It marks them with the `use_buffer_view` attr,
+ * then their X86/ARM kernels make the tensors views of a block of another
+ * tensor:
+ * - the inputs of concat become views of the output, so the producers of the
+ *   inputs write to the output directly,
+ * - the outputs of split and slice become views of the input.
+ * The kernels check the axis at runtime, and fall back to the copies if it is
+ * not the outermost one. See `lite/backends/host/math/buffer_view.h`.
+ *
+ * A tensor can only be a view of one block, so every var takes part in at
+ * most one of these ops. The vars are not reused by MemoryOptimizePass, which
+ * runs after this pass.
+ */
+class BufferViewPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+    std::set<std::string> viewed_vars;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      auto& inst = node->AsStmt();
+      const auto& op_type = inst.op_type();
+      if (op_type != "concat" && op_type != "split" && op_type != "slice") {
+        continue;
+      }
+      const auto& kernel = inst.picked_kernel();
+      if (kernel.target() != TARGET(kX86) && kernel.target() != TARGET(kARM)) {
+        continue;
+      }
+      if (kernel.precision() != PRECISION(kFloat)) continue;
+      if (!IsStaticOp(*inst.op_info())) continue;
+
+      std::vector<Node*> args(node->inlinks.begin(), node->inlinks.end());
+      args.insert(args.end(), node->outlinks.begin(), node->outlinks.end());
+      std::set<std::string> names;
+      bool valid = true;
+      for (auto* arg : args) {
+        valid = valid && CanBeView(arg, kernel.target(), viewed_vars) &&
+                names.insert(arg->AsArg().name).second;
+      }
+      // The producers of the concat inputs write to the shared buffer.
+      if (op_type == "concat") {
+        for (auto* in : node->inlinks) {
+          valid = valid && in->inlinks.size() == 1 &&
+                  in->inlinks.front()->AsStmt().op_type() != "feed" &&
+                  in->inlinks.front()->AsStmt().picked_kernel().target() ==
+                      kernel.target();
+        }
+      }
+      if (!valid) continue;
+      viewed_vars.insert(names.begin(), names.end());
+      UseBufferView(graph.get(), node);
+    }
+  }
+
+ private:
+  // Whether the op has no inputs that decide the axis or the range at runtime.
+  bool IsStaticOp(const cpp::OpDesc& op_info) {
+    auto has_input = [&](const std::string& arg) {
+      return op_info.HasInput(arg) && !op_info.Input(arg).empty();
+    };
+    if (op_info.Type() == "concat") {
+      return !has_input("AxisTensor");
+    }
+    if (op_info.Type() == "slice") {
+      return op_info.GetAttr<std::vector<int>>("axes").size() == 1 &&
+             !has_input("StartsTensor") && !has_input("EndsTensor") &&
+             !has_input("StartsTensorList") && !has_input("EndsTensorList");
+    }
+    return true;
+  }
+
+  bool CanBeView(Node* node,
+                 TargetType target,
+                 const std::set<std::string>& viewed_vars) {
+    const auto& arg = node->AsArg();
+    return !arg.is_weight && !arg.is_persist && arg.type &&
+           arg.type->target() == target && !viewed_vars.count(arg.name);
+  }
+
+  void UseBufferView(SSAGraph* graph, Node* node) {
+    auto& inst = node->AsStmt();
+    auto updated_op_info = *inst.op_info();
+    updated_op_info.SetAttr<bool>("use_buffer_view", true);
+    // Keep the picked kernel, and attach it to the updated op.
+    auto picked_kernel = std::move(inst.kernels().front());
+    inst.ResetOp(updated_op_info, graph->valid_places());
+    inst.kernels().clear();
+    inst.kernels().emplace_back(std::move(picked_kernel));
+    inst.op()->AttachKernel(inst.kernels().front().get());
+    VLOG(4) << "use buffer view for " << inst.op_type();
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(buffer_view_pass, paddle::lite::mir::BufferViewPass)
+    .BindTargets({TARGET(kX86), TARGET(kARM)});
@@ -0,0 +1,244 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * ConstantFoldingPass runs the ops whose inputs are all constant once at
+ * optimization time, and replaces their outputs with persistable tensors.
+ * The constants are the weights and the outputs of the ops folded before, so
+ * the chains of shape arithmetic built from fill_constant, assign_value,
+ * shape and range on the weights are folded as a whole.
+ *
+ * The ops are run with their picked kernels, then removed from the graph
+ * together with the weights no other op consumes. Only the host kernels and
+ * the X86/ARM kernels of the library being built run, so nothing is folded in
+ * model_optimize_tool. The pass is enabled with
+ * CxxConfig::set_constant_folding.
+ */
+class ConstantFoldingPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+    // A var written by more than one op is not a constant.
+    std::map<std::string, int> arg_count;
+    for (auto& node : graph->mutable_nodes()) {
+      if (node.IsArg()) arg_count[node.AsArg().name]++;
+    }
+
+    std::vector<Node*> folded_nodes;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      if (!CanFold(node, arg_count)) continue;
+      if (!Fold(node)) continue;
+      folded_nodes.push_back(node);
+    }
+    if (folded_nodes.empty()) return;
+
+    std::set<Node*> inputs;
+    for (auto* node : folded_nodes) {
+      for (auto* in : std::vector<Node*>(node->inlinks.begin(),
+                                         node->inlinks.end())) {
+        RemoveDirectedLink(in, node);
+        inputs.insert(in);
+      }
+      for (auto* out : std::vector<Node*>(node->outlinks.begin(),
+                                          node->outlinks.end())) {
+        RemoveDirectedLink(node, out);
+      }
+      VLOG(4) << "fold constant op " << node->AsStmt().op_type();
+      graph->RemoveNode(node);
+    }
+    // Remove the constants which are no longer used.
+    for (auto* in : inputs) {
+      if (in->inlinks.empty() && in->outlinks.empty()) {
+        graph->RemoveNode(in);
+      }
+    }
+    graph->CheckValid();
+  }
+
+ private:
+  bool CanFold(Node* node, const std::map<std::string, int>& arg_count) {
+    auto& inst = node->AsStmt();
+    const auto& op_type = inst.op_type();
+    const std::set<std::string> unfoldable_ops{"feed",
+                                               "fetch",
+                                               "while",
+                                               "conditional_block",
+                                               "subgraph",
+                                               "graph_op",
+                                               "io_copy",
+                                               "io_copy_once",
+                                               "calib",
+                                               "calib_once",
+                                               "layout",
+                                               "layout_once",
+                                               "uniform_random",
+                                               "gaussian_random",
+                                               "write_to_array",
+                                               "read_from_array"};
+    if (unfoldable_ops.count(op_type)) return false;
+    // Only the ops without inputs that always generate the same values.
+    if (node->inlinks.empty() && op_type != "fill_constant" &&
+        op_type != "assign_value") {
+      return false;
+    }
+    if (node->outlinks.empty()) return false;
+    if (!RunsOnThisMachine(inst.picked_kernel().target())) return false;
+    for (auto* in : node->inlinks) {
+      const auto& arg = in->AsArg();
+      if (!arg.is_weight || !IsTensor(arg)) return false;
+    }
+    for (auto* out : node->outlinks) {
+      const auto& arg = out->AsArg();
+      if (arg.is_weight || !IsTensor(arg) || arg_count.at(arg.name) != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The kernels of model_optimize_tool are fakes which compute nothing, and
+  // the ARM kernels can not run on an X86 host.
+  bool RunsOnThisMachine(TargetType target) {
+#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+    return false;
+#else
+    switch (target) {
+      case TARGET(kHost):
+        return true;
+#ifdef LITE_WITH_X86
+      case TARGET(kX86):
+        return true;
+#endif
+#ifdef LITE_WITH_ARM
+      case TARGET(kARM):
+        return true;
+#endif
+      default:
+        return false;
+    }
+#endif
+  }
+
+  bool IsTensor(const Node::Arg& arg) {
+    return arg.type && arg.type->IsTensor() &&
+           arg.type->target() != TARGET(kOpenCL) &&
+           arg.type->target() != TARGET(kFPGA);
+  }
+
+  // Run the op, and turn its outputs into weights.
+  bool Fold(Node* node) {
+    auto& inst = node->AsStmt();
+    auto* op = inst.op().get();
+    auto* scope = op->scope();
+    CHECK(scope);
+    std::vector<PrecisionType> in_precisions;
+    for (auto* in : node->inlinks) {
+      auto* var = scope->FindVar(in->AsArg().name);
+      if (!var || !var->IsType<Tensor>()) return false;
+      in_precisions.push_back(var->Get<Tensor>().precision());
+    }
+    std::vector<PrecisionType> out_precisions;
+    for (auto* out : node->outlinks) {
+      auto precision = InferPrecision(*inst.op_info(),
+                                      out->AsArg().type->precision(),
+                                      in_precisions);
+      // Only the precisions that can be saved with the model.
+      if (precision != PRECISION(kFloat) && precision != PRECISION(kInt8) &&
+          precision != PRECISION(kInt16) && precision != PRECISION(kInt32) &&
+          precision != PRECISION(kInt64)) {
+        return false;
+      }
+      out_precisions.push_back(precision);
+    }
+
+    if (!op->CheckShape()) return false;
+    op->InferShape();
+    inst.picked_kernel().Launch();
+
+    size_t i = 0;
+    for (auto* out : node->outlinks) {
+      auto& arg = out->AsArg();
+      auto* tensor = scope->FindVar(arg.name)->GetMutable<Tensor>();
+      tensor->set_precision(out_precisions[i++]);
+      tensor->set_persistable(true);
+      arg.is_weight = true;
+      arg.is_persist = true;
+    }
+    return true;
+  }
+
+  PrecisionType InferPrecision(const cpp::OpDesc& op_info,
+                               PrecisionType decl_precision,
+                               const std::vector<PrecisionType>& inputs) {
+    if (op_info.Type() == "shape") return PRECISION(kInt32);
+    if (op_info.Type() == "cast" && op_info.HasAttr("out_dtype")) {
+      return DataTypeToPrecision(op_info.GetAttr<int>("out_dtype"));
+    }
+    if (op_info.HasAttr("dtype")) {
+      return DataTypeToPrecision(op_info.GetAttr<int>("dtype"));
+    }
+    // Many kernels are registered with kFloat or kAny for all the types of
+    // data, so only the other precisions are trusted.
+    if (decl_precision != PRECISION(kFloat) &&
+        decl_precision != PRECISION(kAny)) {
+      return decl_precision;
+    }
+    if (inputs.empty()) return PRECISION(kUnk);
+    for (auto precision : inputs) {
+      if (precision != inputs.front()) return PRECISION(kUnk);
+    }
+    return inputs.front();
+  }
+
+  // See VarType::Type in framework.proto.
+  PrecisionType DataTypeToPrecision(int dtype) {
+    switch (dtype) {
+      case 0:
+        return PRECISION(kBool);
+      case 1:
+        return PRECISION(kInt16);
+      case 2:
+        return PRECISION(kInt32);
+      case 3:
+        return PRECISION(kInt64);
+      case 4:
+        return PRECISION(kFP16);
+      case 5:
+        return PRECISION(kFloat);
+      case 21:
+        return PRECISION(kInt8);
+      default:
+        return PRECISION(kUnk);
+    }
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass,
+                  paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kAny)});
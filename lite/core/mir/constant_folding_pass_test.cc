@@ -0,0 +1,114 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer.h"
+
+USE_LITE_KERNEL(feed, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(fetch, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(scale, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(reshape2, kX86, kFloat, kNCHW, def);
+USE_LITE_KERNEL(fc, kX86, kFloat, kNCHW, def);
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kX86), PRECISION(kFloat)},
+                                 Place{TARGET(kHost), PRECISION(kFloat)}};
+
+// feed(x) -> fc(W = reshape2(scale(w0))) -> fetch
+void BuildProgram(PassTestHelper* helper) {
+  helper->AddFeed("x", 0);
+  helper->AddWeight("w0", {3, 4}, 0.1f, 0.05f);
+  auto* scale = helper->AddOp("scale", {{"X", {"w0"}}}, {{"Out", {"w1"}}});
+  scale->SetAttr("scale", 2.f);
+  scale->SetAttr("bias", 0.5f);
+  scale->SetAttr("bias_after_scale", true);
+  helper
+      ->AddOp("reshape2",
+              {{"X", {"w1"}}},
+              {{"Out", {"w2"}}, {"XShape", {"w2_shape"}}})
+      ->SetAttr("shape", std::vector<int>{6, 2});
+  helper->AddFc("x", "w2", "out");
+  helper->AddFetch("out", 0);
+}
+
+// Optimize the program with the default passes, run it and return the
+// output. `types` is set to the ops left in the optimized program.
+std::vector<float> RunProgram(bool constant_folding,
+                              std::vector<std::string>* types) {
+  PassTestHelper helper;
+  BuildProgram(&helper);
+  Optimizer optimizer;
+  optimizer.set_constant_folding(constant_folding);
+  optimizer.Run(Program(helper.desc(), helper.scope(), kPlaces),
+                kPlaces,
+                core::KernelPickFactor());
+  *types = PassTestHelper::OpTypes(optimizer.mutable_ssa_graph());
+  auto program = optimizer.GenRuntimeProgram();
+
+  auto* x = program->exec_scope()->FindVar("x")->GetMutable<Tensor>();
+  x->Resize({4, 6});
+  auto* x_data = x->mutable_data<float>();
+  for (int i = 0; i < x->numel(); i++) x_data[i] = 0.1f * (i % 5) - 0.2f;
+  program->Run();
+
+  const auto& out = program->exec_scope()->FindVar("out")->Get<Tensor>();
+  EXPECT_EQ(out.dims(), DDim(std::vector<int64_t>({4, 2})));
+  const auto* out_data = out.data<float>();
+  return std::vector<float>(out_data, out_data + out.numel());
+}
+
+bool Contains(const std::vector<std::string>& types, const std::string& x) {
+  return std::find(types.begin(), types.end(), x) != types.end();
+}
+
+}  // namespace
+
+TEST(ConstantFoldingPass, disabled_by_default) {
+  std::vector<std::string> types;
+  RunProgram(false, &types);
+  EXPECT_TRUE(Contains(types, "scale"));
+  EXPECT_TRUE(Contains(types, "reshape2"));
+}
+
+TEST(ConstantFoldingPass, same_outputs) {
+  std::vector<std::string> unfolded_types;
+  auto unfolded = RunProgram(false, &unfolded_types);
+  std::vector<std::string> folded_types;
+  auto folded = RunProgram(true, &folded_types);
+
+  EXPECT_FALSE(Contains(folded_types, "scale"));
+  EXPECT_FALSE(Contains(folded_types, "reshape2"));
+  EXPECT_TRUE(Contains(folded_types, "fc"));
+  ASSERT_EQ(folded.size(), unfolded.size());
+  for (size_t i = 0; i < folded.size(); i++) {
+    EXPECT_NEAR(folded[i], unfolded[i], 1e-6f) << i;
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,158 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * DeadCodeEliminationPass removes the ops none of whose outputs is consumed,
+ * such as the shape chains left behind by the fusion passes. Ops are visited
+ * consumers first, so a whole chain that only feeds dead ops is removed in
+ * one sweep, together with the weights no other op reads.
+ *
+ * The unconsumed optional outputs of the remaining ops, such as the saved
+ * statistics of batch_norm or the XShape of reshape2, are dropped from the
+ * op. Such an output is then null in the op param, and the kernels skip
+ * computing it.
+ *
+ * The persistable vars are never removed, nor are the ops writing them.
+ */
+class DeadCodeEliminationPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+    // Without fetch ops the outputs of the program are unknown.
+    bool has_fetch = false;
+    for (auto& node : graph->mutable_nodes()) {
+      if (node.IsStmt() && node.AsStmt().op_type() == "fetch") {
+        has_fetch = true;
+        break;
+      }
+    }
+    if (!has_fetch) return;
+
+    auto nodes = graph->StmtTopologicalOrder();
+    std::set<Node*> inputs;
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+      auto* node = *it;
+      if (!IsDead(node)) continue;
+      VLOG(4) << "remove dead op " << node->AsStmt().op_type();
+      for (auto* in : std::vector<Node*>(node->inlinks.begin(),
+                                         node->inlinks.end())) {
+        RemoveDirectedLink(in, node);
+        inputs.insert(in);
+      }
+      for (auto* out : std::vector<Node*>(node->outlinks.begin(),
+                                          node->outlinks.end())) {
+        RemoveDirectedLink(node, out);
+        graph->RemoveNode(out);
+        inputs.erase(out);
+      }
+      graph->RemoveNode(node);
+    }
+    for (auto* in : inputs) {
+      if (in->inlinks.empty() && in->outlinks.empty()) {
+        graph->RemoveNode(in);
+      }
+    }
+
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      RemoveUnusedOutputs(graph.get(), node);
+    }
+    graph->CheckValid();
+  }
+
+ private:
+  // The ops whose effects are not limited to their outputs.
+  bool HasSideEffects(const std::string& op_type) {
+    const std::set<std::string> ops{"feed",
+                                    "fetch",
+                                    "while",
+                                    "conditional_block",
+                                    "subgraph",
+                                    "graph_op",
+                                    "write_to_array",
+                                    "increment",
+                                    "assign",
+                                    "print"};
+    return ops.count(op_type) > 0;
+  }
+
+  // The persistable vars outlive the run, so their writers are kept.
+  bool IsDead(Node* node) {
+    if (HasSideEffects(node->AsStmt().op_type())) return false;
+    if (node->outlinks.empty()) return false;
+    for (auto* out : node->outlinks) {
+      if (!out->outlinks.empty() || out->AsArg().is_weight) return false;
+    }
+    return true;
+  }
+
+  // Drops the optional outputs that no op consumes.
+  void RemoveUnusedOutputs(SSAGraph* graph, Node* node) {
+    // The outputs that the ops and their kernels allow to be absent.
+    const std::map<std::string, std::set<std::string>> optional_outputs{
+        {"batch_norm",
+         {"MeanOut", "VarianceOut", "SavedMean", "SavedVariance"}},
+        {"dropout", {"Mask"}},
+        {"reshape2", {"XShape"}},
+        {"transpose2", {"XShape"}},
+        {"flatten2", {"XShape"}},
+        {"squeeze2", {"XShape"}},
+        {"unsqueeze2", {"XShape"}}};
+    auto& inst = node->AsStmt();
+    auto it = optional_outputs.find(inst.op_type());
+    if (it == optional_outputs.end()) return;
+
+    auto op_info = *inst.op_info();
+    auto* outputs = op_info.mutable_outputs();
+    bool changed = false;
+    for (auto* out : std::vector<Node*>(node->outlinks.begin(),
+                                        node->outlinks.end())) {
+      if (!out->outlinks.empty() || out->AsArg().is_weight) continue;
+      const auto& name = out->AsArg().name;
+      for (const auto& param : it->second) {
+        auto output = outputs->find(param);
+        if (output == outputs->end() || output->second.size() != 1 ||
+            output->second.front() != name) {
+          continue;
+        }
+        VLOG(4) << "remove unused output " << param << " of "
+                << inst.op_type();
+        outputs->erase(output);
+        RemoveDirectedLink(node, out);
+        graph->RemoveNode(out);
+        changed = true;
+        break;
+      }
+    }
+    if (changed) inst.ResetOp(op_info, graph->valid_places());
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(dead_code_elimination_pass,
+                  paddle::lite::mir::DeadCodeEliminationPass)
+    .BindTargets({TARGET(kAny)});
@@ -0,0 +1,166 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kHost), PRECISION(kFloat)}};
+
+std::unique_ptr<SSAGraph> ApplyPass(PassTestHelper* helper) {
+  auto graph = helper->BuildGraph(kPlaces);
+  auto* pass = PassManager::Global().LookUp("dead_code_elimination_pass");
+  CHECK(pass);
+  pass->Apply(graph);
+  return graph;
+}
+
+bool HasArg(SSAGraph* graph, const std::string& name) {
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg() && node.AsArg().name == name) return true;
+  }
+  return false;
+}
+
+void AddScale(PassTestHelper* helper,
+              const std::string& x,
+              const std::string& out) {
+  auto* op = helper->AddOp("scale", {{"X", {x}}}, {{"Out", {out}}});
+  op->SetAttr("scale", 2.f);
+  op->SetAttr("bias", 0.f);
+  op->SetAttr("bias_after_scale", true);
+}
+
+cpp::OpDesc* AddBatchNorm(PassTestHelper* helper,
+                          const std::string& x,
+                          const std::string& y) {
+  for (auto* name : {"bn_scale", "bn_bias", "bn_mean", "bn_variance"}) {
+    helper->AddWeight(name, {4});
+  }
+  // As in the inference models, the running statistics are updated in place.
+  auto* op = helper->AddOp("batch_norm",
+                           {{"X", {x}},
+                            {"Scale", {"bn_scale"}},
+                            {"Bias", {"bn_bias"}},
+                            {"Mean", {"bn_mean"}},
+                            {"Variance", {"bn_variance"}}},
+                           {{"Y", {y}},
+                            {"MeanOut", {"bn_mean"}},
+                            {"VarianceOut", {"bn_variance"}},
+                            {"SavedMean", {"bn_saved_mean"}},
+                            {"SavedVariance", {"bn_saved_variance"}}});
+  op->SetAttr("is_test", 1);
+  op->SetAttr("use_global_stats", false);
+  op->SetAttr("epsilon", 1e-5f);
+  op->SetAttr("momentum", 0.9f);
+  op->SetAttr("data_layout", std::string("NCHW"));
+  return op;
+}
+
+}  // namespace
+
+TEST(dead_code_elimination_pass, remove_dead_ops) {
+  // x -> scale -> scale -> (unused)
+  // x -> mul(w) -> (unused)
+  // x -> scale -> fetch
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddScale(&helper, "x", "dead0");
+  AddScale(&helper, "dead0", "dead1");
+  helper.AddWeight("w", {4, 4});
+  auto* mul =
+      helper.AddOp("mul", {{"X", {"x"}}, {"Y", {"w"}}}, {{"Out", {"dead2"}}});
+  mul->SetAttr("x_num_col_dims", 1);
+  mul->SetAttr("y_num_col_dims", 1);
+  AddScale(&helper, "x", "out");
+  helper.AddFetch("out", 0);
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_EQ(PassTestHelper::OpTypes(graph.get()),
+            (std::vector<std::string>{"feed", "scale", "fetch"}));
+  for (auto* name : {"dead0", "dead1", "dead2", "w"}) {
+    EXPECT_FALSE(HasArg(graph.get(), name)) << name;
+  }
+  EXPECT_TRUE(HasArg(graph.get(), "x"));
+  EXPECT_TRUE(HasArg(graph.get(), "out"));
+}
+
+TEST(dead_code_elimination_pass, keep_persistable_and_fetched_vars) {
+  // x -> scale -> (persistable state)
+  // x -> reshape2 -> fetch, XShape is unused
+  // x -> batch_norm -> fetch, the statistics are unused
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("state", {1, 4});
+  AddScale(&helper, "x", "state");
+  helper
+      .AddOp("reshape2",
+             {{"X", {"x"}}},
+             {{"Out", {"reshape_out"}}, {"XShape", {"reshape_xshape"}}})
+      ->SetAttr("shape", std::vector<int>{4, -1});
+  helper.AddFetch("reshape_out", 0);
+  AddBatchNorm(&helper, "x", "bn_out");
+  helper.AddFetch("bn_out", 1);
+
+  auto graph = ApplyPass(&helper);
+  for (auto* type : {"scale", "reshape2", "batch_norm"}) {
+    EXPECT_TRUE(PassTestHelper::FindOp(graph.get(), type)) << type;
+  }
+  for (auto* name : {"state", "reshape_out", "bn_out", "bn_mean", "fetch"}) {
+    EXPECT_TRUE(HasArg(graph.get(), name)) << name;
+  }
+  for (auto* name :
+       {"reshape_xshape", "bn_saved_mean", "bn_saved_variance"}) {
+    EXPECT_FALSE(HasArg(graph.get(), name)) << name;
+  }
+
+  auto* reshape = PassTestHelper::FindOp(graph.get(), "reshape2")
+                      ->AsStmt()
+                      .op_info();
+  EXPECT_FALSE(reshape->HasOutput("XShape"));
+  auto* batch_norm = PassTestHelper::FindOp(graph.get(), "batch_norm")
+                         ->AsStmt()
+                         .op_info();
+  EXPECT_TRUE(batch_norm->HasOutput("MeanOut"));
+  EXPECT_TRUE(batch_norm->HasOutput("VarianceOut"));
+  EXPECT_FALSE(batch_norm->HasOutput("SavedMean"));
+  EXPECT_FALSE(batch_norm->HasOutput("SavedVariance"));
+}
+
+TEST(dead_code_elimination_pass, skip_programs_without_fetch) {
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddScale(&helper, "x", "out");
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_EQ(PassTestHelper::OpTypes(graph.get()),
+            (std::vector<std::string>{"feed", "scale"}));
+  EXPECT_TRUE(HasArg(graph.get(), "out"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
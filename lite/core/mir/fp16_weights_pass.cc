@@ -0,0 +1,90 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass.h"
+#include "lite/core/mir/pass_registry.h"
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/math/fp16.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * FP16WeightsPass stores the weights of some X86 kernels in half precision, it
+ * halves the model size and the memory bandwidth of the weights. The kernels
+ * convert the weights back to float inside their inner loops, see
+ * `lite/backends/x86/math/fp16.h`.
+ *
+ * It is not in the default pass list, and is run by the Predictor if
+ * `CxxConfig::set_fp16_weights` is set.
+ */
+class FP16WeightsPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+#ifdef LITE_WITH_X86
+    // The op types whose X86 kernel accepts FP16 weights, and the argument of
+    // the weights.
+    const std::map<std::string, std::string> weight_args{
+        {"fc", "W"},
+        {"mul", "Y"},
+        {"conv2d", "Filter"},
+        {"lookup_table", "W"},
+        {"lookup_table_v2", "W"}};
+    for (auto& node : graph->mutable_nodes()) {
+      if (!node.IsStmt()) continue;
+      auto& inst = node.AsStmt();
+      if (inst.picked_kernel().target() != TARGET(kX86)) continue;
+      auto it = weight_args.find(inst.op_type());
+      if (it == weight_args.end()) continue;
+      auto arg_names = inst.op_info()->Input(it->second);
+      CHECK_EQ(arg_names.size(), 1UL);
+      for (auto* in : node.inlinks) {
+        if (!in->IsArg() || in->AsArg().name != arg_names.front()) continue;
+        // Skip the weights shared by other ops, which may not support FP16.
+        if (!in->AsArg().is_weight || in->outlinks.size() != 1) continue;
+        ConvertToFP16(inst.op()->scope(), in->AsArg().name);
+      }
+    }
+#endif
+  }
+
+ private:
+#ifdef LITE_WITH_X86
+  void ConvertToFP16(Scope* scope, const std::string& name) {
+    auto* tensor = scope->FindVar(name)->GetMutable<Tensor>();
+    if (tensor->precision() != PRECISION(kFloat)) return;
+    Tensor fp16;
+    fp16.Resize(tensor->dims());
+    lite::x86::math::fp32_to_fp16(
+        tensor->data<float>(), fp16.mutable_data<uint16_t>(), tensor->numel());
+    *fp16.mutable_lod() = tensor->lod();
+    tensor->ShareDataWith(fp16);
+    tensor->set_precision(PRECISION(kFP16));
+    VLOG(4) << "store weight " << name << " in FP16";
+  }
+#endif
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(fp16_weights_pass, paddle::lite::mir::FP16WeightsPass)
+    .BindTargets({TARGET(kX86)});
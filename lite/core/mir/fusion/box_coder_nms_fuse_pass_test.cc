@@ -0,0 +1,159 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/mir/fusion/box_coder_nms_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kHost), PRECISION(kFloat)}};
+
+// box_coder(prior_box, [prior_box_var], target_box) -> multiclass_nms
+cpp::OpDesc* AddBoxCoder(PassTestHelper* helper,
+                         bool with_prior_box_var,
+                         const std::string& code_type,
+                         int axis) {
+  helper->AddWeight("prior_box", {8, 4});
+  std::map<std::string, std::vector<std::string>> inputs{
+      {"PriorBox", {"prior_box"}}, {"TargetBox", {"target_box"}}};
+  if (with_prior_box_var) {
+    helper->AddWeight("prior_box_var", {8, 4});
+    inputs["PriorBoxVar"] = {"prior_box_var"};
+  }
+  auto* op =
+      helper->AddOp("box_coder", inputs, {{"OutputBox", {"decoded_box"}}});
+  op->SetAttr("code_type", code_type);
+  op->SetAttr("box_normalized", false);
+  op->SetAttr("axis", axis);
+  if (!with_prior_box_var) {
+    op->SetAttr("variance", std::vector<float>{0.1f, 0.1f, 0.2f, 0.2f});
+  }
+  return op;
+}
+
+cpp::OpDesc* AddNms(PassTestHelper* helper) {
+  auto* op = helper->AddOp("multiclass_nms",
+                           {{"BBoxes", {"decoded_box"}}, {"Scores", {"scores"}}},
+                           {{"Out", {"out"}}});
+  op->SetAttr("background_label", 0);
+  op->SetAttr("keep_top_k", 100);
+  op->SetAttr("nms_top_k", 400);
+  op->SetAttr("score_threshold", 0.01f);
+  op->SetAttr("nms_threshold", 0.45f);
+  op->SetAttr("nms_eta", 1.f);
+  op->SetAttr("normalized", false);
+  return op;
+}
+
+void BuildProgram(PassTestHelper* helper,
+                  bool with_prior_box_var,
+                  const std::string& code_type = "decode_center_size",
+                  int axis = 0) {
+  helper->AddFeed("target_box", 0);
+  helper->AddFeed("scores", 1);
+  AddBoxCoder(helper, with_prior_box_var, code_type, axis);
+  AddNms(helper);
+  helper->AddFetch("out", 0);
+}
+
+std::unique_ptr<SSAGraph> ApplyPass(PassTestHelper* helper) {
+  auto graph = helper->BuildGraph(kPlaces);
+  BoxCoderNmsFusePass pass;
+  pass.Apply(graph);
+  return graph;
+}
+
+}  // namespace
+
+TEST(box_coder_nms_fuse_pass, with_prior_box_var) {
+  PassTestHelper helper;
+  BuildProgram(&helper, true);
+  auto graph = ApplyPass(&helper);
+  EXPECT_EQ(PassTestHelper::OpTypes(graph.get()),
+            (std::vector<std::string>{
+                "feed", "feed", "fusion_box_coder_nms", "fetch"}));
+  auto* op_info = PassTestHelper::FindOp(graph.get(), "fusion_box_coder_nms")
+                      ->AsStmt()
+                      .op_info();
+  EXPECT_EQ(op_info->Input("PriorBox"), std::vector<std::string>{"prior_box"});
+  EXPECT_EQ(op_info->Input("PriorBoxVar"),
+            std::vector<std::string>{"prior_box_var"});
+  EXPECT_EQ(op_info->Input("TargetBox"),
+            std::vector<std::string>{"target_box"});
+  EXPECT_EQ(op_info->Input("Scores"), std::vector<std::string>{"scores"});
+  EXPECT_EQ(op_info->Output("Out"), std::vector<std::string>{"out"});
+  EXPECT_FALSE(op_info->GetAttr<bool>("box_normalized"));
+  EXPECT_EQ(op_info->GetAttr<int>("keep_top_k"), 100);
+  EXPECT_EQ(op_info->GetAttr<int>("nms_top_k"), 400);
+  EXPECT_FLOAT_EQ(op_info->GetAttr<float>("nms_threshold"), 0.45f);
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) EXPECT_NE(node.AsArg().name, "decoded_box");
+  }
+}
+
+TEST(box_coder_nms_fuse_pass, with_variance) {
+  PassTestHelper helper;
+  BuildProgram(&helper, false);
+  auto graph = ApplyPass(&helper);
+  auto* node = PassTestHelper::FindOp(graph.get(), "fusion_box_coder_nms");
+  ASSERT_TRUE(node);
+  EXPECT_FALSE(PassTestHelper::FindOp(graph.get(), "box_coder"));
+  EXPECT_FALSE(PassTestHelper::FindOp(graph.get(), "multiclass_nms"));
+  auto* op_info = node->AsStmt().op_info();
+  EXPECT_FALSE(op_info->HasInput("PriorBoxVar") &&
+               !op_info->Input("PriorBoxVar").empty());
+  EXPECT_EQ(op_info->GetAttr<std::vector<float>>("variance"),
+            (std::vector<float>{0.1f, 0.1f, 0.2f, 0.2f}));
+}
+
+TEST(box_coder_nms_fuse_pass, reject_other_box_coders) {
+  // Only decode_center_size with the priors indexed by the columns is fused.
+  for (auto& box_coder : std::vector<std::pair<std::string, int>>{
+           {"encode_center_size", 0}, {"decode_center_size", 1}}) {
+    PassTestHelper helper;
+    BuildProgram(&helper, true, box_coder.first, box_coder.second);
+    auto graph = ApplyPass(&helper);
+    EXPECT_EQ(PassTestHelper::OpTypes(graph.get()),
+              (std::vector<std::string>{
+                  "feed", "feed", "box_coder", "multiclass_nms", "fetch"}))
+        << box_coder.first << " axis " << box_coder.second;
+  }
+}
+
+TEST(box_coder_nms_fuse_pass, keep_the_used_decoded_boxes) {
+  // The decoded boxes are also fetched, so box_coder must stay.
+  PassTestHelper helper;
+  BuildProgram(&helper, true);
+  helper.AddFetch("decoded_box", 1);
+  auto graph = ApplyPass(&helper);
+  EXPECT_TRUE(PassTestHelper::FindOp(graph.get(), "box_coder"));
+  EXPECT_TRUE(PassTestHelper::FindOp(graph.get(), "multiclass_nms"));
+  EXPECT_FALSE(PassTestHelper::FindOp(graph.get(), "fusion_box_coder_nms"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
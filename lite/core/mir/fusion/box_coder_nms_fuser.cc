@@ -0,0 +1,110 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/box_coder_nms_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void BoxCoderNmsFuser::BuildPattern() {
+  // create input nodes.
+  auto* prior_box = VarNode("prior_box")
+                        ->assert_is_op_input("box_coder", "PriorBox")
+                        ->AsInput();
+  auto* target_box = VarNode("target_box")
+                         ->assert_is_op_input("box_coder", "TargetBox")
+                         ->AsInput();
+  auto* scores = VarNode("scores")
+                     ->assert_is_op_input("multiclass_nms", "Scores")
+                     ->AsInput();
+
+  // create op nodes
+  auto* box_coder =
+      OpNode("box_coder", "box_coder")
+          ->assert_op_attr<std::string>("code_type", "decode_center_size")
+          ->assert_op_attr<int>("axis", 0)
+          ->AsIntermediate();
+  auto* nms = OpNode("nms", "multiclass_nms")->AsIntermediate();
+
+  // create intermediate nodes
+  auto* decoded_box = VarNode("decoded_box")
+                          ->assert_is_op_output("box_coder", "OutputBox")
+                          ->assert_is_op_input("multiclass_nms", "BBoxes")
+                          ->AsIntermediate();
+  // create output node
+  auto* out =
+      VarNode("out")->assert_is_op_output("multiclass_nms", "Out")->AsOutput();
+
+  // create topology.
+  std::vector<PMNode*> box_coder_inputs{prior_box, target_box};
+  if (has_prior_box_var_) {
+    auto* prior_box_var = VarNode("prior_box_var")
+                              ->assert_is_op_input("box_coder", "PriorBoxVar")
+                              ->AsInput();
+    box_coder_inputs.push_back(prior_box_var);
+  }
+  std::vector<PMNode*> nms_inputs{decoded_box, scores};
+  box_coder_inputs >> *box_coder >> *decoded_box;
+  nms_inputs >> *nms >> *out;
+}
+
+void BoxCoderNmsFuser::InsertNewNode(SSAGraph* graph,
+                                     const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fusion_box_coder_nms");
+  auto nms = matched.at("nms")->stmt()->op();
+  auto* scope = nms->scope();
+  auto& valid_places = nms->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("prior_box"), new_op_node);
+  if (has_prior_box_var_) {
+    IR_NODE_LINK_TO(matched.at("prior_box_var"), new_op_node);
+  }
+  IR_NODE_LINK_TO(matched.at("target_box"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("scores"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc BoxCoderNmsFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* box_coder_desc = matched.at("box_coder")->stmt()->op_info();
+  cpp::OpDesc op_desc = *matched.at("nms")->stmt()->op_info();
+  op_desc.SetType("fusion_box_coder_nms");
+  op_desc.SetInput("PriorBox", {matched.at("prior_box")->arg()->name});
+  if (has_prior_box_var_) {
+    op_desc.SetInput("PriorBoxVar",
+                     {matched.at("prior_box_var")->arg()->name});
+  }
+  op_desc.SetInput("TargetBox", {matched.at("target_box")->arg()->name});
+  op_desc.SetInput("BBoxes", {});
+  op_desc.SetAttr("box_normalized",
+                  box_coder_desc->GetAttr<bool>("box_normalized"));
+  if (box_coder_desc->HasAttr("variance")) {
+    op_desc.SetAttr(
+        "variance",
+        box_coder_desc->GetAttr<std::vector<float>>("variance"));
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -17,6 +17,7 @@
 #include <vector>
 #include "lite/core/mir/fusion/conv_activation_fuser.h"
 #include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
 
 namespace paddle {
 namespace lite {
@@ -24,16 +25,31 @@ namespace mir {
 
 void ConvActivationFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   std::vector<std::string> act_types{"relu"};
-  for (auto& place : graph->valid_places()) {
-    if (place.target == TARGET(kCUDA)) {
-      act_types.push_back("leaky_relu");
-      break;
+  bool float_only = false;
+  if (PlacesOnCpuOnly(graph->valid_places())) {
+    // The float CPU kernels apply the other activations in the GEMM epilogue,
+    // the int8 ones only fuse relu.
+    act_types.insert(act_types.end(),
+                     {"relu6",
+                      "leaky_relu",
+                      "sigmoid",
+                      "swish",
+                      "hard_sigmoid",
+                      "hard_swish"});
+    float_only = true;
+  } else {
+    for (auto& place : graph->valid_places()) {
+      if (place.target == TARGET(kCUDA)) {
+        act_types.push_back("leaky_relu");
+        break;
+      }
     }
   }
   for (auto conv_type : {"conv2d", "depthwise_conv2d"}) {
     for (auto act_type : act_types) {
       for (auto has_bias : {true, false}) {
-        fusion::ConvActivationFuser fuser(conv_type, act_type, has_bias);
+        fusion::ConvActivationFuser fuser(
+            conv_type, act_type, has_bias, float_only && act_type != "relu");
         fuser(graph.get());
       }
     }
@@ -14,6 +14,7 @@
 
 #include "lite/core/mir/fusion/conv_activation_fuser.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace paddle {
@@ -32,6 +33,13 @@ void ConvActivationFuser::BuildPattern() {
     bias = VarNode("bias")->assert_is_op_input(conv_type_, "Bias")->AsInput();
   }
   auto* conv2d = OpNode("conv2d", conv_type_)->AsIntermediate();
+  if (float_only_) {
+    conv2d->assert_more([](const Node* node) {
+      auto* op_info = node->stmt()->op_info();
+      return !op_info->HasAttr("enable_int8") ||
+             !op_info->GetAttr<bool>("enable_int8");
+    });
+  }
 
   auto* act = OpNode("act", act_type_)->AsIntermediate();
 
@@ -79,13 +87,34 @@ cpp::OpDesc ConvActivationFuser::GenOpDesc(const key2nodes_t& matched) {
   op_desc.SetAttr("act_type", act_type_);
   if (act_type_ == "relu") {
     op_desc.SetAttr("fuse_relu", true);
-  } else if (act_type_ == "leaky_relu") {
-    float alpha = act_op_desc.GetAttr<float>("alpha");
-    op_desc.SetAttr("leaky_relu_alpha", alpha);
   }
+  SetFusedActivationAttrs(act_type_, act_op_desc, &op_desc);
   return op_desc;
 }
 
+void SetFusedActivationAttrs(const std::string& act_type,
+                             const cpp::OpDesc& act_desc,
+                             cpp::OpDesc* op_desc) {
+  // The attrs left out of the activation take the defaults of its op.
+  auto attr_or = [&](const std::string& name, float value) {
+    return act_desc.HasAttr(name) ? act_desc.GetAttr<float>(name) : value;
+  };
+  if (act_type == "leaky_relu") {
+    op_desc->SetAttr("leaky_relu_alpha", act_desc.GetAttr<float>("alpha"));
+  } else if (act_type == "relu6") {
+    op_desc->SetAttr("relu6_threshold", attr_or("threshold", 6.f));
+  } else if (act_type == "swish") {
+    op_desc->SetAttr("swish_beta", attr_or("beta", 1.f));
+  } else if (act_type == "hard_sigmoid") {
+    op_desc->SetAttr("hard_sigmoid_slope", attr_or("slope", 0.2f));
+    op_desc->SetAttr("hard_sigmoid_offset", attr_or("offset", 0.5f));
+  } else if (act_type == "hard_swish") {
+    op_desc->SetAttr("hard_swish_threshold", attr_or("threshold", 6.f));
+    op_desc->SetAttr("hard_swish_scale", attr_or("scale", 6.f));
+    op_desc->SetAttr("hard_swish_offset", attr_or("offset", 3.f));
+  }
+}
+
 }  // namespace fusion
 }  // namespace mir
 }  // namespace lite
@@ -23,14 +23,24 @@ namespace lite {
 namespace mir {
 namespace fusion {
 
+// Copy the coefficients of the activation `act_desc` to the attrs of the op
+// fused with it, such as "relu6_threshold" and "hard_swish_offset".
+void SetFusedActivationAttrs(const std::string& act_type,
+                             const cpp::OpDesc& act_desc,
+                             cpp::OpDesc* op_desc);
+
 class ConvActivationFuser : public FuseBase {
  public:
+  // The activations which only the float convs implement are fused with
+  // `float_only` set, so that the int8 convs are left out.
   explicit ConvActivationFuser(const std::string& conv_type,
                                const std::string& act_type,
-                               bool has_bias) {
+                               bool has_bias,
+                               bool float_only = false) {
     conv_type_ = conv_type;
     act_type_ = act_type;
     has_bias_ = has_bias;
+    float_only_ = float_only;
   }
 
   void BuildPattern() override;
@@ -41,6 +51,7 @@ class ConvActivationFuser : public FuseBase {
   std::string conv_type_;
   std::string act_type_;
   bool has_bias_;
+  bool float_only_;
 };
 
 }  // namespace fusion
@@ -14,9 +14,11 @@
 
 #include "lite/core/mir/fusion/elementwise_add_activation_fuse_pass.h"
 #include <memory>
+#include <string>
 #include <vector>
 #include "lite/core/mir/fusion/elementwise_add_activation_fuser.h"
 #include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
 
 namespace paddle {
 namespace lite {
@@ -24,8 +26,21 @@ namespace mir {
 
 void ElementwiseAddActivationFusePass::Apply(
     const std::unique_ptr<SSAGraph>& graph) {
-  fusion::ElementwiseAddActivationFuser fuser("relu");
-  fuser(graph.get());
+  std::vector<std::string> act_types{"relu"};
+  if (PlacesOnCpuOnly(graph->valid_places())) {
+    // The ARM kernel applies the other activations to each block of the sum.
+    act_types.insert(act_types.end(),
+                     {"relu6",
+                      "leaky_relu",
+                      "sigmoid",
+                      "swish",
+                      "hard_sigmoid",
+                      "hard_swish"});
+  }
+  for (const auto& act_type : act_types) {
+    fusion::ElementwiseAddActivationFuser fuser(act_type);
+    fuser(graph.get());
+  }
 }
 
 }  // namespace mir
@@ -15,6 +15,7 @@
 #include "lite/core/mir/fusion/elementwise_add_activation_fuser.h"
 #include <memory>
 #include <vector>
+#include "lite/core/mir/fusion/conv_activation_fuser.h"
 
 namespace paddle {
 namespace lite {
@@ -78,6 +79,14 @@ cpp::OpDesc ElementwiseAddActivationFuser::GenOpDesc(
 
   op_desc.SetAttr("axis", desc->GetAttr<int>("axis"));
   op_desc.SetAttr("act_type", act_type_);
+  SetFusedActivationAttrs(
+      act_type_, *matched.at("act")->stmt()->op_info(), &op_desc);
+  // Keep the scales of the quantized inputs.
+  for (auto* scale : {"x_input_scale", "y_input_scale"}) {
+    if (desc->HasAttr(scale)) {
+      op_desc.SetAttr(scale, desc->GetAttr<float>(scale));
+    }
+  }
   return op_desc;
 }
 
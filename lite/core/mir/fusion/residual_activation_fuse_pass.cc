@@ -0,0 +1,61 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/mir/fusion/residual_activation_fuse_pass.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/fusion/residual_activation_fuser.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void ResidualActivationFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (!PlacesOnCpuOnly(graph->valid_places())) return;
+  // The longer patterns go first, so that the activation is not left out.
+  const std::vector<std::string> act_types{
+      "relu", "relu6", "leaky_relu", "sigmoid", ""};
+  // The conv ops also take the coefficients of these activations.
+  std::vector<std::string> conv_act_types{
+      "swish", "hard_sigmoid", "hard_swish"};
+  conv_act_types.insert(
+      conv_act_types.end(), act_types.begin(), act_types.end());
+  for (auto op_type : {"conv2d", "depthwise_conv2d", "fc"}) {
+    const bool is_fc = std::string(op_type) == "fc";
+    for (const auto& act_type : is_fc ? act_types : conv_act_types) {
+      for (auto residual_arg : {"X", "Y"}) {
+        fusion::ResidualActivationFuser fuser(op_type, residual_arg, act_type);
+        fuser(graph.get());
+      }
+    }
+  }
+  // The conv activations alone are fused by lite_conv_activation_fuse_pass.
+  for (const auto& act_type : act_types) {
+    if (act_type.empty()) continue;
+    fusion::ResidualActivationFuser fuser("fc", "", act_type);
+    fuser(graph.get());
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_residual_activation_fuse_pass,
+                  paddle::lite::mir::ResidualActivationFusePass)
+    .BindTargets({TARGET(kAny)});
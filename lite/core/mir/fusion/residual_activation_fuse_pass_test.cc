@@ -0,0 +1,162 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/residual_activation_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kX86), PRECISION(kFloat)}};
+
+void AddResidualAdd(PassTestHelper* helper,
+                    const std::string& x,
+                    const std::string& y,
+                    const std::string& out) {
+  helper->AddOp("elementwise_add", {{"X", {x}}, {"Y", {y}}}, {{"Out", {out}}})
+      ->SetAttr("axis", -1);
+}
+
+std::vector<std::string> ApplyPass(PassTestHelper* helper) {
+  auto graph = helper->BuildGraph(kPlaces);
+  ResidualActivationFusePass pass;
+  pass.Apply(graph);
+  return PassTestHelper::OpTypes(graph.get());
+}
+
+}  // namespace
+
+TEST(residual_activation_fuse_pass, conv_residual_relu) {
+  // relu(conv3x3(x) + x)
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("w", {4, 4, 3, 3});
+  helper.AddConv2D("x", "w", "conv_out", 1, 1);
+  AddResidualAdd(&helper, "conv_out", "x", "add_out");
+  helper.AddOp("relu", {{"X", {"add_out"}}}, {{"Out", {"relu_out"}}});
+  helper.AddFetch("relu_out", 0);
+
+  auto graph = helper.BuildGraph(kPlaces);
+  ResidualActivationFusePass pass;
+  pass.Apply(graph);
+  EXPECT_EQ(PassTestHelper::OpTypes(graph.get()),
+            (std::vector<std::string>{"feed", "conv2d", "fetch"}));
+  auto* conv = PassTestHelper::FindOp(graph.get(), "conv2d");
+  auto* op_info = conv->AsStmt().op_info();
+  EXPECT_EQ(op_info->Input("ResidualData"), std::vector<std::string>{"x"});
+  EXPECT_EQ(op_info->Output("Output"), std::vector<std::string>{"relu_out"});
+  EXPECT_TRUE(op_info->GetAttr<bool>("with_act"));
+  EXPECT_EQ(op_info->GetAttr<std::string>("act_type"), "relu");
+}
+
+TEST(residual_activation_fuse_pass, bottleneck) {
+  // The shortcut of a ResNet bottleneck, the channels are changed and
+  // restored by the 1x1 convs.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("w0", {2, 8, 1, 1});
+  helper.AddWeight("w1", {2, 2, 3, 3});
+  helper.AddWeight("w2", {8, 2, 1, 1});
+  helper.AddConv2D("x", "w0", "conv0_out");
+  helper.AddOp("relu", {{"X", {"conv0_out"}}}, {{"Out", {"relu0_out"}}});
+  helper.AddConv2D("relu0_out", "w1", "conv1_out", 1, 1);
+  helper.AddOp("relu", {{"X", {"conv1_out"}}}, {{"Out", {"relu1_out"}}});
+  helper.AddConv2D("relu1_out", "w2", "conv2_out");
+  AddResidualAdd(&helper, "x", "conv2_out", "add_out");
+  helper.AddFetch("add_out", 0);
+
+  EXPECT_EQ(ApplyPass(&helper),
+            (std::vector<std::string>{
+                "feed", "conv2d", "relu", "conv2d", "relu", "conv2d", "fetch"}));
+}
+
+TEST(residual_activation_fuse_pass, reject_other_shapes) {
+  // A strided conv, a conv changing the channels, and an input not derived
+  // from the residual, whose shapes may differ from the residual.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddFeed("y", 1);
+  helper.AddWeight("w0", {4, 4, 3, 3});
+  helper.AddWeight("w1", {8, 4, 1, 1});
+  helper.AddWeight("w2", {4, 4, 1, 1});
+  helper.AddConv2D("x", "w0", "conv0_out", 2, 1);
+  AddResidualAdd(&helper, "conv0_out", "x", "add0_out");
+  helper.AddConv2D("x", "w1", "conv1_out");
+  AddResidualAdd(&helper, "conv1_out", "x", "add1_out");
+  helper.AddConv2D("y", "w2", "conv2_out");
+  AddResidualAdd(&helper, "conv2_out", "x", "add2_out");
+  helper.AddFetch("add0_out", 0);
+  helper.AddFetch("add1_out", 1);
+  helper.AddFetch("add2_out", 2);
+
+  auto op_types = ApplyPass(&helper);
+  EXPECT_EQ(std::count(op_types.begin(), op_types.end(), "elementwise_add"),
+            3);
+}
+
+TEST(residual_activation_fuse_pass, fc) {
+  // sigmoid(fc(x) + x) and fc(x) + fc(x), and a single fc -> relu.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("w0", {16, 16});
+  helper.AddWeight("w1", {16, 8});
+  helper.AddWeight("w2", {16, 8});
+  helper.AddWeight("w3", {16, 4});
+  helper.AddFc("x", "w0", "fc0_out");
+  AddResidualAdd(&helper, "x", "fc0_out", "add0_out");
+  helper.AddOp("sigmoid", {{"X", {"add0_out"}}}, {{"Out", {"sigmoid_out"}}});
+  helper.AddFc("x", "w1", "fc1_out");
+  helper.AddFc("x", "w2", "fc2_out");
+  AddResidualAdd(&helper, "fc1_out", "fc2_out", "add1_out");
+  helper.AddFc("x", "w3", "fc3_out");
+  helper.AddOp("relu", {{"X", {"fc3_out"}}}, {{"Out", {"relu_out"}}});
+  helper.AddFetch("sigmoid_out", 0);
+  helper.AddFetch("add1_out", 1);
+  helper.AddFetch("relu_out", 2);
+
+  auto graph = helper.BuildGraph(kPlaces);
+  ResidualActivationFusePass pass;
+  pass.Apply(graph);
+  for (auto& op_type : PassTestHelper::OpTypes(graph.get())) {
+    EXPECT_TRUE(op_type == "feed" || op_type == "fc" || op_type == "fetch")
+        << op_type << " is not fused";
+  }
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    if (op_info->Type() != "fc") continue;
+    const auto out = op_info->Output("Out").front();
+    if (out == "sigmoid_out") {
+      EXPECT_EQ(op_info->Input("ResidualData"), std::vector<std::string>{"x"});
+      EXPECT_EQ(op_info->GetAttr<std::string>("activation_type"), "sigmoid");
+    } else if (out == "relu_out") {
+      EXPECT_FALSE(op_info->HasInput("ResidualData"));
+      EXPECT_EQ(op_info->GetAttr<std::string>("activation_type"), "relu");
+    } else if (out == "add1_out") {
+      EXPECT_EQ(op_info->Input("ResidualData").size(), 1UL);
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
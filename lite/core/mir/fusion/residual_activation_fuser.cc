@@ -0,0 +1,265 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/residual_activation_fuser.h"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/fusion/conv_activation_fuser.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+// The op is in float, and has no residual or activation fused yet.
+bool IsUnfusedFloatOp(const Node* node) {
+  if (!node->IsStmt()) return false;
+  auto* op_info = node->stmt()->op_info();
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return false;
+  }
+  if (op_info->HasInput("ResidualData") &&
+      !op_info->Input("ResidualData").empty()) {
+    return false;
+  }
+  if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act")) {
+    return false;
+  }
+  return !op_info->HasAttr("activation_type") ||
+         op_info->GetAttr<std::string>("activation_type").empty();
+}
+
+Node* FindInput(const Node* op_node, const std::string& arg) {
+  auto* op_info = op_node->stmt()->op_info();
+  if (!op_info->HasInput(arg) || op_info->Input(arg).empty()) return nullptr;
+  const auto name = op_info->Input(arg).front();
+  for (auto* in : op_node->inlinks) {
+    if (in->IsArg() && in->arg()->name == name) return in;
+  }
+  return nullptr;
+}
+
+const Tensor* FindWeight(const Node* op_node, const std::string& arg) {
+  auto* in = FindInput(op_node, arg);
+  if (!in || !in->arg()->is_weight) return nullptr;
+  auto* var = op_node->stmt()->op()->scope()->FindVar(in->arg()->name);
+  return var ? &var->Get<Tensor>() : nullptr;
+}
+
+// The conv keeps the height and width of its input.
+bool KeepsSpatialDims(const OpInfo& op_info, const DDim& filter_dims) {
+  auto strides = op_info.GetAttr<std::vector<int>>("strides");
+  auto paddings = op_info.GetAttr<std::vector<int>>("paddings");
+  auto dilations = op_info.GetAttr<std::vector<int>>("dilations");
+  if (strides.size() != 2 || dilations.size() != 2) return false;
+  if (strides[0] != 1 || strides[1] != 1) return false;
+  if (op_info.HasAttr("padding_algorithm")) {
+    auto algorithm = op_info.GetAttr<std::string>("padding_algorithm");
+    if (algorithm == "SAME") return true;
+    if (algorithm == "VALID") paddings.assign(2, 0);
+  }
+  for (int i = 0; i < 2; ++i) {
+    int pad = paddings.size() == 4 ? paddings[2 * i] + paddings[2 * i + 1]
+                                   : 2 * paddings[i];
+    if (pad != dilations[i] * (filter_dims[2 + i] - 1)) return false;
+  }
+  return true;
+}
+
+// The shape of an activation relative to the activation `root` it is
+// derived from, through the ops keeping the shape and the convs (or fcs)
+// changing only the channels (or the columns).
+struct ShapeTrace {
+  const Node* root{nullptr};
+  // "conv" or "fc" if the channels are changed on the way.
+  std::string channel_op;
+  // The output channels of the last conv and the input channels of the
+  // first one, -1 if there is no conv.
+  int64_t channels{-1};
+  int64_t root_channels{-1};
+  int in_num_col_dims{-1};
+};
+
+ShapeTrace TraceShape(const Node* var) {
+  static const std::set<std::string> kShapeKeepingOps{
+      "relu", "relu6", "leaky_relu", "sigmoid", "tanh", "swish", "scale",
+      "dropout", "batch_norm"};
+  ShapeTrace trace;
+  while (var->inlinks.size() == 1 && var->inlinks.front()->IsStmt()) {
+    auto* op_node = var->inlinks.front();
+    const auto op_type = op_node->stmt()->op_type();
+    auto* op_info = op_node->stmt()->op_info();
+    Node* in = nullptr;
+    if (kShapeKeepingOps.count(op_type)) {
+      in = FindInput(op_node, "X");
+    } else if (op_type == "elementwise_add" || op_type == "elementwise_mul") {
+      // Only the bias or the scale of the channels keeps the shape.
+      if (FindWeight(op_node, "Y")) in = FindInput(op_node, "X");
+    } else if (op_type == "conv2d" || op_type == "depthwise_conv2d" ||
+               op_type == "fc") {
+      const std::string channel_op = op_type == "fc" ? "fc" : "conv";
+      if (!trace.channel_op.empty() && trace.channel_op != channel_op) break;
+      auto* weight = FindWeight(op_node, channel_op == "fc" ? "W" : "Filter");
+      if (!weight) break;
+      auto dims = weight->dims();
+      if (channel_op == "fc") {
+        int in_num_col_dims = op_info->GetAttr<int>("in_num_col_dims");
+        if (dims.size() != 2 || (trace.in_num_col_dims >= 0 &&
+                                 trace.in_num_col_dims != in_num_col_dims)) {
+          break;
+        }
+        trace.in_num_col_dims = in_num_col_dims;
+        if (trace.channels < 0) trace.channels = dims[1];
+        trace.root_channels = dims[0];
+      } else {
+        if (dims.size() != 4 || !KeepsSpatialDims(*op_info, dims)) break;
+        if (trace.channels < 0) trace.channels = dims[0];
+        trace.root_channels = dims[1] * op_info->GetAttr<int>("groups");
+      }
+      trace.channel_op = channel_op;
+      in = FindInput(op_node, "Input");
+    }
+    if (!in) break;
+    var = in;
+  }
+  trace.root = var;
+  return trace;
+}
+
+// The inputs of the elementwise_add have the same shape, as the kernels add
+// the residual element by element in the epilogue. The shapes of the
+// activations are mostly not known before the InferShape, then they must be
+// derived from the same activation with the same channels.
+bool HasSameShapeInputs(const Node* add) {
+  auto* x = FindInput(add, "X");
+  auto* y = FindInput(add, "Y");
+  if (!x || !y) return false;
+  auto* scope = add->stmt()->op()->scope();
+  auto* x_var = scope->FindVar(x->arg()->name);
+  auto* y_var = scope->FindVar(y->arg()->name);
+  if (x_var && y_var && x_var->IsType<Tensor>() && y_var->IsType<Tensor>()) {
+    auto x_dims = x_var->Get<Tensor>().dims();
+    auto y_dims = y_var->Get<Tensor>().dims();
+    if (x_dims.size() > 0 && y_dims.size() > 0) return x_dims == y_dims;
+  }
+
+  auto x_trace = TraceShape(x);
+  auto y_trace = TraceShape(y);
+  if (x_trace.root != y_trace.root) return false;
+  if (x_trace.channel_op.empty() && y_trace.channel_op.empty()) return true;
+  if (!x_trace.channel_op.empty() && !y_trace.channel_op.empty()) {
+    return x_trace.channel_op == y_trace.channel_op &&
+           x_trace.in_num_col_dims == y_trace.in_num_col_dims &&
+           x_trace.channels == y_trace.channels;
+  }
+  // One of them is the root itself, as in the shortcut of a ResNet block.
+  const auto& trace = x_trace.channel_op.empty() ? y_trace : x_trace;
+  return trace.channels == trace.root_channels;
+}
+
+}  // namespace
+
+void ResidualActivationFuser::BuildPattern() {
+  const std::string out_arg = op_type_ == "fc" ? "Out" : "Output";
+  auto* op = OpNode("op", op_type_)
+                 ->assert_is_op(op_type_)
+                 ->assert_more(IsUnfusedFloatOp);
+  auto* op_out = VarNode("op_out")->assert_is_op_output(op_type_, out_arg);
+  *op >> *op_out;
+
+  PMNode* last_out = op_out;
+  if (!residual_arg_.empty()) {
+    const std::string op_out_arg = residual_arg_ == "X" ? "Y" : "X";
+    op_out->assert_is_op_input("elementwise_add", op_out_arg);
+    // The broadcast adds of the bias have a persistable Y, and an axis other
+    // than -1.
+    auto* residual = VarNode("residual")
+                         ->assert_is_op_input("elementwise_add", residual_arg_)
+                         ->assert_var_not_persistable()
+                         ->AsInput();
+    auto* add = OpNode("add", "elementwise_add")
+                    ->assert_is_op("elementwise_add")
+                    ->assert_op_attr<int>("axis", -1)
+                    ->assert_more(HasSameShapeInputs)
+                    ->AsIntermediate();
+    auto* add_out =
+        VarNode("add_out")->assert_is_op_output("elementwise_add", "Out");
+    std::vector<PMNode*> add_inputs{op_out, residual};
+    add_inputs >> *add >> *add_out;
+    op_out->AsIntermediate();
+    last_out = add_out;
+  }
+  if (!act_type_.empty()) {
+    last_out->assert_is_op_input(act_type_, "X")->AsIntermediate();
+    auto* act = OpNode("act", act_type_)->AsIntermediate();
+    auto* act_out = VarNode("act_out")->assert_is_op_output(act_type_, "Out");
+    *last_out >> *act >> *act_out;
+    last_out = act_out;
+  }
+  last_out->AsOutput();
+}
+
+void ResidualActivationFuser::InsertNewNode(SSAGraph* graph,
+                                            const key2nodes_t& matched) {
+  auto* op_node = matched.at("op");
+  auto* stmt = op_node->stmt();
+  stmt->ResetOp(GenOpDesc(matched), stmt->op()->valid_places());
+
+  if (!residual_arg_.empty()) {
+    // The residual may already be an input of the op, as in conv(x) + x.
+    auto* residual = matched.at("residual");
+    if (std::find(op_node->inlinks.begin(),
+                  op_node->inlinks.end(),
+                  residual) == op_node->inlinks.end()) {
+      IR_NODE_LINK_TO(residual, op_node);
+    }
+  }
+  auto* out = act_type_.empty() ? matched.at("add_out") : matched.at("act_out");
+  IR_OP_VAR_LINK(op_node, out);
+}
+
+cpp::OpDesc ResidualActivationFuser::GenOpDesc(const key2nodes_t& matched) {
+  cpp::OpDesc op_desc = *matched.at("op")->stmt()->op_info();
+  const bool is_fc = op_type_ == "fc";
+  auto* out = act_type_.empty() ? matched.at("add_out") : matched.at("act_out");
+  op_desc.SetOutput(is_fc ? "Out" : "Output", {out->arg()->name});
+  if (!residual_arg_.empty()) {
+    op_desc.SetInput("ResidualData", {matched.at("residual")->arg()->name});
+  }
+  if (act_type_.empty()) return op_desc;
+
+  auto* act_desc = matched.at("act")->stmt()->op_info();
+  if (is_fc) {
+    op_desc.SetAttr("activation_type", act_type_);
+  } else {
+    op_desc.SetAttr("with_act", true);
+    op_desc.SetAttr("act_type", act_type_);
+    if (act_type_ == "relu") {
+      op_desc.SetAttr("fuse_relu", true);
+    }
+  }
+  SetFusedActivationAttrs(act_type_, *act_desc, &op_desc);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,55 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Fuse the elementwise_add of the output of a conv or fc and another tensor
+// of the same shape, the shortcut of a residual block, and the activation
+// after it if act_type is not empty:
+//   out = act(op(input) + residual)
+// The residual becomes the input "ResidualData" of the op, whose kernels add
+// it in the epilogue of their GEMM. `residual_arg` is the input of the
+// elementwise_add taking the residual, "X" or "Y"; it is empty to only fuse
+// the activation into fc.
+class ResidualActivationFuser : public FuseBase {
+ public:
+  ResidualActivationFuser(const std::string& op_type,
+                          const std::string& residual_arg,
+                          const std::string& act_type)
+      : op_type_(op_type), residual_arg_(residual_arg), act_type_(act_type) {}
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string op_type_;
+  std::string residual_arg_;
+  std::string act_type_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/squeeze_excitation_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/mir/fusion/squeeze_excitation_fuser.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void SqueezeExcitationFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The fused kernel runs on the host.
+  if (!PlacesOnCpuOnly(graph->valid_places())) return;
+  for (auto op_type : {"conv2d", "fc"}) {
+    for (auto squeeze_act_type :
+         {"relu", "relu6", "leaky_relu", "swish", "hard_swish"}) {
+      for (auto excite_act_type : {"sigmoid", "hard_sigmoid"}) {
+        fusion::SqueezeExcitationFuser fuser(
+            op_type, squeeze_act_type, excite_act_type);
+        fuser(graph.get());
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_squeeze_excitation_fuse_pass,
+                  paddle::lite::mir::SqueezeExcitationFusePass)
+    .BindTargets({TARGET(kAny)});
@@ -0,0 +1,207 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/mir/fusion/squeeze_excitation_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kHost), PRECISION(kFloat)}};
+
+struct BlockOptions {
+  std::string op_type{"conv2d"};
+  std::string squeeze_act_type{"relu"};
+  std::string excite_act_type{"sigmoid"};
+  std::string pooling_type{"avg"};
+  int filter_size{1};
+  int padding{0};
+  // Set on the squeeze op only, the excite one is still fusible.
+  bool squeeze_int8{false};
+  bool squeeze_with_act{false};
+};
+
+// Adds the squeeze conv2d or fc, and returns it.
+cpp::OpDesc* AddSqueezeOp(PassTestHelper* helper,
+                          const BlockOptions& options,
+                          const std::string& input,
+                          const std::string& prefix,
+                          int in_channels,
+                          int out_channels) {
+  const std::string weight = prefix + "_w";
+  const std::string bias = prefix + "_b";
+  const std::string output = prefix + "_out";
+  helper->AddWeight(bias, {out_channels});
+  cpp::OpDesc* op = nullptr;
+  if (options.op_type == "conv2d") {
+    helper->AddWeight(weight,
+                      {out_channels,
+                       in_channels,
+                       options.filter_size,
+                       options.filter_size});
+    op = helper->AddConv2D(input, weight, output, 1, options.padding);
+  } else {
+    helper->AddWeight(weight, {in_channels, out_channels});
+    op = helper->AddFc(input, weight, output);
+  }
+  op->SetInput("Bias", {bias});
+  return op;
+}
+
+// x -> pool2d -> squeeze -> act -> excite -> act -> elementwise_mul(x, gate)
+void BuildProgram(PassTestHelper* helper, const BlockOptions& options) {
+  helper->AddFeed("x", 0);
+  helper->AddPool2D("x", "pool_out", options.pooling_type, true);
+  auto* squeeze = AddSqueezeOp(helper, options, "pool_out", "squeeze", 8, 2);
+  if (options.squeeze_int8) {
+    squeeze->SetAttr("enable_int8", true);
+    squeeze->SetAttr("input_scale", 0.1f);
+    squeeze->SetAttr("weight_scale", std::vector<float>(2, 0.01f));
+  }
+  if (options.squeeze_with_act) {
+    squeeze->SetAttr("with_act", true);
+    squeeze->SetAttr("act_type", std::string("relu"));
+  }
+  helper->AddOp(options.squeeze_act_type,
+                {{"X", {"squeeze_out"}}},
+                {{"Out", {"squeeze_act_out"}}});
+  AddSqueezeOp(helper, options, "squeeze_act_out", "excite", 2, 8);
+  auto* excite_act = helper->AddOp(options.excite_act_type,
+                                   {{"X", {"excite_out"}}},
+                                   {{"Out", {"gate"}}});
+  if (options.excite_act_type == "hard_sigmoid") {
+    excite_act->SetAttr("slope", 0.2f);
+    excite_act->SetAttr("offset", 0.5f);
+  }
+  helper
+      ->AddOp("elementwise_mul",
+              {{"X", {"x"}}, {"Y", {"gate"}}},
+              {{"Out", {"out"}}})
+      ->SetAttr("axis", 0);
+  helper->AddFetch("out", 0);
+}
+
+std::unique_ptr<SSAGraph> ApplyPass(PassTestHelper* helper) {
+  auto graph = helper->BuildGraph(kPlaces);
+  SqueezeExcitationFusePass pass;
+  pass.Apply(graph);
+  return graph;
+}
+
+void ExpectFused(SSAGraph* graph, const BlockOptions& options) {
+  EXPECT_EQ(PassTestHelper::OpTypes(graph),
+            (std::vector<std::string>{
+                "feed", "fusion_squeeze_excitation", "fetch"}));
+  auto* op_info =
+      PassTestHelper::FindOp(graph, "fusion_squeeze_excitation")
+          ->AsStmt()
+          .op_info();
+  EXPECT_EQ(op_info->Input("X"), std::vector<std::string>{"x"});
+  EXPECT_EQ(op_info->Input("SqueezeWeight"),
+            std::vector<std::string>{"squeeze_w"});
+  EXPECT_EQ(op_info->Input("SqueezeBias"),
+            std::vector<std::string>{"squeeze_b"});
+  EXPECT_EQ(op_info->Input("ExciteWeight"),
+            std::vector<std::string>{"excite_w"});
+  EXPECT_EQ(op_info->Input("ExciteBias"), std::vector<std::string>{"excite_b"});
+  EXPECT_EQ(op_info->Output("Out"), std::vector<std::string>{"out"});
+  EXPECT_EQ(op_info->GetAttr<bool>("conv_weight"),
+            options.op_type == "conv2d");
+  EXPECT_EQ(op_info->GetAttr<std::string>("squeeze_act_type"),
+            options.squeeze_act_type);
+  EXPECT_EQ(op_info->GetAttr<std::string>("excite_act_type"),
+            options.excite_act_type);
+}
+
+void ExpectNotFused(SSAGraph* graph, const std::string& message) {
+  EXPECT_FALSE(PassTestHelper::FindOp(graph, "fusion_squeeze_excitation"))
+      << message;
+  EXPECT_TRUE(PassTestHelper::FindOp(graph, "pool2d")) << message;
+  EXPECT_TRUE(PassTestHelper::FindOp(graph, "elementwise_mul")) << message;
+}
+
+}  // namespace
+
+TEST(squeeze_excitation_fuse_pass, conv) {
+  BlockOptions options;
+  PassTestHelper helper;
+  BuildProgram(&helper, options);
+  auto graph = ApplyPass(&helper);
+  ExpectFused(graph.get(), options);
+}
+
+TEST(squeeze_excitation_fuse_pass, fc) {
+  BlockOptions options;
+  options.op_type = "fc";
+  options.squeeze_act_type = "hard_swish";
+  options.excite_act_type = "hard_sigmoid";
+  PassTestHelper helper;
+  BuildProgram(&helper, options);
+  auto graph = ApplyPass(&helper);
+  ExpectFused(graph.get(), options);
+}
+
+TEST(squeeze_excitation_fuse_pass, reject_int8_and_fused_act) {
+  BlockOptions int8;
+  int8.squeeze_int8 = true;
+  BlockOptions with_act;
+  with_act.squeeze_with_act = true;
+  for (auto& options : {int8, with_act}) {
+    PassTestHelper helper;
+    BuildProgram(&helper, options);
+    auto graph = ApplyPass(&helper);
+    ExpectNotFused(graph.get(),
+                   options.squeeze_int8 ? "int8" : "with_act");
+  }
+}
+
+TEST(squeeze_excitation_fuse_pass, reject_other_convs) {
+  BlockOptions filter_3x3;
+  filter_3x3.filter_size = 3;
+  BlockOptions padded;
+  padded.padding = 1;
+  for (auto& options : {filter_3x3, padded}) {
+    PassTestHelper helper;
+    BuildProgram(&helper, options);
+    auto graph = ApplyPass(&helper);
+    ExpectNotFused(graph.get(),
+                   "filter " + std::to_string(options.filter_size) +
+                       " padding " + std::to_string(options.padding));
+  }
+}
+
+TEST(squeeze_excitation_fuse_pass, reject_max_pool) {
+  for (auto* op_type : {"conv2d", "fc"}) {
+    BlockOptions options;
+    options.op_type = op_type;
+    options.pooling_type = "max";
+    PassTestHelper helper;
+    BuildProgram(&helper, options);
+    auto graph = ApplyPass(&helper);
+    ExpectNotFused(graph.get(), op_type);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
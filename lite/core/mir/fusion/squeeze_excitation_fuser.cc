@@ -0,0 +1,214 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/fusion/squeeze_excitation_fuser.h"
+#include <memory>
+#include <vector>
+#include "lite/core/mir/fusion/conv_activation_fuser.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+bool IsInt8(const OpInfo* op_info) {
+  return op_info->HasAttr("enable_int8") &&
+         op_info->GetAttr<bool>("enable_int8");
+}
+
+// The pooling reduces each channel to its mean.
+bool IsGlobalAvgPool(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (IsInt8(op_info) ||
+      op_info->GetAttr<std::string>("pooling_type") != "avg") {
+    return false;
+  }
+  if (op_info->GetAttr<bool>("global_pooling")) return true;
+  return op_info->HasAttr("adaptive") && op_info->GetAttr<bool>("adaptive") &&
+         op_info->GetAttr<std::vector<int>>("ksize") == std::vector<int>{1, 1};
+}
+
+// The conv is a matrix-vector product on the pooled 1x1 input.
+bool IsPointwiseConv(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (IsInt8(op_info) || op_info->GetAttr<int>("groups") != 1) return false;
+  if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act")) {
+    return false;
+  }
+  for (int padding : op_info->GetAttr<std::vector<int>>("paddings")) {
+    if (padding != 0) return false;
+  }
+  auto* scope = node->stmt()->op()->scope();
+  auto* filter = scope->FindVar(op_info->Input("Filter").front());
+  if (filter == nullptr) return false;
+  auto filter_dims = filter->Get<lite::Tensor>().dims();
+  return filter_dims.size() == 4 && filter_dims[2] == 1 && filter_dims[3] == 1;
+}
+
+// The fc is in float, and takes the pooled [N, C, 1, 1] as [N, C].
+bool IsFloatFc(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (IsInt8(op_info) || op_info->GetAttr<int>("in_num_col_dims") != 1) {
+    return false;
+  }
+  if (op_info->HasAttr("weight_only_quant_bits") &&
+      op_info->GetAttr<int>("weight_only_quant_bits") != 0) {
+    return false;
+  }
+  return !op_info->HasAttr("activation_type") ||
+         op_info->GetAttr<std::string>("activation_type").empty();
+}
+
+}  // namespace
+
+void SqueezeExcitationFuser::BuildPattern() {
+  const bool is_conv = op_type_ == "conv2d";
+  const std::string weight_arg = is_conv ? "Filter" : "W";
+  const std::string out_arg = is_conv ? "Output" : "Out";
+  auto op_teller = is_conv ? IsPointwiseConv : IsFloatFc;
+
+  // create input nodes.
+  auto* input = VarNode("input")
+                    ->assert_is_op_input("pool2d", "X")
+                    ->assert_is_op_input("elementwise_mul", "X")
+                    ->AsInput();
+  auto* squeeze_weight = VarNode("squeeze_weight")
+                             ->assert_is_op_input(op_type_, weight_arg)
+                             ->AsInput();
+  auto* squeeze_bias =
+      VarNode("squeeze_bias")->assert_is_op_input(op_type_, "Bias")->AsInput();
+  auto* excite_weight = VarNode("excite_weight")
+                            ->assert_is_op_input(op_type_, weight_arg)
+                            ->AsInput();
+  auto* excite_bias =
+      VarNode("excite_bias")->assert_is_op_input(op_type_, "Bias")->AsInput();
+
+  // create op nodes
+  auto* pool = OpNode("pool", "pool2d")
+                   ->assert_is_op("pool2d")
+                   ->assert_more(IsGlobalAvgPool)
+                   ->AsIntermediate();
+  auto* squeeze = OpNode("squeeze", op_type_)
+                      ->assert_is_op(op_type_)
+                      ->assert_more(op_teller)
+                      ->AsIntermediate();
+  auto* squeeze_act = OpNode("squeeze_act", squeeze_act_type_)
+                          ->assert_is_op(squeeze_act_type_)
+                          ->AsIntermediate();
+  auto* excite = OpNode("excite", op_type_)
+                     ->assert_is_op(op_type_)
+                     ->assert_more(op_teller)
+                     ->AsIntermediate();
+  auto* excite_act = OpNode("excite_act", excite_act_type_)
+                         ->assert_is_op(excite_act_type_)
+                         ->AsIntermediate();
+  // The gate is [N, C, 1, 1] after the convs, and [N, C] after the fcs.
+  auto* scale = OpNode("scale", "elementwise_mul")
+                    ->assert_is_op("elementwise_mul")
+                    ->assert_op_attr_satisfied<int>(
+                        "axis",
+                        [=](const int& axis) {
+                          return axis == 0 || (is_conv && axis == -1);
+                        })
+                    ->AsIntermediate();
+
+  // create intermediate nodes
+  auto* pool_out = VarNode("pool_out")
+                       ->assert_is_op_output("pool2d", "Out")
+                       ->assert_is_op_input(op_type_, "Input")
+                       ->AsIntermediate();
+  auto* squeeze_out = VarNode("squeeze_out")
+                          ->assert_is_op_output(op_type_, out_arg)
+                          ->assert_is_op_input(squeeze_act_type_, "X")
+                          ->AsIntermediate();
+  auto* squeeze_act_out = VarNode("squeeze_act_out")
+                              ->assert_is_op_output(squeeze_act_type_, "Out")
+                              ->assert_is_op_input(op_type_, "Input")
+                              ->AsIntermediate();
+  auto* excite_out = VarNode("excite_out")
+                         ->assert_is_op_output(op_type_, out_arg)
+                         ->assert_is_op_input(excite_act_type_, "X")
+                         ->AsIntermediate();
+  auto* gate = VarNode("gate")
+                   ->assert_is_op_output(excite_act_type_, "Out")
+                   ->assert_is_op_input("elementwise_mul", "Y")
+                   ->AsIntermediate();
+
+  // create output node
+  auto* out =
+      VarNode("out")->assert_is_op_output("elementwise_mul", "Out")->AsOutput();
+
+  // create topology.
+  std::vector<PMNode*> squeeze_inputs{pool_out, squeeze_weight, squeeze_bias};
+  std::vector<PMNode*> excite_inputs{
+      squeeze_act_out, excite_weight, excite_bias};
+  std::vector<PMNode*> scale_inputs{input, gate};
+  *input >> *pool >> *pool_out;
+  squeeze_inputs >> *squeeze >> *squeeze_out;
+  *squeeze_out >> *squeeze_act >> *squeeze_act_out;
+  excite_inputs >> *excite >> *excite_out;
+  *excite_out >> *excite_act >> *gate;
+  scale_inputs >> *scale >> *out;
+}
+
+void SqueezeExcitationFuser::InsertNewNode(SSAGraph* graph,
+                                           const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fusion_squeeze_excitation");
+  auto squeeze = matched.at("squeeze")->stmt()->op();
+  auto* scope = squeeze->scope();
+  auto& valid_places = squeeze->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  for (auto* name : {"input",
+                     "squeeze_weight",
+                     "squeeze_bias",
+                     "excite_weight",
+                     "excite_bias"}) {
+    IR_NODE_LINK_TO(matched.at(name), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc SqueezeExcitationFuser::GenOpDesc(const key2nodes_t& matched) {
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_squeeze_excitation");
+  op_desc.SetInput("X", {matched.at("input")->arg()->name});
+  op_desc.SetInput("SqueezeWeight",
+                   {matched.at("squeeze_weight")->arg()->name});
+  op_desc.SetInput("SqueezeBias", {matched.at("squeeze_bias")->arg()->name});
+  op_desc.SetInput("ExciteWeight", {matched.at("excite_weight")->arg()->name});
+  op_desc.SetInput("ExciteBias", {matched.at("excite_bias")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr("conv_weight", op_type_ == "conv2d");
+  op_desc.SetAttr("squeeze_act_type", squeeze_act_type_);
+  op_desc.SetAttr("excite_act_type", excite_act_type_);
+  // The two activations have different coefficients, see the op.
+  SetFusedActivationAttrs(squeeze_act_type_,
+                          *matched.at("squeeze_act")->stmt()->op_info(),
+                          &op_desc);
+  SetFusedActivationAttrs(excite_act_type_,
+                          *matched.at("excite_act")->stmt()->op_info(),
+                          &op_desc);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
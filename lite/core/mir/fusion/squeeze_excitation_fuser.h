@@ -0,0 +1,52 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Fuses the squeeze-excitation block of MobileNetV3 and EfficientNet:
+//   pool2d (global avg) -> op -> squeeze_act -> op -> excite_act
+//   elementwise_mul(x, gate)
+// into fusion_squeeze_excitation, where op is a 1x1 conv2d or fc with a bias.
+class SqueezeExcitationFuser : public FuseBase {
+ public:
+  explicit SqueezeExcitationFuser(const std::string& op_type,
+                                  const std::string& squeeze_act_type,
+                                  const std::string& excite_act_type)
+      : op_type_(op_type),
+        squeeze_act_type_(squeeze_act_type),
+        excite_act_type_(excite_act_type) {}
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string op_type_;
+  std::string squeeze_act_type_;
+  std::string excite_act_type_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,176 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/int8_propagation_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The ops the int8 can be propagated through, and their int8 inputs. The
+// other inputs, such as the `Shape` of reshape, are not quantized.
+const std::map<std::string, std::vector<std::string>>& Int8InputArgs() {
+  static const std::map<std::string, std::vector<std::string>> args{
+      {"relu", {"X"}},
+      {"pool2d", {"X"}},
+      {"concat", {"X"}},
+      {"elementwise_add", {"X", "Y"}},
+      {"fusion_elementwise_add_activation", {"X", "Y"}},
+      {"reshape", {"X"}},
+      {"reshape2", {"X"}},
+      {"flatten", {"X"}},
+      {"flatten2", {"X"}}};
+  return args;
+}
+
+// The ops whose kernels accept any precision.
+bool IsPrecisionAgnostic(const std::string& op_type) {
+  return op_type == "reshape" || op_type == "reshape2" ||
+         op_type == "flatten" || op_type == "flatten2";
+}
+
+// The ops which requantize their inputs to the output scale.
+bool Requantizes(const std::string& op_type) {
+  return op_type == "pool2d" || op_type == "elementwise_add" ||
+         op_type == "fusion_elementwise_add_activation";
+}
+
+std::vector<Node*> Int8Inputs(Node* node) {
+  auto* op_info = node->AsStmt().op_info();
+  std::vector<Node*> res;
+  for (auto& arg : Int8InputArgs().at(node->AsStmt().op_type())) {
+    if (!op_info->HasInput(arg)) continue;
+    for (auto& name : op_info->Input(arg)) {
+      for (auto* in : node->inlinks) {
+        if (in->AsArg().name == name) res.push_back(in);
+      }
+    }
+  }
+  return res;
+}
+
+Node* OutputNode(Node* node) {
+  auto* op_info = node->AsStmt().op_info();
+  if (!op_info->HasOutput("Out")) return nullptr;
+  auto out_names = op_info->Output("Out");
+  if (out_names.size() != 1) return nullptr;
+  for (auto* out : node->outlinks) {
+    if (out->AsArg().name == out_names.front()) return out;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+bool Int8PropagationPass::IsPropagatable(const SSAGraph& graph,
+                                         Node* node) const {
+  auto& inst = node->AsStmt();
+  const auto& op_type = inst.op_type();
+  if (!Int8InputArgs().count(op_type)) return false;
+  if (inst.op_info()->HasAttr("enable_int8")) return false;
+  if (op_type == "pool2d" && inst.op_info()->HasAttr("adaptive") &&
+      inst.op_info()->GetAttr<bool>("adaptive")) {
+    return false;
+  }
+  // The int8 kernel of the fused add only applies relu.
+  if (op_type == "fusion_elementwise_add_activation" &&
+      inst.op_info()->GetAttr<std::string>("act_type") != "relu") {
+    return false;
+  }
+  if (IsPrecisionAgnostic(op_type)) return true;
+  for (auto& place : graph.valid_places()) {
+    if (place.precision == PRECISION(kInt8) &&
+        KernelRegistered(op_type, place)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Int8PropagationPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  auto nodes = graph->StmtTopologicalOrder();
+
+  // Forward, find the ops whose int8 inputs are all produced by quantized ops
+  // or by the other candidates.
+  std::set<const Node*> candidates;
+  auto is_quantized = [&](Node* op) {
+    return op->AsStmt().op_info()->HasAttr("enable_int8") ||
+           candidates.count(op);
+  };
+  for (auto* node : nodes) {
+    if (!IsPropagatable(*graph, node) || !OutputNode(node)) continue;
+    auto inputs = Int8Inputs(node);
+    bool fed_by_int8 = !inputs.empty();
+    for (auto* in : inputs) {
+      if (in->inlinks.empty() || !is_quantized(in->inlinks.front())) {
+        fed_by_int8 = false;
+        break;
+      }
+    }
+    if (fed_by_int8) candidates.insert(node);
+  }
+
+  // Backward, keep the candidates whose consumers are all quantized, and
+  // propagate the input scale of the consumers. The consumers are visited
+  // first, so a candidate consumer is decided before its producers.
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+    auto* node = *it;
+    if (!candidates.count(node)) continue;
+    auto* out = OutputNode(node);
+    bool all_int8 = !out->outlinks.empty();
+    float scale = 0.f;
+    for (auto* consumer : out->outlinks) {
+      auto* info = consumer->AsStmt().op_info();
+      float consumer_scale;
+      if (!info->HasAttr("enable_int8") ||
+          !info->GetInputScale(out->AsArg().name, &consumer_scale) ||
+          (scale != 0.f && consumer_scale != scale)) {
+        all_int8 = false;
+        break;
+      }
+      scale = consumer_scale;
+    }
+    if (!all_int8) {
+      candidates.erase(node);
+      continue;
+    }
+
+    auto& inst = node->AsStmt();
+    auto* op_info = inst.mutable_op_info();
+    op_info->SetAttr("enable_int8", true);
+    op_info->SetAttr("output_scale", scale);
+    if (!Requantizes(inst.op_type()) || !op_info->HasAttr("input_scale")) {
+      op_info->SetAttr("input_scale", scale);
+    }
+    VLOG(3) << "propagate int8 through " << inst.op_type()
+            << ", output scale " << scale;
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(int8_propagation_pass, paddle::lite::mir::Int8PropagationPass)
+    .BindTargets({TARGET(kARM)});
@@ -0,0 +1,56 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Int8PropagationPass keeps the activations in int8 between the quantized ops.
+ *
+ * A quantized conv2d or fc, with the `enable_int8` attribute, outputs int8
+ * only if all its consumers have `enable_int8` too, see StaticKernelPickPass.
+ * Otherwise it outputs float, and a calib op quantizes the input of the next
+ * quantized op again, see PrecisionCastPass. So a chain such as
+ * conv2d -> relu -> pool2d -> conv2d is dequantized and quantized around the
+ * relu and the pool2d.
+ *
+ * This pass sets `enable_int8` on the relu, pool2d, concat, elementwise_add
+ * and reshape ops which are fed by quantized ops, if all their consumers are
+ * quantized and agree on the input scale. The scale of the output is the
+ * input scale of the consumers, and it is propagated backward:
+ *  - relu, concat and the reshape ops keep the scale of their inputs;
+ *  - pool2d and elementwise_add requantize their inputs if the quantized
+ *    model gives their input scales, see DeleteQuantDequantOpFuser, or keep
+ *    the scale otherwise.
+ */
+class Int8PropagationPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // Whether the int8 can be propagated through the op of `node`.
+  bool IsPropagatable(const SSAGraph& graph, Node* node) const;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
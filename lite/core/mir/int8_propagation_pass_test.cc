@@ -0,0 +1,239 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/mir/int8_propagation_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The int8 is only propagated through the ops which have int8 kernels, so
+// fake ones are registered for the ARM int8 place as the test runs on the
+// host.
+class FakeInt8Compute : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  void Run() override {}
+};
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kARM), PRECISION(kInt8)},
+                                 Place{TARGET(kARM), PRECISION(kFloat)}};
+
+// A quantized conv2d, as given by a quantized model.
+cpp::OpDesc* AddInt8Conv2D(PassTestHelper* helper,
+                           const std::string& input,
+                           const std::string& filter,
+                           const std::string& output,
+                           float input_scale) {
+  helper->AddWeight(filter, {4, 4, 1, 1});
+  auto* op = helper->AddConv2D(input, filter, output);
+  op->SetAttr("enable_int8", true);
+  op->SetAttr("input_scale", input_scale);
+  op->SetAttr("weight_scale", std::vector<float>(4, 0.01f));
+  return op;
+}
+
+void AddRelu(PassTestHelper* helper,
+             const std::string& x,
+             const std::string& out) {
+  helper->AddOp("relu", {{"X", {x}}}, {{"Out", {out}}});
+}
+
+std::unique_ptr<SSAGraph> ApplyPass(PassTestHelper* helper) {
+  auto graph = helper->BuildGraph(kPlaces);
+  Int8PropagationPass pass;
+  pass.Apply(graph);
+  return graph;
+}
+
+const OpInfo* FindOpInfo(SSAGraph* graph, const std::string& type) {
+  auto* node = PassTestHelper::FindOp(graph, type);
+  CHECK(node) << "no op " << type;
+  return node->AsStmt().op_info();
+}
+
+bool IsInt8(SSAGraph* graph, const std::string& type) {
+  return FindOpInfo(graph, type)->HasAttr("enable_int8");
+}
+
+}  // namespace
+
+TEST(int8_propagation_pass, relu_pool) {
+  // conv2d -> relu -> pool2d -> conv2d
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  AddRelu(&helper, "conv0_out", "relu_out");
+  helper.AddPool2D("relu_out", "pool_out", "max", false);
+  AddInt8Conv2D(&helper, "pool_out", "w1", "conv1_out", 0.05f);
+  helper.AddFetch("conv1_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  for (auto type : {"relu", "pool2d"}) {
+    auto* op_info = FindOpInfo(graph.get(), type);
+    ASSERT_TRUE(op_info->HasAttr("enable_int8")) << type;
+    EXPECT_FLOAT_EQ(op_info->GetAttr<float>("input_scale"), 0.05f) << type;
+    EXPECT_FLOAT_EQ(op_info->GetAttr<float>("output_scale"), 0.05f) << type;
+  }
+}
+
+TEST(int8_propagation_pass, concat_reshape) {
+  // conv2d, conv2d -> concat -> reshape2 -> conv2d
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  AddInt8Conv2D(&helper, "x", "w1", "conv1_out", 0.02f);
+  helper
+      .AddOp("concat",
+             {{"X", {"conv0_out", "conv1_out"}}},
+             {{"Out", {"concat_out"}}})
+      ->SetAttr("axis", 1);
+  helper
+      .AddOp("reshape2",
+             {{"X", {"concat_out"}}},
+             {{"Out", {"reshape_out"}}, {"XShape", {"reshape_xshape"}}})
+      ->SetAttr("shape", std::vector<int>{0, 4, -1, 1});
+  AddInt8Conv2D(&helper, "reshape_out", "w2", "conv2_out", 0.1f);
+  helper.AddFetch("conv2_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  for (auto type : {"concat", "reshape2"}) {
+    auto* op_info = FindOpInfo(graph.get(), type);
+    ASSERT_TRUE(op_info->HasAttr("enable_int8")) << type;
+    EXPECT_FLOAT_EQ(op_info->GetAttr<float>("input_scale"), 0.1f) << type;
+    EXPECT_FLOAT_EQ(op_info->GetAttr<float>("output_scale"), 0.1f) << type;
+  }
+}
+
+TEST(int8_propagation_pass, add_requantizes) {
+  // conv2d, conv2d -> elementwise_add -> conv2d, the input scales of the add
+  // are given by the quantized model.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  AddInt8Conv2D(&helper, "x", "w1", "conv1_out", 0.02f);
+  auto* add = helper.AddOp("elementwise_add",
+                           {{"X", {"conv0_out"}}, {"Y", {"conv1_out"}}},
+                           {{"Out", {"add_out"}}});
+  add->SetAttr("axis", -1);
+  add->SetAttr("x_input_scale", 0.03f);
+  add->SetAttr("y_input_scale", 0.04f);
+  AddInt8Conv2D(&helper, "add_out", "w2", "conv2_out", 0.2f);
+  helper.AddFetch("conv2_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  auto* op_info = FindOpInfo(graph.get(), "elementwise_add");
+  ASSERT_TRUE(op_info->HasAttr("enable_int8"));
+  EXPECT_FLOAT_EQ(op_info->GetAttr<float>("output_scale"), 0.2f);
+  float scale = 0.f;
+  ASSERT_TRUE(op_info->GetInputScale("conv0_out", &scale));
+  EXPECT_FLOAT_EQ(scale, 0.03f);
+  ASSERT_TRUE(op_info->GetInputScale("conv1_out", &scale));
+  EXPECT_FLOAT_EQ(scale, 0.04f);
+}
+
+TEST(int8_propagation_pass, stop_at_float_producers) {
+  // feed -> relu -> conv2d, the input of relu is float.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddRelu(&helper, "x", "relu_out");
+  AddInt8Conv2D(&helper, "relu_out", "w0", "conv0_out", 0.02f);
+  helper.AddFetch("conv0_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_FALSE(IsInt8(graph.get(), "relu"));
+}
+
+TEST(int8_propagation_pass, stop_at_float_consumers) {
+  // conv2d -> relu -> pool2d -> fetch, the output of pool2d is float so
+  // neither pool2d nor relu is quantized.
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  AddRelu(&helper, "conv0_out", "relu_out");
+  helper.AddPool2D("relu_out", "pool_out", "avg", false);
+  helper.AddFetch("pool_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_FALSE(IsInt8(graph.get(), "relu"));
+  EXPECT_FALSE(IsInt8(graph.get(), "pool2d"));
+}
+
+TEST(int8_propagation_pass, stop_at_different_scales) {
+  // conv2d -> relu -> conv2d(0.05)
+  //                \-> conv2d(0.07)
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  AddRelu(&helper, "conv0_out", "relu_out");
+  AddInt8Conv2D(&helper, "relu_out", "w1", "conv1_out", 0.05f);
+  AddInt8Conv2D(&helper, "relu_out", "w2", "conv2_out", 0.07f);
+  helper.AddFetch("conv1_out", 0);
+  helper.AddFetch("conv2_out", 1);
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_FALSE(IsInt8(graph.get(), "relu"));
+}
+
+TEST(int8_propagation_pass, stop_at_adaptive_pool) {
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  AddInt8Conv2D(&helper, "x", "w0", "conv0_out", 0.02f);
+  helper.AddPool2D("conv0_out", "pool_out", "avg", false)
+      ->SetAttr("adaptive", true);
+  AddInt8Conv2D(&helper, "pool_out", "w1", "conv1_out", 0.05f);
+  helper.AddFetch("conv1_out", 0);
+
+  auto graph = ApplyPass(&helper);
+  EXPECT_FALSE(IsInt8(graph.get(), "pool2d"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(
+    relu, kARM, kInt8, kNCHW, paddle::lite::mir::FakeInt8Compute, fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+REGISTER_LITE_KERNEL(
+    pool2d, kARM, kInt8, kNCHW, paddle::lite::mir::FakeInt8Compute, fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+REGISTER_LITE_KERNEL(
+    concat, kARM, kInt8, kNCHW, paddle::lite::mir::FakeInt8Compute, fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kARM,
+                     kInt8,
+                     kNCHW,
+                     paddle::lite::mir::FakeInt8Compute,
+                     fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
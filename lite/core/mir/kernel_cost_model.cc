@@ -0,0 +1,149 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/kernel_cost_model.h"
+#include <fstream>
+#include <sstream>
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+// Used for the tensors whose shapes are only known at runtime.
+const int64_t kDefaultNumel = 1 << 14;
+}  // namespace
+
+KernelCostModel::KernelCostModel() {
+  io_copy_.latency = 30.f;
+  io_copy_.latency_per_kelement = 1.f;
+  calib_.latency = 0.5f;
+  calib_.latency_per_kelement = 0.5f;
+  layout_.latency = 0.5f;
+  layout_.latency_per_kelement = 1.f;
+}
+
+float KernelCostModel::LaunchOverhead(TargetType target) const {
+  switch (target) {
+    case TARGET(kCUDA):
+      return 10.f;
+    case TARGET(kOpenCL):
+      return 25.f;
+    case TARGET(kFPGA):
+      return 50.f;
+    default:
+      return 0.2f;
+  }
+}
+
+float KernelCostModel::Throughput(TargetType target,
+                                  PrecisionType precision) const {
+  float elements_per_us{2000.f};
+  switch (target) {
+    case TARGET(kCUDA):
+      elements_per_us = 50000.f;
+      break;
+    case TARGET(kOpenCL):
+    case TARGET(kFPGA):
+      elements_per_us = 20000.f;
+      break;
+    default:
+      break;
+  }
+  if (precision == PRECISION(kInt8)) {
+    elements_per_us *= 2.f;
+  } else if (precision == PRECISION(kFP16)) {
+    elements_per_us *= 1.5f;
+  }
+  return elements_per_us;
+}
+
+int64_t KernelCostModel::ArgNumel(const Node::Stmt& stmt,
+                                  const std::string& name) const {
+  auto* scope = stmt.op()->scope();
+  auto* var = scope ? scope->FindVar(name) : nullptr;
+  if (!var || !var->IsType<lite::Tensor>()) return kDefaultNumel;
+  const auto& dims = var->Get<lite::Tensor>().dims();
+  if (dims.empty() || dims.production() <= 0) return kDefaultNumel;
+  return dims.production();
+}
+
+float KernelCostModel::KernelCost(const Node::Stmt& stmt,
+                                  const KernelBase& kernel) const {
+  auto it = kernel_latency_.find(kernel.SerializedKernelType());
+  if (it != kernel_latency_.end()) return it->second;
+
+  int64_t numel = 0;
+  for (auto& name : stmt.op_info()->input_names()) {
+    numel += ArgNumel(stmt, name);
+  }
+  for (auto& name : stmt.op_info()->output_names()) {
+    numel += ArgNumel(stmt, name);
+  }
+  return LaunchOverhead(kernel.target()) +
+         numel / Throughput(kernel.target(), kernel.precision());
+}
+
+float KernelCostModel::CastCost(const Type& from,
+                                const Type& to,
+                                int64_t numel) const {
+  if (!from.IsTensor() || !to.IsTensor()) return 0.f;
+  float cost{0.f};
+  auto add = [&](const CastCoeff& coeff) {
+    cost += coeff.latency + numel / 1000.f * coeff.latency_per_kelement;
+  };
+  if (!TargetCompatibleTo(from, to)) add(io_copy_);
+  if (!PrecisionCompatibleTo(from, to)) add(calib_);
+  if (!DataLayoutCompatibleTo(from, to)) add(layout_);
+  return cost;
+}
+
+bool KernelCostModel::LoadProfile(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin.is_open()) {
+    LOG(WARNING) << "failed to open the kernel cost profile " << path;
+    return false;
+  }
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream ss(line);
+    std::string key;
+    if (!(ss >> key) || key[0] == '#') continue;
+    CastCoeff* coeff = nullptr;
+    if (key == "io_copy") {
+      coeff = &io_copy_;
+    } else if (key == "calib") {
+      coeff = &calib_;
+    } else if (key == "layout") {
+      coeff = &layout_;
+    }
+    float latency{0.f};
+    CHECK(ss >> latency) << "bad kernel cost profile line: " << line;
+    if (coeff) {
+      coeff->latency = latency;
+      ss >> coeff->latency_per_kelement;
+    } else {
+      kernel_latency_[key] = latency;
+    }
+  }
+  VLOG(3) << "loaded " << kernel_latency_.size() << " kernel latencies from "
+          << path;
+  return true;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
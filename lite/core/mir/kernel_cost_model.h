@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/mir/node.h"
+#include "lite/core/type_system.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * KernelCostModel estimates the latency, in microseconds, of running a
+ * candidate kernel for an op and of the io_copy, calib and layout casts
+ * the type passes insert between two kernels whose argument types differ.
+ *
+ * The default estimates are `launch + elements / throughput` with a launch
+ * overhead and a throughput per target, the elements being the numel of the
+ * op's tensors whose shapes are known at optimization time. Measured
+ * latencies can override them with `LoadProfile`, the profile is a text file
+ * with one entry per line:
+ *
+ *   # <serialized kernel type> <latency in us>
+ *   conv2d/def/4/1/1 812.5
+ *   # <io_copy|calib|layout> <latency in us> <latency per 1k elements in us>
+ *   io_copy 35 1.2
+ *
+ * Derive from it to plug in another model.
+ */
+class KernelCostModel {
+ public:
+  KernelCostModel();
+  virtual ~KernelCostModel() = default;
+
+  // The latency of running `kernel` for the op of `stmt`.
+  virtual float KernelCost(const Node::Stmt& stmt,
+                           const KernelBase& kernel) const;
+  // The latency of passing a tensor of `numel` elements of type `from` to an
+  // argument declared as `to`, 0 if they are compatible.
+  virtual float CastCost(const Type& from, const Type& to, int64_t numel) const;
+
+  // The numel of the tensor `name` in the scope of the op of `stmt`, or a
+  // default numel if its shape is not known yet.
+  int64_t ArgNumel(const Node::Stmt& stmt, const std::string& name) const;
+
+  // Load the measured latencies, returns false if the file can't be read.
+  bool LoadProfile(const std::string& path);
+
+ protected:
+  struct CastCoeff {
+    float latency{0.f};
+    float latency_per_kelement{0.f};
+  };
+
+  // The launch overhead and the elements processed per us of a target.
+  float LaunchOverhead(TargetType target) const;
+  float Throughput(TargetType target, PrecisionType precision) const;
+
+  std::map<std::string, float> kernel_latency_;
+  CastCoeff io_copy_;
+  CastCoeff calib_;
+  CastCoeff layout_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
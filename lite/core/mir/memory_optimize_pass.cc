@@ -53,11 +53,18 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
                                         "graph_op",
                                         "feed",
                                         "fetch"};
+    // The vars which are views of a shared buffer, see BufferViewPass.
+    auto use_buffer_view = [](Node* stmt) -> bool {
+      auto* op_info = stmt->AsStmt().op_info();
+      return op_info->HasAttr("use_buffer_view") &&
+             op_info->GetAttr<bool>("use_buffer_view");
+    };
     for (auto* tmp : node->inlinks) {
       CHECK(tmp->IsStmt());
       std::string op_type = tmp->AsStmt().op_info()->Type();
       if (std::find(invalid_op.begin(), invalid_op.end(), op_type) !=
-          invalid_op.end()) {
+              invalid_op.end() ||
+          use_buffer_view(tmp)) {
         return false;
       }
     }
@@ -65,7 +72,8 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
       CHECK(tmp->IsStmt());
       std::string op_type = tmp->AsStmt().op_info()->Type();
       if (std::find(invalid_op.begin(), invalid_op.end(), op_type) !=
-          invalid_op.end()) {
+              invalid_op.end() ||
+          use_buffer_view(tmp)) {
         return false;
       }
     }
@@ -0,0 +1,182 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/model_parser/cpp/program_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * PassTestHelper builds a small program for the pass tests without a model
+ * file. The weights are created in the scope with their data, the other vars
+ * are declared only.
+ *
+ *   PassTestHelper helper;
+ *   helper.AddFeed("x", 0);
+ *   helper.AddWeight("w", {4, 5}, 0.1f);
+ *   helper.AddOp("mul", {{"X", {"x"}}, {"Y", {"w"}}}, {{"Out", {"out"}}});
+ *   helper.AddFetch("out", 0);
+ *   auto graph = helper.BuildGraph(places);
+ */
+class PassTestHelper {
+ public:
+  using args_t = std::map<std::string, std::vector<std::string>>;
+
+  PassTestHelper() : scope_(std::make_shared<Scope>()) {
+    desc_.AddBlock<cpp::BlockDesc>();
+  }
+
+  // Add a persistable float weight of `dims`, whose i-th value is
+  // start + step * (i % 7 - 3).
+  Tensor* AddWeight(const std::string& name,
+                    const std::vector<int64_t>& dims,
+                    float step = 0.1f,
+                    float start = 0.f) {
+    DeclareVar(name, true);
+    auto* tensor = scope_->Var(name)->GetMutable<Tensor>();
+    tensor->Resize(dims);
+    auto* data = tensor->mutable_data<float>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      data[i] = start + step * (i % 7 - 3);
+    }
+    tensor->set_precision(PRECISION(kFloat));
+    tensor->set_persistable(true);
+    return tensor;
+  }
+
+  // Add an op, the vars of its inputs and outputs are declared if they are
+  // not yet.
+  cpp::OpDesc* AddOp(const std::string& type,
+                     const args_t& inputs,
+                     const args_t& outputs) {
+    for (auto& arg : inputs) {
+      for (auto& name : arg.second) DeclareVar(name, false);
+    }
+    for (auto& arg : outputs) {
+      for (auto& name : arg.second) DeclareVar(name, false);
+    }
+    auto* op = block()->AddOp<cpp::OpDesc>();
+    op->SetType(type);
+    for (auto& arg : inputs) op->SetInput(arg.first, arg.second);
+    for (auto& arg : outputs) op->SetOutput(arg.first, arg.second);
+    return op;
+  }
+
+  cpp::OpDesc* AddConv2D(const std::string& input,
+                         const std::string& filter,
+                         const std::string& output,
+                         int stride = 1,
+                         int padding = 0,
+                         int groups = 1) {
+    auto* op = AddOp("conv2d",
+                     {{"Input", {input}}, {"Filter", {filter}}},
+                     {{"Output", {output}}});
+    op->SetAttr("strides", std::vector<int>{stride, stride});
+    op->SetAttr("paddings", std::vector<int>{padding, padding});
+    op->SetAttr("dilations", std::vector<int>{1, 1});
+    op->SetAttr("groups", groups);
+    return op;
+  }
+
+  cpp::OpDesc* AddPool2D(const std::string& x,
+                         const std::string& out,
+                         const std::string& pooling_type,
+                         bool global_pooling) {
+    auto* op = AddOp("pool2d", {{"X", {x}}}, {{"Out", {out}}});
+    op->SetAttr("pooling_type", pooling_type);
+    op->SetAttr("global_pooling", global_pooling);
+    op->SetAttr("ksize", std::vector<int>{2, 2});
+    op->SetAttr("strides", std::vector<int>{2, 2});
+    op->SetAttr("paddings", std::vector<int>{0, 0});
+    return op;
+  }
+
+  cpp::OpDesc* AddFc(const std::string& input,
+                     const std::string& w,
+                     const std::string& out) {
+    auto* op =
+        AddOp("fc", {{"Input", {input}}, {"W", {w}}}, {{"Out", {out}}});
+    op->SetAttr("in_num_col_dims", 1);
+    return op;
+  }
+
+  void AddFeed(const std::string& out, int col) {
+    DeclareVar("feed", true);
+    AddOp("feed", {{"X", {"feed"}}}, {{"Out", {out}}})->SetAttr("col", col);
+  }
+
+  void AddFetch(const std::string& x, int col) {
+    DeclareVar("fetch", true);
+    AddOp("fetch", {{"X", {x}}}, {{"Out", {"fetch"}}})->SetAttr("col", col);
+  }
+
+  // The first op of `type` in the graph, nullptr if there is none.
+  static Node* FindOp(SSAGraph* graph, const std::string& type) {
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      if (node->AsStmt().op_type() == type) return node;
+    }
+    return nullptr;
+  }
+
+  // The types of the ops of the graph in the topological order.
+  static std::vector<std::string> OpTypes(SSAGraph* graph) {
+    std::vector<std::string> types;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      types.push_back(node->AsStmt().op_type());
+    }
+    return types;
+  }
+
+  std::unique_ptr<SSAGraph> BuildGraph(const std::vector<Place>& places) {
+    Program program(desc_, scope_, places);
+    std::unique_ptr<SSAGraph> graph(new SSAGraph);
+    graph->Build(program, places);
+    graph->SetValidPlaces(places);
+    return graph;
+  }
+
+  const cpp::ProgramDesc& desc() const { return desc_; }
+  const std::shared_ptr<Scope>& scope() const { return scope_; }
+
+ private:
+  cpp::BlockDesc* block() { return desc_.GetBlock<cpp::BlockDesc>(0); }
+
+  void DeclareVar(const std::string& name, bool persistable) {
+    if (!declared_.emplace(name, persistable).second) return;
+    auto* var = block()->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetType(cpp::VarDesc::Type::LOD_TENSOR);
+    var->SetPersistable(persistable);
+  }
+
+  std::shared_ptr<Scope> scope_;
+  cpp::ProgramDesc desc_;
+  std::map<std::string, bool> declared_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -16,6 +16,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -65,5 +66,15 @@ bool PassMatchesKernels(const mir::Pass& pass) {
   return true;
 }
 
+bool PlacesOnCpuOnly(const std::vector<Place>& places) {
+  for (const auto& place : places) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kX86) &&
+        place.target != TARGET(kHost) && place.target != TARGET(kAny)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "lite/core/mir/pass.h"
 
 namespace paddle {
@@ -29,5 +30,9 @@ bool PassMatchesTarget(const mir::Pass& pass, TargetType target);
 // Check if the pass hits all necessary operators.
 bool PassMatchesKernels(const mir::Pass& pass);
 
+// Check if all the places run on the CPU, for the fusions which only the ARM
+// and X86 kernels implement.
+bool PlacesOnCpuOnly(const std::vector<Place>& places);
+
 }  // namespace lite
 }  // namespace paddle
@@ -161,6 +161,12 @@ struct PMNode {
         attr_name, [=](const T& src) { return src == attr; });
   }
 
+  // A condition on the matched node which the helpers above do not cover.
+  PMNode* assert_more(const teller_t& condition) {
+    asserts_.push_back(condition);
+    return this;
+  }
+
  private:
   PMNode(PMPattern* pattern,
          const std::string& name = "",
@@ -0,0 +1,195 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/post_training_quant_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_utils.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The quantized ops, and the arguments of their input and weight.
+const std::map<std::string, std::pair<std::string, std::string>>&
+QuantArgs() {
+  static const std::map<std::string, std::pair<std::string, std::string>>
+      args{{"conv2d", {"Input", "Filter"}},
+           {"depthwise_conv2d", {"Input", "Filter"}},
+           {"fc", {"Input", "W"}},
+           {"mul", {"X", "Y"}}};
+  return args;
+}
+
+bool HasInt8Kernel(const SSAGraph& graph, const std::string& op_type) {
+  for (auto& place : graph.valid_places()) {
+    if (place.precision == PRECISION(kInt8) &&
+        KernelRegistered(op_type, place)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool PostTrainingQuantPass::LoadScales(const std::string& path) {
+  std::ifstream fin(path);
+  if (!fin.is_open()) {
+    LOG(WARNING) << "failed to open the calibration table " << path;
+    return false;
+  }
+  scales_.clear();
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream ss(line);
+    std::string name;
+    if (!(ss >> name) || name[0] == '#') continue;
+    float scale{0.f};
+    CHECK(ss >> scale) << "bad calibration table line: " << line;
+    CHECK_GT(scale, 0.f) << "bad scale of " << name;
+    scales_[name] = scale;
+  }
+  VLOG(3) << "loaded " << scales_.size() << " activation scales from " << path;
+  return true;
+}
+
+void PostTrainingQuantPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (scales_.empty()) return;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& inst = node->AsStmt();
+    if (inst.op_info()->HasAttr("enable_int8")) continue;
+    if (QuantArgs().count(inst.op_type())) {
+      QuantizeOp(graph.get(), node);
+    } else {
+      SetInputScales(node);
+    }
+  }
+}
+
+void PostTrainingQuantPass::QuantizeOp(SSAGraph* graph, Node* node) {
+  auto& inst = node->AsStmt();
+  const auto& op_type = inst.op_type();
+  auto* op_info = inst.op_info();
+  const auto& args = QuantArgs().at(op_type);
+  if (!HasInt8Kernel(*graph, op_type)) return;
+  auto input_name = op_info->Input(args.first).front();
+  auto scale_it = scales_.find(input_name);
+  if (scale_it == scales_.end()) return;
+  if (op_type == "mul" && op_info->GetAttr<int>("y_num_col_dims") != 1) {
+    return;
+  }
+  // The int8 kernels fuse relu, but not the residual add nor the other
+  // activations of lite_residual_activation_fuse_pass.
+  if (op_info->HasInput("ResidualData") &&
+      !op_info->Input("ResidualData").empty()) {
+    return;
+  }
+  if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act") &&
+      op_info->GetAttr<std::string>("act_type") != "relu") {
+    return;
+  }
+  if (op_info->HasAttr("activation_type") &&
+      !op_info->GetAttr<std::string>("activation_type").empty()) {
+    return;
+  }
+
+  auto weight_name = op_info->Input(args.second).front();
+  Node* weight_arg = nullptr;
+  for (auto* in : node->inlinks) {
+    if (in->IsArg() && in->AsArg().name == weight_name) weight_arg = in;
+  }
+  // Skip the weights shared by other ops, which may run in float.
+  if (!weight_arg || !weight_arg->AsArg().is_weight ||
+      weight_arg->outlinks.size() != 1) {
+    return;
+  }
+  auto* scope = inst.op()->scope();
+  auto* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+  if (weight->precision() != PRECISION(kFloat)) return;
+
+  // The conv weights of shape [Cout, Cin, kh, kw] are quantized per output
+  // channel, and the fc/mul weights of shape [K, N] per output column.
+  const bool is_conv = args.second == "Filter";
+  if (weight->dims().size() != (is_conv ? 4 : 2)) return;
+  const int64_t num = weight->numel();
+  const int64_t channels = is_conv ? weight->dims()[0] : weight->dims()[1];
+  const int64_t inner = is_conv ? num / channels : 1;
+  auto channel_of = [&](int64_t i) {
+    return is_conv ? i / inner : i % channels;
+  };
+  const float* weight_data = weight->data<float>();
+  std::vector<float> weight_scale(channels, 0.f);
+  for (int64_t i = 0; i < num; ++i) {
+    auto& max = weight_scale[channel_of(i)];
+    max = std::max(max, std::fabs(weight_data[i]));
+  }
+  for (auto& scale : weight_scale) {
+    scale = scale > 0.f ? scale / 127.f : 1.f;
+  }
+  Tensor quant;
+  quant.Resize(weight->dims());
+  auto* quant_data = quant.mutable_data<int8_t>();
+  for (int64_t i = 0; i < num; ++i) {
+    float q = std::round(weight_data[i] / weight_scale[channel_of(i)]);
+    quant_data[i] = static_cast<int8_t>(std::min(std::max(q, -127.f), 127.f));
+  }
+  weight->ShareDataWith(quant);
+  weight->set_persistable(true);
+  weight->set_precision(PRECISION(kInt8));
+
+  auto updated_op_info = *op_info;
+  updated_op_info.SetAttr("enable_int8", true);
+  updated_op_info.SetAttr("input_scale", scale_it->second);
+  updated_op_info.SetAttr("weight_scale", weight_scale);
+  inst.ResetOp(updated_op_info, graph->valid_places());
+  VLOG(4) << "quantize " << op_type << " of input " << input_name
+          << ", input scale " << scale_it->second;
+}
+
+void PostTrainingQuantPass::SetInputScales(Node* node) {
+  auto& inst = node->AsStmt();
+  const auto& op_type = inst.op_type();
+  auto* op_info = inst.mutable_op_info();
+  auto set_scale = [&](const std::string& arg, const std::string& attr) {
+    if (!op_info->HasInput(arg) || op_info->HasAttr(attr)) return;
+    auto it = scales_.find(op_info->Input(arg).front());
+    if (it != scales_.end()) op_info->SetAttr(attr, it->second);
+  };
+  if (op_type == "pool2d") {
+    set_scale("X", "input_scale");
+  } else if (op_type == "elementwise_add" ||
+             op_type == "fusion_elementwise_add_activation") {
+    set_scale("X", "x_input_scale");
+    set_scale("Y", "y_input_scale");
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(post_training_quant_pass,
+                  paddle::lite::mir::PostTrainingQuantPass)
+    .BindTargets({TARGET(kARM)});
@@ -0,0 +1,71 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * PostTrainingQuantPass quantizes a float model with the activation scales
+ * collected by running it over a calibration dataset, see
+ * `lite/api/calibrator.h`, so that no quantization aware training is needed.
+ *
+ * The conv2d, depthwise_conv2d, fc and mul ops which have int8 kernels are
+ * set `enable_int8`, with the `input_scale` of their input and the weights
+ * quantized to int8 with a scale per output channel, as the
+ * DequantOpFuser does for the quantized models. The pool2d and
+ * elementwise_add ops get the scales of their inputs too, so that the
+ * Int8PropagationPass can requantize them.
+ *
+ * The scales are loaded from a calibration table, a text file with one
+ * activation per line:
+ *
+ *   # <var name> <scale>
+ *   conv2d_0.tmp_1 0.0157
+ *
+ * where `scale` is the threshold of the activation divided by 127.
+ *
+ * It does nothing if no scale is set, the Predictor sets them if
+ * `CxxConfig::set_calibration_table` is set.
+ */
+class PostTrainingQuantPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetScales(const std::map<std::string, float>& scales) {
+    scales_ = scales;
+  }
+  // Load the scales of a calibration table, returns false if the file can't
+  // be read.
+  bool LoadScales(const std::string& path);
+
+ private:
+  // Quantize the op of `node` if its input has a scale.
+  void QuantizeOp(SSAGraph* graph, Node* node);
+  // Set the input scales of the ops the int8 is propagated through.
+  void SetInputScales(Node* node);
+
+  std::map<std::string, float> scales_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,203 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/post_training_quant_pass.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The pass only quantizes the ops which have int8 kernels, so fake ones are
+// registered for the ARM int8 place as the test runs on the host.
+class FakeInt8Compute : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  void Run() override {}
+};
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kARM), PRECISION(kInt8)},
+                                 Place{TARGET(kARM), PRECISION(kFloat)}};
+
+// conv2d -> pool2d -> elementwise_add -> fc(sigmoid)
+//        \-> conv2d(w1, no scale) -^
+// and two conv2d sharing a filter.
+void BuildProgram(PassTestHelper* helper) {
+  helper->AddFeed("x", 0);
+  helper->AddWeight("w0", {4, 3, 1, 1}, 0.1f, 0.05f);
+  helper->AddWeight("w1", {4, 4, 1, 1});
+  helper->AddWeight("w_shared", {4, 3, 1, 1});
+  helper->AddWeight("w_fc", {16, 2});
+  helper->AddConv2D("x", "w0", "conv0_out");
+  helper->AddPool2D("conv0_out", "pool_out", "max", false);
+  helper->AddConv2D("conv0_out", "w1", "conv1_out", 2);
+  helper->AddOp("elementwise_add",
+                {{"X", {"pool_out"}}, {"Y", {"conv1_out"}}},
+                {{"Out", {"add_out"}}})
+      ->SetAttr("axis", -1);
+  helper->AddFc("add_out", "w_fc", "fc_out")
+      ->SetAttr<std::string>("activation_type", "sigmoid");
+  helper->AddConv2D("x", "w_shared", "shared0_out");
+  helper->AddConv2D("x", "w_shared", "shared1_out");
+  helper->AddFetch("fc_out", 0);
+  helper->AddFetch("shared0_out", 1);
+  helper->AddFetch("shared1_out", 2);
+}
+
+std::vector<Node*> FindOps(SSAGraph* graph, const std::string& type) {
+  std::vector<Node*> nodes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (node->AsStmt().op_type() == type) nodes.push_back(node);
+  }
+  return nodes;
+}
+
+}  // namespace
+
+TEST(post_training_quant_pass, quantize) {
+  PassTestHelper helper;
+  BuildProgram(&helper);
+  auto graph = helper.BuildGraph(kPlaces);
+
+  PostTrainingQuantPass pass;
+  pass.SetScales({{"x", 0.02f},
+                  {"conv0_out", 0.03f},
+                  {"pool_out", 0.04f},
+                  {"conv1_out", 0.05f},
+                  {"add_out", 0.06f}});
+  pass.Apply(graph);
+
+  auto convs = FindOps(graph.get(), "conv2d");
+  ASSERT_EQ(convs.size(), 4u);
+  const OpInfo* conv0 = nullptr;
+  const OpInfo* conv1 = nullptr;
+  for (auto* node : convs) {
+    auto* info = node->AsStmt().op_info();
+    auto filter = info->Input("Filter").front();
+    if (filter == "w0") conv0 = info;
+    if (filter == "w1") conv1 = info;
+    // The shared filter stays in float.
+    if (filter == "w_shared") EXPECT_FALSE(info->HasAttr("enable_int8"));
+  }
+  ASSERT_TRUE(conv0 && conv1);
+
+  ASSERT_TRUE(conv0->HasAttr("enable_int8"));
+  EXPECT_FLOAT_EQ(conv0->GetAttr<float>("input_scale"), 0.02f);
+  auto weight_scale = conv0->GetAttr<std::vector<float>>("weight_scale");
+  ASSERT_EQ(weight_scale.size(), 4u);
+  auto* w0 = helper.scope()->FindVar("w0")->GetMutable<Tensor>();
+  EXPECT_EQ(w0->precision(), PRECISION(kInt8));
+  // The values of w0 are 0.05 + 0.1 * (i % 7 - 3), the first channel holds
+  // i = 0..2 of which -0.25 is the max abs value.
+  EXPECT_FLOAT_EQ(weight_scale[0], 0.25f / 127.f);
+  const int8_t* w0_data = w0->data<int8_t>();
+  EXPECT_EQ(w0_data[0], -127);
+  EXPECT_EQ(w0_data[1], static_cast<int8_t>(std::round(-0.15f / 0.25f * 127)));
+
+  ASSERT_TRUE(conv1->HasAttr("enable_int8"));
+  EXPECT_FLOAT_EQ(conv1->GetAttr<float>("input_scale"), 0.03f);
+
+  auto* pool = PassTestHelper::FindOp(graph.get(), "pool2d");
+  ASSERT_TRUE(pool);
+  EXPECT_FLOAT_EQ(pool->AsStmt().op_info()->GetAttr<float>("input_scale"),
+                  0.03f);
+  auto* add = PassTestHelper::FindOp(graph.get(), "elementwise_add");
+  ASSERT_TRUE(add);
+  EXPECT_FLOAT_EQ(add->AsStmt().op_info()->GetAttr<float>("x_input_scale"),
+                  0.04f);
+  EXPECT_FLOAT_EQ(add->AsStmt().op_info()->GetAttr<float>("y_input_scale"),
+                  0.05f);
+
+  // The int8 fc doesn't fuse sigmoid.
+  auto* fc = PassTestHelper::FindOp(graph.get(), "fc");
+  ASSERT_TRUE(fc);
+  EXPECT_FALSE(fc->AsStmt().op_info()->HasAttr("enable_int8"));
+  EXPECT_EQ(helper.scope()->FindVar("w_fc")->Get<Tensor>().precision(),
+            PRECISION(kFloat));
+}
+
+TEST(post_training_quant_pass, skip_the_ops_without_scale) {
+  PassTestHelper helper;
+  BuildProgram(&helper);
+  auto graph = helper.BuildGraph(kPlaces);
+
+  PostTrainingQuantPass pass;
+  pass.SetScales({{"conv0_out", 0.03f}});
+  pass.Apply(graph);
+
+  for (auto* node : FindOps(graph.get(), "conv2d")) {
+    auto* info = node->AsStmt().op_info();
+    EXPECT_EQ(info->HasAttr("enable_int8"),
+              info->Input("Input").front() == "conv0_out");
+  }
+  EXPECT_EQ(helper.scope()->FindVar("w0")->Get<Tensor>().precision(),
+            PRECISION(kFloat));
+  auto* add = PassTestHelper::FindOp(graph.get(), "elementwise_add");
+  EXPECT_FALSE(add->AsStmt().op_info()->HasAttr("x_input_scale"));
+}
+
+TEST(post_training_quant_pass, load_scales) {
+  const std::string path = "post_training_quant_pass_test.table";
+  {
+    std::ofstream fout(path);
+    fout << "# <var name> <scale>\n"
+         << "x 0.02\n"
+         << "\n"
+         << "conv0_out 0.03\n";
+  }
+  PassTestHelper helper;
+  BuildProgram(&helper);
+  auto graph = helper.BuildGraph(kPlaces);
+
+  PostTrainingQuantPass pass;
+  ASSERT_TRUE(pass.LoadScales(path));
+  pass.Apply(graph);
+  auto* pool = PassTestHelper::FindOp(graph.get(), "pool2d");
+  EXPECT_FLOAT_EQ(pool->AsStmt().op_info()->GetAttr<float>("input_scale"),
+                  0.03f);
+  EXPECT_FALSE(pass.LoadScales("not_exist.table"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(conv2d,
+                     kARM,
+                     kInt8,
+                     kNCHW,
+                     paddle::lite::mir::FakeInt8Compute,
+                     fake)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+REGISTER_LITE_KERNEL(
+    fc, kARM, kInt8, kNCHW, paddle::lite::mir::FakeInt8Compute, fake)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
@@ -14,7 +14,10 @@
 
 #include "lite/core/mir/static_kernel_pick_pass.h"
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/mir/graph_visualize_pass.h"
@@ -29,6 +32,28 @@ bool KernelScoreCmp(const std::pair<float, std::unique_ptr<KernelBase>>& a,
   return a.first > b.first;
 }
 
+namespace {
+// The type `kernel` declares for the argument of the var `var_name` of the
+// op of `stmt`, nullptr if unknown.
+const Type* ArgDeclType(const Node::Stmt& stmt,
+                        const KernelBase& kernel,
+                        const std::string& var_name,
+                        bool is_input) {
+  std::string arg_name;
+  const ParamType* type = nullptr;
+  if (is_input) {
+    if (!stmt.op_info()->GetInputArgname(var_name, &arg_name)) return nullptr;
+    type = ParamTypeRegistry::Global().RetrieveInArgument(
+        kernel.place(), kernel.GenParamTypeKey(), arg_name);
+  } else {
+    if (!stmt.op_info()->GetOutputArgname(var_name, &arg_name)) return nullptr;
+    type = ParamTypeRegistry::Global().RetrieveOutArgument(
+        kernel.place(), kernel.GenParamTypeKey(), arg_name);
+  }
+  return type ? type->type : nullptr;
+}
+}  // namespace
+
 void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   kernel_pick_factors_.ConsiderTarget();
   kernel_pick_factors_.ConsiderPrecision();
@@ -56,8 +81,27 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     }
     std::sort(scored.begin(), scored.end(), KernelScoreCmp);
     instruct.kernels().clear();
-
     if (!instruct.op_info()->HasAttr("enable_int8")) {
+      // The int8 kernels need the scales, which only the quantized ops have,
+      // so drop them if the op has other kernels.
+      auto int8_begin = std::stable_partition(
+          scored.begin(),
+          scored.end(),
+          [](const std::pair<float, std::unique_ptr<KernelBase>>& x) {
+            return x.second->precision() != PRECISION(kInt8);
+          });
+      if (int8_begin != scored.begin()) {
+        scored.erase(int8_begin, scored.end());
+      }
+    }
+
+    if (!instruct.op_info()->HasAttr("enable_int8") && cost_model_) {
+      // Keep all the candidates, ordered by grade, PickKernelsByCost picks
+      // one of them when all the candidates of the graph are known.
+      for (auto& candidate : scored) {
+        instruct.kernels().emplace_back(std::move(candidate.second));
+      }
+    } else if (!instruct.op_info()->HasAttr("enable_int8")) {
       // Move kernel back
       // Just keep a single best kernel.
       // TODO(Superjomn) reconsider this.
@@ -89,11 +133,11 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
         CHECK(one_adj_op_node->IsStmt());
         auto& one_adj_instruct = one_adj_op_node->AsStmt();
         CHECK(one_adj_instruct.op_info()->HasAttr("enable_int8"));
-        CHECK(one_adj_instruct.op_info()->HasAttr("input_scale"));
+        float output_scale;
+        CHECK(one_adj_instruct.op_info()->GetInputScale(out_node->AsArg().name,
+                                                        &output_scale));
 
-        instruct.mutable_op_info()->SetAttr(
-            "output_scale",
-            one_adj_instruct.op_info()->GetAttr<float>("input_scale"));
+        instruct.mutable_op_info()->SetAttr("output_scale", output_scale);
 
         auto update_desc = *instruct.mutable_op_info();
         instruct.ResetOp(update_desc, graph->valid_places());
@@ -109,6 +153,7 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
       // int8 input and int8 output.
       // If the out_type_int8 is false, we should pick the kernel with the
       // int8 input and fp32 output.
+      // The kernels of kAny output, such as reshape, match both of them.
       auto output_arguments = instruct.op_info()->OutputArgumentNames();
       for (auto& candidate : scored) {
         bool all_output_type_match = true;
@@ -118,7 +163,8 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
         for (auto& arg_name : output_arguments) {
           const Type* out_arg_ty =
               candidate.second->GetOutputDeclType(arg_name);
-          if (out_arg_ty->precision() != expect_output_type) {
+          if (out_arg_ty->precision() != expect_output_type &&
+              out_arg_ty->precision() != PRECISION(kAny)) {
             all_output_type_match = false;
           }
         }
@@ -134,6 +180,108 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                                          << instruct.op_type();
     }
   }
+
+  if (cost_model_) PickKernelsByCost(graph.get());
+}
+
+float StaticKernelPickPass::EdgeCost(
+    Node* node,
+    const KernelBase& kernel,
+    const std::map<Node*, KernelBase*>& picked) const {
+  auto& stmt = node->AsStmt();
+  float cost{0.f};
+  for (auto* in : node->inlinks) {
+    // The weights are copied once when loaded, and the graph inputs are
+    // produced by feed.
+    if (in->inlinks.empty()) continue;
+    auto* producer = in->inlinks.front();
+    const auto& name = in->AsArg().name;
+    const Type* from = ArgDeclType(
+        producer->AsStmt(), *picked.at(producer), name, false /*is_input*/);
+    const Type* to = ArgDeclType(stmt, kernel, name, true /*is_input*/);
+    if (!from || !to) continue;
+    int64_t numel = cost_model_->ArgNumel(stmt, name);
+    cost += cost_model_->CastCost(*from, *to, numel);
+  }
+  for (auto* out : node->outlinks) {
+    const auto& name = out->AsArg().name;
+    const Type* from = ArgDeclType(stmt, kernel, name, false /*is_input*/);
+    if (!from) continue;
+    int64_t numel = cost_model_->ArgNumel(stmt, name);
+    for (auto* consumer : out->outlinks) {
+      const Type* to = ArgDeclType(
+          consumer->AsStmt(), *picked.at(consumer), name, true /*is_input*/);
+      if (to) cost += cost_model_->CastCost(*from, *to, numel);
+    }
+  }
+  return cost;
+}
+
+void StaticKernelPickPass::PickKernelsByCost(SSAGraph* graph) {
+  const float kEpsilon = 1e-3f;
+  const int kMaxIterations = 8;
+  auto nodes = graph->StmtTopologicalOrder();
+
+  // Start from the cheapest kernel of each stmt on its own, the first one of
+  // the equally cheap kernels has the best grade.
+  std::map<Node*, KernelBase*> picked;
+  for (auto* node : nodes) {
+    auto& stmt = node->AsStmt();
+    KernelBase* best = nullptr;
+    float best_cost = std::numeric_limits<float>::max();
+    for (auto& kernel : stmt.kernels()) {
+      float cost = cost_model_->KernelCost(stmt, *kernel);
+      if (cost < best_cost - kEpsilon) {
+        best_cost = cost;
+        best = kernel.get();
+      }
+    }
+    CHECK(best) << "No kernels found for " << stmt.op_type();
+    picked[node] = best;
+  }
+
+  // The total latency is the sum of the kernel costs and the cast costs on
+  // the edges, re-pick the kernel of one stmt at a time given its neighbours
+  // until none of them can be made cheaper.
+  for (int iter = 0; iter < kMaxIterations; ++iter) {
+    bool changed = false;
+    for (auto* node : nodes) {
+      auto& stmt = node->AsStmt();
+      if (stmt.kernels().size() < 2) continue;
+      KernelBase* best = picked[node];
+      float best_cost = cost_model_->KernelCost(stmt, *best) +
+                        EdgeCost(node, *best, picked);
+      for (auto& kernel : stmt.kernels()) {
+        if (kernel.get() == picked[node]) continue;
+        float cost = cost_model_->KernelCost(stmt, *kernel) +
+                     EdgeCost(node, *kernel, picked);
+        if (cost < best_cost - kEpsilon) {
+          best_cost = cost;
+          best = kernel.get();
+        }
+      }
+      if (best != picked[node]) {
+        picked[node] = best;
+        changed = true;
+      }
+    }
+    if (!changed) break;
+  }
+
+  for (auto* node : nodes) {
+    auto& kernels = node->AsStmt().kernels();
+    if (kernels.size() < 2) continue;
+    auto it = std::find_if(kernels.begin(),
+                           kernels.end(),
+                           [&](const std::unique_ptr<KernelBase>& kernel) {
+                             return kernel.get() == picked[node];
+                           });
+    CHECK(it != kernels.end());
+    std::unique_ptr<KernelBase> kernel = std::move(*it);
+    kernels.clear();
+    kernels.emplace_back(std::move(kernel));
+    VLOG(2) << "pick " << kernels.front()->name() << " by cost";
+  }
 }
 
 }  // namespace mir
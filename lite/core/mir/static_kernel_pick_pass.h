@@ -15,8 +15,10 @@
 #pragma once
 
 #include <limits>
+#include <map>
 #include <memory>
 #include <vector>
+#include "lite/core/mir/kernel_cost_model.h"
 #include "lite/core/mir/pass.h"
 #include "lite/core/types.h"
 
@@ -26,9 +28,14 @@ namespace mir {
 
 /*
  * StaticKernelPickPass is a simple strategy for picking the kernel for each
- * Operator using operator developer defined rule, there are many other tactics
- * such as considering IO or kernel execution latency and we will implement them
- * latter.
+ * Operator using operator developer defined rule.
+ *
+ * If a KernelCostModel is set, the kernels of the ops without `enable_int8`
+ * are picked by their estimated latency instead, plus the latency of the
+ * io_copy, calib and layout casts needed between the kernels picked for
+ * neighbouring ops, so that e.g. a small op between two ARM ops is not put on
+ * OpenCL only because OpenCL comes first in valid_places. The grade is then
+ * only used to break ties.
  *
  * There are two argument for this pass:
  * - place, the target place.
@@ -46,7 +53,21 @@ class StaticKernelPickPass : public mir::StmtPass {
     return &kernel_pick_factors_;
   }
 
+  // Pick the kernels by `cost_model`, nullptr to pick them by their grade.
+  void SetCostModel(const std::shared_ptr<KernelCostModel>& cost_model) {
+    cost_model_ = cost_model;
+  }
+
  private:
+  // Pick one of the kernels of each stmt, which are sorted by grade, so that
+  // the total latency of the kernels and the casts between them is minimal.
+  void PickKernelsByCost(SSAGraph* graph);
+  // The latency of the casts on the edges of `node` if `kernel` is picked for
+  // it, and `picked` for the other stmts.
+  float EdgeCost(Node* node,
+                 const KernelBase& kernel,
+                 const std::map<Node*, KernelBase*>& picked) const;
+
   // Score the kernel.
   size_t KernelGrade(const lite::KernelBase& kernel,
                      const std::vector<Place>& places) {
@@ -124,6 +145,7 @@ class StaticKernelPickPass : public mir::StmtPass {
 
  private:
   core::KernelPickFactor kernel_pick_factors_;
+  std::shared_ptr<KernelCostModel> cost_model_;
 };
 
 }  // namespace mir
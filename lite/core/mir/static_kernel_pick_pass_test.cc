@@ -0,0 +1,127 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/mir/static_kernel_pick_pass.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The candidates of scale, so the test does not depend on the kernels of the
+// build.
+class FakeHostScaleCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+class FakeOpenCLScaleCompute
+    : public KernelLite<TARGET(kOpenCL), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+namespace {
+
+const std::vector<Place> kPlaces{Place{TARGET(kOpenCL), PRECISION(kFloat)},
+                                 Place{TARGET(kHost), PRECISION(kFloat)}};
+
+std::string ScaleKernelType(TargetType target) {
+  return KernelBase::SerializeKernelType(
+      "scale", "fake", Place{target, PRECISION(kFloat), DATALAYOUT(kNCHW)});
+}
+
+// Picks the kernels of feed -> scale -> fetch with the profile `lines`, and
+// returns the target of the kernel picked for scale.
+TargetType PickScaleTarget(const std::vector<std::string>& lines) {
+  const std::string path = "__kernel_cost_profile__.txt";
+  {
+    std::ofstream fout(path);
+    for (auto& line : lines) fout << line << "\n";
+  }
+  auto cost_model = std::make_shared<KernelCostModel>();
+  CHECK(cost_model->LoadProfile(path));
+  std::remove(path.c_str());
+
+  PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  auto* scale = helper.AddOp("scale", {{"X", {"x"}}}, {{"Out", {"out"}}});
+  scale->SetAttr("scale", 2.f);
+  scale->SetAttr("bias", 0.f);
+  scale->SetAttr("bias_after_scale", true);
+  helper.AddFetch("out", 0);
+  auto graph = helper.BuildGraph(kPlaces);
+
+  StaticKernelPickPass pass;
+  pass.SetCostModel(cost_model);
+  pass.Apply(graph);
+  auto& kernels =
+      PassTestHelper::FindOp(graph.get(), "scale")->AsStmt().kernels();
+  CHECK_EQ(kernels.size(), 1UL);
+  return kernels.front()->target();
+}
+
+}  // namespace
+
+TEST(static_kernel_pick_pass, pick_the_profiled_kernel) {
+  // The casts are free, so the fastest kernel is picked.
+  EXPECT_EQ(PickScaleTarget({"# a small profile",
+                             ScaleKernelType(TARGET(kHost)) + " 50",
+                             ScaleKernelType(TARGET(kOpenCL)) + " 5",
+                             "io_copy 0 0"}),
+            TARGET(kOpenCL));
+  EXPECT_EQ(PickScaleTarget({ScaleKernelType(TARGET(kHost)) + " 5",
+                             ScaleKernelType(TARGET(kOpenCL)) + " 50",
+                             "io_copy 0 0"}),
+            TARGET(kHost));
+}
+
+TEST(static_kernel_pick_pass, pick_with_the_profiled_casts) {
+  // The OpenCL kernel is faster on its own, but its input and output are
+  // copied from and to the host.
+  EXPECT_EQ(PickScaleTarget({ScaleKernelType(TARGET(kHost)) + " 50",
+                             ScaleKernelType(TARGET(kOpenCL)) + " 5",
+                             "io_copy 40 0"}),
+            TARGET(kHost));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(
+    scale, kHost, kFloat, kNCHW, paddle::lite::mir::FakeHostScaleCompute, fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+REGISTER_LITE_KERNEL(scale,
+                     kOpenCL,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::mir::FakeOpenCLScaleCompute,
+                     fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kOpenCL))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kOpenCL))})
+    .Finalize();
@@ -0,0 +1,147 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/weight_only_quant_pass.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/backends/host/math/weight_only_quant.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void WeightOnlyQuantPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(bits_ == 8 || bits_ == 4) << "unsupported quant bits " << bits_;
+  CHECK(!dynamic_ || bits_ == 8) << "dynamic quantization needs int8 weights";
+  // The op types whose float kernels accept the quantized weights, and the
+  // argument of the weights.
+  const std::map<std::string, std::string> weight_args =
+      dynamic_ ? std::map<std::string, std::string>{{"fc", "W"},
+                                                    {"mul", "Y"},
+                                                    {"matmul", "Y"}}
+               : std::map<std::string, std::string>{{"fc", "W"},
+                                                    {"mul", "Y"},
+                                                    {"lookup_table", "W"},
+                                                    {"lookup_table_v2", "W"}};
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& inst = node->AsStmt();
+    const auto& kernel = inst.picked_kernel();
+    if (kernel.target() != TARGET(kX86) && kernel.target() != TARGET(kARM)) {
+      continue;
+    }
+    // The int8 kernels quantize the weights in their own way.
+    if (kernel.precision() == PRECISION(kInt8) ||
+        kernel.precision() == PRECISION(kFP16)) {
+      continue;
+    }
+    auto it = weight_args.find(inst.op_type());
+    if (it == weight_args.end()) continue;
+    if (inst.op_info()->HasAttr("weight_only_quant_bits")) continue;
+    auto arg_names = inst.op_info()->Input(it->second);
+    CHECK_EQ(arg_names.size(), 1UL);
+    for (auto* in : node->inlinks) {
+      if (!in->IsArg() || in->AsArg().name != arg_names.front()) continue;
+      // Skip the weights shared by other ops, which may not support the
+      // quantized weights.
+      if (!in->AsArg().is_weight || in->outlinks.size() != 1) continue;
+      QuantizeWeight(graph.get(), node, in);
+      break;
+    }
+  }
+}
+
+void WeightOnlyQuantPass::QuantizeWeight(SSAGraph* graph,
+                                         Node* node,
+                                         Node* arg) {
+  auto& inst = node->AsStmt();
+  auto* op_info = inst.op_info();
+  auto* scope = inst.op()->scope();
+  const auto& name = arg->AsArg().name;
+  auto* weight = scope->FindVar(name)->GetMutable<Tensor>();
+  if (weight->precision() != PRECISION(kFloat) || weight->dims().size() != 2) {
+    return;
+  }
+  if (inst.op_type() == "mul" && op_info->GetAttr<int>("y_num_col_dims") != 1) {
+    return;
+  }
+  if (inst.op_type() == "matmul" &&
+      (op_info->GetAttr<bool>("transpose_X") ||
+       op_info->GetAttr<bool>("transpose_Y"))) {
+    return;
+  }
+
+  // The embedding tables are gathered by rows, and the fc/mul/matmul weights
+  // of shape [K, N] are quantized per output column.
+  const bool per_row = inst.op_type() == "lookup_table" ||
+                       inst.op_type() == "lookup_table_v2";
+  const int rows = weight->dims()[0];
+  const int cols = weight->dims()[1];
+  int bits = bits_;
+  if (bits == 4 && cols % 2 != 0) {
+    VLOG(4) << "the width of " << name << " is odd, quantize it to int8";
+    bits = 8;
+  }
+
+  auto scale_name = name + "@weight_only_scale";
+  auto* scale = scope->Var(scale_name)->GetMutable<Tensor>();
+  scale->Resize({per_row ? rows : cols});
+  scale->set_persistable(true);
+  scale->set_precision(PRECISION(kFloat));
+  Tensor quant;
+  quant.Resize({rows, bits == 4 ? cols / 2 : cols});
+  host::math::quantize_weight(weight->data<float>(),
+                              rows,
+                              cols,
+                              bits,
+                              per_row,
+                              quant.mutable_data<int8_t>(),
+                              scale->mutable_data<float>());
+  weight->ShareDataWith(quant);
+  weight->set_precision(PRECISION(kInt8));
+
+  auto* scale_arg = graph->NewArgumentNode(scale_name);
+  scale_arg->AsArg().is_weight = true;
+  scale_arg->AsArg().is_persist = true;
+  scale_arg->AsArg().type = LiteType::GetTensorTy(
+      inst.picked_kernel().target(), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  DirectedLink(scale_arg, node);
+
+  // Keep the picked kernel, and attach it to the updated op.
+  auto updated_op_info = *op_info;
+  updated_op_info.SetInput("WeightScale", {scale_name});
+  updated_op_info.SetAttr<int>("weight_only_quant_bits", bits);
+  if (dynamic_) {
+    updated_op_info.SetAttr<bool>("dynamic_quant", true);
+  }
+  auto picked_kernel = std::move(inst.kernels().front());
+  inst.ResetOp(updated_op_info, graph->valid_places());
+  inst.kernels().clear();
+  inst.kernels().emplace_back(std::move(picked_kernel));
+  inst.op()->AttachKernel(inst.kernels().front().get());
+  graph->CheckValid();
+  VLOG(4) << "quantize weight " << name << " of " << inst.op_type() << " to "
+          << bits << " bits" << (dynamic_ ? ", dynamic" : "");
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(weight_only_quant_pass,
+                  paddle::lite::mir::WeightOnlyQuantPass)
+    .BindTargets({TARGET(kX86), TARGET(kARM)});
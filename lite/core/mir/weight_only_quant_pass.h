@@ -0,0 +1,66 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * WeightOnlyQuantPass stores the weights of fc, mul and the embedding tables
+ * in int8 or in packed int4, and the float kernels dequantize them on the fly,
+ * see `lite/backends/host/math/weight_only_quant.h`. The activations are kept
+ * in float, so no calibration is needed.
+ *
+ * The fc and mul weights have a scale per output column, and the embedding
+ * tables have a scale per row. The scales are stored in a new persistable var
+ * which is the `WeightScale` input of the op.
+ *
+ * In the dynamic quantization mode, the int8 weights of fc, mul and matmul
+ * are used as is: the kernels quantize the activations per row at runtime and
+ * run an int8 GEMM, and the row and column scales are applied in its epilogue.
+ * Only the matmul ops with a constant 2-D `Y` and no transpose are supported.
+ *
+ * It is not in the default pass list, and is run by the Predictor if
+ * `CxxConfig::set_weight_only_quant_bits` or `CxxConfig::set_dynamic_quant`
+ * is set.
+ */
+class WeightOnlyQuantPass : public StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // 8 or 4.
+  void SetQuantBits(int bits) { bits_ = bits; }
+  int quant_bits() const { return bits_; }
+  // Quantize the activations of fc, mul and matmul at runtime, the weights
+  // are always in int8 then.
+  void SetDynamicQuant(bool dynamic) { dynamic_ = dynamic; }
+  bool dynamic_quant() const { return dynamic_; }
+
+ private:
+  // Quantize the weight `arg` of the stmt `node` if it is supported.
+  void QuantizeWeight(SSAGraph* graph, Node* node, Node* arg);
+
+  int bits_{8};
+  bool dynamic_{false};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
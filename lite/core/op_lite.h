@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cctype>
 #include <list>
 #include <map>
 #include <memory>
@@ -212,6 +214,26 @@ class OpInfo : public cpp::OpDesc {
     return false;
   }
 
+  // Get the scale of an int8 input. The ops with several quantized inputs,
+  // such as elementwise_add, keep a scale per argument, e.g. `x_input_scale`,
+  // the others share `input_scale`.
+  bool GetInputScale(const std::string &value_name, float *out) const {
+    std::string argname;
+    if (GetInputArgname(value_name, &argname)) {
+      std::transform(
+          argname.begin(), argname.end(), argname.begin(), ::tolower);
+      if (HasAttr(argname + "_input_scale")) {
+        *out = GetAttr<float>(argname + "_input_scale");
+        return true;
+      }
+    }
+    if (HasAttr("input_scale")) {
+      *out = GetAttr<float>("input_scale");
+      return true;
+    }
+    return false;
+  }
+
   void UpdateAllInputs(const std::string &from, const std::string &to) {
     for (auto &item : inputs_) {
       for (auto &var : item.second) {
@@ -229,10 +229,10 @@ class KernelRegistry final {
     auto *reg = varient.template get<kernel_registor_t *>();
     CHECK(reg) << "Can not be empty of " << name;
     reg->Register(name, std::move(creator));
-#ifdef LITE_ON_MODEL_OPTIMIZE_TOOL
+#ifndef LITE_ON_TINY_PUBLISH
     kernel_info_map_[name].push_back(
         std::make_tuple(Target, Precision, Layout));
-#endif  // LITE_ON_MODEL_OPTIMIZE_TOOL
+#endif  // LITE_ON_TINY_PUBLISH
   }
 
   template <TargetType Target,
@@ -267,6 +267,17 @@ class KernelRegistry final {
            static_cast<int>(Layout);
   }
 
+#ifndef LITE_ON_TINY_PUBLISH
+  // The places of the kernels registered for each op type, one entry for
+  // every registered kernel.
+  const std::map<
+      std::string,
+      std::vector<std::tuple<TargetType, PrecisionType, DataLayoutType>>>
+      &kernel_info_map() const {
+    return kernel_info_map_;
+  }
+#endif  // LITE_ON_TINY_PUBLISH
+
   std::string DebugString() const {
 #ifndef LITE_ON_MODEL_OPTIMIZE_TOOL
     return "No more debug info";
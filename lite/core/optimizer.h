@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -57,25 +58,31 @@ class Optimizer {
     InitTargetTypeTransformPass();
 
     if (passes.empty()) {
-      RunPasses(std::vector<std::string>{
-          {"lite_quant_dequant_fuse_pass",     //
-           "lite_conv_elementwise_fuse_pass",  // conv-elemwise-bn
-           "lite_conv_bn_fuse_pass",           //
-           "lite_conv_elementwise_fuse_pass",  // conv-bn-elemwise
+      std::vector<std::string> default_passes{
+          {"lite_quant_dequant_fuse_pass",       //
+           "lite_conv_elementwise_fuse_pass",    // conv-elemwise-bn
+           "lite_conv_bn_fuse_pass",             //
+           "lite_conv_elementwise_fuse_pass",    // conv-bn-elemwise
+           "lite_fc_fuse_pass",                  //
+           "lite_squeeze_excitation_fuse_pass",  // before conv-act fusion
            // This pass is disabled to force some opencl kernels selected for
            // final running, otherwise, they will be fused to ARM fusion
            // kernels, and the OpenCL devices will be discarded.
            // TODO(Superjomn) Refine the fusion related design to select fusion
            // kernels for devices automatically.
            "lite_conv_activation_fuse_pass",              //
-           "lite_fc_fuse_pass",                           //
+           "lite_residual_activation_fuse_pass",          //
            "lite_shuffle_channel_fuse_pass",              //
            "lite_transpose_softmax_transpose_fuse_pass",  //
            "lite_interpolate_fuse_pass",                  //
+           "lite_box_coder_nms_fuse_pass",                //
            "identity_scale_eliminate_pass",               //
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
            "lite_elementwise_add_activation_fuse_pass",  //
 #endif
+           "dead_code_elimination_pass",     // drop unused ops and outputs
+           "post_training_quant_pass",       // quantize with calib table
+           "int8_propagation_pass",          // keep int8 between quant ops
            "static_kernel_pick_pass",        // pick original kernel from graph
            "variable_place_inference_pass",  // inference arg/var's
            // info(target/precision/layout/device)
@@ -109,12 +116,22 @@ class Optimizer {
 
            "runtime_context_assign_pass",
            "argument_type_display_pass",  //
+           "buffer_view_pass",            // concat/split/slice without copies
 #if !defined(LITE_WITH_OPENCL) && !defined(LITE_WITH_NPU) && \
     !defined(LITE_WITH_XPU)
            // TODO(ysh329): cause CL_INVALID_MEM_OBJECT when setArg in kernel
            "memory_optimize_pass",
 #endif
-           "argument_type_display_pass"}});
+           "argument_type_display_pass"}};
+      if (constant_folding_) {
+        // The kernels are picked and have their contexts, and the memory of
+        // the folded outputs is not reused yet.
+        auto it = std::find(default_passes.begin(),
+                            default_passes.end(),
+                            "buffer_view_pass");
+        default_passes.insert(it, "constant_folding_pass");
+      }
+      RunPasses(default_passes);
     } else {
       RunPasses(passes);
     }
@@ -191,8 +208,8 @@ class Optimizer {
 
   lite::Scope* exec_scope() { return exec_scope_; }
 
- protected:
-  void SpecifyKernelPickTactic(core::KernelPickFactor factor);
+  // Run constant_folding_pass in the default passes.
+  void set_constant_folding(bool x) { constant_folding_ = x; }
 
   // Specify the passes and run them.
   void RunPasses(const std::vector<std::string>& passes) {
@@ -217,11 +234,15 @@ class Optimizer {
     }
   }
 
+ protected:
+  void SpecifyKernelPickTactic(core::KernelPickFactor factor);
+
  private:
   std::unique_ptr<mir::SSAGraph> graph_;
   std::vector<Place> valid_places_;
   lite::Scope* exec_scope_{};
   Program* program_{};
+  bool constant_folding_{false};
 };
 
 }  // namespace lite
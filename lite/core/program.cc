@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/program.h"
+#include <map>
 #include <unordered_map>
 #include "lite/model_parser/cpp/block_desc.h"
 #include "lite/model_parser/cpp/op_desc.h"
 #include "lite/model_parser/cpp/var_desc.h"
+#include "lite/model_parser/model_parser.h"
 #include "lite/operators/while_op.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/precision_profiler.h"
@@ -36,9 +38,58 @@ void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) {
     auto* op = main_block.AddOp<cpp::OpDesc>();
     *op = *node.op()->op_info();
     op->SetAttr(kKernelTypeAttr, node.kernel()->SerializedKernelType());
+
+    // Save the weights transformed by the kernel as new persistable vars.
+    auto prepared_weights = node.kernel()->PreparedWeights();
+    if (prepared_weights.empty()) continue;
+    CHECK(exec_scope_);
+    auto out_vars = op->output_vars();
+    CHECK(!out_vars.empty());
+    std::vector<std::string> names;
+    std::vector<std::string> vars;
+    for (auto& item : prepared_weights) {
+      auto var_name = out_vars.front() + "@prepared@" + item.first;
+      auto* tensor = exec_scope_->Var(var_name)->GetMutable<Tensor>();
+      tensor->ShareDataWith(*item.second);
+      tensor->set_precision(item.second->precision());
+      tensor->set_persistable(true);
+      names.push_back(item.first);
+      vars.push_back(var_name);
+    }
+    op->SetAttr<std::string>(kPreparedWeightsKeyAttr,
+                             node.kernel()->PreparedWeightsKey());
+    op->SetAttr<std::vector<std::string>>(kPreparedWeightsNamesAttr, names);
+    op->SetAttr<std::vector<std::string>>(kPreparedWeightsVarsAttr, vars);
+  }
+}
+
+void RuntimeProgram::RestorePreparedWeights() {
+  CHECK(exec_scope_);
+  for (auto& inst : instructions_) {
+    auto* op_info = inst.op()->op_info();
+    if (!op_info->HasAttr(kPreparedWeightsVarsAttr)) continue;
+    auto key = op_info->GetAttr<std::string>(kPreparedWeightsKeyAttr);
+    auto names =
+        op_info->GetAttr<std::vector<std::string>>(kPreparedWeightsNamesAttr);
+    auto vars =
+        op_info->GetAttr<std::vector<std::string>>(kPreparedWeightsVarsAttr);
+    CHECK_EQ(names.size(), vars.size());
+    std::map<std::string, const Tensor*> weights;
+    for (size_t i = 0; i < names.size(); i++) {
+      auto* var = exec_scope_->FindVar(vars[i]);
+      CHECK(var) << "prepared weights " << vars[i] << " not found";
+      weights[names[i]] = &var->Get<Tensor>();
+    }
+    inst.mutable_kernel()->SetPreparedWeights(key, weights);
   }
 }
 
+// The vars made persistable by the passes, e.g. the folded constants.
+static bool IsPersistableTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  return var && var->IsType<Tensor>() && var->Get<Tensor>().persistable();
+}
+
 // `UpdateVarsOfProgram` will remove unused var_descs and add new created
 // vars' descs in the block 0. Now, the type of a new created var can only
 // be LOD_TENSOR.
@@ -67,7 +118,8 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         auto* v = main_block.AddVar<cpp::VarDesc>();
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
-        v->SetPersistable((it->second).Persistable());
+        v->SetPersistable((it->second).Persistable() ||
+                          IsPersistableTensor(scope, in_name));
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -91,7 +143,8 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         auto* v = main_block.AddVar<cpp::VarDesc>();
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
-        v->SetPersistable((it->second).Persistable());
+        v->SetPersistable((it->second).Persistable() ||
+                          IsPersistableTensor(scope, out_name));
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -109,13 +162,40 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
       }
     }
   }
+  // The prepared weights saved by `SaveOpInfosToProgram`.
+  for (size_t i = 0; i < main_block.OpsSize(); i++) {
+    auto* op = main_block.GetOp<cpp::OpDesc>(i);
+    if (!op->HasAttr(kPreparedWeightsVarsAttr)) continue;
+    for (auto& name :
+         op->GetAttr<std::vector<std::string>>(kPreparedWeightsVarsAttr)) {
+      auto* v = main_block.AddVar<cpp::VarDesc>();
+      v->SetName(name);
+      v->SetType(cpp::VarDesc::Type::LOD_TENSOR);
+      v->SetPersistable(true);
+    }
+  }
 }
 
-void RuntimeProgram::Run() {
+void RuntimeProgram::Run(
+    const std::function<void(const Instruction&)>& observer) {
+  if (params_loader_ && params_loader_->finished()) {
+    params_loader_ = nullptr;
+  }
   for (auto& inst : instructions_) {
     std::string op_type = inst.op()->op_info()->Type();
     if (op_type == "feed" || op_type == "fetch") continue;
+    if (params_loader_) {
+      auto* op_info = inst.op()->op_info();
+      auto params = op_info->input_vars();
+      if (op_info->HasAttr(kPreparedWeightsVarsAttr)) {
+        auto prepared = op_info->GetAttr<std::vector<std::string>>(
+            kPreparedWeightsVarsAttr);
+        params.insert(params.end(), prepared.begin(), prepared.end());
+      }
+      params_loader_->Wait(params);
+    }
     inst.Run();
+    if (observer) observer(inst);
 #ifdef LITE_WITH_PROFILE
 #ifdef LITE_WITH_PRECISION_PROFILE
     LITE_PRECISION_PROFILE(inst)
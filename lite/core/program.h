@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
@@ -29,7 +30,14 @@
 namespace paddle {
 namespace lite {
 
+class AsyncParamsLoader;
+
 static const char kKernelTypeAttr[] = "__@kernel_type_attr@__";
+// The prepared weights of the kernel saved with the optimized model, see
+// `KernelBase::PreparedWeights`.
+static const char kPreparedWeightsKeyAttr[] = "__@prepared_weights_key@__";
+static const char kPreparedWeightsNamesAttr[] = "__@prepared_weights_names@__";
+static const char kPreparedWeightsVarsAttr[] = "__@prepared_weights_vars@__";
 
 // A program is used to represent a code program, in Paddle, a code program
 // contains:
@@ -137,7 +145,13 @@ class LITE_API RuntimeProgram {
     }
   }
 
-  void Run();
+  // Call `observer` after each instruction if it is set, e.g. to collect the
+  // statistics of the activations.
+  void Run(const std::function<void(const Instruction&)>& observer = nullptr);
+
+  // Run each instruction as soon as its params are loaded by `loader`, the
+  // loader is dropped once all the params arrive.
+  void set_params_loader(AsyncParamsLoader* loader) { params_loader_ = loader; }
 
   void set_exec_scope(lite::Scope* x) { exec_scope_ = x; }
   lite::Scope* exec_scope() { return exec_scope_; }
@@ -155,10 +169,15 @@ class LITE_API RuntimeProgram {
   // be added in vars_.
   void UpdateVarsOfProgram(cpp::ProgramDesc* desc);
 
+  // Hand the prepared weights saved in the op attributes over to the kernels,
+  // it should be called before the first run.
+  void RestorePreparedWeights();
+
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
   std::vector<Instruction> instructions_;
   lite::Scope* exec_scope_{};
+  AsyncParamsLoader* params_loader_{};
 };
 
 }  // namespace lite
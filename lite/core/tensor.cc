@@ -87,6 +87,15 @@ void TensorLite::CopyDataFrom(const TensorLite &other) {
   buffer_->CopyDataFrom(*other.buffer_, memory_size_);
 }
 
+void TensorLite::ShareExternalMemory(void *data,
+                                     size_t memory_size,
+                                     TargetType target) {
+  buffer_ = std::make_shared<Buffer>(data, target, memory_size);
+  memory_size_ = memory_size;
+  target_ = target;
+  offset_ = 0;
+}
+
 void *TensorLite::mutable_data(size_t memory_size) {
   memory_size_ = memory_size;
   buffer_->ResetLazy(target_, memory_size_);
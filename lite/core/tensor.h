@@ -182,11 +182,19 @@ class TensorLite {
 
   bool IsInitialized() const { return buffer_->data(); }
 
+  // The size of the memory allocated, which may be larger than memory_size().
+  size_t capacity() const { return buffer_->space(); }
+
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
   void CopyDataFrom(const TensorLite &other);
 
+  // Use the memory owned by others, such as a weight blob linked into the
+  // binary or a slice of a pre-planned arena. The memory is not freed by the
+  // tensor.
+  void ShareExternalMemory(void *data, size_t memory_size, TargetType target);
+
   TargetType target() const { return target_; }
 
   template <typename T>
@@ -14,8 +14,13 @@
 
 #include "lite/gen_code/gen_code.h"
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
+#include "lite/core/op_registry.h"
 
 namespace paddle {
 namespace lite {
@@ -42,20 +47,223 @@ void Module::AddWeight(const std::string &name, const TensorRepr &tensor) {
                      w_data_repr.c_str()));
   // w0->Assign<float, lite::DDim, TARGET(kX86)>(w0_data.data(), w0_ddim);
   Line(string_format(
-      "%s->Assign<%s, lite::DDim, TARGET(kX86)>(%s_data.data(), %s_ddim);",
+      "%s->Assign<%s, lite::DDim, TARGET(%s)>(%s_data.data(), %s_ddim);",
       w_name.c_str(),
       PrecisionToStr(tensor.dtype).c_str(),
+      TargetRepr(target_).c_str(),
       w_name.c_str(),
       w_name.c_str()));
   Line("");
 }
 
+constexpr size_t ArenaPlanner::kAlignment;
+
+void ArenaPlanner::AddVar(const std::string &name,
+                          size_t num_bytes,
+                          int first_use,
+                          int last_use) {
+  CHECK_LE(first_use, last_use);
+  vars_.push_back(VarRecord{name, num_bytes, first_use, last_use});
+}
+
+void ArenaPlanner::AddView(const std::string &view, const std::string &base) {
+  views_.emplace(view, base);
+}
+
+std::vector<ArenaPlanner::VarRecord> ArenaPlanner::MergeViews() const {
+  // Union the views with their bases.
+  std::map<std::string, std::string> parent;
+  std::function<std::string(const std::string &)> find =
+      [&](const std::string &x) -> std::string {
+    auto it = parent.find(x);
+    if (it == parent.end() || it->second == x) return x;
+    return it->second = find(it->second);
+  };
+  std::map<std::string, int> num_bases;
+  for (auto &view : views_) {
+    num_bases[view.first]++;
+    parent[find(view.first)] = find(view.second);
+  }
+
+  struct Group {
+    VarRecord merged;
+    int num_vars{0};
+    int num_bases{0};
+    bool valid{true};
+  };
+  std::map<std::string, Group> groups;
+  std::set<std::string> added;
+  for (auto &var : vars_) {
+    CHECK(added.insert(var.name).second) << "duplicated var " << var.name;
+    auto &group = groups[find(var.name)];
+    if (group.num_vars++ == 0) {
+      group.merged = var;
+    } else {
+      group.merged.num_bytes = std::max(group.merged.num_bytes, var.num_bytes);
+      group.merged.first_use = std::min(group.merged.first_use, var.first_use);
+      group.merged.last_use = std::max(group.merged.last_use, var.last_use);
+    }
+    if (!num_bases.count(var.name)) {
+      group.num_bases++;
+      group.merged.name = var.name;
+    }
+  }
+  for (auto &view : views_) {
+    auto &group = groups[find(view.first)];
+    group.valid = group.valid && num_bases[view.first] == 1 &&
+                  added.count(view.first) && added.count(view.second);
+  }
+
+  std::vector<VarRecord> records;
+  for (auto &var : vars_) {
+    if (num_bases.count(var.name)) continue;
+    auto &group = groups[find(var.name)];
+    if (group.valid && group.num_bases == 1) records.push_back(group.merged);
+  }
+  return records;
+}
+
+size_t ArenaPlanner::Plan(std::map<std::string, size_t> *offsets) const {
+  CHECK(offsets);
+  auto align = [](size_t x) {
+    return (x + kAlignment - 1) / kAlignment * kAlignment;
+  };
+  // Greedy by size: place the biggest variables first, each one at the lowest
+  // offset that does not collide with a placed variable alive at the same
+  // time.
+  auto records = MergeViews();
+  std::vector<const VarRecord *> order;
+  for (auto &var : records) order.push_back(&var);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [](const VarRecord *a, const VarRecord *b) {
+                     return a->num_bytes > b->num_bytes;
+                   });
+
+  struct Placed {
+    size_t offset;
+    size_t size;
+    const VarRecord *var;
+  };
+  std::vector<Placed> placed;
+  size_t arena_size = 0;
+  for (auto *var : order) {
+    size_t size = align(var->num_bytes);
+    std::vector<std::pair<size_t, size_t>> conflicts;
+    for (auto &p : placed) {
+      if (p.var->first_use <= var->last_use &&
+          var->first_use <= p.var->last_use) {
+        conflicts.emplace_back(p.offset, p.offset + p.size);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+    size_t offset = 0;
+    for (auto &range : conflicts) {
+      if (offset + size <= range.first) break;
+      offset = std::max(offset, range.second);
+    }
+    placed.push_back(Placed{offset, size, var});
+    (*offsets)[var->name] = offset;
+    arena_size = std::max(arena_size, offset + size);
+  }
+  return arena_size;
+}
+
+void Module::AddWeightBlob(const std::string &blob) {
+  Line("// All the weights, the tensors share the memory of this blob.");
+  Line("alignas(64) static unsigned char kWeightBlob[] = {");
+  IncIndent();
+  const int kBytesPerLine = 16;
+  for (size_t i = 0; i < blob.size(); i += kBytesPerLine) {
+    STL::stringstream ss;
+    for (size_t j = i; j < std::min(blob.size(), i + kBytesPerLine); j++) {
+      ss << static_cast<int>(static_cast<unsigned char>(blob[j])) << ",";
+    }
+    Line(ss.str());
+  }
+  // Avoid the zero-sized array for programs without weights.
+  if (blob.empty()) Line("0");
+  DecIndent();
+  Line("};");
+  Line("");
+}
+
+void Module::AddStaticWeight(const std::string &name,
+                             const lite::Tensor &tensor,
+                             size_t blob_offset) {
+  auto w_name = WeightUniqueName();
+  Line(string_format("// Create weight: %s", name.c_str()));
+  Line(string_format("auto* %s = scope->Var(%s)->GetMutable<lite::Tensor>();",
+                     w_name.c_str(),
+                     Repr(name).c_str()));
+  Line(string_format("%s->Resize(std::vector<int64_t>(%s));",
+                     w_name.c_str(),
+                     tensor.dims().repr().c_str()));
+  Line(string_format("%s->set_precision(PRECISION(%s));",
+                     w_name.c_str(),
+                     PrecisionRepr(tensor.precision()).c_str()));
+  Line(string_format("%s->set_persistable(true);", w_name.c_str()));
+  // clang-format off
+  Line(string_format("%s->ShareExternalMemory(kWeightBlob + %s, %s, TARGET(%s));",  // NOLINT
+                     w_name.c_str(),
+                     std::to_string(blob_offset).c_str(),
+                     std::to_string(tensor.memory_size()).c_str(),
+                     TargetRepr(target_).c_str()));
+  // clang-format on
+  Line("");
+}
+
+std::string Module::AddTmpVarShape(const std::string &name,
+                                   const lite::Tensor &tensor) {
+  auto var_name = TmpVarUniqueName();
+  Line(string_format("// Create temporary variable: %s", name.c_str()));
+  Line(string_format(
+      "auto* %s = exec_scope->Var(%s)->GetMutable<lite::Tensor>();",
+      var_name.c_str(),
+      Repr(name).c_str()));
+  Line(string_format("%s->Resize(std::vector<int64_t>(%s));",
+                     var_name.c_str(),
+                     tensor.dims().repr().c_str()));
+  if (!tensor.lod().empty()) {
+    std::vector<std::string> levels;
+    for (auto &level : tensor.lod()) {
+      levels.push_back("{" + Join(level, ",") + "}");
+    }
+    Line(string_format("%s->set_lod({%s});",
+                       var_name.c_str(),
+                       Join(levels, ",").c_str()));
+  }
+  return var_name;
+}
+
+void Module::AddStaticTmpVar(const std::string &name,
+                             const lite::Tensor &tensor,
+                             size_t num_bytes,
+                             size_t arena_offset) {
+  auto var_name = AddTmpVarShape(name, tensor);
+  // clang-format off
+  Line(string_format("%s->ShareExternalMemory(static_cast<char*>(raw_arena_) + %s, %s, TARGET(%s));",  // NOLINT
+                     var_name.c_str(),
+                     std::to_string(arena_offset).c_str(),
+                     std::to_string(num_bytes).c_str(),
+                     TargetRepr(target_).c_str()));
+  // clang-format on
+  Line("");
+}
+
+void Module::AddStaticTmpVar(const std::string &name,
+                             const lite::Tensor &tensor) {
+  AddTmpVarShape(name, tensor);
+  Line("");
+}
+
 void Module::AddHeaderIncludeGenCode() {
   Line("");
   Line("#include <string>");
   Line("#include <vector>");
   Line("#include \"lite/core/tensor.h\"");
   Line("#include \"lite/core/context.h\"");
+  Line("#include \"lite/core/memory.h\"");
   Line("#include \"lite/gen_code/paddle_infer.h\"");
   Line("#include \"lite/core/op_registry.h\"");
   Line("#include \"lite/core/scope.h\"");
@@ -218,6 +426,275 @@ void Module::AddOp(const cpp::OpDesc &op) {
   op_kinds_.insert(op.Type());
   kernel_kinds_.insert(kernel_type);
 }
+
+namespace {
+
+size_t SizeOfVarType(const framework::proto::VarType::Type &type) {
+  switch (type) {
+    case framework::proto::VarType::BOOL:
+    case framework::proto::VarType::UINT8:
+    case framework::proto::VarType::INT8:
+      return 1;
+    case framework::proto::VarType::INT16:
+    case framework::proto::VarType::FP16:
+      return 2;
+    case framework::proto::VarType::INT32:
+    case framework::proto::VarType::FP32:
+      return 4;
+    default:
+      // INT64, FP64 and the unknown types.
+      return 8;
+  }
+}
+
+// The kernel picked for the op with its param attached, nullptr if it is not
+// linked into the code generator.
+std::unique_ptr<KernelBase> PickedKernel(OpLite *op, const cpp::OpDesc &desc) {
+  if (!desc.HasAttr(kKernelTypeAttr)) return nullptr;
+  std::string op_type, alias;
+  Place place;
+  KernelBase::ParseKernelType(
+      desc.GetAttr<std::string>(kKernelTypeAttr), &op_type, &alias, &place);
+  for (auto &kernel : KernelRegistry::Global().Create(
+           op_type, place.target, place.precision, place.layout)) {
+    if (kernel->alias() != alias) continue;
+    op->AttachKernel(kernel.get());
+    return std::move(kernel);
+  }
+  return nullptr;
+}
+
+// The (view arg, base arg) pairs of the concat, split and slice that use
+// buffer views, see `BufferViewPass`.
+std::vector<std::pair<std::string, std::string>> BufferViewArgs(
+    const cpp::OpDesc &desc) {
+  if (!desc.HasAttr("use_buffer_view") ||
+      !desc.GetAttr<bool>("use_buffer_view")) {
+    return {};
+  }
+  if (desc.Type() == "concat") return {{"X", "Out"}};
+  if (desc.Type() == "split") return {{"Out", "X"}};
+  if (desc.Type() == "slice") return {{"Out", "Input"}};
+  return {};
+}
+
+}  // namespace
+
+TargetType ProgramCodeGenerator::ProgramTarget() const {
+  for (auto &pb_op : program_.blocks(0).ops()) {
+    auto op = pb_op;
+    lite::pb::OpDesc pb_desc(&op);
+    if (!pb_desc.HasAttr(kKernelTypeAttr)) continue;
+    std::string op_type, alias;
+    Place place;
+    KernelBase::ParseKernelType(
+        pb_desc.GetAttr<std::string>(kKernelTypeAttr), &op_type, &alias, &place);
+    if (place.target != TARGET(kHost) && place.target != TARGET(kAny)) {
+      return place.target;
+    }
+  }
+  return TARGET(kHost);
+}
+
+std::string ProgramCodeGenerator::GenStaticCode(
+    const std::vector<std::vector<int64_t>> &feed_shapes) {
+  const auto &block = program_.blocks(0);
+  auto target = ProgramTarget();
+  // The arena and the weight blob are host memory.
+  CHECK(target == TARGET(kHost) || target == TARGET(kX86) ||
+        target == TARGET(kARM))
+      << "static mode does not support the target " << TargetToStr(target);
+  // The output shapes of these ops depend on the data, they can not be fixed
+  // at code generation time.
+  const std::set<std::string> dynamic_shape_ops({"while",
+                                                 "conditional_block",
+                                                 "conditional_block_infer",
+                                                 "merge_lod_tensor_infer",
+                                                 "merge_lod_tensor"});
+  // The vars which inputs or outputs are these ops will not be placed in the
+  // arena, neither are the ones of the ops whose kernels are unknown. The
+  // tensors which become views of others (see `KernelBase::ViewArgs` and
+  // `BufferViewPass`) are planned together with their bases.
+  const std::set<std::string> invalid_ops({"equal",
+                                           "lod_reset",
+                                           "yolo_box",
+                                           "graph_op",
+                                           "feed",
+                                           "fetch"});
+
+  std::map<std::string, size_t> var_elem_size;
+  std::set<std::string> persistable_vars;
+  for (auto &var : block.vars()) {
+    if (var.persistable()) {
+      persistable_vars.insert(var.name());
+    } else if (var.type().has_lod_tensor()) {
+      var_elem_size[var.name()] =
+          SizeOfVarType(var.type().lod_tensor().tensor().data_type());
+    } else if (var.type().type() == framework::proto::VarType::LOD_TENSOR) {
+      // The models saved by lite do not record the data types.
+      var_elem_size[var.name()] = sizeof(int64_t);
+    }
+  }
+
+  // Infer the shapes of all the variables with the given input shapes.
+  auto &tmp_scope = exec_scope_.NewScope();
+  tmp_scope.Var("feed")->GetMutable<std::vector<lite::Tensor>>();
+  tmp_scope.Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
+  for (auto &var : block.vars()) {
+    if (!var.persistable()) tmp_scope.Var(var.name());
+  }
+
+  std::vector<cpp::OpDesc> ops;
+  std::map<std::string, std::pair<int, int>> lifetimes;
+  std::set<std::string> excluded_vars;
+  std::vector<std::pair<std::string, std::string>> views;
+  for (auto &pb_op : block.ops()) {
+    auto op_proto = pb_op;
+    lite::pb::OpDesc pb_desc(&op_proto);
+    lite::cpp::OpDesc cpp_desc;
+    TransformOpDescAnyToCpp(pb_desc, &cpp_desc);
+
+    CHECK(!dynamic_shape_ops.count(cpp_desc.Type()))
+        << "static mode does not support " << cpp_desc.Type()
+        << ", whose output shapes depend on the data";
+    auto op = LiteOpRegistry::Global().Create(cpp_desc.Type());
+    CHECK(op) << "no op found for " << cpp_desc.Type();
+    op->Attach(cpp_desc, &tmp_scope);
+    if (cpp_desc.Type() == "feed") {
+      int col = cpp_desc.GetAttr<int>("col");
+      CHECK_LT(col, static_cast<int>(feed_shapes.size()))
+          << "the shape of the " << col << "-th input is not specified";
+      auto *out = tmp_scope.FindVar(cpp_desc.Output("Out").front());
+      out->GetMutable<lite::Tensor>()->Resize(feed_shapes[col]);
+    }
+    CHECK(op->CheckShape()) << "CheckShape failed for " << cpp_desc.Type();
+    CHECK(op->InferShape()) << "InferShape failed for " << cpp_desc.Type();
+
+    auto kernel = PickedKernel(op.get(), cpp_desc);
+    if (!kernel) {
+      LOG(WARNING) << "no kernel found for " << cpp_desc.Type()
+                   << ", its vars are not placed in the arena";
+    }
+
+    int op_idx = ops.size();
+    bool invalid_op = invalid_ops.count(cpp_desc.Type()) || !kernel;
+    auto view_args = BufferViewArgs(cpp_desc);
+    if (kernel) {
+      auto kernel_view_args = kernel->ViewArgs();
+      view_args.insert(
+          view_args.end(), kernel_view_args.begin(), kernel_view_args.end());
+    }
+    auto arg_vars = [&](const std::string &arg) {
+      return cpp_desc.HasInput(arg) ? cpp_desc.Input(arg)
+                                    : cpp_desc.Output(arg);
+    };
+    for (auto &item : view_args) {
+      auto bases = arg_vars(item.second);
+      if (bases.size() != 1) {
+        invalid_op = true;
+        continue;
+      }
+      for (auto &view : arg_vars(item.first)) {
+        if (view != bases.front()) views.emplace_back(view, bases.front());
+      }
+    }
+    std::vector<std::string> args = cpp_desc.input_vars();
+    auto out_args = cpp_desc.output_vars();
+    args.insert(args.end(), out_args.begin(), out_args.end());
+    for (auto &arg : args) {
+      if (persistable_vars.count(arg) || !var_elem_size.count(arg)) continue;
+      if (invalid_op) excluded_vars.insert(arg);
+      if (!lifetimes.count(arg)) {
+        lifetimes[arg] = std::make_pair(op_idx, op_idx);
+      } else {
+        lifetimes[arg].second = std::max(lifetimes[arg].second, op_idx);
+      }
+    }
+    ops.push_back(cpp_desc);
+  }
+
+  // Plan the arena.
+  ArenaPlanner planner;
+  std::map<std::string, size_t> num_bytes;
+  for (auto &item : lifetimes) {
+    if (excluded_vars.count(item.first)) continue;
+    const auto &tensor =
+        tmp_scope.FindVar(item.first)->Get<lite::Tensor>();
+    size_t bytes = tensor.dims().production() * var_elem_size[item.first];
+    if (bytes == 0) continue;
+    num_bytes[item.first] = bytes;
+    planner.AddVar(item.first, bytes, item.second.first, item.second.second);
+  }
+  for (auto &view : views) {
+    planner.AddView(view.first, view.second);
+  }
+  std::map<std::string, size_t> arena_offsets;
+  size_t arena_size = planner.Plan(&arena_offsets);
+  LOG(INFO) << "static arena size: " << arena_size << " bytes for "
+            << arena_offsets.size() << " temporary variables";
+
+  // Pack the weights.
+  std::string blob;
+  std::vector<std::pair<std::string, size_t>> weight_offsets;
+  for (auto &name : persistable_vars) {
+    if (name == "feed" || name == "fetch") continue;
+    const auto &tensor = exec_scope_.FindVar(name)->Get<lite::Tensor>();
+    size_t offset = (blob.size() + ArenaPlanner::kAlignment - 1) /
+                    ArenaPlanner::kAlignment * ArenaPlanner::kAlignment;
+    blob.resize(offset);
+    blob.append(static_cast<const char *>(tensor.raw_data()),
+                tensor.memory_size());
+    weight_offsets.emplace_back(name, offset);
+  }
+
+  Module m;
+  m.set_target(target);
+  m.AddHeaderIncludeGenCode();
+  m.AddNamespaceBegin();
+  m.AddWeightBlob(blob);
+  m.AddInitFuncBegin();
+  m.AddMemberCast();
+  m.AddScopeDecl();
+  m.AddValidPlaceDecl();
+  m.AddArenaDecl(arena_size);
+
+  for (auto &item : weight_offsets) {
+    m.AddStaticWeight(item.first,
+                      exec_scope_.FindVar(item.first)->Get<lite::Tensor>(),
+                      item.second);
+  }
+  std::set<std::string> declared_vars;
+  for (auto &var : block.vars()) {
+    if (var.persistable() || !declared_vars.insert(var.name()).second) {
+      continue;
+    }
+    auto *tmp_var = tmp_scope.FindVar(var.name());
+    if (arena_offsets.count(var.name())) {
+      m.AddStaticTmpVar(var.name(),
+                        tmp_var->Get<lite::Tensor>(),
+                        num_bytes[var.name()],
+                        arena_offsets[var.name()]);
+    } else if (tmp_var->IsType<lite::Tensor>()) {
+      // The kernels do not infer the shapes in static mode, so the vars out
+      // of the arena still get the inferred ones.
+      m.AddStaticTmpVar(var.name(), tmp_var->Get<lite::Tensor>());
+    } else {
+      m.AddTmpVar(var.name());
+    }
+  }
+  for (auto &op : ops) {
+    m.AddOp(op);
+  }
+
+  m.AddInitFuncEnd();
+  m.AddNamespaceEnd();
+
+  m.AddOpCompileDeps();
+  m.AddKernelCompileDeps();
+
+  return m.stream().str();
+}
+
 }  // namespace gencode
 }  // namespace lite
 }  // namespace paddle
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lite/core/framework.pb.h"
 #include "lite/core/program.h"
@@ -44,6 +46,42 @@ struct TensorRepr {
   size_t num_bytes{};
 };
 
+// The memory layout of the temporary variables in static mode. Each variable
+// lives at a fixed offset of one arena, two variables share memory only if
+// their lifetimes (the range of op indices that touch them) do not overlap.
+class ArenaPlanner {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  void AddVar(const std::string &name,
+              size_t num_bytes,
+              int first_use,
+              int last_use);
+
+  // `view` lives in the memory of `base` at runtime, such as the outputs of
+  // split with buffer views. A base and all its views are planned as one
+  // variable alive as long as any of them, and only the base gets an offset.
+  // No variable of the group gets one if a view has several bases or a
+  // variable of the group is not added.
+  void AddView(const std::string &view, const std::string &base);
+
+  // Assign offsets to all the variables and return the size of the arena.
+  size_t Plan(std::map<std::string, size_t> *offsets) const;
+
+ private:
+  struct VarRecord {
+    std::string name;
+    size_t num_bytes;
+    int first_use;
+    int last_use;
+  };
+  // Merge the views into the records of their bases.
+  std::vector<VarRecord> MergeViews() const;
+
+  std::vector<VarRecord> vars_;
+  std::set<std::pair<std::string, std::string>> views_;
+};
+
 class Module {
   std::vector<cpp::OpDesc> ops;
   std::vector<TensorRepr> weights;
@@ -54,6 +92,9 @@ class Module {
 
   int line_indent_{};
   const int indent_unit_{2};
+  // The target of the kernels, the weights and the temporary variables live
+  // on it.
+  TargetType target_{TARGET(kHost)};
 
  public:
   void NewOp(const cpp::OpDesc &desc) { ops.push_back(desc); }
@@ -62,6 +103,8 @@ class Module {
 
   STL::stringstream &stream() { return stream_; }
 
+  void set_target(TargetType target) { target_ = target; }
+
   void AddHeaderIncludeGenCode();
 
   void AddNamespaceBegin() {
@@ -102,7 +145,7 @@ class Module {
 
   void AddValidPlaceDecl() {
     // clang-format off
-    Line("std::vector<lite::Place> valid_places({lite::Place({TARGET(kX86), PRECISION(kFloat), DATALAYOUT(kNCHW)})});");  // NOLINT
+    Line(string_format("std::vector<lite::Place> valid_places({lite::Place({TARGET(%s), PRECISION(kFloat), DATALAYOUT(kNCHW)})});", TargetRepr(target_).c_str()));  // NOLINT
     // clang-format on
   }
 
@@ -117,6 +160,29 @@ class Module {
 
   void AddWeight(const std::string &name, const TensorRepr &tensor);
 
+  // Static mode: all the weights are packed into one blob linked into the
+  // binary, the tensors just point into it.
+  void AddWeightBlob(const std::string &blob);
+  void AddStaticWeight(const std::string &name,
+                       const lite::Tensor &tensor,
+                       size_t blob_offset);
+
+  // Static mode: the temporary variables are resized once and placed at fixed
+  // offsets of the predictor's arena. The ones out of the arena only get
+  // their shapes, their memory is allocated by the kernels.
+  void AddArenaDecl(size_t arena_size) {
+    Line("// Allocate the arena for all the temporary variables.");
+    Line("raw_arena_ = lite::TargetMalloc(TARGET(kHost), " +
+         std::to_string(arena_size) + ");");
+    Line("static_shape_ = true;");
+    Line("");
+  }
+  void AddStaticTmpVar(const std::string &name,
+                       const lite::Tensor &tensor,
+                       size_t num_bytes,
+                       size_t arena_offset);
+  void AddStaticTmpVar(const std::string &name, const lite::Tensor &tensor);
+
   void AddTmpVar(const std::string &x) {
     Line(string_format("// Create temporary variable: %s", x.c_str()));
     Line(string_format("exec_scope->Var(%s);", Repr(x).c_str()));
@@ -167,6 +233,10 @@ class Module {
 
   std::string DataRepr(const std::string &raw_data, PrecisionType dtype);
 
+  // Declare the temporary variable and set its shape, return its C++ name.
+  std::string AddTmpVarShape(const std::string &name,
+                             const lite::Tensor &tensor);
+
   void IncIndent() { line_indent_++; }
   void DecIndent() { line_indent_--; }
 
@@ -188,8 +258,17 @@ class ProgramCodeGenerator {
                        const lite::Scope &exec_scope)
       : program_(program), exec_scope_(exec_scope) {}
 
+  // Generate the code for a program whose input shapes are fixed. The shapes
+  // of all the variables are inferred here, the weights are emitted as one
+  // blob and the temporary variables get fixed arena offsets, so the
+  // generated predictor runs the kernels without any shape inference or
+  // memory allocation.
+  std::string GenStaticCode(
+      const std::vector<std::vector<int64_t>> &feed_shapes);
+
   std::string GenCode() {
     Module m;
+    m.set_target(ProgramTarget());
     m.AddHeaderIncludeGenCode();
     m.AddNamespaceBegin();
     m.AddInitFuncBegin();
@@ -240,6 +319,9 @@ class ProgramCodeGenerator {
   }
 
  private:
+  // The target of the picked kernels, kHost if all of them are host kernels.
+  TargetType ProgramTarget() const;
+
   void TensorToRepr(const lite::Tensor &tensor, TensorRepr *repr) {
     repr->ddim = tensor.dims();
     // TODO(Superjomn) support other types.
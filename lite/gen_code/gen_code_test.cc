@@ -16,12 +16,15 @@
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <fstream>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/core/context.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/op_registry.h"
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
 #include "lite/model_parser/compatible_pb.h"
@@ -31,11 +34,58 @@
 
 DEFINE_string(optimized_model, "", "");
 DEFINE_string(generated_code_file, "__generated_code__.cc", "");
+DEFINE_string(generated_static_code_file, "__generated_static_code__.cc", "");
 
 namespace paddle {
 namespace lite {
 namespace gencode {
 
+// The kernels of split -> conv2d -> concat, so the static code test does not
+// depend on the kernels of the build.
+class FakeSplitCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+class FakeConvCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+class FakeConcatCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+};
+
+namespace {
+
+std::string KernelType(const std::string &op_type) {
+  if (op_type == "feed" || op_type == "fetch") {
+    return KernelBase::SerializeKernelType(
+        op_type,
+        "def",
+        Place{TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)});
+  }
+  return KernelBase::SerializeKernelType(
+      op_type, "fake", Place{TARGET(kHost), PRECISION(kFloat)});
+}
+
+// The arena offset of the temporary variable `name` in the static `code`, -1
+// if it is not placed in the arena.
+int ArenaOffset(const std::string &code, const std::string &name) {
+  const std::string comment = "// Create temporary variable: ";
+  auto begin = code.find(comment + name + "\n");
+  CHECK_NE(begin, std::string::npos) << name << " is not declared";
+  auto end = code.find("// ", begin + comment.size());
+  auto decl = code.substr(begin, end - begin);
+  const std::string arena = "raw_arena_) + ";
+  auto pos = decl.find(arena);
+  if (pos == std::string::npos) return -1;
+  return std::stoi(decl.substr(pos + arena.size()));
+}
+
+}  // namespace
+
 // Manually construct a program.
 TEST(gen_code, manual) {
   // For holding the weights.
@@ -142,6 +192,98 @@ TEST(gen_code, auto_gen) {
   LOG(INFO) << module.stream().str();
 }
 
+TEST(gen_code, arena_planner) {
+  ArenaPlanner planner;
+  // a and b are alive at the same time, c can reuse the memory of a.
+  planner.AddVar("a", 100, 0, 1);
+  planner.AddVar("b", 200, 1, 2);
+  planner.AddVar("c", 50, 2, 3);
+
+  std::map<std::string, size_t> offsets;
+  size_t arena_size = planner.Plan(&offsets);
+  ASSERT_EQ(offsets.size(), 3UL);
+  EXPECT_EQ(offsets["b"], 0UL);
+  EXPECT_EQ(offsets["a"], 256UL);
+  EXPECT_EQ(offsets["c"], 256UL);
+  EXPECT_EQ(arena_size, 384UL);
+  for (auto &item : offsets) {
+    EXPECT_EQ(item.second % ArenaPlanner::kAlignment, 0UL);
+  }
+}
+
+TEST(gen_code, arena_planner_views) {
+  ArenaPlanner planner;
+  // b0 and b1 are views of b, so b is alive from 0 to 3 and can not share
+  // the memory of a. c is a view of two bases, d of a variable not added,
+  // none of them is placed.
+  planner.AddVar("a", 100, 0, 1);
+  planner.AddVar("b", 200, 1, 1);
+  planner.AddVar("b0", 100, 2, 2);
+  planner.AddVar("b1", 100, 2, 3);
+  planner.AddVar("c", 50, 4, 4);
+  planner.AddVar("c0", 50, 4, 5);
+  planner.AddVar("c1", 50, 4, 5);
+  planner.AddVar("d", 50, 4, 5);
+  planner.AddView("b0", "b");
+  planner.AddView("b1", "b");
+  planner.AddView("c", "c0");
+  planner.AddView("c", "c1");
+  planner.AddView("d", "e");
+
+  std::map<std::string, size_t> offsets;
+  size_t arena_size = planner.Plan(&offsets);
+  ASSERT_EQ(offsets.size(), 2UL);
+  EXPECT_EQ(offsets["b"], 0UL);
+  EXPECT_EQ(offsets["a"], 256UL);
+  EXPECT_EQ(arena_size, 384UL);
+}
+
+// The outputs of split and the inputs of concat with buffer views live in the
+// memory of their bases, so they are not placed in the arena, while the bases
+// are, for all the lifetimes of their views.
+TEST(gen_code, static_buffer_views) {
+  mir::PassTestHelper helper;
+  helper.AddFeed("x", 0);
+  helper.AddWeight("w", {4, 4, 1, 1});
+  helper.AddWeight("w0", {2, 2, 1, 1});
+  helper.AddWeight("w1", {2, 2, 1, 1});
+  helper.AddWeight("w2", {4, 4, 1, 1});
+  helper.AddConv2D("x", "w", "a");
+  auto *split = helper.AddOp("split", {{"X", {"a"}}}, {{"Out", {"a0", "a1"}}});
+  split->SetAttr("axis", 1);
+  split->SetAttr("num", 2);
+  split->SetAttr("sections", std::vector<int>{});
+  split->SetAttr("use_buffer_view", true);
+  helper.AddConv2D("a0", "w0", "y0");
+  helper.AddConv2D("a1", "w1", "y1");
+  auto *concat =
+      helper.AddOp("concat", {{"X", {"y0", "y1"}}}, {{"Out", {"y"}}});
+  concat->SetAttr("axis", 1);
+  concat->SetAttr("use_buffer_view", true);
+  helper.AddConv2D("y", "w2", "z");
+  helper.AddFetch("z", 0);
+
+  cpp::ProgramDesc cpp_desc = helper.desc();
+  auto *block = cpp_desc.GetBlock<cpp::BlockDesc>(0);
+  for (size_t i = 0; i < block->OpsSize(); ++i) {
+    auto *op = block->GetOp<cpp::OpDesc>(i);
+    op->SetAttr<std::string>(kKernelTypeAttr, KernelType(op->Type()));
+  }
+  framework::proto::ProgramDesc pb_proto_desc;
+  lite::pb::ProgramDesc pb_desc(&pb_proto_desc);
+  TransformProgramDescCppToAny(cpp_desc, &pb_desc);
+
+  ProgramCodeGenerator codegen(pb_proto_desc, *helper.scope());
+  auto code = codegen.GenStaticCode({{1, 4, 4, 4}});
+  for (auto &view : {"a0", "a1", "y0", "y1"}) {
+    EXPECT_EQ(ArenaOffset(code, view), -1) << view;
+  }
+  // a is alive until the conv of a1 runs, after y0 is written into y.
+  EXPECT_GE(ArenaOffset(code, "a"), 0);
+  EXPECT_GE(ArenaOffset(code, "y"), 0);
+  EXPECT_NE(ArenaOffset(code, "a"), ArenaOffset(code, "y"));
+}
+
 TEST(gen_code, optimized_program) {
   lite::Scope scope;
   cpp::ProgramDesc cpp_desc;
@@ -163,6 +305,49 @@ TEST(gen_code, optimized_program) {
   file.close();
 }
 
+TEST(gen_code, optimized_program_static) {
+  lite::Scope scope;
+  cpp::ProgramDesc cpp_desc;
+  std::string model_file = FLAGS_optimized_model + "/model";
+  std::string param_file = FLAGS_optimized_model + "/params";
+  LoadModelPb(
+      FLAGS_optimized_model, model_file, param_file, &scope, &cpp_desc, true);
+
+  framework::proto::ProgramDesc pb_proto_desc;
+  lite::pb::ProgramDesc pb_desc(&pb_proto_desc);
+  TransformProgramDescCppToAny(cpp_desc, &pb_desc);
+
+  ProgramCodeGenerator codegen(pb_proto_desc, scope);
+
+  // Compiled and run against the normal predictor by test_generated_static_code.
+  std::ofstream file(FLAGS_generated_static_code_file);
+
+  file << codegen.GenStaticCode({{100, 100}});
+
+  file.close();
+}
+
 }  // namespace gencode
 }  // namespace lite
 }  // namespace paddle
+
+REGISTER_LITE_KERNEL(
+    split, kHost, kFloat, kNCHW, paddle::lite::gencode::FakeSplitCompute, fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+REGISTER_LITE_KERNEL(
+    conv2d, kHost, kFloat, kNCHW, paddle::lite::gencode::FakeConvCompute, fake)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+REGISTER_LITE_KERNEL(concat,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::gencode::FakeConcatCompute,
+                     fake)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
@@ -0,0 +1,76 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/gen_code/paddle_infer.h"
+#include "lite/utils/cp_logging.h"
+
+DEFINE_string(model_dir, "", "");
+
+namespace paddle {
+namespace lite {
+
+// The code generated in static mode for the input shape {100, 100} by
+// test_gen_code gives the same outputs as the normal predictor.
+TEST(PaddlePredictor, RunStatic) {
+  gencode::PaddlePredictor predictor;
+  predictor.Init();
+
+  lite::Predictor ref_predictor;
+  std::vector<Place> valid_places({
+#ifdef LITE_WITH_ARM
+      Place{TARGET(kARM), PRECISION(kFloat)},
+#else
+      Place{TARGET(kX86), PRECISION(kFloat)},
+#endif
+  });
+  ref_predictor.Build(FLAGS_model_dir, "", "", valid_places);
+
+  auto input_tensor = predictor.GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  auto* data = input_tensor->mutable_data<float>();
+  auto* ref_input_tensor = ref_predictor.GetInput(0);
+  ref_input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+  auto* ref_data = ref_input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = static_cast<float>(i % 13) / 13.f - 0.5f;
+    ref_data[i] = data[i];
+  }
+
+  // Run twice, the second run reuses the arena.
+  for (int repeat = 0; repeat < 2; repeat++) {
+    predictor.Run();
+    ref_predictor.Run();
+
+    auto output_tensor = predictor.GetOutput(0);
+    auto* ref_output_tensor = ref_predictor.GetOutput(0);
+    auto output_shape = output_tensor->shape();
+    ASSERT_EQ(output_shape, ref_output_tensor->dims().Vectorize());
+    const auto* output_data = output_tensor->data<float>();
+    const auto* ref_output_data = ref_output_tensor->data<float>();
+    for (int i = 0; i < ref_output_tensor->dims().production(); i++) {
+      EXPECT_NEAR(output_data[i], ref_output_data[i], 1e-5) << i;
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
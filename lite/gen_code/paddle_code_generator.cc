@@ -13,17 +13,38 @@
 // limitations under the License.
 
 #include <gflags/gflags.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
 #include "lite/gen_code/gen_code.h"
 #include "lite/model_parser/model_parser.h"
 #include "lite/model_parser/pb/program_desc.h"
+#include "lite/utils/string.h"
 
 DEFINE_string(optimized_model, "", "");
 DEFINE_string(generated_code_file, "__generated_code__.cc", "");
+DEFINE_string(static_input_shape,
+              "",
+              "generate the code in static mode with these fixed input "
+              "shapes, separated by colon and comma, such as "
+              "1,3,224,224:1,10");
 
 namespace paddle {
 namespace lite {
 namespace gencode {
 
+std::vector<std::vector<int64_t>> ParseShapes(const std::string& repr) {
+  std::vector<std::vector<int64_t>> shapes;
+  for (auto& str_shape : Split(repr, ":")) {
+    std::vector<int64_t> shape;
+    for (auto& dim : Split(str_shape, ",")) {
+      shape.push_back(std::stoll(dim));
+    }
+    shapes.push_back(shape);
+  }
+  return shapes;
+}
+
 void GenCode(const std::string& model_dir, const std::string& out_file) {
   lite::Scope scope;
   cpp::ProgramDesc cpp_desc;
@@ -39,7 +60,11 @@ void GenCode(const std::string& model_dir, const std::string& out_file) {
 
   std::ofstream file(out_file);
 
-  file << codegen.GenCode();
+  if (FLAGS_static_input_shape.empty()) {
+    file << codegen.GenCode();
+  } else {
+    file << codegen.GenStaticCode(ParseShapes(FLAGS_static_input_shape));
+  }
 
   file.close();
 }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/gen_code/paddle_infer.h"
+#include "lite/core/memory.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/tensor.h"
 
@@ -103,6 +104,9 @@ PaddlePredictor::~PaddlePredictor() {
   if (scope) {
     delete scope;
   }
+  if (raw_arena_) {
+    lite::TargetFree(TARGET(kHost), raw_arena_);
+  }
 }
 
 void PaddlePredictor::Run() {
@@ -114,8 +118,11 @@ void PaddlePredictor::Run() {
   CHECK_EQ(ops->size(), kernels->size());
 
   for (size_t i = 0; i < ops->size(); i++) {
-    LOG(INFO) << "Running the " << i << "-th operator";
-    ops->at(i)->InferShape();
+    VLOG(4) << "Running the " << i << "-th operator";
+    // The shapes are baked into the generated code in static mode.
+    if (!static_shape_) {
+      ops->at(i)->InferShape();
+    }
     kernels->at(i)->Launch();
   }
 }
@@ -66,6 +66,11 @@ class PaddlePredictor {
   void *raw_kernels_;
   void *raw_scope_{};
   void *raw_exe_scope_{};  // raw_exe_scope is not owned.
+  // The following members are only used by the code generated in static
+  // mode, where all the shapes are fixed at code generation time and the
+  // temporary variables are placed at fixed offsets of one arena.
+  void *raw_arena_{};
+  bool static_shape_{false};
 };
 
 }  // namespace gencode
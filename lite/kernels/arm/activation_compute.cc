@@ -30,6 +30,16 @@ void ReluCompute::Run() {
       x_data, output_data, x_dims.production(), ctx.threads());
 }
 
+void ReluInt8Compute::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto x_dims = param.X->dims();
+  auto x_data = param.X->data<int8_t>();
+  auto output_data = param.Out->mutable_data<int8_t>();
+  lite::arm::math::act_relu<int8_t>(
+      x_data, output_data, x_dims.production(), ctx.threads());
+}
+
 void LeakyReluCompute::Run() {
   auto& param = this->Param<param_t>();
   auto& ctx = this->ctx_->template As<ARMContext>();
@@ -159,6 +169,21 @@ void HardSigmoidCompute::Run() {
       x_data, output_data, x_dims.production(), slope, offset, ctx.threads());
 }
 
+void HardSwishCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto x_dims = param.X->dims();
+  auto x_data = param.X->data<float>();
+  auto output_data = param.Out->mutable_data<float>();
+  lite::arm::math::act_hard_swish<float>(x_data,
+                                         output_data,
+                                         x_dims.production(),
+                                         param.hard_swish_threshold,
+                                         param.hard_swish_scale,
+                                         param.hard_swish_offset,
+                                         ctx.threads());
+}
+
 void RsqrtCompute::Run() {
   auto& param = this->Param<param_t>();
   auto& ctx = this->ctx_->template As<ARMContext>();
@@ -179,6 +204,11 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
+REGISTER_LITE_KERNEL(
+    relu, kARM, kInt8, kNCHW, paddle::lite::kernels::arm::ReluInt8Compute, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
 REGISTER_LITE_KERNEL(leaky_relu,
                      kARM,
                      kFloat,
@@ -255,6 +285,15 @@ REGISTER_LITE_KERNEL(hard_sigmoid,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
+REGISTER_LITE_KERNEL(hard_swish,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::HardSwishCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
 REGISTER_LITE_KERNEL(
     rsqrt, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::RsqrtCompute, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
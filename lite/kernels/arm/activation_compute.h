@@ -31,6 +31,16 @@ class ReluCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   virtual ~ReluCompute() = default;
 };
 
+// The relu on int8 activations, the output keeps the scale of the input.
+class ReluInt8Compute : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void Run() override;
+
+  virtual ~ReluInt8Compute() = default;
+};
+
 class LeakyReluCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   using param_t = operators::ActivationParam;
@@ -130,6 +140,15 @@ class HardSigmoidCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   virtual ~HardSigmoidCompute() = default;
 };
 
+class HardSwishCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void Run() override;
+
+  virtual ~HardSwishCompute() = default;
+};
+
 class RsqrtCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   using param_t = operators::ActivationParam;
@@ -0,0 +1,67 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/kernels/arm/activation_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+TEST(relu_int8, retrive_op) {
+  auto relu = KernelRegistry::Global().Create<TARGET(kARM), PRECISION(kInt8)>(
+      "relu");
+  ASSERT_FALSE(relu.empty());
+  ASSERT_TRUE(relu.front());
+}
+
+TEST(relu_int8, compute) {
+  ReluInt8Compute relu;
+  operators::ActivationParam param;
+  lite::Tensor x, output;
+  // The sizes cover the neon loop of 16 and the remain.
+  for (int size : {1, 15, 16, 33, 1000}) {
+    x.Resize(DDim(std::vector<int64_t>({1, size})));
+    output.Resize(x.dims());
+    auto* x_data = x.mutable_data<int8_t>();
+    for (int i = 0; i < size; i++) {
+      x_data[i] = static_cast<int8_t>(i * 37 % 256 - 128);
+    }
+    param.X = &x;
+    param.Out = &output;
+    relu.SetParam(param);
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<ARMContext>();
+    relu.SetContext(std::move(ctx));
+    relu.Run();
+    auto* output_data = output.data<int8_t>();
+    for (int i = 0; i < size; i++) {
+      EXPECT_EQ(output_data[i], std::max<int8_t>(x_data[i], 0));
+    }
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(relu, kARM, kInt8, kNCHW, def);
@@ -31,6 +31,15 @@ class ConcatCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   virtual ~ConcatCompute() = default;
 };
 
+class ConcatInt8Compute : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ConcatParam;
+
+  void Run() override;
+
+  virtual ~ConcatInt8Compute() = default;
+};
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
@@ -53,6 +53,7 @@ bool infer_shape(const operators::ConcatParam& param) {
   return true;
 }
 
+template <typename T = float>
 void concat_compute_ref(const operators::ConcatParam& param) {
   std::vector<lite::Tensor*> input = param.x;
   int axis = param.axis;
@@ -79,15 +80,15 @@ void concat_compute_ref(const operators::ConcatParam& param) {
   }
 
   // computation
-  auto output_data = output->mutable_data<float>();
+  auto output_data = output->mutable_data<T>();
   int col_idx = 0;
   for (int j = 0; j < num; ++j) {
     int col_len = input_cols[j];
-    auto input_data = input[j]->data<float>();
+    auto input_data = input[j]->data<T>();
     for (int k = 0; k < out_rows; ++k) {
       memcpy(output_data + k * out_cols + col_idx,
              input_data + k * col_len,
-             sizeof(float) * col_len);
+             sizeof(T) * col_len);
     }
     col_idx += col_len;
   }
@@ -220,6 +221,44 @@ TEST(concat_arm, compute_input_multi) {
   }
 }
 
+TEST(concat_arm, compute_int8) {
+  ConcatInt8Compute concat;
+  operators::ConcatParam param;
+
+  lite::Tensor output;
+  lite::Tensor output_ref;
+  lite::Tensor tensorA;
+  lite::Tensor tensorB;
+  DDimLite ddimA({2, 3, 4, 5});
+  DDimLite ddimB({2, 3, 4, 5});
+  tensorA.Resize(ddimA);
+  tensorB.Resize(ddimB);
+  for (int i = 0; i < ddimA.production(); i++) {
+    tensorA.mutable_data<int8_t>()[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+    tensorB.mutable_data<int8_t>()[i] = static_cast<int8_t>(i * 53 % 255 - 127);
+  }
+
+  param.x.push_back(&tensorA);
+  param.x.push_back(&tensorB);
+  for (int cur_axis : {0, 1, 2, 3}) {
+    param.output = &output;
+    param.axis = cur_axis;
+    CHECK(infer_shape(param));
+    concat.SetParam(param);
+    concat.Run();
+
+    param.output = &output_ref;
+    concat_compute_ref<int8_t>(param);
+
+    auto* output_data = output.data<int8_t>();
+    auto* output_ref_data = output_ref.data<int8_t>();
+    ASSERT_EQ(output.dims(), output_ref.dims());
+    for (int i = 0; i < output.dims().production(); i++) {
+      EXPECT_EQ(output_data[i], output_ref_data[i]);
+    }
+  }
+}
+
 TEST(concat, retrive_op) {
   auto concat =
       KernelRegistry::Global().Create<TARGET(kARM), PRECISION(kFloat)>(
@@ -234,3 +273,4 @@ TEST(concat, retrive_op) {
 }  // namespace paddle
 
 USE_LITE_KERNEL(concat, kARM, kFloat, kNCHW, def);
+USE_LITE_KERNEL(concat, kARM, kInt8, kNCHW, def);
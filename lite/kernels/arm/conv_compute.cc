@@ -53,6 +53,7 @@ void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   bool flag_dw_5x5 =
       (kw == 5 && stride == 1) || (kw == 5 && stride == 2 && pad == 2);
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
+  bool gemm_like = false;
 
   /// select conv impl
   if (param.groups == ic && ic == oc && kps_equal && no_dilation && flag_dw) {
@@ -77,10 +78,23 @@ void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
     VLOG(3) << "invoking direct conv";
   } else {
     impl_ = new GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>;
+    gemm_like = true;
     VLOG(3) << "invoking gemm like conv";
   }
+  // The gemm like conv fuses the residual add and the activations into the
+  // epilogue of its GEMM, the others only fuse the bias and relu.
+  auto impl_param = param;
+  if (!gemm_like &&
+      (param.residualData ||
+       (param.activation_param.has_active && !param.fuse_relu))) {
+    impl_param.residualData = nullptr;
+    impl_param.fuse_relu = false;
+    impl_param.activation_param.has_active = false;
+    flag_residual_act_ = true;
+  }
   impl_->SetContext(std::move(this->ctx_));
-  impl_->SetParam(param);
+  impl_->SetParam(impl_param);
+  impl_->SetPreparedWeights(prepared_key_, prepared_weights_);
   impl_->PrepareForRun();
   is_first_epoch_ = false;
 }
@@ -88,6 +102,8 @@ void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
 template <>
 void ConvCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
   auto& param = this->Param<param_t>();
+  CHECK(param.residualData == nullptr)
+      << "the int8 conv does not fuse the residual add";
   auto w_dims = param.filter->dims();
 
   auto& ctx = this->ctx_->template As<ARMContext>();
@@ -120,6 +136,7 @@ void ConvCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
   }
   impl_->SetContext(std::move(this->ctx_));
   impl_->SetParam(param);
+  impl_->SetPreparedWeights(prepared_key_, prepared_weights_);
   impl_->PrepareForRun();
   is_first_epoch_ = false;
 }
@@ -127,6 +144,8 @@ void ConvCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
 template <>
 void ConvCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
   auto& param = this->Param<param_t>();
+  CHECK(param.residualData == nullptr)
+      << "the int8 conv does not fuse the residual add";
   auto w_dims = param.filter->dims();
 
   auto& ctx = this->ctx_->template As<ARMContext>();
@@ -159,6 +178,7 @@ void ConvCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
   }
   impl_->SetContext(std::move(this->ctx_));
   impl_->SetParam(param);
+  impl_->SetPreparedWeights(prepared_key_, prepared_weights_);
   impl_->PrepareForRun();
   is_first_epoch_ = false;
 }
@@ -181,6 +201,7 @@ typedef paddle::lite::kernels::arm::ConvCompute<PRECISION(kInt8),
 REGISTER_LITE_KERNEL(conv2d, kARM, kFloat, kNCHW, ConvFp32, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("ResidualData", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -188,6 +209,7 @@ REGISTER_LITE_KERNEL(conv2d, kARM, kFloat, kNCHW, ConvFp32, def)
 REGISTER_LITE_KERNEL(depthwise_conv2d, kARM, kFloat, kNCHW, ConvFp32, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("ResidualData", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
+#include <string>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/kernel.h"
 
@@ -34,6 +36,28 @@ class ConvCompute : public KernelLite<TARGET(kARM), Ptype> {
   virtual void Run() {
     CHECK(impl_);
     impl_->Run();
+    if (flag_residual_act_) {
+      lite::arm::math::conv_residual_act(this->template Param<param_t>());
+    }
+  }
+
+  std::map<std::string, const Tensor*> PreparedWeights() const override {
+    if (impl_ == nullptr) return {};
+    return impl_->PreparedWeights();
+  }
+
+  std::string PreparedWeightsKey() const override {
+    if (impl_ == nullptr) return "";
+    return impl_->PreparedWeightsKey();
+  }
+
+  /// The impl is selected in `PrepareForRun`, so keep the restored weights and
+  /// hand them over to the impl then.
+  void SetPreparedWeights(
+      const std::string& key,
+      const std::map<std::string, const Tensor*>& weights) override {
+    prepared_key_ = key;
+    prepared_weights_ = weights;
   }
 
   ~ConvCompute() {
@@ -45,6 +69,11 @@ class ConvCompute : public KernelLite<TARGET(kARM), Ptype> {
  private:
   using param_t = operators::ConvParam;
   KernelLite<TARGET(kARM), Ptype>* impl_{nullptr};
+  // The impl only fuses the bias and relu, and the residual add and the
+  // activation of the fused conv are applied after it.
+  bool flag_residual_act_{false};
+  std::string prepared_key_;
+  std::map<std::string, const Tensor*> prepared_weights_;
 };
 
 }  // namespace arm
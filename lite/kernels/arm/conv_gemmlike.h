@@ -15,9 +15,13 @@
 #pragma once
 
 #include <cmath>
+#include <map>
+#include <string>
 #include <vector>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/arm/math/gemm_prepacked_int8.h"
+#include "lite/backends/arm/math/packed_sgemm.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
 #include "lite/core/target_wrapper.h"
@@ -75,8 +79,15 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
       workspace_size_ = k * n * sizeof(float);
     }
     if (!flag_trans_weights_ && n > 1) {
-      lite::arm::math::trans_gemm_weights<Ptype>(
-          *(param.filter), weights_, param.groups, &ctx);
+      auto it = prepared_weights_.find("Filter");
+      if (prepared_key_ == PreparedWeightsKey() &&
+          it != prepared_weights_.end() && it->second->numel() > 0) {
+        weights_.ShareDataWith(*it->second);
+      } else {
+        lite::arm::math::trans_gemm_weights<Ptype>(
+            *(param.filter), weights_, param.groups, &ctx);
+        weights_.set_precision(Ptype);
+      }
       flag_trans_weights_ = true;
     } else if (n == 1) {
       flag_trans_weights_ = false;
@@ -87,6 +98,34 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
   virtual void PrepareForRun();
   virtual void Run();
 
+  std::map<std::string, const Tensor*> PreparedWeights() const override {
+    if (!flag_trans_weights_) return {};
+    return {{"Filter", &weights_}};
+  }
+
+  /// The packed weights depend on the precision and the blocking of the
+  /// prepacked gemm, which is selected by the arch and the CPU.
+  std::string PreparedWeightsKey() const override {
+    auto& ctx = this->ctx_->template As<ARMContext>();
+    int hblock = Ptype == PRECISION(kInt8)
+                     ? lite::arm::math::get_hblock_int8(&ctx)
+                     : lite::arm::math::get_hblock(&ctx);
+#ifdef __aarch64__
+    std::string arch = "armv8";
+#else
+    std::string arch = "armv7";
+#endif
+    return "gemm_like/" + arch + "/" + PrecisionToStr(Ptype) + "/hblock_" +
+           std::to_string(hblock);
+  }
+
+  void SetPreparedWeights(
+      const std::string& key,
+      const std::map<std::string, const Tensor*>& weights) override {
+    prepared_key_ = key;
+    prepared_weights_ = weights;
+  }
+
   /// todo, support inplace weights transform
  protected:
   using param_t = operators::ConvParam;
@@ -98,6 +137,8 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
   Tensor weights_;
   Tensor bias_;
   int workspace_size_{0};
+  std::string prepared_key_;
+  std::map<std::string, const Tensor*> prepared_weights_;
 };
 
 }  // namespace arm
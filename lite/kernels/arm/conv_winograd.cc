@@ -74,8 +74,17 @@ void WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   const int n_wino = size_tile;
   int hblock = lite::arm::math::get_hblock(&ctx);
   int m_round = hblock * ((m_wino + hblock - 1) / hblock);
-  weights_.Resize({1, 1, 1, 8 * 8 * m_round * ic});
   workspace_size_ = (size_trans_channel * max_ch * 2 + n_wino) * sizeof(float);
+  auto it = prepared_weights_.find("Filter");
+  if (prepared_key_ == PreparedWeightsKey() && it != prepared_weights_.end() &&
+      it->second->numel() == 8 * 8 * m_round * ic) {
+    // reuse the weights transformed and saved with the optimized model
+    weights_.ShareDataWith(*it->second);
+    weights_.Resize({1, 1, 1, 8 * 8 * m_round * ic});
+    return;
+  }
+  weights_.Resize({1, 1, 1, 8 * 8 * m_round * ic});
+  weights_.set_precision(PRECISION(kFloat));
   auto weights_wino =
       static_cast<float*>(malloc(sizeof(float) * 8 * 8 * oc * ic));
   void* trans_tmp_ptr = malloc(sizeof(float) * 8 * 8 * oc * ic);
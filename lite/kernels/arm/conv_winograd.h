@@ -15,7 +15,10 @@
 #pragma once
 
 #include <cmath>
+#include <map>
+#include <string>
 #include "lite/backends/arm/math/conv_impl.h"
+#include "lite/backends/arm/math/packed_sgemm.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
 #include "lite/core/target_wrapper.h"
@@ -35,11 +38,38 @@ class WinogradConv : public KernelLite<TARGET(kARM), Ptype> {
   virtual void ReInitWhenNeeded();
   virtual void Run();
 
+  std::map<std::string, const Tensor*> PreparedWeights() const override {
+    if (!weights_.IsInitialized()) return {};
+    return {{"Filter", &weights_}};
+  }
+
+  /// The transformed weights are packed by the prepacked sgemm, whose blocking
+  /// is selected by the arch and the CPU.
+  std::string PreparedWeightsKey() const override {
+    auto& ctx = this->ctx_->template As<ARMContext>();
+#ifdef __aarch64__
+    std::string arch = "armv8";
+#else
+    std::string arch = "armv7";
+#endif
+    return "winograd_f6k3/" + arch + "/hblock_" +
+           std::to_string(lite::arm::math::get_hblock(&ctx));
+  }
+
+  void SetPreparedWeights(
+      const std::string& key,
+      const std::map<std::string, const Tensor*>& weights) override {
+    prepared_key_ = key;
+    prepared_weights_ = weights;
+  }
+
  protected:
   using param_t = operators::ConvParam;
   Tensor weights_;
   DDim last_shape_;
   int workspace_size_{0};
+  std::string prepared_key_;
+  std::map<std::string, const Tensor*> prepared_weights_;
 };
 
 }  // namespace arm
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/elementwise_compute.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/gemm_epilogue.h"
 
 namespace paddle {
 namespace lite {
@@ -89,6 +91,44 @@ void ElementwiseAddCompute::Run() {
   }
 }
 
+// out = act(x + y) for the activations other than relu. The sum of each
+// block is activated while it is still in cache.
+inline void elementwise_add_act(const float* x_data,
+                                const float* y_data,
+                                float* out_data,
+                                const DDim& x_dims,
+                                const DDim& y_dims,
+                                int axis,
+                                const operators::ActivationParam& act_param) {
+  lite::host::math::GemmEpilogue epilogue;
+  lite::host::math::set_epilogue_act(act_param, &epilogue);
+  int pre, n, post;
+  if (is_broadcast(x_dims, y_dims, axis, &pre, &n, &post)) {
+    // The nested parallel regions of the adds run on a single thread.
+#pragma omp parallel for
+    for (int i = 0; i < pre * n; ++i) {
+      const int64_t offset = static_cast<int64_t>(i) * post;
+      lite::arm::math::elementwise_add_broadcast(
+          x_data + offset, y_data + i % n, out_data + offset, 1, 1, post);
+      lite::host::math::apply_gemm_epilogue(
+          epilogue, 0, 1, 0, post, out_data + offset, post);
+    }
+  } else {
+    const int64_t num = x_dims.production();
+    const int64_t block = 4096;
+    const int64_t blocks = (num + block - 1) / block;
+#pragma omp parallel for
+    for (int64_t i = 0; i < blocks; ++i) {
+      const int64_t offset = i * block;
+      const int len = static_cast<int>(std::min(block, num - offset));
+      lite::arm::math::elementwise_add(
+          x_data + offset, y_data + offset, out_data + offset, len);
+      lite::host::math::apply_gemm_epilogue(
+          epilogue, 0, 1, 0, len, out_data + offset, len);
+    }
+  }
+}
+
 void ElementwiseAddActivationCompute::Run() {
   auto& param = Param<operators::FusionElementwiseActivationParam>();
   const float* x_data = param.X->data<float>();
@@ -98,24 +138,69 @@ void ElementwiseAddActivationCompute::Run() {
   std::string act_type = param.act_type;
   auto x_dims = param.X->dims();
   auto y_dims = param.Y->dims();
+  if (act_type != "relu") {
+    elementwise_add_act(x_data,
+                        y_data,
+                        out_data,
+                        x_dims,
+                        y_dims,
+                        axis,
+                        param.activation_param);
+    return;
+  }
   int pre, n, post;
   if (is_broadcast(x_dims, y_dims, axis, &pre, &n, &post)) {
-    if (act_type == "relu") {
-      lite::arm::math::elementwise_add_relu_broadcast(
-          x_data, y_data, out_data, pre, n, post);
-    } else {
-      LOG(FATAL) << "unsupported Activation type: " << act_type;
-    }
+    lite::arm::math::elementwise_add_relu_broadcast(
+        x_data, y_data, out_data, pre, n, post);
   } else {
-    if (act_type == "relu") {
-      lite::arm::math::elementwise_add_relu(
-          x_data, y_data, out_data, x_dims.production());
-    } else {
-      LOG(FATAL) << "unsupported Activation type: " << act_type;
-    }
+    lite::arm::math::elementwise_add_relu(
+        x_data, y_data, out_data, x_dims.production());
   }
 }
 
+inline void ElementwiseAddInt8(const operators::ElementwiseParam& param,
+                              bool relu) {
+  const int8_t* x_data = param.X->data<int8_t>();
+  const int8_t* y_data = param.Y->data<int8_t>();
+  int8_t* out_data = param.Out->mutable_data<int8_t>();
+  auto x_dims = param.X->dims();
+  auto y_dims = param.Y->dims();
+  int pre, n, post;
+  if (is_broadcast(x_dims, y_dims, param.axis, &pre, &n, &post)) {
+    lite::arm::math::elementwise_add_int8_broadcast(x_data,
+                                                    y_data,
+                                                    out_data,
+                                                    pre,
+                                                    n,
+                                                    post,
+                                                    param.x_input_scale,
+                                                    param.y_input_scale,
+                                                    param.output_scale,
+                                                    relu);
+  } else {
+    lite::arm::math::elementwise_add_int8(x_data,
+                                          y_data,
+                                          out_data,
+                                          x_dims.production(),
+                                          param.x_input_scale,
+                                          param.y_input_scale,
+                                          param.output_scale,
+                                          relu);
+  }
+}
+
+void ElementwiseAddInt8Compute::Run() {
+  auto& param = Param<operators::ElementwiseParam>();
+  ElementwiseAddInt8(param, false);
+}
+
+void ElementwiseAddActivationInt8Compute::Run() {
+  auto& param = Param<operators::FusionElementwiseActivationParam>();
+  CHECK_EQ(param.act_type, "relu") << "unsupported Activation type: "
+                                   << param.act_type;
+  ElementwiseAddInt8(param, true);
+}
+
 void ElementwiseSubCompute::Run() {
   auto& param = Param<operators::ElementwiseParam>();
   const float* x_data = param.X->data<float>();
@@ -324,6 +409,29 @@ REGISTER_LITE_KERNEL(
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
 
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kARM,
+                     kInt8,
+                     kNCHW,
+                     paddle::lite::kernels::arm::ElementwiseAddInt8Compute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    fusion_elementwise_add_activation,
+    kARM,
+    kInt8,
+    kNCHW,
+    paddle::lite::kernels::arm::ElementwiseAddActivationInt8Compute,
+    def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+
 REGISTER_LITE_KERNEL(elementwise_sub,
                      kARM,
                      kFloat,
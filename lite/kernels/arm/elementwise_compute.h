@@ -38,6 +38,23 @@ class ElementwiseAddActivationCompute
   virtual ~ElementwiseAddActivationCompute() = default;
 };
 
+// The int8 add requantizes X and Y to the scale of Out.
+class ElementwiseAddInt8Compute
+    : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseAddInt8Compute() = default;
+};
+
+class ElementwiseAddActivationInt8Compute
+    : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseAddActivationInt8Compute() = default;
+};
+
 class ElementwiseSubCompute
     : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
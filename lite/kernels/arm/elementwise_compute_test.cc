@@ -14,6 +14,8 @@
 
 #include "lite/kernels/arm/elementwise_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 #include "lite/core/op_registry.h"
@@ -220,6 +222,50 @@ TEST(elementwise_add, compute) {
   }
 }
 
+TEST(elementwise_add_int8, compute) {
+  ElementwiseAddInt8Compute elementwise_add;
+  operators::ElementwiseParam param;
+  lite::Tensor x, y, output;
+  auto x_dim = DDim(std::vector<int64_t>({2, 3, 4, 5}));
+  for (auto yd : {std::vector<int64_t>({2, 3, 4, 5}),
+                  std::vector<int64_t>({3})}) {
+    // The same scales are a saturating add, the others requantize.
+    for (auto y_scale : {0.1f, 0.05f}) {
+      auto y_dim = DDim(yd);
+      x.Resize(x_dim);
+      y.Resize(y_dim);
+      output.Resize(x_dim);
+      auto* x_data = x.mutable_data<int8_t>();
+      auto* y_data = y.mutable_data<int8_t>();
+      for (int i = 0; i < x_dim.production(); i++) {
+        x_data[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+      }
+      for (int i = 0; i < y_dim.production(); i++) {
+        y_data[i] = static_cast<int8_t>(i * 53 % 255 - 127);
+      }
+      param.X = &x;
+      param.Y = &y;
+      param.axis = 1;
+      param.Out = &output;
+      param.x_input_scale = 0.1f;
+      param.y_input_scale = y_scale;
+      param.output_scale = 0.1f;
+      elementwise_add.SetParam(param);
+      elementwise_add.Run();
+      auto* output_data = output.data<int8_t>();
+      int inner = y_dim.production() == 3 ? 20 : 1;
+      for (int i = 0; i < x_dim.production(); i++) {
+        int y_idx = inner == 1 ? i : i / inner % 3;
+        float ref = (x_data[i] * param.x_input_scale +
+                     y_data[y_idx] * param.y_input_scale) /
+                    param.output_scale;
+        ref = std::max(-128.f, std::min(127.f, std::round(ref)));
+        EXPECT_NEAR(output_data[i], ref, 1);
+      }
+    }
+  }
+}
+
 TEST(fusion_elementwise_add_activation_arm, retrive_op) {
   auto fusion_elementwise_add_activation =
       KernelRegistry::Global().Create<TARGET(kARM), PRECISION(kFloat)>(
@@ -715,6 +761,7 @@ TEST(fusion_elementwise_max_activation_arm, compute) {
 
 USE_LITE_KERNEL(elementwise_add, kARM, kFloat, kNCHW, def);
 USE_LITE_KERNEL(fusion_elementwise_add_activation, kARM, kFloat, kNCHW, def);
+USE_LITE_KERNEL(elementwise_add, kARM, kInt8, kNCHW, def);
 USE_LITE_KERNEL(elementwise_mul, kARM, kFloat, kNCHW, def);
 USE_LITE_KERNEL(fusion_elementwise_mul_activation, kARM, kFloat, kNCHW, def);
 USE_LITE_KERNEL(elementwise_max, kARM, kFloat, kNCHW, def);
@@ -18,6 +18,7 @@
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/backends/arm/math/gemv_arm_int8.h"
+#include "lite/backends/host/math/gemm_epilogue.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 
@@ -37,6 +38,8 @@ template <>
 void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
   ReInitWhenNeeded();
   auto& param = this->template Param<operators::FcParam>();
+  CHECK(param.residualData == nullptr)
+      << "the int8 fc does not fuse the residual add";
   /// update scale
   float input_scale = param.input_scale;
   int extend_size = flag_gemm_ ? m_ : n_;
@@ -55,6 +58,8 @@ template <>
 void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
   ReInitWhenNeeded();
   auto& param = this->template Param<operators::FcParam>();
+  CHECK(param.residualData == nullptr)
+      << "the int8 fc does not fuse the residual add";
   /// update scale
   scale_ = param.weight_scale;
   float input_scale = param.input_scale;
@@ -88,11 +93,59 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
   auto i_data = param.input->data<float>();
   auto o_data = param.output->mutable_data<float>();
-  auto w_data = flag_gemm_ ? param.w->data<float>() : weights_.data<float>();
   const float* b_data = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
     b_data = bias_.data<float>();
   }
+  if (param.bias) {
+    CHECK_EQ(param.bias->numel(), n_);
+  }
+  // The bias, the residual add and the activation of the fused fc, whose
+  // channels are the columns of the output.
+  lite::host::math::GemmEpilogue epilogue;
+  epilogue.channel_is_row = false;
+  epilogue.bias = b_data;
+  if (param.residualData) {
+    CHECK_EQ(param.residualData->numel(), static_cast<int64_t>(m_) * n_);
+    epilogue.residual = param.residualData->data<float>();
+    epilogue.ldr = n_;
+  }
+  epilogue.act = lite::host::math::epilogue_act_type(param.activation_type);
+  epilogue.leaky_alpha = param.leaky_relu_alpha;
+  epilogue.relu6_threshold = param.relu6_threshold;
+
+  if (param.dynamic_quant) {
+    lite::arm::math::sgemm_dynamic_quant(m_,
+                                         n_,
+                                         k_,
+                                         i_data,
+                                         param.w->data<int8_t>(),
+                                         param.weight_only_scale->data<float>(),
+                                         epilogue,
+                                         o_data,
+                                         &quant_input_,
+                                         &ctx);
+    return;
+  }
+  if (param.weight_only_quant_bits) {
+    lite::arm::math::sgemm_weight_only_quant(
+        m_,
+        n_,
+        k_,
+        i_data,
+        param.w->data<int8_t>(),
+        param.weight_only_scale->data<float>(),
+        param.weight_only_quant_bits,
+        o_data,
+        &weight_block_,
+        &ctx);
+    if (!epilogue.empty()) {
+      lite::host::math::apply_gemm_epilogue(
+          epilogue, 0, m_, 0, n_, o_data, n_);
+    }
+    return;
+  }
+  auto w_data = flag_gemm_ ? param.w->data<float>() : weights_.data<float>();
   if (flag_gemm_) {
     lite::arm::math::sgemm(false,
                            false,
@@ -107,27 +160,33 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                            0.f,
                            o_data,
                            n_,
-                           nullptr,
-                           false,
-                           false,
+                           epilogue,
                            &ctx);
-    if (param.bias) {
-      CHECK_EQ(param.bias->numel(), n_);
-      lite::arm::math::fill_bias_fc(o_data, b_data, m_, n_);
-    }
   } else {
+    // The GEMV fuses the bias and relu, the rest is applied to each row.
+    const bool gemv_fused =
+        epilogue.residual == nullptr &&
+        (epilogue.act == lite_api::ActivationType::kIndentity ||
+         epilogue.act == lite_api::ActivationType::kRelu);
+    lite::host::math::GemmEpilogue rest = epilogue;
+    rest.bias = nullptr;
     for (int i = 0; i < m_; ++i) {
       auto i_data_batch = i_data + i * k_;
       auto o_data_batch = o_data + i * n_;
-      lite::arm::math::sgemv(w_data,
-                             i_data_batch,
-                             o_data_batch,
-                             false,
-                             n_,
-                             k_,
-                             param.bias != nullptr,
-                             b_data,
-                             false);
+      lite::arm::math::sgemv(
+          w_data,
+          i_data_batch,
+          o_data_batch,
+          false,
+          n_,
+          k_,
+          param.bias != nullptr,
+          b_data,
+          gemv_fused && epilogue.act == lite_api::ActivationType::kRelu);
+      if (!gemv_fused) {
+        lite::host::math::apply_gemm_epilogue(
+            rest, i, i + 1, 0, n_, o_data, n_);
+      }
     }
   }
 }
@@ -248,7 +307,9 @@ typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kInt8),
 REGISTER_LITE_KERNEL(fc, kARM, kFloat, kNCHW, FcCompute_FP32, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("ResidualData", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
 
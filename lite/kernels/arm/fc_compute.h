@@ -101,10 +101,15 @@ class FcCompute : public KernelLite<TARGET(kARM), PType> {
     k_ = x_dims.Slice(param.in_num_col_dims, x_dims.size()).production();
     CHECK_EQ(k_, w_dims[0]);
     n_ = w_dims[1];
+    // Two int4 values of the weight-only quantized weight are stored in a byte.
+    if (param.weight_only_quant_bits == 4) {
+      n_ *= 2;
+    }
     CHECK_EQ(k_, static_cast<int>(w_dims[0]));
     flag_gemm_ = check_fc_use_gemm<PType, OutType>(
         m_, param.weight_scale, param.bias != nullptr);
-    if (!flag_trans_weights_ && !flag_gemm_) {
+    // The weight-only quantized weight is dequantized by blocks in Run.
+    if (!flag_trans_weights_ && !flag_gemm_ && !param.weight_only_quant_bits) {
       flag_trans_weights_ = true;
       fc_trans_weights<PType>(*param.w, &weights_);
     }
@@ -126,6 +131,9 @@ class FcCompute : public KernelLite<TARGET(kARM), PType> {
   int n_;
   int k_;
   std::vector<float> scale_;
+  std::vector<float> weight_block_;
+  // The input quantized at runtime in the dynamic quantization.
+  std::vector<int8_t> quant_input_;
 };
 
 }  // namespace arm
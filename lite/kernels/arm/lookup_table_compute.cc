@@ -17,6 +17,7 @@
 #include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/weight_only_quant.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
@@ -39,8 +40,11 @@ void LookupTableCompute::Run() {
   auto ids_data = ids->data<int64_t>();
 
   int64_t row_number = table_dim[0];
-  int64_t row_width = table_dim[1];
-  auto table_data = w->data<float>();
+  int64_t row_width = out->dims()[out->dims().size() - 1];
+  // The table may be quantized, then the rows are dequantized when being
+  // looked up. Two int4 values are stored in a byte.
+  int quant_bits = param.weight_only_quant_bits;
+  int64_t packed_width = table_dim[1];
   auto dout = out->mutable_data<float>();
 
   for (int64_t i = 0; i < ids_numel; ++i) {
@@ -52,9 +56,18 @@ void LookupTableCompute::Run() {
           << "look uptable ids[i] < row_number check failed";
       CHECK_GE(ids_data[i], 0) << "lookuptable ids[i] >= 0 check failed";
 
-      memcpy(dout + i * row_width,
-             table_data + ids_int * row_width,
-             row_width * sizeof(float));
+      if (quant_bits) {
+        lite::host::math::dequantize_weight_row(
+            w->data<int8_t>() + ids_int * packed_width,
+            row_width,
+            quant_bits,
+            param.weight_only_scale->data<float>()[ids_int],
+            dout + i * row_width);
+      } else {
+        memcpy(dout + i * row_width,
+               w->data<float>() + ids_int * row_width,
+               row_width * sizeof(float));
+      }
     }
   }
   *(out->mutable_lod()) = ids->lod();
@@ -72,6 +85,7 @@ REGISTER_LITE_KERNEL(lookup_table,
                      paddle::lite::kernels::arm::LookupTableCompute,
                      def)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -83,6 +97,7 @@ REGISTER_LITE_KERNEL(lookup_table_v2,
                      paddle::lite::kernels::arm::LookupTableCompute,
                      def)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/matmul_compute.h"
+#include <algorithm>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/gemm_epilogue.h"
+#include "lite/backends/host/math/matmul_batch_offsets.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 
@@ -31,7 +34,6 @@ void MatMulCompute::Run() {
   auto& param = Param<param_t>();
 
   const auto* x_data = param.X->data<float>();
-  const auto* y_data = param.Y->data<float>();
   auto* o_data = param.Out->mutable_data<float>();
 
   auto x_dims = param.X->dims();
@@ -42,9 +44,41 @@ void MatMulCompute::Run() {
   float alpha = param.alpha;
   auto& ctx = this->ctx_->template As<ARMContext>();
 
-  if (x_dims.size() > 2 && y_dims.size() >= 2) {
+  if (param.weight_only_quant_bits) {
+    // The dynamic quantization of the matmul with a constant y [K, N], alpha
+    // is folded into the scales of the columns.
+    CHECK(param.dynamic_quant);
+    CHECK_EQ(y_dims.size(), 2UL);
+    k_ = y_dims[0];
+    n_ = y_dims[1];
+    m_ = x_dims.production() / k_;
+    if (y_scale_.empty()) {
+      const float* scale = param.weight_only_scale->data<float>();
+      y_scale_.resize(n_);
+      for (int j = 0; j < n_; ++j) {
+        y_scale_[j] = scale[j] * alpha;
+      }
+    }
+    lite::arm::math::sgemm_dynamic_quant(m_,
+                                         n_,
+                                         k_,
+                                         x_data,
+                                         param.Y->data<int8_t>(),
+                                         y_scale_.data(),
+                                         lite::host::math::GemmEpilogue(),
+                                         o_data,
+                                         &quant_x_,
+                                         &ctx);
+    return;
+  }
+  const auto* y_data = param.Y->data<float>();
+
+  if ((x_dims.size() > 2 && y_dims.size() >= 2) ||
+      (x_dims.size() == 2 && y_dims.size() > 2)) {
     // x: [B, ..., M, K], y: [B, ..., K, N], out: [B, ..., M, N]
     // x: [B, M, K], y: [K, N], out: [B, M, N]
+    // x: [M, K], y: [B, K, N], out: [B, M, N]
+    // The batch dims of x and y are broadcast.
 
     if (!x_transpose && !y_transpose) {
       CHECK_EQ(x_dims[x_dims.size() - 1], y_dims[y_dims.size() - 2])
@@ -89,58 +123,45 @@ void MatMulCompute::Run() {
 
     ldc = n_;
 
-    int x_inner = x_dims[x_dims.size() - 2] * x_dims[x_dims.size() - 1];
-    int y_inner = y_dims[y_dims.size() - 2] * y_dims[y_dims.size() - 1];
     int out_inner = o_dims[o_dims.size() - 2] * o_dims[o_dims.size() - 1];
+    int batch = lite::host::math::matmul_batch_offsets(
+        x_dims, y_dims, &x_offsets_, &y_offsets_);
 
-    float* x_data_trans = nullptr;
-    if (x_transpose) {
-      x_data_trans = static_cast<float*>(malloc(sizeof(float) * x_inner));
-    }
-
-    if (y_dims.size() > 2) {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::sgemm(x_transpose,
-                               y_transpose,
-                               m_,
-                               n_,
-                               k_,
-                               alpha,
-                               x_data + i * x_inner,
-                               lda,
-                               y_data + i * y_inner,
-                               ldb,
-                               0.f,
-                               o_data + i * out_inner,
-                               ldc,
-                               nullptr,
-                               false,
-                               false,
-                               &ctx);
-      }
-    } else {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::sgemm(x_transpose,
-                               y_transpose,
-                               m_,
-                               n_,
-                               k_,
-                               alpha,
-                               x_data + i * x_inner,
-                               lda,
-                               y_data,
-                               ldb,
-                               0.f,
-                               o_data + i * out_inner,
-                               ldc,
-                               nullptr,
-                               false,
-                               false,
-                               &ctx);
+    // A matrix of x is packed once for all the matrices of y it multiplies,
+    // the transpose of x is done by the packing.
+    int hblock = lite::arm::math::get_hblock(&ctx);
+    int m_roundup = hblock * ((m_ + hblock - 1) / hblock);
+    packed_x_.Resize({static_cast<int64_t>(m_roundup) * k_});
+    auto* packed_x = packed_x_.mutable_data<float>();
+    int64_t packed_offset = -1;
+    for (int i = 0; i < batch; ++i) {
+      if (x_offsets_[i] != packed_offset) {
+        packed_offset = x_offsets_[i];
+        lite::arm::math::prepackA(packed_x,
+                                  x_data + packed_offset,
+                                  alpha,
+                                  lda,
+                                  0,
+                                  m_,
+                                  0,
+                                  k_,
+                                  x_transpose,
+                                  &ctx);
       }
-    }
-    if (x_data_trans) {
-      free(x_data_trans);
+      lite::arm::math::sgemm_prepack(y_transpose,
+                                     m_,
+                                     n_,
+                                     k_,
+                                     packed_x,
+                                     y_data + y_offsets_[i],
+                                     ldb,
+                                     0.f,
+                                     o_data + i * out_inner,
+                                     ldc,
+                                     nullptr,
+                                     false,
+                                     false,
+                                     &ctx);
     }
   } else if (x_dims.size() == 2 && y_dims.size() == 2) {
     // x: [M, K], y: [K, N], out: [M, N]
@@ -273,5 +294,6 @@ REGISTER_LITE_KERNEL(
     matmul, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::MatMulCompute, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -34,6 +35,14 @@ class MatMulCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
  private:
   int m_, n_, k_;
+  // The offsets of the matrices of x and y of each batch of out.
+  std::vector<int64_t> x_offsets_;
+  std::vector<int64_t> y_offsets_;
+  Tensor packed_x_;
+  // The x quantized at runtime, and the scales of the columns of y multiplied
+  // by alpha in the dynamic quantization.
+  std::vector<int8_t> quant_x_;
+  std::vector<float> y_scale_;
 };
 
 }  // namespace arm
@@ -15,6 +15,7 @@
 #include "lite/kernels/arm/mul_compute.h"
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/gemm_epilogue.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 
@@ -31,7 +32,6 @@ void MulCompute::Run() {
   auto& param = Param<param_t>();
 
   const auto* x_data = param.x->data<float>();
-  const auto* y_data = param.y->data<float>();
   auto* o_data = param.output->mutable_data<float>();
 
   m_ = static_cast<int>(
@@ -49,6 +49,41 @@ void MulCompute::Run() {
   CHECK_EQ(x_w, y_h) << "x_w must be equal with y_h";
   k_ = x_w;
 
+  if (param.dynamic_quant) {
+    auto& ctx = this->ctx_->template As<ARMContext>();
+    lite::arm::math::sgemm_dynamic_quant(m_,
+                                         n_,
+                                         k_,
+                                         x_data,
+                                         param.y->data<int8_t>(),
+                                         param.weight_only_scale->data<float>(),
+                                         lite::host::math::GemmEpilogue(),
+                                         o_data,
+                                         &quant_x_,
+                                         &ctx);
+    return;
+  }
+  if (param.weight_only_quant_bits) {
+    // Two int4 values are stored in a byte.
+    if (param.weight_only_quant_bits == 4) {
+      n_ *= 2;
+    }
+    auto& ctx = this->ctx_->template As<ARMContext>();
+    lite::arm::math::sgemm_weight_only_quant(
+        m_,
+        n_,
+        k_,
+        x_data,
+        param.y->data<int8_t>(),
+        param.weight_only_scale->data<float>(),
+        param.weight_only_quant_bits,
+        o_data,
+        &weight_block_,
+        &ctx);
+    return;
+  }
+
+  const auto* y_data = param.y->data<float>();
   if (n_ == 1) {
     lite::arm::math::sgemv(
         x_data, y_data, o_data, false, m_, k_, false, nullptr, false);
@@ -94,5 +129,6 @@ REGISTER_LITE_KERNEL(
     mul, kARM, kFloat, kNCHW, paddle::lite::kernels::arm::MulCompute, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -34,6 +35,10 @@ class MulCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
  private:
   int m_, n_, k_;
+  // The dequantized block of the weight-only quantized weight.
+  std::vector<float> weight_block_;
+  // The x quantized at runtime in the dynamic quantization.
+  std::vector<int8_t> quant_x_;
 };
 
 }  // namespace arm
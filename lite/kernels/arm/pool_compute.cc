@@ -231,6 +231,38 @@ void PoolCompute::Run() {
                                  pooling_type);
 }
 
+void PoolInt8Compute::Run() {
+  auto& param = Param<operators::PoolParam>();
+  auto& in_dims = param.x->dims();
+  auto& out_dims = param.output->dims();
+  CHECK(!param.adaptive) << "int8 pool2d does not support adaptive pooling";
+
+  std::vector<int> ksize = param.ksize;
+  std::vector<int> paddings = param.paddings;
+  if (param.global_pooling) {
+    for (size_t i = 0; i < ksize.size(); ++i) {
+      paddings[i] = 0;
+      ksize[i] = static_cast<int>(in_dims[i + 2]);
+    }
+  }
+  lite::arm::math::pooling_basic_int8(param.x->data<int8_t>(),
+                                      param.output->mutable_data<int8_t>(),
+                                      out_dims[0],
+                                      out_dims[1],
+                                      out_dims[2],
+                                      out_dims[3],
+                                      in_dims[1],
+                                      in_dims[2],
+                                      in_dims[3],
+                                      ksize,
+                                      param.strides,
+                                      paddings,
+                                      param.exclusive,
+                                      param.pooling_type,
+                                      param.input_scale,
+                                      param.output_scale);
+}
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
@@ -241,3 +273,13 @@ REGISTER_LITE_KERNEL(
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d,
+                     kARM,
+                     kInt8,
+                     kNCHW,
+                     paddle::lite::kernels::arm::PoolInt8Compute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
@@ -32,6 +32,15 @@ class PoolCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   virtual ~PoolCompute() = default;
 };
 
+class PoolInt8Compute : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::PoolParam;
+
+  void Run() override;
+
+  virtual ~PoolInt8Compute() = default;
+};
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
@@ -14,6 +14,8 @@
 
 #include "lite/kernels/arm/pool_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 #include <vector>
@@ -307,6 +309,85 @@ TEST(pool_arm, compute) {
   }
 }
 
+TEST(pool_arm, compute_int8) {
+  PoolInt8Compute pool;
+  operators::PoolParam param;
+
+  lite::Tensor x;
+  lite::Tensor x_fp32;
+  lite::Tensor output;
+  lite::Tensor output_ref;
+
+  // The reference pools the dequantized input in float.
+  for (auto pooling_type : {"max", "avg"}) {
+    for (auto global_pooling : {true, false}) {
+      for (auto exclusive : {true, false}) {
+        for (auto ksize : {2, 3}) {
+          for (auto stride : {1, 2}) {
+            for (auto pad : {0, 1}) {
+              for (auto out_scale : {0.1f, 0.05f}) {
+                for (auto h : {3, 11}) {
+                  for (auto w : {4, 11}) {
+                    const int n = 2;
+                    const int c = 3;
+                    const float in_scale = 0.1f;
+                    x.Resize(DDim(std::vector<int64_t>({n, c, h, w})));
+                    x_fp32.Resize(x.dims());
+                    auto* x_data = x.mutable_data<int8_t>();
+                    auto* x_fp32_data = x_fp32.mutable_data<float>();
+                    for (int i = 0; i < x.dims().production(); ++i) {
+                      x_data[i] = static_cast<int8_t>(i * 37 % 255 - 127);
+                      x_fp32_data[i] = x_data[i] * in_scale;
+                    }
+
+                    param.x = &x;
+                    param.output = &output;
+                    param.pooling_type = pooling_type;
+                    if (global_pooling) {
+                      param.ksize = {h, w};
+                    } else {
+                      param.ksize = {ksize, ksize};
+                    }
+                    param.global_pooling = global_pooling;
+                    param.strides = {stride, stride};
+                    param.paddings = {pad, pad};
+                    param.exclusive = exclusive;
+                    param.ceil_mode = false;
+                    param.adaptive = false;
+                    param.use_quantizer = false;
+                    param.input_scale = in_scale;
+                    param.output_scale = out_scale;
+
+                    const std::vector<int64_t>& output_shape =
+                        compute_output_shape(&param);
+                    output.Resize(DDim(output_shape));
+                    output_ref.Resize(DDim(output_shape));
+
+                    pool.SetParam(param);
+                    pool.Run();
+
+                    param.x = &x_fp32;
+                    param.output = &output_ref;
+                    pool_compute_ref(param);
+
+                    auto* output_data = output.data<int8_t>();
+                    auto* output_ref_data = output_ref.data<float>();
+                    for (int i = 0; i < output.dims().production(); i++) {
+                      float ref = std::round(output_ref_data[i] / out_scale);
+                      ref = std::max(-128.f, std::min(127.f, ref));
+                      EXPECT_NEAR(output_data[i], ref, 1);
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(pool_arm, retrive_op) {
   auto pool = KernelRegistry::Global().Create<TARGET(kARM), PRECISION(kFloat)>(
       "pool2d");
@@ -320,3 +401,4 @@ TEST(pool_arm, retrive_op) {
 }  // namespace paddle
 
 USE_LITE_KERNEL(pool2d, kARM, kFloat, kNCHW, def);
+USE_LITE_KERNEL(pool2d, kARM, kInt8, kNCHW, def);
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/buffer_view.h"
 
 namespace paddle {
 namespace lite {
@@ -47,6 +48,11 @@ void SliceCompute::PrepareForRun() {}
 void SliceCompute::Run() {
   auto& ctx = this->ctx_->template As<ARMContext>();
   auto& param = this->Param<operators::SliceParam>();
+  if (param.use_buffer_view && param.axes.size() == 1 &&
+      lite::host::math::slice_as_view<float>(
+          *param.X, param.axes[0], param.starts[0], param.Out)) {
+    return;
+  }
 
   auto in = param.X;
   auto in_dims = in->dims();
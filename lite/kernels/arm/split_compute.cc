@@ -15,6 +15,7 @@
 #include "lite/kernels/arm/split_compute.h"
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/buffer_view.h"
 
 namespace paddle {
 namespace lite {
@@ -23,6 +24,11 @@ namespace arm {
 
 void SplitCompute::Run() {
   auto& param = Param<operators::SplitParam>();
+  if (param.use_buffer_view &&
+      lite::host::math::split_as_view<float>(
+          *param.x, param.axis, param.output)) {
+    return;
+  }
   const float* din = param.x->data<float>();
   auto& dout = param.output;
   auto in_dim = param.x->dims();
@@ -38,9 +38,12 @@ void Unsqueeze2Compute::Run() {
   auto x_dims = x->dims();
   auto* x_data = x->data<float>();
   auto* out_data = output->mutable_data<float>();
-  auto* xshape_data = xshape->mutable_data<float>();
   memcpy(out_data, x_data, x_dims.production() * sizeof(float));
-  memcpy(xshape_data, x_data, x_dims.production() * sizeof(float));
+  // XShape is null when no op consumes it.
+  if (xshape) {
+    auto* xshape_data = xshape->mutable_data<float>();
+    memcpy(xshape_data, x_data, x_dims.production() * sizeof(float));
+  }
 }
 
 }  // namespace host
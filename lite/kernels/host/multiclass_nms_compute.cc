@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/host/multiclass_nms_compute.h"
+#include <cmath>
+#include <cstring>
 #include <map>
 #include <utility>
 #include <vector>
@@ -22,30 +24,43 @@ namespace lite {
 namespace kernels {
 namespace host {
 
+// Orders by descending score, and by ascending index among equal scores,
+// which is the order a stable sort of the candidates produces.
 template <class T>
 bool SortScorePairDescend(const std::pair<float, T>& pair1,
                           const std::pair<float, T>& pair2) {
-  return pair1.first > pair2.first;
+  return pair1.first > pair2.first ||
+         (pair1.first == pair2.first && pair1.second < pair2.second);
 }
 
+// Collects the scores above threshold, scores[i * stride] being the score of
+// box i, and keeps the top_k of them in descending order. Only the kept
+// candidates are sorted.
 template <class T>
-static void GetMaxScoreIndex(const std::vector<T>& scores,
+static void GetMaxScoreIndex(const T* scores,
+                             const int64_t num,
+                             const int64_t stride,
                              const T threshold,
                              int top_k,
                              std::vector<std::pair<T, int>>* sorted_indices) {
-  for (size_t i = 0; i < scores.size(); ++i) {
-    if (scores[i] > threshold) {
-      sorted_indices->push_back(std::make_pair(scores[i], i));
+  sorted_indices->clear();
+  for (int64_t i = 0; i < num; ++i) {
+    const T score = scores[i * stride];
+    if (score > threshold) {
+      sorted_indices->push_back(std::make_pair(score, static_cast<int>(i)));
     }
   }
-  // Sort the score pair according to the scores in descending order
-  std::stable_sort(sorted_indices->begin(),
-                   sorted_indices->end(),
-                   SortScorePairDescend<int>);
   // Keep top_k scores if needed.
   if (top_k > -1 && top_k < static_cast<int>(sorted_indices->size())) {
+    std::nth_element(sorted_indices->begin(),
+                     sorted_indices->begin() + top_k,
+                     sorted_indices->end(),
+                     SortScorePairDescend<int>);
     sorted_indices->resize(top_k);
   }
+  std::sort(sorted_indices->begin(),
+            sorted_indices->end(),
+            SortScorePairDescend<int>);
 }
 
 template <class T>
@@ -66,26 +81,6 @@ static T BBoxArea(const T* box, const bool normalized) {
   }
 }
 
-template <class T>
-static T JaccardOverlap(const T* box1, const T* box2, const bool normalized) {
-  if (box2[0] > box1[2] || box2[2] < box1[0] || box2[1] > box1[3] ||
-      box2[3] < box1[1]) {
-    return static_cast<T>(0.);
-  } else {
-    const T inter_xmin = std::max(box1[0], box2[0]);
-    const T inter_ymin = std::max(box1[1], box2[1]);
-    const T inter_xmax = std::min(box1[2], box2[2]);
-    const T inter_ymax = std::min(box1[3], box2[3]);
-    T norm = normalized ? static_cast<T>(0.) : static_cast<T>(1.);
-    T inter_w = inter_xmax - inter_xmin + norm;
-    T inter_h = inter_ymax - inter_ymin + norm;
-    const T inter_area = inter_w * inter_h;
-    const T bbox1_area = BBoxArea<T>(box1, normalized);
-    const T bbox2_area = BBoxArea<T>(box2, normalized);
-    return inter_area / (bbox1_area + bbox2_area - inter_area);
-  }
-}
-
 template <class T>
 T PolyIoU(const T* box1,
           const T* box2,
@@ -94,94 +89,136 @@ T PolyIoU(const T* box1,
   LOG(FATAL) << "PolyIoU not implement.";
 }
 
+// The [xmin ymin xmax ymax] boxes kept by NMS so far, stored coordinate by
+// coordinate so that the overlap test against all of them is a branch-free
+// loop the compiler vectorizes.
 template <class T>
-void SliceOneClass(const Tensor& items,
-                   const int class_id,
-                   Tensor* one_class_item) {
-  T* item_data = one_class_item->mutable_data<T>();
-  const T* items_data = items.data<T>();
-  const int64_t num_item = items.dims()[0];
-  const int64_t class_num = items.dims()[1];
-  if (items.dims().size() == 3) {
-    int64_t item_size = items.dims()[2];
-    for (int i = 0; i < num_item; ++i) {
-      std::memcpy(item_data + i * item_size,
-                  items_data + i * class_num * item_size + class_id * item_size,
-                  sizeof(T) * item_size);
-    }
-  } else {
-    for (int i = 0; i < num_item; ++i) {
-      item_data[i] = items_data[i * class_num + class_id];
+class KeptBoxes {
+ public:
+  explicit KeptBoxes(const bool normalized) : normalized_(normalized) {}
+
+  void Add(const T* box) {
+    xmin_.push_back(box[0]);
+    ymin_.push_back(box[1]);
+    xmax_.push_back(box[2]);
+    ymax_.push_back(box[3]);
+    area_.push_back(BBoxArea<T>(box, normalized_));
+  }
+
+  // Whether the Jaccard overlap of box with any kept box is above threshold.
+  bool Overlaps(const T* box, const T threshold) const {
+    const int num = static_cast<int>(area_.size());
+    const T norm = normalized_ ? static_cast<T>(0.) : static_cast<T>(1.);
+    const T area = BBoxArea<T>(box, normalized_);
+    const T x0 = box[0], y0 = box[1], x1 = box[2], y1 = box[3];
+    const T* xmin = xmin_.data();
+    const T* ymin = ymin_.data();
+    const T* xmax = xmax_.data();
+    const T* ymax = ymax_.data();
+    const T* areas = area_.data();
+    // A disjoint box has no overlap, which is above threshold only when the
+    // threshold is negative.
+    const bool disjoint_hit = !(static_cast<T>(0.) <= threshold);
+    for (int k0 = 0; k0 < num; k0 += kBlock) {
+      const int k1 = std::min(num, k0 + kBlock);
+      int hit = 0;
+      for (int k = k0; k < k1; ++k) {
+        const bool disjoint = (xmin[k] > x1) | (xmax[k] < x0) |
+                              (ymin[k] > y1) | (ymax[k] < y0);
+        const T inter_w = std::min(x1, xmax[k]) - std::max(x0, xmin[k]) + norm;
+        const T inter_h = std::min(y1, ymax[k]) - std::max(y0, ymin[k]) + norm;
+        const T inter_area = inter_w * inter_h;
+        const T iou = inter_area / (area + areas[k] - inter_area);
+        const bool overlapped = !(iou <= threshold);
+        // Selected with bit operations so that the loop has no branch.
+        hit |= (disjoint & disjoint_hit) | (!disjoint & overlapped);
+      }
+      if (hit) return true;
     }
+    return false;
   }
-}
 
+ private:
+  // Boxes are tested in blocks, returning at the first block with a hit.
+  static const int kBlock = 16;
+  bool normalized_;
+  std::vector<T> xmin_, ymin_, xmax_, ymax_, area_;
+};
+
+// Greedy NMS over the candidates of one class, already sorted by score.
+// Box i starts at bbox + i * box_stride.
 template <typename T>
-void NMSFast(const Tensor& bbox,
-             const Tensor& scores,
-             const T score_threshold,
+void NMSFast(const T* bbox,
+             const int64_t box_stride,
+             const int64_t box_size,
+             const std::vector<std::pair<T, int>>& sorted_indices,
              const T nms_threshold,
              const T eta,
-             const int64_t top_k,
-             std::vector<int>* selected_indices,
-             const bool normalized) {
-  // The total boxes for each instance.
-  int64_t num_boxes = bbox.dims()[0];
-  // 4: [xmin ymin xmax ymax]
-  // 8: [x1 y1 x2 y2 x3 y3 x4 y4]
-  // 16, 24, or 32: [x1 y1 x2 y2 ...  xn yn], n = 8, 12 or 16
-  int64_t box_size = bbox.dims()[1];
-
-  std::vector<T> scores_data(num_boxes);
-  std::copy_n(scores.data<T>(), num_boxes, scores_data.begin());
-  std::vector<std::pair<T, int>> sorted_indices;
-  GetMaxScoreIndex(scores_data, score_threshold, top_k, &sorted_indices);
-
+             const bool normalized,
+             std::vector<int>* selected_indices) {
   selected_indices->clear();
+  KeptBoxes<T> kept(normalized);
   T adaptive_threshold = nms_threshold;
-  const T* bbox_data = bbox.data<T>();
-
-  while (sorted_indices.size() != 0) {
-    const int idx = sorted_indices.front().second;
+  for (const auto& candidate : sorted_indices) {
+    const int idx = candidate.second;
+    const T* box = bbox + idx * box_stride;
     bool keep = true;
-    for (size_t k = 0; k < selected_indices->size(); ++k) {
-      if (keep) {
-        const int kept_idx = (*selected_indices)[k];
-        T overlap = T(0.);
-        // 4: [xmin ymin xmax ymax]
-        if (box_size == 4) {
-          overlap = JaccardOverlap<T>(bbox_data + idx * box_size,
-                                      bbox_data + kept_idx * box_size,
-                                      normalized);
-        }
-        // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
-        if (box_size == 8 || box_size == 16 || box_size == 24 ||
-            box_size == 32) {
-          overlap = PolyIoU<T>(bbox_data + idx * box_size,
-                               bbox_data + kept_idx * box_size,
-                               box_size,
-                               normalized);
-        }
-        keep = overlap <= adaptive_threshold;
-      } else {
-        break;
-      }
+    // 4: [xmin ymin xmax ymax]
+    if (box_size == 4) {
+      keep = !kept.Overlaps(box, adaptive_threshold);
+    } else if (!selected_indices->empty()) {
+      // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
+      const int kept_idx = selected_indices->front();
+      keep = PolyIoU<T>(box,
+                        bbox + kept_idx * box_stride,
+                        box_size,
+                        normalized) <= adaptive_threshold;
     }
     if (keep) {
       selected_indices->push_back(idx);
-    }
-    sorted_indices.erase(sorted_indices.begin());
-    if (keep && eta < 1 && adaptive_threshold > 0.5) {
-      adaptive_threshold *= eta;
+      if (box_size == 4) kept.Add(box);
+      if (eta < 1 && adaptive_threshold > 0.5) {
+        adaptive_threshold *= eta;
+      }
     }
   }
 }
 
+// Strided view of the boxes and scores of one image. With 3-D scores, the
+// scores are [class_num, num_boxes] and the boxes [num_boxes, box_size] are
+// shared by all classes. With 2-D (LoD) scores, the scores are
+// [num_boxes, class_num] and the boxes [num_boxes, class_num, box_size].
+template <typename T>
+struct NmsInput {
+  const T* scores;
+  const T* bboxes;
+  int64_t num_boxes;
+  int64_t class_num;
+  int64_t box_size;
+  bool per_class_boxes;
+
+  const T* class_scores(int c) const {
+    return per_class_boxes ? scores + c : scores + c * num_boxes;
+  }
+  int64_t score_stride() const { return per_class_boxes ? class_num : 1; }
+  const T* class_boxes(int c) const {
+    return per_class_boxes ? bboxes + c * box_size : bboxes;
+  }
+  int64_t box_stride() const {
+    return per_class_boxes ? class_num * box_size : box_size;
+  }
+};
+
 template <typename T>
+using ClassCandidates = std::vector<std::vector<std::pair<T, int>>>;
+
+// Runs NMS on every class of one image. The candidates of all the classes
+// are selected before any box is read, and handed to prepare_boxes so that
+// the boxes can be produced lazily. Classes are processed in parallel.
+template <typename T, typename PrepareFn>
 void MultiClassNMS(const operators::MulticlassNmsParam& param,
-                   const Tensor& scores,
-                   const Tensor& bboxes,
-                   const int scores_size,
+                   const NmsInput<T>& input,
+                   PrepareFn prepare_boxes,
                    std::map<int, std::vector<int>>* indices,
                    int* num_nmsed_out) {
   int64_t background_label = param.background_label;
@@ -192,61 +229,73 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
   T nms_eta = static_cast<T>(param.nms_eta);
   T score_threshold = static_cast<T>(param.score_threshold);
 
-  int num_det = 0;
+  std::vector<int> labels;
+  for (int c = 0; c < input.class_num; ++c) {
+    if (c != background_label) labels.push_back(c);
+  }
+  const int num_labels = static_cast<int>(labels.size());
+  ClassCandidates<T> candidates(num_labels);
+  std::vector<std::vector<int>> selected(num_labels);
 
-  int64_t class_num = scores_size == 3 ? scores.dims()[0] : scores.dims()[1];
-  Tensor bbox_slice, score_slice;
-  for (int64_t c = 0; c < class_num; ++c) {
-    if (c == background_label) continue;
-    if (scores_size == 3) {
-      score_slice = scores.Slice<T>(c, c + 1);
-      bbox_slice = bboxes;
-    } else {
-      score_slice.Resize({scores.dims()[0], 1});
-      bbox_slice.Resize({scores.dims()[0], 4});
-      SliceOneClass<T>(scores, c, &score_slice);
-      SliceOneClass<T>(bboxes, c, &bbox_slice);
-    }
-    NMSFast(bbox_slice,
-            score_slice,
-            score_threshold,
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < num_labels; ++k) {
+    GetMaxScoreIndex(input.class_scores(labels[k]),
+                     input.num_boxes,
+                     input.score_stride(),
+                     score_threshold,
+                     nms_top_k,
+                     &candidates[k]);
+  }
+  prepare_boxes(candidates);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = 0; k < num_labels; ++k) {
+    NMSFast(input.class_boxes(labels[k]),
+            input.box_stride(),
+            input.box_size,
+            candidates[k],
             nms_threshold,
             nms_eta,
-            nms_top_k,
-            &((*indices)[c]),
-            normalized);
-    if (scores_size == 2) {
-      std::stable_sort((*indices)[c].begin(), (*indices)[c].end());
+            normalized,
+            &selected[k]);
+    if (input.per_class_boxes) {
+      std::sort(selected[k].begin(), selected[k].end());
     }
-    num_det += (*indices)[c].size();
+  }
+
+  int num_det = 0;
+  for (int k = 0; k < num_labels; ++k) {
+    num_det += selected[k].size();
+    (*indices)[labels[k]].swap(selected[k]);
   }
 
   *num_nmsed_out = num_det;
-  const T* scores_data = scores.data<T>();
   if (keep_top_k > -1 && num_det > keep_top_k) {
-    const T* sdata;
     std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
+    score_index_pairs.reserve(num_det);
     for (const auto& it : *indices) {
       int label = it.first;
-      if (scores_size == 3) {
-        sdata = scores_data + label * scores.dims()[1];
-      } else {
-        score_slice.Resize({scores.dims()[0], 1});
-        SliceOneClass<T>(scores, label, &score_slice);
-        sdata = score_slice.data<T>();
-      }
+      const T* sdata = input.class_scores(label);
+      const int64_t stride = input.score_stride();
       const std::vector<int>& label_indices = it.second;
       for (size_t j = 0; j < label_indices.size(); ++j) {
         int idx = label_indices[j];
         score_index_pairs.push_back(
-            std::make_pair(sdata[idx], std::make_pair(label, idx)));
+            std::make_pair(sdata[idx * stride], std::make_pair(label, idx)));
       }
     }
     // Keep top k results per image.
-    std::stable_sort(score_index_pairs.begin(),
+    std::nth_element(score_index_pairs.begin(),
+                     score_index_pairs.begin() + keep_top_k,
                      score_index_pairs.end(),
                      SortScorePairDescend<std::pair<int, int>>);
     score_index_pairs.resize(keep_top_k);
+    std::sort(score_index_pairs.begin(),
+              score_index_pairs.end(),
+              SortScorePairDescend<std::pair<int, int>>);
 
     // Store the new indices.
     std::map<int, std::vector<int>> new_indices;
@@ -255,10 +304,9 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
       int idx = score_index_pairs[j].second.second;
       new_indices[label].push_back(idx);
     }
-    if (scores_size == 2) {
-      for (const auto& it : new_indices) {
-        int label = it.first;
-        std::stable_sort(new_indices[label].begin(), new_indices[label].end());
+    if (input.per_class_boxes) {
+      for (auto& it : new_indices) {
+        std::sort(it.second.begin(), it.second.end());
       }
     }
     new_indices.swap(*indices);
@@ -267,120 +315,193 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
 }
 
 template <typename T>
-void MultiClassOutput(const Tensor& scores,
-                      const Tensor& bboxes,
+void MultiClassOutput(const NmsInput<T>& input,
                       const std::map<int, std::vector<int>>& selected_indices,
-                      const int scores_size,
-                      Tensor* outs) {
-  int64_t class_num = scores.dims()[1];
-  int64_t predict_dim = scores.dims()[1];
-  int64_t box_size = bboxes.dims()[1];
-  if (scores_size == 2) {
-    box_size = bboxes.dims()[2];
-  }
-  int64_t out_dim = box_size + 2;
-  auto* scores_data = scores.data<T>();
-  auto* bboxes_data = bboxes.data<T>();
-  auto* odata = outs->mutable_data<T>();
-  const T* sdata;
-  Tensor bbox;
-  bbox.Resize({scores.dims()[0], box_size});
-  int count = 0;
+                      T* odata) {
+  const int64_t box_size = input.box_size;
+  const int64_t out_dim = box_size + 2;
   for (const auto& it : selected_indices) {
     int label = it.first;
-    const std::vector<int>& indices = it.second;
-    if (scores_size == 2) {
-      SliceOneClass<T>(bboxes, label, &bbox);
-    } else {
-      sdata = scores_data + label * predict_dim;
-    }
-    for (size_t j = 0; j < indices.size(); ++j) {
-      int idx = indices[j];
-      odata[count * out_dim] = label;  // label
-      const T* bdata;
-      if (scores_size == 3) {
-        bdata = bboxes_data + idx * box_size;
-        odata[count * out_dim + 1] = sdata[idx];  // score
-      } else {
-        bdata = bbox.data<T>() + idx * box_size;
-        odata[count * out_dim + 1] = *(scores_data + idx * class_num + label);
-      }
+    const T* sdata = input.class_scores(label);
+    const T* bdata = input.class_boxes(label);
+    for (int idx : it.second) {
+      odata[0] = label;                              // label
+      odata[1] = sdata[idx * input.score_stride()];  // score
       // xmin, ymin, xmax, ymax or multi-points coordinates
-      std::memcpy(odata + count * out_dim + 2, bdata, box_size * sizeof(T));
-      count++;
+      std::memcpy(odata + 2,
+                  bdata + idx * input.box_stride(),
+                  box_size * sizeof(T));
+      odata += out_dim;
     }
   }
 }
 
-void MulticlassNmsCompute::Run() {
-  auto& param = Param<operators::MulticlassNmsParam>();
-  auto* boxes = param.bboxes;
-  auto* scores = param.scores;
-  auto* outs = param.out;
-
-  auto score_dims = scores->dims();
-  auto score_size = score_dims.size();
-
-  std::vector<std::map<int, std::vector<int>>> all_indices;
+// Runs multiclass NMS on all the images and writes the LoD output. The boxes
+// of image i may be produced lazily by prepare_boxes(i, candidates).
+template <typename T, typename PrepareFn>
+void MultiClassNMSBatch(const operators::MulticlassNmsParam& param,
+                        const std::vector<NmsInput<T>>& inputs,
+                        PrepareFn prepare_boxes,
+                        Tensor* outs) {
+  const int n = static_cast<int>(inputs.size());
+  std::vector<std::map<int, std::vector<int>>> all_indices(n);
   std::vector<uint64_t> batch_starts = {0};
-  int64_t batch_size = score_dims[0];
-  int64_t box_dim = boxes->dims()[2];
-  int64_t out_dim = box_dim + 2;
-  int num_nmsed_out = 0;
-  Tensor boxes_slice, scores_slice;
-  int n = score_size == 3 ? batch_size : boxes->lod().back().size() - 1;
   for (int i = 0; i < n; ++i) {
-    if (score_size == 3) {
-      scores_slice = scores->Slice<float>(i, i + 1);
-      scores_slice.Resize({score_dims[1], score_dims[2]});
-      boxes_slice = boxes->Slice<float>(i, i + 1);
-      boxes_slice.Resize({score_dims[2], box_dim});
-    } else {
-      auto boxes_lod = boxes->lod().back();
-      scores_slice = scores->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-      boxes_slice = boxes->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-    }
-    std::map<int, std::vector<int>> indices;
-    MultiClassNMS<float>(
-        param, scores_slice, boxes_slice, score_size, &indices, &num_nmsed_out);
-    all_indices.push_back(indices);
+    int num_nmsed_out = 0;
+    MultiClassNMS<T>(param,
+                     inputs[i],
+                     [&](const ClassCandidates<T>& candidates) {
+                       prepare_boxes(i, candidates);
+                     },
+                     &all_indices[i],
+                     &num_nmsed_out);
     batch_starts.push_back(batch_starts.back() + num_nmsed_out);
   }
 
   uint64_t num_kept = batch_starts.back();
   if (num_kept == 0) {
     outs->Resize({1, 1});
-    float* od = outs->mutable_data<float>();
+    T* od = outs->mutable_data<T>();
     od[0] = -1;
     batch_starts = {0, 1};
   } else {
+    int64_t out_dim = n > 0 ? inputs[0].box_size + 2 : 0;
     outs->Resize({static_cast<int64_t>(num_kept), out_dim});
+    T* odata = outs->mutable_data<T>();
     for (int i = 0; i < n; ++i) {
-      if (score_size == 3) {
-        scores_slice = scores->Slice<float>(i, i + 1);
-        boxes_slice = boxes->Slice<float>(i, i + 1);
-        scores_slice.Resize({score_dims[1], score_dims[2]});
-        boxes_slice.Resize({score_dims[2], box_dim});
-      } else {
-        auto boxes_lod = boxes->lod().back();
-        scores_slice = scores->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-        boxes_slice = boxes->Slice<float>(boxes_lod[i], boxes_lod[i + 1]);
-      }
-      int64_t s = static_cast<int64_t>(batch_starts[i]);
-      int64_t e = static_cast<int64_t>(batch_starts[i + 1]);
-      if (e > s) {
-        Tensor out = outs->Slice<float>(s, e);
-        MultiClassOutput<float>(
-            scores_slice, boxes_slice, all_indices[i], score_dims.size(), &out);
-      }
+      MultiClassOutput<T>(
+          inputs[i], all_indices[i], odata + batch_starts[i] * out_dim);
     }
   }
 
   LoD lod;
   lod.emplace_back(batch_starts);
-
   outs->set_lod(lod);
 }
+
+void MulticlassNmsCompute::Run() {
+  auto& param = Param<operators::MulticlassNmsParam>();
+  auto* boxes = param.bboxes;
+  auto* scores = param.scores;
+
+  auto score_dims = scores->dims();
+  auto score_size = score_dims.size();
+  int64_t box_dim = boxes->dims()[2];
+  const float* scores_data = scores->data<float>();
+  const float* boxes_data = boxes->data<float>();
+
+  std::vector<NmsInput<float>> inputs;
+  if (score_size == 3) {
+    int64_t class_num = score_dims[1];
+    int64_t num_boxes = score_dims[2];
+    for (int64_t i = 0; i < score_dims[0]; ++i) {
+      inputs.push_back({scores_data + i * class_num * num_boxes,
+                        boxes_data + i * num_boxes * box_dim,
+                        num_boxes,
+                        class_num,
+                        box_dim,
+                        false});
+    }
+  } else {
+    int64_t class_num = score_dims[1];
+    auto boxes_lod = boxes->lod().back();
+    for (size_t i = 0; i + 1 < boxes_lod.size(); ++i) {
+      int64_t start = static_cast<int64_t>(boxes_lod[i]);
+      int64_t num_boxes = static_cast<int64_t>(boxes_lod[i + 1]) - start;
+      inputs.push_back({scores_data + start * class_num,
+                        boxes_data + start * class_num * box_dim,
+                        num_boxes,
+                        class_num,
+                        box_dim,
+                        true});
+    }
+  }
+
+  MultiClassNMSBatch<float>(
+      param,
+      inputs,
+      [](int, const ClassCandidates<float>&) {},
+      param.out);
+}
+
+// box_coder decode_center_size with axis 0, applied only to the candidate
+// boxes. target holds the [num_boxes, 4] encoded boxes of one image.
+static void DecodeCandidates(const operators::FusionBoxCoderNmsParam& param,
+                             const float* target,
+                             int64_t num_boxes,
+                             const ClassCandidates<float>& candidates,
+                             float* output) {
+  const float* prior = param.prior_box->data<float>();
+  const float* prior_var =
+      param.prior_box_var ? param.prior_box_var->data<float>() : nullptr;
+  const float norm = param.box_normalized ? 0.f : 1.f;
+  const float unit_var[4] = {1.f, 1.f, 1.f, 1.f};
+  const float* attr_var =
+      param.variance.empty() ? unit_var : param.variance.data();
+
+  std::vector<char> decoded(num_boxes, 0);
+  for (const auto& class_candidates : candidates) {
+    for (const auto& candidate : class_candidates) {
+      const int j = candidate.second;
+      if (decoded[j]) continue;
+      decoded[j] = 1;
+      const float* p = prior + j * 4;
+      const float* t = target + j * 4;
+      const float* var = prior_var ? prior_var + j * 4 : attr_var;
+      float prior_w = p[2] - p[0] + norm;
+      float prior_h = p[3] - p[1] + norm;
+      float prior_cx = p[0] + prior_w / 2;
+      float prior_cy = p[1] + prior_h / 2;
+      float cx = var[0] * t[0] * prior_w + prior_cx;
+      float cy = var[1] * t[1] * prior_h + prior_cy;
+      float w = std::exp(var[2] * t[2]) * prior_w;
+      float h = std::exp(var[3] * t[3]) * prior_h;
+      float* out = output + j * 4;
+      out[0] = cx - w / 2;
+      out[1] = cy - h / 2;
+      out[2] = cx + w / 2 - norm;
+      out[3] = cy + h / 2 - norm;
+    }
+  }
+}
+
+void FusionBoxCoderNmsCompute::Run() {
+  auto& param = Param<operators::FusionBoxCoderNmsParam>();
+  auto* target_box = param.target_box;
+  auto* scores = param.scores;
+
+  auto score_dims = scores->dims();
+  CHECK_EQ(score_dims.size(), 3UL);
+  int64_t class_num = score_dims[1];
+  int64_t num_boxes = score_dims[2];
+  const float* scores_data = scores->data<float>();
+  const float* target_data = target_box->data<float>();
+  decoded_boxes_.Resize(target_box->dims());
+  float* boxes_data = decoded_boxes_.mutable_data<float>();
+
+  std::vector<NmsInput<float>> inputs;
+  for (int64_t i = 0; i < score_dims[0]; ++i) {
+    inputs.push_back({scores_data + i * class_num * num_boxes,
+                      boxes_data + i * num_boxes * 4,
+                      num_boxes,
+                      class_num,
+                      4,
+                      false});
+  }
+
+  MultiClassNMSBatch<float>(
+      param,
+      inputs,
+      [&](int i, const ClassCandidates<float>& candidates) {
+        DecodeCandidates(param,
+                         target_data + i * num_boxes * 4,
+                         num_boxes,
+                         candidates,
+                         boxes_data + i * num_boxes * 4);
+      },
+      param.out);
+}
+
 }  // namespace host
 }  // namespace kernels
 }  // namespace lite
@@ -396,3 +517,16 @@ REGISTER_LITE_KERNEL(multiclass_nms,
     .BindInput("Scores", {LiteType::GetTensorTy(TARGET(kHost))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_box_coder_nms,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::FusionBoxCoderNmsCompute,
+                     def)
+    .BindInput("PriorBox", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("PriorBoxVar", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("TargetBox", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Scores", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
@@ -30,6 +30,20 @@ class MulticlassNmsCompute
   virtual ~MulticlassNmsCompute() = default;
 };
 
+// box_coder (decode_center_size, axis 0) followed by multiclass_nms. Only the
+// boxes that survive the score threshold and nms_top_k of some class are
+// decoded.
+class FusionBoxCoderNmsCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override;
+
+  virtual ~FusionBoxCoderNmsCompute() = default;
+
+ private:
+  Tensor decoded_boxes_;
+};
+
 }  // namespace host
 }  // namespace kernels
 }  // namespace lite
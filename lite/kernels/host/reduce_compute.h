@@ -0,0 +1,107 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/backends/host/math/reduce.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+// The input, the output and the reduced axes of the reduce ops, no axes
+// means all of them.
+inline void GetReduceArgs(const operators::ReduceParam& param,
+                          const Tensor** x,
+                          Tensor** out,
+                          std::vector<int>* axes) {
+  *x = param.x;
+  *out = param.output;
+  if (!param.reduce_all) *axes = param.dim;
+}
+
+inline void GetReduceArgs(const operators::ReduceMaxParam& param,
+                          const Tensor** x,
+                          Tensor** out,
+                          std::vector<int>* axes) {
+  *x = param.X;
+  *out = param.Out;
+  *axes = param.dim;
+}
+
+inline void GetReduceArgs(const operators::ReduceMeanParam& param,
+                          const Tensor** x,
+                          Tensor** out,
+                          std::vector<int>* axes) {
+  *x = param.X;
+  *out = param.Out;
+  *axes = param.dim;
+}
+
+// The reduce ops on all the CPU targets, see `host::math::reduce`.
+template <TargetType Target,
+          typename T,
+          lite::host::math::ReduceType Type,
+          typename ParamType>
+class ReduceCompute : public KernelLite<Target, PRECISION(kFloat)> {
+ public:
+  using param_t = ParamType;
+
+  void Run() override {
+    auto& param = this->template Param<param_t>();
+    const Tensor* x{};
+    Tensor* out{};
+    std::vector<int> axes;
+    GetReduceArgs(param, &x, &out, &axes);
+    lite::host::math::reduce<T, Type>(
+        x->data<T>(), x->dims().Vectorize(), axes, out->mutable_data<T>());
+  }
+
+  virtual ~ReduceCompute() = default;
+};
+
+template <TargetType Target, typename T>
+using ReduceSumCompute = ReduceCompute<Target,
+                                       T,
+                                       lite::host::math::ReduceType::kSum,
+                                       operators::ReduceParam>;
+template <TargetType Target, typename T>
+using ReduceMeanCompute = ReduceCompute<Target,
+                                        T,
+                                        lite::host::math::ReduceType::kMean,
+                                        operators::ReduceMeanParam>;
+template <TargetType Target, typename T>
+using ReduceMaxCompute = ReduceCompute<Target,
+                                       T,
+                                       lite::host::math::ReduceType::kMax,
+                                       operators::ReduceMaxParam>;
+template <TargetType Target, typename T>
+using ReduceMinCompute = ReduceCompute<Target,
+                                       T,
+                                       lite::host::math::ReduceType::kMin,
+                                       operators::ReduceParam>;
+template <TargetType Target, typename T>
+using ReduceProdCompute = ReduceCompute<Target,
+                                        T,
+                                        lite::host::math::ReduceType::kProd,
+                                        operators::ReduceParam>;
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
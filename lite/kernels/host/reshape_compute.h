@@ -14,6 +14,9 @@
 
 #pragma once
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -27,6 +30,12 @@ class ReshapeCompute
  public:
   void Run() override;
 
+  // The output shares the input of the inplace ops, reshape, reshape2,
+  // flatten and flatten2 all run this kernel.
+  std::vector<std::pair<std::string, std::string>> ViewArgs() const override {
+    return {{"Out", "X"}};
+  }
+
   virtual ~ReshapeCompute() = default;
 };
 
@@ -0,0 +1,74 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/squeeze_excitation_compute.h"
+#include "lite/backends/host/math/squeeze_excitation.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void SqueezeExcitationCompute::Run() {
+  auto& param = Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto squeeze_dims = param.squeeze_weight->dims();
+  const int hidden = param.conv_weight ? squeeze_dims[0] : squeeze_dims[1];
+
+  // The biases and the activations of the layers are applied to the columns
+  // of their one row outputs.
+  lite::host::math::GemmEpilogue squeeze_epilogue;
+  squeeze_epilogue.channel_is_row = false;
+  if (param.squeeze_bias) {
+    squeeze_epilogue.bias = param.squeeze_bias->data<float>();
+  }
+  lite::host::math::set_epilogue_act(param.squeeze_act, &squeeze_epilogue);
+  lite::host::math::GemmEpilogue excite_epilogue;
+  excite_epilogue.channel_is_row = false;
+  if (param.excite_bias) {
+    excite_epilogue.bias = param.excite_bias->data<float>();
+  }
+  lite::host::math::set_epilogue_act(param.excite_act, &excite_epilogue);
+
+  lite::host::math::squeeze_excitation(param.x->data<float>(),
+                                       x_dims[0],
+                                       x_dims[1],
+                                       x_dims[2] * x_dims[3],
+                                       param.squeeze_weight->data<float>(),
+                                       hidden,
+                                       squeeze_epilogue,
+                                       param.excite_weight->data<float>(),
+                                       excite_epilogue,
+                                       param.conv_weight,
+                                       param.out->mutable_data<float>());
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_squeeze_excitation,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::SqueezeExcitationCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("SqueezeWeight", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("SqueezeBias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("ExciteWeight", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("ExciteBias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
@@ -86,7 +86,7 @@ node_map_type ReshapeConverter(const std::shared_ptr<lite::OpLite> reshape_op,
 
   node_map_type outputs_map;
   outputs_map[op_info->Output("Out").front()] = reshape_node;
-  if (op_type == "reshape2") {
+  if (op_type == "reshape2" && op_info->HasOutput("XShape")) {
     // append an extra reshape node to calc XShape
     std::vector<int64_t> xshape_dims(x_dims.size() + 1, 1);
     for (size_t i = 0; i < x_dims.size(); i++) {
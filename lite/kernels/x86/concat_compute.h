@@ -14,7 +14,10 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <string>
+#include <utility>
 #include <vector>
+#include "lite/backends/host/math/buffer_view.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -51,6 +54,10 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       param.output->ShareDataWith(*param.x[0]);
       return;
     }
+    if (param.use_buffer_view &&
+        lite::host::math::concat_as_view<T>(param.x, axis, out)) {
+      return;
+    }
 
     auto output_data = param.output->template mutable_data<T>();
     int offset_concat_axis = 0;
@@ -70,6 +77,12 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       offset_concat_axis += bottom_concat_axis;
     }
   }
+  // A single input is shared by the output.
+  std::vector<std::pair<std::string, std::string>> ViewArgs() const override {
+    if (param_.get<param_t>().x.size() != 1) return {};
+    return {{"Out", "X"}};
+  }
+
   virtual ~ConcatCompute() = default;
 };
 
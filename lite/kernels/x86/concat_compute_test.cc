@@ -74,6 +74,62 @@ TEST(concat_x86, run_test) {
   }
 }
 
+TEST(concat_x86, buffer_view) {
+  lite::Tensor x1, x2, out;
+  x1.Resize({1, 1, 3, 3});
+  x2.Resize({1, 1, 3, 3});
+  out.Resize({1, 2, 3, 3});
+  auto fill = [](lite::Tensor* x, float value) {
+    auto* data = x->mutable_data<float>();
+    for (int64_t i = 0; i < x->numel(); i++) {
+      data[i] = value;
+    }
+  };
+  auto check = [&](const std::vector<float>& values) {
+    auto* out_data = out.data<float>();
+    int64_t offset = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      int64_t size = (i == 0 ? x1 : x2).numel();
+      for (int64_t j = 0; j < size; j++) {
+        EXPECT_NEAR(out_data[offset + j], values[i], 1e-6);
+      }
+      offset += size;
+    }
+  };
+
+  ConcatCompute<float> concat;
+  operators::ConcatParam param;
+  param.x = {&x1, &x2};
+  param.output = &out;
+  param.axis = 1;
+  param.use_buffer_view = true;
+  concat.SetParam(param);
+
+  // The inputs are copied in the first run, and become views of the output.
+  fill(&x1, 1);
+  fill(&x2, 2);
+  concat.Run();
+  check({1, 2});
+  EXPECT_EQ(x1.data<float>(), out.data<float>());
+  EXPECT_EQ(x2.data<float>(), out.data<float>() + x1.numel());
+
+  // The producers write to the output directly.
+  fill(&x1, 3);
+  fill(&x2, 4);
+  EXPECT_EQ(x1.data<float>(), out.data<float>());
+  concat.Run();
+  check({3, 4});
+
+  // An input gets its own buffer if it needs more memory.
+  x2.Resize({1, 2, 3, 3});
+  out.Resize({1, 3, 3, 3});
+  fill(&x1, 5);
+  fill(&x2, 6);
+  concat.Run();
+  check({5, 6});
+  EXPECT_EQ(x2.data<float>(), out.data<float>() + x1.numel());
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,9 +14,12 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <string>
 #include <vector>
+#include "lite/backends/host/math/gemm_epilogue.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fp16.h"
 #include "lite/backends/x86/math/im2col.h"
 #include "lite/backends/x86/math/vol2col.h"
 #include "lite/core/kernel.h"
@@ -44,6 +47,30 @@ inline bool IsExpand(const std::vector<int64_t>& filter_dim,
   return !(filter_1 && strides_1 && padding_0 && dilation_1);
 }
 
+// The epilogue of the fused conv for the output channels starting at `c0` in
+// the batch `batch`, each of `size` values: the bias, the residual add and the
+// activation.
+inline lite::host::math::GemmEpilogue ConvEpilogue(
+    const operators::ConvParam& param, int batch, int c0, int size) {
+  lite::host::math::GemmEpilogue epilogue;
+  if (param.bias) {
+    epilogue.bias = param.bias->data<float>() + c0;
+  }
+  if (param.residualData) {
+    CHECK_EQ(param.residualData->dims(), param.output->dims());
+    int64_t channels = param.output->dims()[1];
+    epilogue.residual = param.residualData->data<float>() +
+                        (batch * channels + c0) * static_cast<int64_t>(size);
+    epilogue.ldr = size;
+  }
+  if (param.fuse_relu) {
+    epilogue.act = lite_api::ActivationType::kRelu;
+  } else if (param.activation_param.has_active) {
+    lite::host::math::set_epilogue_act(param.activation_param, &epilogue);
+  }
+  return epilogue;
+}
+
 template <typename T>
 class Conv2dCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -139,22 +166,83 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
         out_slice.ShareDataWith(
             out_batch.Slice<T>(static_cast<int64_t>(g * out_step),
                                static_cast<int64_t>((g + 1) * out_step)));
-        lite::Tensor filter_slice;
-        filter_slice.ShareDataWith(
-            filter.Slice<T>(static_cast<int64_t>(g * out_step),
-                            static_cast<int64_t>((g + 1) * out_step)));
-        blas.MatMul(filter_slice,
-                    false,
-                    col_matrix,
-                    false,
-                    T(1.0),
-                    &(out_slice),
-                    T(0.0));
+        if (filter.precision() == PRECISION(kFP16)) {
+          int k = filter_matrix_shape[1];
+          MatMulWithFP16Filter(blas,
+                               filter.data<uint16_t>() +
+                                   static_cast<int64_t>(g) * out_step * k,
+                               out_step,
+                               k,
+                               col_matrix.data<T>(),
+                               col_matrix_shape[1],
+                               out_slice.mutable_data<T>());
+        } else {
+          lite::Tensor filter_slice;
+          filter_slice.ShareDataWith(
+              filter.Slice<T>(static_cast<int64_t>(g * out_step),
+                              static_cast<int64_t>((g + 1) * out_step)));
+          blas.MatMul(filter_slice,
+                      false,
+                      col_matrix,
+                      false,
+                      T(1.0),
+                      &(out_slice),
+                      T(0.0));
+        }
+        // Apply the fused ops to the output of the group while it is still
+        // in cache.
+        int size = col_matrix_shape[1];
+        auto epilogue = ConvEpilogue(param, i, g * out_step, size);
+        if (!epilogue.empty()) {
+          lite::host::math::apply_gemm_epilogue(epilogue,
+                                          0,
+                                          out_step,
+                                          0,
+                                          size,
+                                          out_slice.mutable_data<T>(),
+                                          size);
+        }
       }
     }
   }
 
   virtual ~Conv2dCompute() = default;
+
+ private:
+  // C[m, n] = A[m, k] * B[k, n], where the filter A is stored in FP16. A block
+  // of the rows of A is converted at a time to compute the same rows of C.
+  template <typename BlasT>
+  void MatMulWithFP16Filter(const BlasT& blas,
+                            const uint16_t* a,
+                            int m,
+                            int k,
+                            const T* b,
+                            int n,
+                            T* c) {
+    int block = std::min(m, std::max(1, lite::x86::math::kFP16BlockSize / k));
+    filter_block_.resize(static_cast<size_t>(block) * k);
+    for (int m0 = 0; m0 < m; m0 += block) {
+      int mb = std::min(block, m - m0);
+      lite::x86::math::fp16_to_fp32(a + static_cast<int64_t>(m0) * k,
+                                    filter_block_.data(),
+                                    static_cast<int64_t>(mb) * k);
+      blas.GEMM(false,
+                false,
+                mb,
+                n,
+                k,
+                T(1),
+                filter_block_.data(),
+                k,
+                b,
+                n,
+                T(0),
+                c + static_cast<int64_t>(m0) * n,
+                n);
+    }
+  }
+
+  std::vector<T> filter_block_;
 };
 
 }  // namespace x86
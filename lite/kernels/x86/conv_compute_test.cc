@@ -14,6 +14,7 @@
 
 #include "lite/kernels/x86/conv_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -90,6 +91,79 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+TEST(conv2d_x86, run_residual_relu_test) {
+  // out = relu(conv(x) + bias + residual) with a padded 3x3 filter.
+  const int ic = 2, oc = 3, hw = 4;
+  lite::Tensor x, filter, b, residual, out;
+  x.Resize({1, ic, hw, hw});
+  filter.Resize({oc, ic, 3, 3});
+  b.Resize({oc});
+  residual.Resize({1, oc, hw, hw});
+  out.Resize({1, oc, hw, hw});
+
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  auto residual_data = residual.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  for (int64_t i = 0; i < filter.numel(); i++) {
+    filter_data[i] = static_cast<float>(i % 5) * 0.25f - 0.5f;
+  }
+  for (int64_t i = 0; i < b.numel(); i++) {
+    b_data[i] = static_cast<float>(i) - 1.f;
+  }
+  for (int64_t i = 0; i < residual.numel(); i++) {
+    residual_data[i] = static_cast<float>(i % 3) - 1.f;
+  }
+
+  std::vector<float> ref(out.numel());
+  for (int o = 0; o < oc; o++) {
+    for (int h = 0; h < hw; h++) {
+      for (int w = 0; w < hw; w++) {
+        float sum = b_data[o];
+        for (int c = 0; c < ic; c++) {
+          for (int kh = 0; kh < 3; kh++) {
+            for (int kw = 0; kw < 3; kw++) {
+              int ih = h + kh - 1;
+              int iw = w + kw - 1;
+              if (ih < 0 || ih >= hw || iw < 0 || iw >= hw) continue;
+              sum += x_data[(c * hw + ih) * hw + iw] *
+                     filter_data[((o * ic + c) * 3 + kh) * 3 + kw];
+            }
+          }
+        }
+        int idx = (o * hw + h) * hw + w;
+        ref[idx] = std::max(sum + residual_data[idx], 0.f);
+      }
+    }
+  }
+
+  Conv2dCompute<float> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &b;
+  param.residualData = &residual;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.paddings = {1, 1};
+  param.groups = 1;
+  param.dilations = {1, 1};
+  param.fuse_relu = true;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.Run();
+
+  auto out_data = out.data<float>();
+  for (int64_t i = 0; i < out.numel(); i++) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-4);
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -41,27 +41,29 @@ class DropoutCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     const auto* x_data = param.x->data<T>();
     auto* out_data = param.output->mutable_data<T>();
     if (!param.is_test) {
-      auto* mask_data = param.mask->mutable_data<T>();
+      // Mask is null when no op consumes it.
+      auto* mask_data = param.mask ? param.mask->mutable_data<T>() : nullptr;
       std::random_device rnd;
       std::minstd_rand engine;
       int seed = param.fix_seed ? param.seed : rnd();
       engine.seed(seed);
       std::uniform_real_distribution<float> dist(0, 1);
 
-      size_t size = param.mask->dims().production();
+      size_t size = param.x->dims().production();
       for (size_t i = 0; i < size; ++i) {
+        T mask = 0;
         if (dist(engine) < param.dropout_prob) {
-          mask_data[i] = 0;
           out_data[i] = 0;
         } else {
           if (param.dropout_implementation == "upscale_in_train") {
-            mask_data[i] = 1.0f / static_cast<T>(1.0f - param.dropout_prob);
+            mask = 1.0f / static_cast<T>(1.0f - param.dropout_prob);
             out_data[i] = x_data[i] / static_cast<T>(1.0f - param.dropout_prob);
           } else {
-            mask_data[i] = 1;
+            mask = 1;
             out_data[i] = x_data[i];
           }
         }
+        if (mask_data) mask_data[i] = mask;
       }
     } else {
       auto X = EigenMatrix<T>::Reshape(*param.x, 1);
@@ -18,6 +18,8 @@ REGISTER_LITE_KERNEL(
     fc, kX86, kFloat, kNCHW, paddle::lite::kernels::x86::FcCompute<float>, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("ResidualData", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
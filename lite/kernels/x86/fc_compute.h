@@ -13,44 +13,20 @@
 // limitations under the License.
 #pragma once
 
-#include <Eigen/Core>
+#include <string>
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
+#include "lite/kernels/x86/mul_compute.h"
 #include "lite/operators/fc_op.h"
-#include "paddle/fluid/framework/eigen.h"
-#include "paddle/fluid/framework/operator.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace x86 {
 
-template <typename T>
-void fc_compute_eigen(const T* x,
-                      int x_h,
-                      int x_w,  //
-                      const T* w,
-                      int w_h,
-                      int w_w,     //
-                      const T* b,  //
-                      T* out) {
-  using matrix_t =
-      Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
-
-  Eigen::Map<const matrix_t> X(x, x_h, x_w);
-  Eigen::Map<const matrix_t> W(w, w_h, w_w);
-  Eigen::Map<matrix_t> Out(out, x_h, w_w);
-
-  Out = X * W;
-
-  if (b) {
-    Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>> B(b, w_w);
-    Out = Out.array().rowwise() + B.transpose().array();
-  }
-}
-
 template <typename T>
 void fc_compute_naive(const T* x,
                       int x_h,
@@ -79,25 +55,68 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::FcParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<param_t>();
+    act_ = lite::host::math::epilogue_act_type(param.activation_type);
+  }
+
   void Run() override {
+    auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<param_t>();
     CHECK_GE(param.input->dims().size(), 2UL);
-    CHECK_EQ(param.output->dims().size(), 2UL);
+    auto x_dims = param.input->dims().Flatten2D(param.in_num_col_dims);
+    int m = x_dims[0];
+    int k = x_dims[1];
+    int n = param.output->dims()[param.output->dims().size() - 1];
+    CHECK_EQ(param.w->dims()[0], k);
 
-    fc_compute_eigen(
-        param.input->data<T>(),  // x
-        param.input->dims().Slice(0, param.in_num_col_dims).production(),
-        param.input->dims()
-            .Slice(param.in_num_col_dims, param.input->dims().size())
-            .production(),
-        param.w->data<T>(),     // w
-        param.w->dims()[0],     // w_h
-        param.w->dims()[1],     // w_w
-        param.bias->data<T>(),  // b
-        param.output->mutable_data<T>());
+    // The bias, the residual add and the activation are fused after the
+    // GEMM, or in the GEMV of the batch-1 fc.
+    lite::host::math::GemmEpilogue epilogue;
+    epilogue.channel_is_row = false;
+    epilogue.bias = param.bias ? param.bias->data<T>() : nullptr;
+    if (param.residualData) {
+      CHECK_EQ(param.residualData->numel(), static_cast<int64_t>(m) * n);
+      epilogue.residual = param.residualData->data<T>();
+      epilogue.ldr = n;
+    }
+    epilogue.act = act_;
+    epilogue.leaky_alpha = param.leaky_relu_alpha;
+    epilogue.relu6_threshold = param.relu6_threshold;
+    if (param.dynamic_quant) {
+      MatMulWeightDynamicQuant(param.input->data<T>(),
+                               m,
+                               k,
+                               n,
+                               *param.w,
+                               param.weight_only_scale->data<float>(),
+                               epilogue,
+                               &packed_w_,
+                               param.output->mutable_data<T>());
+      return;
+    }
+    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    MatMulWeight(blas,
+                 param.input->data<T>(),
+                 m,
+                 k,
+                 n,
+                 *param.w,
+                 param.weight_only_quant_bits,
+                 param.weight_only_quant_bits
+                     ? param.weight_only_scale->data<float>()
+                     : nullptr,
+                 epilogue,
+                 &w_block_,
+                 param.output->mutable_data<T>());
   }
 
   virtual ~FcCompute() = default;
+
+ private:
+  lite_api::ActivationType act_{lite_api::ActivationType::kIndentity};
+  std::vector<float> w_block_;
+  std::vector<int16_t> packed_w_;
 };
 
 }  // namespace x86
@@ -13,7 +13,16 @@
 // limitations under the License.
 #include "lite/kernels/x86/fc_compute.h"
 #include <gtest/gtest.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
+#include "lite/backends/host/math/weight_only_quant.h"
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -34,62 +43,160 @@ TEST(fc_x86, init) {
   ASSERT_EQ(fc.target(), TARGET(kX86));
 }
 
-TEST(fc_x86, run_test) {
+void RunFcAndCheck(int m,
+                   int k,
+                   int n,
+                   const std::string& act,
+                   float relu6_threshold = 6.f) {
   lite::Tensor x, w, b, out;
-  constexpr int batch_size = 2;
-  std::vector<int64_t> x_shape{batch_size, 3};
-  x.Resize(lite::DDim(x_shape));
-  std::vector<int64_t> w_shape{3, 4};
-  w.Resize(lite::DDim(w_shape));
-  std::vector<int64_t> b_shape{1, 4};
-  b.Resize(lite::DDim(b_shape));
-  std::vector<int64_t> out_shape{1, 4};
-  out.Resize(lite::DDim(out_shape));
+  x.Resize({m, k});
+  w.Resize({k, n});
+  b.Resize({1, n});
+  out.Resize({m, n});
 
   auto x_data = x.mutable_data<float>();
   auto w_data = w.mutable_data<float>();
   auto b_data = b.mutable_data<float>();
-  auto out_data = out.mutable_data<float>();
-
   for (int64_t i = 0; i < x.dims().production(); i++) {
-    x_data[i] = static_cast<float>(i);
+    x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
   }
   for (int64_t i = 0; i < w.dims().production(); i++) {
-    w_data[i] = static_cast<float>(i);
+    w_data[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
   }
   for (int64_t i = 0; i < b.dims().production(); i++) {
-    b_data[i] = static_cast<float>(i);
+    b_data[i] = static_cast<float>(i % 5) * 0.5f - 1.f;
   }
 
-  /* lite::x86::math::fc_compute_eigen(x_data, batch_size, 3,  //
-                                     w_data, 3, 4,           //
-                                     b_data, ref_data); */
-
-  // FcCompute fc;
   FcCompute<float> fc;
   operators::FcParam param;
-
   param.in_num_col_dims = 1;
   param.input = &x;
   param.w = &w;
   param.bias = &b;
   param.output = &out;
   param.in_mat_dims = x.dims();
+  param.activation_type = act;
+  param.relu6_threshold = relu6_threshold;
 
-  // std::unique_ptr<KernelContext> ctx(new KernelContext);
-  // ctx->As<X86Context>();
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
   fc.SetParam(param);
-  // fc.SetContext(std::move(ctx));
+  fc.SetContext(std::move(ctx));
+  fc.PrepareForRun();
   fc.Run();
 
-  VLOG(3) << "output vs ref";
-  for (int i = 0; i < out.dims().production(); i++) {
-    VLOG(3) << out_data[i];
+  std::vector<float> ref(m * n);
+  fc_compute_naive(x_data, m, k, w_data, k, n, b_data, ref.data());
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m * n; ++i) {
+    float r = ref[i];
+    if (act == "relu") {
+      r = std::max(r, 0.f);
+    } else if (act == "relu6") {
+      r = std::min(std::max(r, 0.f), relu6_threshold);
+    }
+    EXPECT_NEAR(out_data[i], r, 1e-3 * std::max(1.f, std::abs(r)));
+  }
+}
+
+TEST(fc_x86, run_test) { RunFcAndCheck(2, 3, 4, ""); }
+
+TEST(fc_x86, run_batch1_relu_test) {
+  // The batch-1 fc runs the GEMV with the bias and relu fused.
+  RunFcAndCheck(1, 3, 4, "relu");
+  RunFcAndCheck(1, 200, 150, "relu");
+}
+
+TEST(fc_x86, run_relu6_test) {
+  // A threshold other than 6 can not be fused into the GEMV.
+  RunFcAndCheck(3, 20, 15, "relu6", 0.5f);
+  RunFcAndCheck(1, 20, 15, "relu6", 0.5f);
+  RunFcAndCheck(1, 20, 15, "relu6");
+}
+
+TEST(fc_x86, run_batch1_threaded_test) {
+#ifdef _OPENMP
+  omp_set_num_threads(4);
+#endif
+  // Enough work for the threads: the columns are split over the threads
+  // first, then the rows are split when there are fewer column blocks than
+  // threads.
+  RunFcAndCheck(1, 1024, 640, "relu");
+  RunFcAndCheck(1, 4096, 48, "");
+  RunFcAndCheck(1, 2048, 100, "relu");
+}
+
+TEST(fc_x86, run_dynamic_quant_test) {
+  // The int8 weight is multiplied with the rows of x quantized at runtime,
+  // then the bias and relu are applied. Check it against the product of the
+  // dequantized weight and x quantized the same way.
+  constexpr int m = 4, k = 90, n = 50;
+  lite::Tensor x, w_fp32, w, scale, b, out;
+  x.Resize({m, k});
+  w_fp32.Resize({k, n});
+  w.Resize({k, n});
+  scale.Resize({n});
+  b.Resize({1, n});
+  out.Resize({m, n});
+  auto x_data = x.mutable_data<float>();
+  auto w_fp32_data = w_fp32.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
   }
+  for (int64_t i = 0; i < w_fp32.dims().production(); i++) {
+    w_fp32_data[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
+  }
+  for (int64_t i = 0; i < b.dims().production(); i++) {
+    b_data[i] = static_cast<float>(i % 5) * 0.5f - 1.f;
+  }
+  lite::host::math::quantize_weight(w_fp32_data,
+                                    k,
+                                    n,
+                                    8,
+                                    false,
+                                    w.mutable_data<int8_t>(),
+                                    scale.mutable_data<float>());
+  std::vector<float> w_ref(k * n);
+  lite::host::math::dequantize_weight_rows(
+      w.data<int8_t>(), k, n, 8, scale.data<float>(), w_ref.data());
+
+  FcCompute<float> fc;
+  operators::FcParam param;
+  param.in_num_col_dims = 1;
+  param.input = &x;
+  param.w = &w;
+  param.bias = &b;
+  param.output = &out;
+  param.in_mat_dims = x.dims();
+  param.activation_type = "relu";
+  param.weight_only_quant_bits = 8;
+  param.weight_only_scale = &scale;
+  param.dynamic_quant = true;
 
-  /* for (int i = 0; i < out.dims().production(); ++i) {
-     EXPECT_NEAR(out_data[i], ref_data[i], 1e-5);
-   }*/
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetParam(param);
+  fc.SetContext(std::move(ctx));
+  fc.PrepareForRun();
+  fc.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    float abs_max = 0.f;
+    for (int l = 0; l < k; l++) {
+      abs_max = std::max(abs_max, std::abs(x_data[i * k + l]));
+    }
+    float x_scale = abs_max / 127.f;
+    for (int j = 0; j < n; j++) {
+      float ref = b_data[j];
+      for (int l = 0; l < k; l++) {
+        float x_quant = std::round(x_data[i * k + l] / x_scale) * x_scale;
+        ref += x_quant * w_ref[l * n + j];
+      }
+      EXPECT_NEAR(out_data[i * n + j], std::max(ref, 0.f), 1e-2);
+    }
+  }
 }
 
 }  // namespace x86
@@ -29,6 +29,7 @@ REGISTER_LITE_KERNEL(lookup_table,
                      paddle::lite::kernels::x86::LookupTableCompute<float>,
                      def)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
@@ -39,6 +40,7 @@ REGISTER_LITE_KERNEL(lookup_table_v2,
                      paddle::lite::kernels::x86::LookupTableCompute<float>,
                      def)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("WeightScale", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
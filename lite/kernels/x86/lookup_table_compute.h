@@ -14,6 +14,8 @@
 #pragma once
 
 #include <vector>
+#include "lite/backends/host/math/weight_only_quant.h"
+#include "lite/backends/x86/math/fp16.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/fluid/eigen.h"
@@ -38,9 +40,14 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kInt64)> {
 
     auto *table_t = param.W;
     int64_t row_number = table_t->dims()[0];
-    int64_t row_width = table_t->dims()[1];
+    int64_t row_width = output_t->dims()[output_t->dims().size() - 1];
+    // The packed width of the table, two int4 values are stored in a byte.
+    int64_t packed_width = table_t->dims()[1];
 
-    auto *table = table_t->data<float>();
+    // The table may be stored in FP16 or quantized, then the rows are
+    // converted to float when being looked up.
+    bool fp16_table = table_t->precision() == PRECISION(kFP16);
+    int quant_bits = param.weight_only_quant_bits;
     auto *output = output_t->mutable_data<float>();
     memset(output, 0, output_t->dims().production() * sizeof(float));
     for (int64_t i = 0; i < ids_numel; ++i) {
@@ -49,9 +56,23 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kInt64)> {
       } else {
         CHECK_LT(ids[i], row_number);
         CHECK_GE(ids[i], 0);
-        memcpy(output + i * row_width,
-               table + ids[i] * row_width,
-               row_width * sizeof(float));
+        if (quant_bits) {
+          lite::host::math::dequantize_weight_row(
+              table_t->data<int8_t>() + ids[i] * packed_width,
+              row_width,
+              quant_bits,
+              param.weight_only_scale->data<float>()[ids[i]],
+              output + i * row_width);
+        } else if (fp16_table) {
+          lite::x86::math::fp16_to_fp32(
+              table_t->data<uint16_t>() + ids[i] * row_width,
+              output + i * row_width,
+              row_width);
+        } else {
+          memcpy(output + i * row_width,
+                 table_t->data<float>() + ids[i] * row_width,
+                 row_width * sizeof(float));
+        }
       }
     }
   }
@@ -17,6 +17,7 @@
 #include <cmath>
 #include <string>
 #include <vector>
+#include "lite/backends/host/math/weight_only_quant.h"
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -74,6 +75,55 @@ TEST(lookup_table_x86, compute) {
   }
 }
 
+TEST(lookup_table_x86, weight_only_quant) {
+  int vocab_size = 40;
+  int emb_size = 50;
+  int ids_num = 30;
+  std::vector<float> w_ref(vocab_size * emb_size);
+  for (size_t i = 0; i < w_ref.size(); i++) {
+    w_ref[i] = std::sin(static_cast<float>(i));
+  }
+
+  for (int bits : {8, 4}) {
+    LookupTableCompute<float> lookup_table;
+    operators::LookupTableParam param;
+    lite::Tensor w, scale, ids, out;
+    w.Resize({vocab_size, bits == 4 ? emb_size / 2 : emb_size});
+    scale.Resize({vocab_size});
+    ids.Resize({ids_num, 1});
+    out.Resize({ids_num, emb_size});
+    host::math::quantize_weight(w_ref.data(),
+                                vocab_size,
+                                emb_size,
+                                bits,
+                                true,
+                                w.mutable_data<int8_t>(),
+                                scale.mutable_data<float>());
+    auto* ids_data = ids.mutable_data<int64_t>();
+    for (int i = 0; i < ids_num; i++) {
+      ids_data[i] = (i * 7) % vocab_size;
+    }
+
+    param.W = &w;
+    param.Ids = &ids;
+    param.Out = &out;
+    param.weight_only_scale = &scale;
+    param.weight_only_quant_bits = bits;
+    lookup_table.SetParam(param);
+    lookup_table.Run();
+
+    auto* out_data = out.data<float>();
+    auto* scale_data = scale.data<float>();
+    for (int i = 0; i < ids_num; i++) {
+      for (int j = 0; j < emb_size; j++) {
+        EXPECT_NEAR(out_data[i * emb_size + j],
+                    w_ref[ids_data[i] * emb_size + j],
+                    scale_data[ids_data[i]] / 2 + 1e-6);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
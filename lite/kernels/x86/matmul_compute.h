@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <vector>
+#include "lite/backends/host/math/matmul_batch_offsets.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_s8.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -59,6 +63,64 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     out->mutable_data<T>();
 
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+    auto x_dims = x->dims();
+    auto y_dims = y->dims();
+    if (param.weight_only_quant_bits) {
+      // The dynamic quantization of the matmul with a constant Y [K, N], the
+      // rows of x are quantized at runtime and alpha is folded into the
+      // scales of the columns.
+      CHECK(param.dynamic_quant);
+      CHECK_EQ(y_dims.size(), 2UL);
+      int k = y_dims[0];
+      int n = y_dims[1];
+      int m = x_dims.production() / k;
+      if (packed_y_.empty()) {
+        lite::x86::math::pack_weight_s8(y->data<int8_t>(), k, n, &packed_y_);
+        const float *scale = param.weight_only_scale->data<float>();
+        y_scale_.resize(n);
+        for (int j = 0; j < n; ++j) {
+          y_scale_[j] = scale[j] * param.alpha;
+        }
+      }
+      lite::x86::math::gemm_s8_dynamic(x->data<T>(),
+                                       m,
+                                       k,
+                                       n,
+                                       packed_y_.data(),
+                                       y_scale_.data(),
+                                       lite::host::math::GemmEpilogue(),
+                                       out->mutable_data<T>());
+      return;
+    }
+    if (x_dims.size() >= 2 && y_dims.size() >= 2 &&
+        (x_dims.size() > 2 || y_dims.size() > 2)) {
+      // The batch dims can be broadcast, each GEMM reads its matrices of x
+      // and y in place, transposed or not.
+      int m = param.transpose_X ? x_dims[x_dims.size() - 1]
+                                : x_dims[x_dims.size() - 2];
+      int k = param.transpose_X ? x_dims[x_dims.size() - 2]
+                                : x_dims[x_dims.size() - 1];
+      int n = param.transpose_Y ? y_dims[y_dims.size() - 2]
+                                : y_dims[y_dims.size() - 1];
+      std::vector<int64_t> x_offsets;
+      std::vector<int64_t> y_offsets;
+      int batch = lite::host::math::matmul_batch_offsets(
+          x_dims, y_dims, &x_offsets, &y_offsets);
+      blas.BatchedGEMM(param.transpose_X ? CblasTrans : CblasNoTrans,
+                       param.transpose_Y ? CblasTrans : CblasNoTrans,
+                       m,
+                       n,
+                       k,
+                       static_cast<T>(param.alpha),
+                       x->data<T>(),
+                       x_offsets.data(),
+                       y->data<T>(),
+                       y_offsets.data(),
+                       T(0),
+                       out->mutable_data<T>(),
+                       batch);
+      return;
+    }
     auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
         RowMatrixFromVector(x->dims()), 0, param.transpose_X);
     auto mat_dim_b = lite::x86::math::CreateMatrixDescriptor(
@@ -68,6 +130,10 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~MatMulCompute() = default;
+
+ private:
+  std::vector<int16_t> packed_y_;
+  std::vector<float> y_scale_;
 };
 
 }  // namespace x86
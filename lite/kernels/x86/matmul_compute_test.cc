@@ -14,10 +14,13 @@
 
 #include "lite/kernels/x86/matmul_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/weight_only_quant.h"
 #include "lite/core/op_registry.h"
 namespace paddle {
 namespace lite {
@@ -30,6 +33,8 @@ TEST(matmul_x86, retrive_op) {
           "matmul");
   ASSERT_FALSE(matmul.empty());
   ASSERT_TRUE(matmul.front());
+  // The dynamic quantization adds the scales of the weight as an input.
+  ASSERT_TRUE(matmul.front()->GetInputDeclType("WeightScale"));
 }
 
 TEST(matmul_x86, init) {
@@ -79,6 +84,71 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+TEST(matmul_x86, run_dynamic_quant_test) {
+  // The int8 Y is multiplied with the rows of x quantized at runtime, check
+  // it against the product of the dequantized Y and x quantized the same
+  // way, scaled by alpha.
+  constexpr int m = 6, k = 70, n = 40;
+  constexpr float alpha = 0.5f;
+  lite::Tensor x, y_fp32, y, scale, out;
+  x.Resize({2, m / 2, k});
+  y_fp32.Resize({k, n});
+  y.Resize({k, n});
+  scale.Resize({n});
+  out.Resize({2, m / 2, n});
+  auto x_data = x.mutable_data<float>();
+  auto y_fp32_data = y_fp32.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 9) * 0.25f - 1.f;
+  }
+  for (int64_t i = 0; i < y_fp32.dims().production(); i++) {
+    y_fp32_data[i] = static_cast<float>(i % 13) * 0.2f - 1.2f;
+  }
+  lite::host::math::quantize_weight(y_fp32_data,
+                                    k,
+                                    n,
+                                    8,
+                                    false,
+                                    y.mutable_data<int8_t>(),
+                                    scale.mutable_data<float>());
+  std::vector<float> y_ref(k * n);
+  lite::host::math::dequantize_weight_rows(
+      y.data<int8_t>(), k, n, 8, scale.data<float>(), y_ref.data());
+
+  MatMulCompute<float> matmul;
+  operators::MatMulParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = &out;
+  param.alpha = alpha;
+  param.weight_only_quant_bits = 8;
+  param.weight_only_scale = &scale;
+  param.dynamic_quant = true;
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    float abs_max = 0.f;
+    for (int l = 0; l < k; l++) {
+      abs_max = std::max(abs_max, std::fabs(x_data[i * k + l]));
+    }
+    float x_scale = abs_max / 127.f;
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      for (int l = 0; l < k; l++) {
+        float x_quant = std::round(x_data[i * k + l] / x_scale) * x_scale;
+        ref += x_quant * y_ref[l * n + j];
+      }
+      EXPECT_NEAR(out_data[i * n + j], alpha * ref, 1e-2);
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,7 +13,14 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <vector>
+#include "lite/backends/host/math/gemm_epilogue.h"
+#include "lite/backends/host/math/weight_only_quant.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fp16.h"
+#include "lite/backends/x86/math/gemm_s8.h"
+#include "lite/backends/x86/math/gemv.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -34,6 +41,151 @@ inline lite::Tensor ReshapeToMatrix(const lite::Tensor& src, int num_col_dims) {
   return res;
 }
 
+// Whether the GEMV kernels, which take a bias and a kIndentity, kRelu or kRelu6
+// activation, fuse all of `epilogue`.
+inline bool GemvFusesEpilogue(const lite::host::math::GemmEpilogue& epilogue) {
+  using lite_api::ActivationType;
+  return epilogue.scale == nullptr && epilogue.residual == nullptr &&
+         (epilogue.act == ActivationType::kIndentity ||
+          epilogue.act == ActivationType::kRelu ||
+          (epilogue.act == ActivationType::kRelu6 &&
+           epilogue.relu6_threshold == 6.f));
+}
+
+// out[M, N] = epilogue(x[M, K] * W[K, N]) for the weight W of mul and fc. W
+// is stored in float, in FP16, or weight-only quantized in `quant_bits` with a
+// scale per column in `quant_scale`. The channels of the epilogue are the
+// columns of out.
+//
+// The batch-1 products use the GEMV kernels, which fuse the bias and the
+// simple activations. The others are done by GEMM. If W is not stored in
+// float, a block of its rows is unpacked to float at a time into `w_block`,
+// and the partial products are accumulated to out.
+template <typename BlasT>
+void MatMulWeight(const BlasT& blas,
+                  const float* x,
+                  int m,
+                  int k,
+                  int n,
+                  const Tensor& w,
+                  int quant_bits,
+                  const float* quant_scale,
+                  const lite::host::math::GemmEpilogue& epilogue,
+                  std::vector<float>* w_block,
+                  float* out) {
+  const bool fp16 = w.precision() == PRECISION(kFP16);
+  lite::host::math::GemmEpilogue ep = epilogue;
+  ep.channel_is_row = false;
+  if (m == 1) {
+    const bool fused = GemvFusesEpilogue(ep);
+    const float* bias = fused ? ep.bias : nullptr;
+    auto act = fused ? ep.act : lite_api::ActivationType::kIndentity;
+    if (quant_bits) {
+      lite::x86::math::sgemv_weight_only_quant(x,
+                                               w.data<int8_t>(),
+                                               quant_bits,
+                                               quant_scale,
+                                               k,
+                                               n,
+                                               bias,
+                                               act,
+                                               out);
+    } else if (fp16) {
+      lite::x86::math::sgemv_fp16(x, w.data<uint16_t>(), k, n, bias, act, out);
+    } else {
+      lite::x86::math::sgemv(x, w.data<float>(), k, n, bias, act, out);
+    }
+    if (!fused) {
+      lite::host::math::apply_gemm_epilogue(ep, 0, 1, 0, n, out, n);
+    }
+    return;
+  }
+
+  if (quant_bits || fp16) {
+    int block = std::min(
+        k, std::max(16, lite::x86::math::kFP16BlockSize / std::max(n, 1)));
+    w_block->resize(static_cast<size_t>(block) * n);
+    const int64_t packed_n = quant_bits == 4 ? n / 2 : n;
+    for (int k0 = 0; k0 < k; k0 += block) {
+      int kb = std::min(block, k - k0);
+      if (quant_bits) {
+        lite::host::math::dequantize_weight_rows(
+            w.data<int8_t>() + k0 * packed_n,
+            kb,
+            n,
+            quant_bits,
+            quant_scale,
+            w_block->data());
+      } else {
+        lite::x86::math::fp16_to_fp32(w.data<uint16_t>() + k0 * packed_n,
+                                      w_block->data(),
+                                      static_cast<int64_t>(kb) * n);
+      }
+      blas.GEMM(false,
+                false,
+                m,
+                n,
+                kb,
+                1.f,
+                x + k0,
+                k,
+                w_block->data(),
+                n,
+                k0 == 0 ? 0.f : 1.f,
+                out,
+                n);
+    }
+  } else {
+    blas.GEMM(
+        false, false, m, n, k, 1.f, x, k, w.data<float>(), n, 0.f, out, n);
+  }
+
+  if (!ep.empty()) {
+    lite::host::math::apply_gemm_epilogue(ep, 0, m, 0, n, out, n);
+  }
+}
+
+// out[M, N] = epilogue(x[M, K] * W[K, N]) for the dynamic quantization: W
+// is in int8 with a scale per column in `quant_scale`, and the rows of x are
+// quantized at runtime. W is packed for the int8 GEMM into `packed_w` at the
+// first run. The batch-1 products keep to the weight-only GEMV, which reads
+// the int8 weight instead of the wider packed one.
+inline void MatMulWeightDynamicQuant(
+    const float* x,
+    int m,
+    int k,
+    int n,
+    const Tensor& w,
+    const float* quant_scale,
+    const lite::host::math::GemmEpilogue& epilogue,
+    std::vector<int16_t>* packed_w,
+    float* out) {
+  if (m == 1) {
+    lite::host::math::GemmEpilogue ep = epilogue;
+    ep.channel_is_row = false;
+    const bool fused = GemvFusesEpilogue(ep);
+    lite::x86::math::sgemv_weight_only_quant(
+        x,
+        w.data<int8_t>(),
+        8,
+        quant_scale,
+        k,
+        n,
+        fused ? ep.bias : nullptr,
+        fused ? ep.act : lite_api::ActivationType::kIndentity,
+        out);
+    if (!fused) {
+      lite::host::math::apply_gemm_epilogue(ep, 0, 1, 0, n, out, n);
+    }
+    return;
+  }
+  if (packed_w->empty()) {
+    lite::x86::math::pack_weight_s8(w.data<int8_t>(), k, n, packed_w);
+  }
+  lite::x86::math::gemm_s8_dynamic(
+      x, m, k, n, packed_w->data(), quant_scale, epilogue, out);
+}
+
 template <typename T>
 class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -72,13 +224,47 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
 
-    blas.MatMul(x_matrix, y_matrix, z);
+    if (param.dynamic_quant) {
+      CHECK_EQ(y_matrix.dims()[0], x_matrix.dims()[1]);
+      MatMulWeightDynamicQuant(x_matrix.data<T>(),
+                               x_matrix.dims()[0],
+                               x_matrix.dims()[1],
+                               z->dims()[1],
+                               *y,
+                               param.weight_only_scale->data<float>(),
+                               lite::host::math::GemmEpilogue(),
+                               &packed_w_,
+                               z->mutable_data<T>());
+    } else if (param.weight_only_quant_bits ||
+               y->precision() == PRECISION(kFP16) ||
+               x_matrix.dims()[0] == 1) {
+      CHECK_EQ(y_matrix.dims()[0], x_matrix.dims()[1]);
+      MatMulWeight(blas,
+                   x_matrix.data<T>(),
+                   x_matrix.dims()[0],
+                   x_matrix.dims()[1],
+                   z->dims()[1],
+                   *y,
+                   param.weight_only_quant_bits,
+                   param.weight_only_quant_bits
+                       ? param.weight_only_scale->data<float>()
+                       : nullptr,
+                   lite::host::math::GemmEpilogue(),
+                   &w_block_,
+                   z->mutable_data<T>());
+    } else {
+      blas.MatMul(x_matrix, y_matrix, z);
+    }
     if (z_dim.size() != 2) {
       z->Resize(z_dim);
     }
   }
 
   virtual ~MulCompute() = default;
+
+ private:
+  std::vector<float> w_block_;
+  std::vector<int16_t> packed_w_;
 };
 
 #ifdef LITE_WITH_TRAIN
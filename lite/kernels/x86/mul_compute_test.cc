@@ -14,6 +14,8 @@
 
 #include "lite/kernels/x86/mul_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -78,6 +80,186 @@ TEST(mul_x86, run_test) {
   }
 }
 
+TEST(mul_x86, run_fp16_weights_test) {
+  lite::Tensor x, y, y_fp32, out;
+  // n is large enough to convert Y in two blocks.
+  constexpr int m = 3, k = 70, n = 300;
+  x.Resize({m, k});
+  y_fp32.Resize({k, n});
+  y.Resize({k, n});
+  out.Resize({m, n});
+
+  auto x_data = x.mutable_data<float>();
+  auto y_fp32_data = y_fp32.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 7) * 0.25f;
+  }
+  for (int64_t i = 0; i < y_fp32.dims().production(); i++) {
+    y_fp32_data[i] = static_cast<float>(i % 11) * 0.5f - 2.f;
+  }
+  // The values above are exact in FP16.
+  lite::x86::math::fp32_to_fp16(
+      y_fp32_data, y.mutable_data<uint16_t>(), y.dims().production());
+  y.set_precision(PRECISION(kFP16));
+
+  MulCompute<float> mul;
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      for (int l = 0; l < k; l++) {
+        ref += x_data[i * k + l] * y_fp32_data[l * n + j];
+      }
+      EXPECT_NEAR(out_data[i * n + j], ref, 1e-3);
+    }
+  }
+}
+
+TEST(mul_x86, run_gemv_test) {
+  // The batch-1 mul runs the GEMV kernels, check them with the weight stored
+  // in float, in FP16 and weight-only quantized in int8 and int4.
+  constexpr int k = 150, n = 130;
+  lite::Tensor x, y_fp32, scale;
+  x.Resize({1, k});
+  y_fp32.Resize({k, n});
+  scale.Resize({n});
+  auto x_data = x.mutable_data<float>();
+  auto y_fp32_data = y_fp32.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 7) * 0.25f - 0.5f;
+  }
+  for (int64_t i = 0; i < y_fp32.dims().production(); i++) {
+    y_fp32_data[i] = static_cast<float>(i % 11) * 0.5f - 2.f;
+  }
+
+  for (int bits : {0, 16, 8, 4}) {
+    lite::Tensor y, out;
+    out.Resize({1, n});
+    std::vector<float> y_ref(k * n);
+    if (bits == 0) {
+      y.Resize({k, n});
+      std::copy(y_fp32_data, y_fp32_data + k * n, y.mutable_data<float>());
+      std::copy(y_fp32_data, y_fp32_data + k * n, y_ref.begin());
+    } else if (bits == 16) {
+      y.Resize({k, n});
+      lite::x86::math::fp32_to_fp16(
+          y_fp32_data, y.mutable_data<uint16_t>(), k * n);
+      y.set_precision(PRECISION(kFP16));
+      std::copy(y_fp32_data, y_fp32_data + k * n, y_ref.begin());
+    } else {
+      y.Resize({k, bits == 4 ? n / 2 : n});
+      lite::host::math::quantize_weight(y_fp32_data,
+                                        k,
+                                        n,
+                                        bits,
+                                        false,
+                                        y.mutable_data<int8_t>(),
+                                        scale.mutable_data<float>());
+      lite::host::math::dequantize_weight_rows(
+          y.data<int8_t>(), k, n, bits, scale.data<float>(), y_ref.data());
+    }
+
+    MulCompute<float> mul;
+    operators::MulParam param;
+    param.x = &x;
+    param.y = &y;
+    param.output = &out;
+    if (bits == 8 || bits == 4) {
+      param.weight_only_quant_bits = bits;
+      param.weight_only_scale = &scale;
+    }
+
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    mul.SetContext(std::move(ctx));
+    mul.SetParam(param);
+    mul.Run();
+
+    auto out_data = out.data<float>();
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      for (int l = 0; l < k; l++) {
+        ref += x_data[l] * y_ref[l * n + j];
+      }
+      EXPECT_NEAR(out_data[j], ref, 1e-3) << "bits " << bits;
+    }
+  }
+}
+
+TEST(mul_x86, run_dynamic_quant_test) {
+  // The int8 weight is multiplied with the rows of x quantized at runtime,
+  // check it against the product of the dequantized weight and x quantized
+  // the same way.
+  constexpr int m = 5, k = 150, n = 130;
+  lite::Tensor x, y_fp32, y, scale, out;
+  x.Resize({m, k});
+  y_fp32.Resize({k, n});
+  y.Resize({k, n});
+  scale.Resize({n});
+  out.Resize({m, n});
+  auto x_data = x.mutable_data<float>();
+  auto y_fp32_data = y_fp32.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 7) * 0.25f - 0.5f;
+  }
+  for (int64_t i = 0; i < y_fp32.dims().production(); i++) {
+    y_fp32_data[i] = static_cast<float>(i % 11) * 0.5f - 2.f;
+  }
+  lite::host::math::quantize_weight(y_fp32_data,
+                                    k,
+                                    n,
+                                    8,
+                                    false,
+                                    y.mutable_data<int8_t>(),
+                                    scale.mutable_data<float>());
+  std::vector<float> y_ref(k * n);
+  lite::host::math::dequantize_weight_rows(
+      y.data<int8_t>(), k, n, 8, scale.data<float>(), y_ref.data());
+
+  MulCompute<float> mul;
+  operators::MulParam param;
+  param.x = &x;
+  param.y = &y;
+  param.output = &out;
+  param.weight_only_quant_bits = 8;
+  param.weight_only_scale = &scale;
+  param.dynamic_quant = true;
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  mul.SetContext(std::move(ctx));
+  mul.SetParam(param);
+  mul.Run();
+
+  auto out_data = out.data<float>();
+  for (int i = 0; i < m; i++) {
+    float abs_max = 0.f;
+    for (int l = 0; l < k; l++) {
+      abs_max = std::max(abs_max, std::fabs(x_data[i * k + l]));
+    }
+    float x_scale = abs_max / 127.f;
+    for (int j = 0; j < n; j++) {
+      float ref = 0.f;
+      for (int l = 0; l < k; l++) {
+        float x_quant = std::round(x_data[i * k + l] / x_scale) * x_scale;
+        ref += x_quant * y_ref[l * n + j];
+      }
+      EXPECT_NEAR(out_data[i * n + j], ref, 1e-2);
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <type_traits>
 #include "lite/backends/x86/math/math_function.h"
 #include "lite/backends/x86/math/pooling.h"
 #include "lite/core/kernel.h"
@@ -33,12 +34,34 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<param_t>();
+    bool is_max = param.pooling_type == "max";
+    // Adaptive pooling to 1x1 is also global pooling.
+    bool adaptive_global = param.adaptive && param.ksize.size() == 2 &&
+                           param.output->dims()[2] == 1 &&
+                           param.output->dims()[3] == 1;
+    if (std::is_same<T, float>::value &&
+        (param.global_pooling || adaptive_global)) {
+      paddle::lite::x86::math::GlobalPool2d(param.x, is_max, param.output);
+      return;
+    }
     if (param.global_pooling) {
       for (size_t i = 0; i < param.ksize.size(); ++i) {
         param.paddings[i] = 0;
         param.ksize[i] = static_cast<int>(param.x->dims()[i + 2]);
       }
     }
+    if (std::is_same<T, float>::value &&
+        (is_max || param.pooling_type == "avg") &&
+        paddle::lite::x86::math::Pool2dFast(param.x,
+                                            param.ksize,
+                                            param.strides,
+                                            param.paddings,
+                                            is_max,
+                                            is_max || param.exclusive,
+                                            param.adaptive,
+                                            param.output)) {
+      return;
+    }
     switch (param.ksize.size()) {
       case 2: {
         if (param.pooling_type == "max") {
@@ -14,8 +14,11 @@
 
 #include "lite/kernels/x86/pool_compute.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cfloat>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
@@ -78,6 +81,119 @@ TEST(pool2d_x86, run_test) {
   }
 }
 
+TEST(pool2d_x86, fast_path) {
+  for (int ksize : {2, 3}) {
+    for (int stride : {1, 2}) {
+      for (int pad : {0, 1}) {
+        for (std::string type : {"max", "avg"}) {
+          for (bool exclusive : {true, false}) {
+            lite::Tensor x, out, ref;
+            x.Resize({2, 5, 13, 22});
+            auto x_data = x.mutable_data<float>();
+            for (int64_t i = 0; i < x.dims().production(); i++) {
+              x_data[i] = static_cast<float>((i * 37) % 101) / 10.f - 5.f;
+            }
+            // ceil_mode
+            int64_t out_h = (13 - ksize + 2 * pad + stride - 1) / stride + 1;
+            int64_t out_w = (22 - ksize + 2 * pad + stride - 1) / stride + 1;
+            out.Resize({2, 5, out_h, out_w});
+            ref.Resize({2, 5, out_h, out_w});
+
+            PoolCompute<float> pool2d;
+            operators::PoolParam param;
+            param.x = &x;
+            param.output = &out;
+            param.strides = {stride, stride};
+            param.paddings = {pad, pad};
+            param.ksize = {ksize, ksize};
+            param.pooling_type = type;
+            param.exclusive = exclusive;
+            std::unique_ptr<KernelContext> ctx(new KernelContext);
+            ctx->As<X86Context>();
+            pool2d.SetContext(std::move(ctx));
+            pool2d.SetParam(param);
+            pool2d.Run();
+
+            X86Context context;
+            if (type == "max") {
+              lite::x86::math::Pool2dFunctor<TARGET(kX86),
+                                             lite::x86::math::MaxPool<float>,
+                                             float>
+                  pool2d_ref;
+              pool2d_ref(context,
+                         &x,
+                         param.ksize,
+                         param.strides,
+                         param.paddings,
+                         lite::x86::math::MaxPool<float>(),
+                         true,
+                         false,
+                         &ref);
+            } else {
+              lite::x86::math::Pool2dFunctor<TARGET(kX86),
+                                             lite::x86::math::AvgPool<float>,
+                                             float>
+                  pool2d_ref;
+              pool2d_ref(context,
+                         &x,
+                         param.ksize,
+                         param.strides,
+                         param.paddings,
+                         lite::x86::math::AvgPool<float>(),
+                         exclusive,
+                         false,
+                         &ref);
+            }
+            auto out_data = out.data<float>();
+            auto ref_data = ref.data<float>();
+            for (int64_t i = 0; i < out.dims().production(); i++) {
+              EXPECT_NEAR(out_data[i], ref_data[i], 1e-5);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(pool2d_x86, global_pooling) {
+  for (std::string type : {"max", "avg"}) {
+    lite::Tensor x, out;
+    x.Resize({2, 3, 7, 9});
+    out.Resize({2, 3, 1, 1});
+    auto x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.dims().production(); i++) {
+      x_data[i] = static_cast<float>((i * 37) % 101) / 10.f - 5.f;
+    }
+
+    PoolCompute<float> pool2d;
+    operators::PoolParam param;
+    param.x = &x;
+    param.output = &out;
+    param.strides = {1, 1};
+    param.paddings = {0, 0};
+    param.ksize = {1, 1};
+    param.global_pooling = true;
+    param.pooling_type = type;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    pool2d.SetContext(std::move(ctx));
+    pool2d.SetParam(param);
+    pool2d.Run();
+
+    auto out_data = out.data<float>();
+    for (int c = 0; c < 6; c++) {
+      float ref = type == "max" ? -FLT_MAX : 0.f;
+      for (int i = 0; i < 63; i++) {
+        ref = type == "max" ? std::max(ref, x_data[c * 63 + i])
+                            : ref + x_data[c * 63 + i];
+      }
+      if (type == "avg") ref /= 63;
+      EXPECT_NEAR(out_data[c], ref, 1e-5);
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
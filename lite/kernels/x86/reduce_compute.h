@@ -12,70 +12,25 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
-
 #include <vector>
-#include "lite/core/kernel.h"
-#include "lite/core/op_registry.h"
-#include "lite/fluid/eigen.h"
-#include "lite/kernels/x86/reduce_op_function.h"
+#include "lite/kernels/host/reduce_compute.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace x86 {
 
-struct SumFunctor {
-  template <typename X, typename Y, typename Dim>
-  void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->sum(dim);
-  }
-};
-
-#define HANDLE_DIM(NDIM, RDIM)                                            \
-  if (ndim == NDIM && rdim == RDIM) {                                     \
-    paddle::lite::kernels::x86::                                          \
-        ReduceFunctor<lite::TargetType::kX86, T, NDIM, RDIM, SumFunctor>( \
-            *input, output, dims, keep_dim);                              \
-  }
-
+// The x86 reduce kernels share the vectorized engine of the host ones.
 template <typename T>
-class ReduceSumCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
- public:
-  using param_t = operators::ReduceParam;
-
-  void Run() override {
-    auto& param = *param_.get_mutable<operators::ReduceParam>();
-    // auto& context = ctx_->As<X86Context>();
-    bool reduce_all = param.reduce_all;
-    auto* input = param.x;
-    auto* output = param.output;
-    param.output->mutable_data<T>();
-
-    auto dims = param.dim;
-    bool keep_dim = param.keep_dim;
-    if (reduce_all) {
-      // Flatten and reduce 1-D tensor
-      auto x = lite::fluid::EigenVector<T>::Flatten(*input);
-      auto out = lite::fluid::EigenScalar<T>::From(output);
-      // auto& place = *platform::CPUDeviceContext().eigen_device();
-      auto reduce_dim = Eigen::array<int, 1>({{0}});
-      SumFunctor functor;
-      functor(&x, &out, reduce_dim);
-    } else {
-      int ndim = input->dims().size();
-      int rdim = dims.size();
-      HANDLE_DIM(4, 3);
-      HANDLE_DIM(4, 2);
-      HANDLE_DIM(4, 1);
-      HANDLE_DIM(3, 2);
-      HANDLE_DIM(3, 1);
-      HANDLE_DIM(2, 1);
-      HANDLE_DIM(1, 1);
-    }
-  }
-
-  virtual ~ReduceSumCompute() = default;
-};
+using ReduceSumCompute = host::ReduceSumCompute<TARGET(kX86), T>;
+template <typename T>
+using ReduceMeanCompute = host::ReduceMeanCompute<TARGET(kX86), T>;
+template <typename T>
+using ReduceMaxCompute = host::ReduceMaxCompute<TARGET(kX86), T>;
+template <typename T>
+using ReduceMinCompute = host::ReduceMinCompute<TARGET(kX86), T>;
+template <typename T>
+using ReduceProdCompute = host::ReduceProdCompute<TARGET(kX86), T>;
 
 }  // namespace x86
 }  // namespace kernels
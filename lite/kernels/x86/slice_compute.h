@@ -16,6 +16,7 @@
 #include <Eigen/Core>
 #include <algorithm>
 #include <vector>
+#include "lite/backends/host/math/buffer_view.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -288,6 +289,11 @@ class SliceCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto& param = *param_.get_mutable<param_t>();
+    if (param.use_buffer_view && param.axes.size() == 1 &&
+        lite::host::math::slice_as_view<T>(
+            *param.X, param.axes[0], param.starts[0], param.Out)) {
+      return;
+    }
     slice_compute_<T>(param.X,
                       param.Out,
                       param.axes,
@@ -56,9 +56,12 @@ class Squeeze2Compute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto x_dims = x->dims();
     auto* x_data = x->data<T>();
     auto* out_data = output->mutable_data<T>();
-    auto* xshape_data = xshape->mutable_data<T>();
     memcpy(out_data, x_data, x_dims.production() * sizeof(T));
-    memcpy(xshape_data, x_data, x_dims.production() * sizeof(T));
+    // XShape is null when no op consumes it.
+    if (xshape) {
+      auto* xshape_data = xshape->mutable_data<T>();
+      memcpy(xshape_data, x_data, x_dims.production() * sizeof(T));
+    }
   }
 
   virtual ~Squeeze2Compute() = default;
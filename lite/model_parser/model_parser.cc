@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <fstream>
 #include <limits>
+#include <map>
 #include <set>
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
@@ -34,6 +35,40 @@
 namespace paddle {
 namespace lite {
 
+std::vector<std::string> ParamNamesInExecutionOrder(
+    const cpp::ProgramDesc &cpp_prog) {
+  auto prog = cpp_prog;
+  auto &main_block_desc = *prog.GetBlock<cpp::BlockDesc>(0);
+  std::set<std::string> params;
+  for (size_t i = 0; i < main_block_desc.VarsSize(); ++i) {
+    auto &var = *main_block_desc.GetVar<cpp::VarDesc>(i);
+    if (var.Name() == "feed" || var.Name() == "fetch" || !var.Persistable())
+      continue;
+    params.insert(var.Name());
+  }
+
+  std::vector<std::string> res;
+  std::set<std::string> visited;
+  for (size_t i = 0; i < main_block_desc.OpsSize(); ++i) {
+    auto &op = *main_block_desc.GetOp<cpp::OpDesc>(i);
+    for (auto &name : op.input_vars()) {
+      if (params.count(name) && !visited.count(name)) {
+        res.push_back(name);
+        visited.insert(name);
+      }
+    }
+  }
+  // The params not used by the main block, keep the order of the var list.
+  for (size_t i = 0; i < main_block_desc.VarsSize(); ++i) {
+    auto name = main_block_desc.GetVar<cpp::VarDesc>(i)->Name();
+    if (params.count(name) && !visited.count(name)) {
+      res.push_back(name);
+      visited.insert(name);
+    }
+  }
+  return res;
+}
+
 #ifndef LITE_ON_TINY_PUBLISH
 int SizeOfType(framework::proto::VarType::Type type) {
   using Type = framework::proto::VarType::Type;
@@ -42,7 +77,7 @@ int SizeOfType(framework::proto::VarType::Type type) {
   case Type::VarType_Type_##desc: \
     return sizeof(type);
     DO(BOOL, bool);
-    DO(FP16, float);
+    DO(FP16, uint16_t);
     DO(FP32, float);
     DO(INT8, int8_t);
     DO(INT32, int);
@@ -88,6 +123,7 @@ void TensorFromStream(std::istream &is, lite::Tensor *tensor) {
     break
 
     // SET_TENSOR(BOOL, bool, PRECISION(kBool));
+    SET_TENSOR(FP16, uint16_t, PRECISION(kFP16));
     SET_TENSOR(FP32, float, PRECISION(kFloat));
     SET_TENSOR(INT8, int8_t, PRECISION(kInt8));
     SET_TENSOR(INT16, int16_t, PRECISION(kInt16));
@@ -365,6 +401,7 @@ void TensorToStream(std::ostream &os, const lite::Tensor &tensor) {
     desc.set_data_type(type_desc);          \
     break
 
+      SET_DATA_TYPE(PRECISION(kFP16), framework::proto::VarType_Type_FP16);
       SET_DATA_TYPE(PRECISION(kFloat), framework::proto::VarType_Type_FP32);
       SET_DATA_TYPE(PRECISION(kInt8), framework::proto::VarType_Type_INT8);
       SET_DATA_TYPE(PRECISION(kInt16), framework::proto::VarType_Type_INT16);
@@ -445,6 +482,7 @@ void SetParamInfoNaive(naive_buffer::ParamDesc *param_desc,
     desc.SetDataType(type_desc);            \
     break;
 
+    SET_DATA_TYPE(PRECISION(kFP16), VarDescAPI::VarDataType::FP16);
     SET_DATA_TYPE(PRECISION(kFloat), VarDescAPI::VarDataType::FP32);
     SET_DATA_TYPE(PRECISION(kInt8), VarDescAPI::VarDataType::INT8);
     SET_DATA_TYPE(PRECISION(kInt16), VarDescAPI::VarDataType::INT16);
@@ -472,6 +510,7 @@ void SetParamInfoNaive(naive_buffer::ParamDesc *param_desc,
                                   IoDirection::DtoH);               \
     desc.SetData<type>(tmp_buffer.get(), tensor.data_size());       \
   } break;
+      DO(PRECISION(kFP16), uint16_t);
       DO(PRECISION(kFloat), float);
       DO(PRECISION(kInt8), int8_t);
       DO(PRECISION(kInt16), int16_t);
@@ -490,6 +529,7 @@ void SetParamInfoNaive(naive_buffer::ParamDesc *param_desc,
   case precision:                                                \
     desc.SetData<type>(tensor.data<type>(), tensor.data_size()); \
     break;
+      DO(PRECISION(kFP16), uint16_t);
       DO(PRECISION(kFloat), float);
       DO(PRECISION(kInt8), int8_t);
       DO(PRECISION(kInt16), int16_t);
@@ -524,14 +564,11 @@ void SaveCombinedParamsNaive(const std::string &path,
   naive_buffer::proto::CombinedParamsDesc pt_desc(&table);
   naive_buffer::CombinedParamsDesc desc(&pt_desc);
 
-  auto prog = cpp_prog;
-  auto &main_block_desc = *prog.GetBlock<cpp::BlockDesc>(0);
-  for (size_t i = 0; i < main_block_desc.VarsSize(); ++i) {
-    auto &var = *main_block_desc.GetVar<cpp::VarDesc>(i);
-    if (var.Name() == "feed" || var.Name() == "fetch" || !var.Persistable())
-      continue;
+  // Save the params in the order they are used, so that the params can be
+  // streamed by the AsyncParamsLoader while the first ops are running.
+  for (auto &name : ParamNamesInExecutionOrder(cpp_prog)) {
     naive_buffer::ParamDesc param_desc(desc.AddParam());
-    SetParamInfoNaive(&param_desc, exec_scope, var.Name());
+    SetParamInfoNaive(&param_desc, exec_scope, name);
   }
 
   pt_desc.Save();
@@ -582,15 +619,8 @@ void SetTensorDataNaive(T *out, size_t size, const std::vector<T> &src) {
 }
 
 void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
-                       lite::Scope *scope,
-                       const std::string &name) {
-  CHECK(scope);
-  CHECK_EQ(desc.Name(), name)
-      << "Var name not equal: ParamDesc.name=" << desc.Name()
-      << "vs filename=" << name;
-
-  auto *tensor = scope->Var(name)->GetMutable<lite::Tensor>();
-
+                       lite::Tensor *tensor) {
+  CHECK(tensor);
   VLOG(3) << "model version " << desc.ModelVersion();
   CHECK_EQ(desc.TensorVersion(), 0U) << "Only version 0 is supported";
 
@@ -612,6 +642,7 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
     break
 
     // SET_TENSOR(BOOL, bool, PRECISION(kBool));
+    SET_TENSOR(FP16, uint16_t, PRECISION(kFP16));
     SET_TENSOR(FP32, float, PRECISION(kFloat));
     SET_TENSOR(INT8, int8_t, PRECISION(kInt8));
     SET_TENSOR(INT16, int16_t, PRECISION(kInt16));
@@ -624,6 +655,16 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
   tensor->set_persistable(true);
 }
 
+void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
+                       lite::Scope *scope,
+                       const std::string &name) {
+  CHECK(scope);
+  CHECK_EQ(desc.Name(), name)
+      << "Var name not equal: ParamDesc.name=" << desc.Name()
+      << "vs filename=" << name;
+  GetParamInfoNaive(desc, scope->Var(name)->GetMutable<lite::Tensor>());
+}
+
 void LoadParamNaive(const std::string &path,
                     lite::Scope *scope,
                     const std::string &name) {
@@ -669,15 +710,11 @@ void LoadCombinedParamsNaive(const std::string &path,
   }
 }
 
-void LoadModelNaive(const std::string &model_dir,
-                    Scope *scope,
-                    cpp::ProgramDesc *cpp_prog,
-                    bool combined) {
+void LoadProgramNaive(const std::string &model_dir,
+                      cpp::ProgramDesc *cpp_prog) {
   CHECK(cpp_prog);
-  CHECK(scope);
   cpp_prog->ClearBlocks();
 
-  // Load model
   const std::string prog_path = model_dir + "/__model__.nb";
   naive_buffer::BinaryTable table;
   table.LoadFromFile(prog_path);
@@ -687,6 +724,32 @@ void LoadModelNaive(const std::string &model_dir,
 
   // Transform to cpp::ProgramDesc
   TransformProgramDescAnyToCpp(nb_prog, cpp_prog);
+}
+
+void LoadProgramNaiveFromMemory(const std::string &model_buffer,
+                                cpp::ProgramDesc *cpp_prog) {
+  CHECK(cpp_prog);
+  cpp_prog->ClearBlocks();
+
+  naive_buffer::BinaryTable table;
+  table.LoadFromMemory(model_buffer.c_str(), model_buffer.length());
+  naive_buffer::proto::ProgramDesc nb_proto_prog(&table);
+  nb_proto_prog.Load();
+  naive_buffer::ProgramDesc nb_prog(&nb_proto_prog);
+
+  // Transform to cpp::ProgramDesc
+  TransformProgramDescAnyToCpp(nb_prog, cpp_prog);
+}
+
+void LoadModelNaive(const std::string &model_dir,
+                    Scope *scope,
+                    cpp::ProgramDesc *cpp_prog,
+                    bool combined) {
+  CHECK(cpp_prog);
+  CHECK(scope);
+
+  // Load model
+  LoadProgramNaive(model_dir, cpp_prog);
 
   // Load Params
   // NOTE: Only main block be used now.
@@ -723,19 +786,9 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
                               cpp::ProgramDesc *cpp_prog) {
   CHECK(cpp_prog);
   CHECK(scope);
-  cpp_prog->ClearBlocks();
 
   // Load model
-
-  naive_buffer::BinaryTable table;
-  table.LoadFromMemory(model_buffer.c_str(), model_buffer.length());
-
-  naive_buffer::proto::ProgramDesc nb_proto_prog(&table);
-  nb_proto_prog.Load();
-  naive_buffer::ProgramDesc nb_prog(&nb_proto_prog);
-
-  // Transform to cpp::ProgramDesc
-  TransformProgramDescAnyToCpp(nb_prog, cpp_prog);
+  LoadProgramNaiveFromMemory(model_buffer, cpp_prog);
 
   // Load Params
   // NOTE: Only main block be used now.
@@ -745,5 +798,87 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
   VLOG(4) << "Load model from naive buffer memory successfully";
 }
 
+AsyncParamsLoader::AsyncParamsLoader(const std::string &path,
+                                     lite::Scope *scope,
+                                     const cpp::ProgramDesc &cpp_prog,
+                                     bool params_from_memory)
+    : params_from_memory_(params_from_memory) {
+  CHECK(scope);
+  if (params_from_memory_) {
+    buffer_ = path;
+  } else {
+    path_ = path;
+  }
+  // All the tensors are created here, the loading thread never touches the
+  // scope, which is being used to build the program at the same time.
+  for (auto &name : ParamNamesInExecutionOrder(cpp_prog)) {
+    tensors_[name] = scope->Var(name)->GetMutable<lite::Tensor>();
+  }
+  thread_ = std::thread(&AsyncParamsLoader::LoadParams, this);
+}
+
+AsyncParamsLoader::~AsyncParamsLoader() {
+  if (thread_.joinable()) thread_.join();
+}
+
+void AsyncParamsLoader::LoadParams() {
+  naive_buffer::BinaryTable table;
+  if (params_from_memory_) {
+    table.LoadFromMemory(buffer_.c_str(), buffer_.length());
+    std::string().swap(buffer_);
+  } else {
+    table.LoadFromFile(path_);
+  }
+
+  // The same layout as naive_buffer::proto::CombinedParamsDesc, but the params
+  // are parsed and published one by one.
+  uint64_t num_params{};
+  memcpy(&num_params, table.cursor(), sizeof(uint64_t));
+  table.Consume(sizeof(uint64_t));
+  for (uint64_t i = 0; i < num_params; i++) {
+    naive_buffer::proto::ParamDesc pt_desc(&table);
+    pt_desc.Load();
+    naive_buffer::ParamDesc desc(&pt_desc);
+    auto name = desc.Name();
+    auto it = tensors_.find(name);
+    CHECK(it != tensors_.end()) << "Param[" << name << "] not in the program";
+    GetParamInfoNaive(desc, it->second);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      loaded_.insert(name);
+    }
+    cond_.notify_all();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &item : tensors_) {
+    CHECK(loaded_.count(item.first)) << "Persistable var[" << item.first
+                                     << "] not found";
+  }
+  finished_ = true;
+  cond_.notify_all();
+}
+
+void AsyncParamsLoader::Wait(const std::vector<std::string> &names) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [&] {
+    if (finished_) return true;
+    for (auto &name : names) {
+      if (tensors_.count(name) && !loaded_.count(name)) return false;
+    }
+    return true;
+  });
+}
+
+void AsyncParamsLoader::WaitAll() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_.wait(lock, [&] { return finished_; });
+}
+
+bool AsyncParamsLoader::finished() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finished_;
+}
+
 }  // namespace lite
 }  // namespace paddle
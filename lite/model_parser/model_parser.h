@@ -16,8 +16,13 @@
 // parse an operator definitions and so on.
 
 #pragma once
+#include <condition_variable>  // NOLINT
+#include <map>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <set>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #ifndef LITE_ON_TINY_PUBLISH
 #include "lite/core/framework.pb.h"
@@ -104,5 +109,52 @@ void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               lite::Scope* scope,
                               cpp::ProgramDesc* cpp_prog);
 
+// Load only the program of a naive buffer model, without the params.
+void LoadProgramNaive(const std::string& model_dir, cpp::ProgramDesc* prog);
+void LoadProgramNaiveFromMemory(const std::string& model_buffer,
+                                cpp::ProgramDesc* prog);
+
+// The names of the persistable vars of the main block, ordered by their first
+// use in the ops.
+std::vector<std::string> ParamNamesInExecutionOrder(
+    const cpp::ProgramDesc& prog);
+
+/*
+ * AsyncParamsLoader loads the combined params of a naive buffer model in a
+ * background thread. The params are published one by one as they are parsed,
+ * so the program can be built and the first ops can run while the rest of the
+ * params are still loading.
+ */
+class AsyncParamsLoader {
+ public:
+  // `path` is the param file, or the content of it if `params_from_memory`.
+  AsyncParamsLoader(const std::string& path,
+                    lite::Scope* scope,
+                    const cpp::ProgramDesc& prog,
+                    bool params_from_memory = false);
+  ~AsyncParamsLoader();
+
+  // Block until all the params in `names` are loaded, the other names are
+  // ignored.
+  void Wait(const std::vector<std::string>& names);
+  // Block until all the params are loaded.
+  void WaitAll();
+  bool finished() const;
+
+ private:
+  void LoadParams();
+
+  std::string path_;
+  std::string buffer_;
+  bool params_from_memory_{false};
+  std::map<std::string, lite::Tensor*> tensors_;
+
+  std::thread thread_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  std::set<std::string> loaded_;
+  bool finished_{false};
+};
+
 }  // namespace lite
 }  // namespace paddle
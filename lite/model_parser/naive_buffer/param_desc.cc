@@ -92,6 +92,7 @@ VarDescAPI::VarDataType ParamDesc::GetDataType() const {
     GET_DATA_TYPE_CASE_ITEM(INT16);
     GET_DATA_TYPE_CASE_ITEM(INT32);
     GET_DATA_TYPE_CASE_ITEM(INT64);
+    GET_DATA_TYPE_CASE_ITEM(FP16);
     GET_DATA_TYPE_CASE_ITEM(FP32);
     GET_DATA_TYPE_CASE_ITEM(FP64);
     default:
@@ -119,6 +120,7 @@ void ParamDesc::SetDataType(VarDescAPI::VarDataType data_type) {
     SET_DATA_TYPE_CASE_ITEM(INT16);
     SET_DATA_TYPE_CASE_ITEM(INT32);
     SET_DATA_TYPE_CASE_ITEM(INT64);
+    SET_DATA_TYPE_CASE_ITEM(FP16);
     SET_DATA_TYPE_CASE_ITEM(FP32);
     SET_DATA_TYPE_CASE_ITEM(FP64);
     default:
@@ -164,6 +166,8 @@ GET_DATA_IMPL(int8_t, INT8);
 GET_DATA_IMPL(int16_t, INT16);
 GET_DATA_IMPL(int32_t, INT32);
 GET_DATA_IMPL(int64_t, INT64);
+// FP16 data is kept as the raw bits.
+GET_DATA_IMPL(uint16_t, FP16);
 GET_DATA_IMPL(float, FP32);
 GET_DATA_IMPL(double, FP64);
 #undef GET_DATA_IMPL
@@ -198,6 +202,7 @@ SET_DATA_IMPL(int8_t, INT8);
 SET_DATA_IMPL(int16_t, INT16);
 SET_DATA_IMPL(int32_t, INT32);
 SET_DATA_IMPL(int64_t, INT64);
+SET_DATA_IMPL(uint16_t, FP16);
 SET_DATA_IMPL(float, FP32);
 SET_DATA_IMPL(double, FP64);
 #undef SET_DATA_IMPL
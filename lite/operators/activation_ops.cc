@@ -56,6 +56,25 @@ bool ActivationOp::AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) {
     param_.hard_sigmoid_slope = opdesc.GetAttr<float>("slope");
     param_.hard_sigmoid_offset = opdesc.GetAttr<float>("offset");
   }
+  if (opdesc.Type() == "hard_swish") {
+    if (opdesc.HasAttr("threshold")) {
+      param_.hard_swish_threshold = opdesc.GetAttr<float>("threshold");
+    }
+    if (opdesc.HasAttr("scale")) {
+      param_.hard_swish_scale = opdesc.GetAttr<float>("scale");
+    }
+    if (opdesc.HasAttr("offset")) {
+      param_.hard_swish_offset = opdesc.GetAttr<float>("offset");
+    }
+  }
+  // For Int8
+  if (opdesc.HasAttr("enable_int8")) {
+    param_.enable_int8 = opdesc.GetAttr<bool>("enable_int8");
+    if (opdesc.HasAttr("input_scale"))
+      param_.input_scale = opdesc.GetAttr<float>("input_scale");
+    if (opdesc.HasAttr("output_scale"))
+      param_.output_scale = opdesc.GetAttr<float>("output_scale");
+  }
   param_.Out = scope->FindVar(out_name)->GetMutable<lite::Tensor>();
   return true;
 }
@@ -117,6 +136,7 @@ REGISTER_LITE_OP(log, paddle::lite::operators::ActivationOp);
 REGISTER_LITE_OP(exp, paddle::lite::operators::ActivationOp);
 REGISTER_LITE_OP(floor, paddle::lite::operators::ActivationOp);
 REGISTER_LITE_OP(hard_sigmoid, paddle::lite::operators::ActivationOp);
+REGISTER_LITE_OP(hard_swish, paddle::lite::operators::ActivationOp);
 REGISTER_LITE_OP(rsqrt, paddle::lite::operators::ActivationOp);
 REGISTER_LITE_OP(softsign, paddle::lite::operators::ActivationOp);
 
@@ -20,6 +20,45 @@ namespace paddle {
 namespace lite {
 namespace operators {
 
+// Parse the activation `act_type` fused into an op, and its coefficients such
+// as "relu6_threshold", which the fusion passes set. It returns false for the
+// activations which can't be fused.
+inline bool ParseFusedActivation(const cpp::OpDesc& op_desc,
+                                 const std::string& act_type,
+                                 ActivationParam* param) {
+  using lite_api::ActivationType;
+  if (act_type == "relu") {
+    param->active_type = ActivationType::kRelu;
+  } else if (act_type == "leaky_relu") {
+    param->active_type = ActivationType::kLeakyRelu;
+    param->Leaky_relu_alpha = op_desc.GetAttr<float>("leaky_relu_alpha");
+  } else if (act_type == "relu6") {
+    param->active_type = ActivationType::kRelu6;
+    if (op_desc.HasAttr("relu6_threshold")) {
+      param->Relu_clipped_coef = op_desc.GetAttr<float>("relu6_threshold");
+    }
+  } else if (act_type == "sigmoid") {
+    param->active_type = ActivationType::kSigmoid;
+  } else if (act_type == "swish") {
+    param->active_type = ActivationType::kSwish;
+    param->Swish_beta = op_desc.GetAttr<float>("swish_beta");
+  } else if (act_type == "hard_sigmoid") {
+    param->active_type = ActivationType::kHardSigmoid;
+    param->hard_sigmoid_slope = op_desc.GetAttr<float>("hard_sigmoid_slope");
+    param->hard_sigmoid_offset = op_desc.GetAttr<float>("hard_sigmoid_offset");
+  } else if (act_type == "hard_swish") {
+    param->active_type = ActivationType::kHardSwish;
+    param->hard_swish_threshold =
+        op_desc.GetAttr<float>("hard_swish_threshold");
+    param->hard_swish_scale = op_desc.GetAttr<float>("hard_swish_scale");
+    param->hard_swish_offset = op_desc.GetAttr<float>("hard_swish_offset");
+  } else {
+    return false;
+  }
+  param->has_active = true;
+  return true;
+}
+
 class ActivationOp : public OpLite {
  public:
   explicit ActivationOp(const std::string& type) : OpLite(type) {}
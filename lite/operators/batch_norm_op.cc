@@ -25,12 +25,6 @@ bool BatchNormOp::CheckShape() const {
   CHECK_OR_FALSE(param_.mean);
   CHECK_OR_FALSE(param_.variance);
   CHECK_OR_FALSE(param_.y);
-  if (!param_.is_test) {
-    CHECK_OR_FALSE(param_.mean_out);
-    CHECK_OR_FALSE(param_.variance_out);
-    CHECK_OR_FALSE(param_.saved_mean);
-    CHECK_OR_FALSE(param_.saved_variance);
-  }
   auto x_dims = param_.x->dims();
   auto scale_dims = param_.scale->dims();
   auto bias_dims = param_.bias->dims();
@@ -62,10 +56,12 @@ bool BatchNormOp::InferShape() const {
       break;
   }
   if (!param_.is_test) {
-    param_.mean_out->Resize({channel_size});
-    param_.variance_out->Resize({channel_size});
-    param_.saved_mean->Resize({channel_size});
-    param_.saved_variance->Resize({channel_size});
+    for (auto *out : {param_.mean_out,
+                      param_.variance_out,
+                      param_.saved_mean,
+                      param_.saved_variance}) {
+      if (out) out->Resize({channel_size});
+    }
   }
   param_.y->Resize(x_dims);
   return true;
@@ -86,17 +82,16 @@ bool BatchNormOp::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   if (op_desc.HasAttr("use_global_stats")) {
     param_.use_global_stats = op_desc.GetAttr<bool>("use_global_stats");
   }
-  if (!param_.is_test) {
-    param_.mean_out =
-        scope->FindVar(op_desc.Output("MeanOut").front())->GetMutable<Tensor>();
-    param_.variance_out = scope->FindVar(op_desc.Output("VarianceOut").front())
-                              ->GetMutable<Tensor>();
-    param_.saved_mean = scope->FindVar(op_desc.Output("SavedMean").front())
-                            ->GetMutable<Tensor>();
-    param_.saved_variance =
-        scope->FindVar(op_desc.Output("SavedVariance").front())
-            ->GetMutable<Tensor>();
-  }
+  // The statistics outputs are removed by dead_code_elimination_pass when
+  // they are not used.
+  auto optional_output = [&](const std::string &name) -> Tensor * {
+    if (param_.is_test || !op_desc.HasOutput(name)) return nullptr;
+    return scope->FindVar(op_desc.Output(name).front())->GetMutable<Tensor>();
+  };
+  param_.mean_out = optional_output("MeanOut");
+  param_.variance_out = optional_output("VarianceOut");
+  param_.saved_mean = optional_output("SavedMean");
+  param_.saved_variance = optional_output("SavedVariance");
   param_.epsilon = op_desc.GetAttr<float>("epsilon");
   param_.momentum = op_desc.GetAttr<float>("momentum");
   std::string data_layout = op_desc.GetAttr<std::string>("data_layout");
@@ -78,6 +78,9 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   CHECK(scope->FindVar(out));
   param_.output = scope->FindVar(out)->GetMutable<lite::Tensor>();
   param_.axis = op_desc.GetAttr<int>("axis");
+  if (op_desc.HasAttr("use_buffer_view")) {
+    param_.use_buffer_view = op_desc.GetAttr<bool>("use_buffer_view");
+  }
 
   std::vector<std::string> input_arg_names = op_desc.InputArgumentNames();
   if (std::find(input_arg_names.begin(), input_arg_names.end(), "AxisTensor") !=
@@ -90,6 +93,14 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
       }
     }
   }
+  // For Int8
+  if (op_desc.HasAttr("enable_int8")) {
+    param_.enable_int8 = op_desc.GetAttr<bool>("enable_int8");
+    if (op_desc.HasAttr("input_scale"))
+      param_.input_scale = op_desc.GetAttr<float>("input_scale");
+    if (op_desc.HasAttr("output_scale"))
+      param_.output_scale = op_desc.GetAttr<float>("output_scale");
+  }
   return true;
 }
 
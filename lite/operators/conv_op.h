@@ -19,6 +19,7 @@
 #include "lite/core/op_lite.h"
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
+#include "lite/operators/activation_ops.h"
 #include "lite/operators/op_params.h"
 #include "lite/utils/all.h"
 
@@ -78,20 +79,11 @@ class ConvOpLite : public OpLite {
     }
 
     if (op_desc.HasAttr("with_act") && op_desc.GetAttr<bool>("with_act")) {
-      param_.activation_param.has_active = true;
       auto act_type = op_desc.GetAttr<std::string>("act_type");
-      if (act_type == "relu") {
-        param_.activation_param.active_type = lite_api::ActivationType::kRelu;
-        param_.fuse_relu = true;
-      } else if (act_type == "leaky_relu") {
-        param_.activation_param.active_type =
-            lite_api::ActivationType::kLeakyRelu;
-        param_.activation_param.Leaky_relu_alpha =
-            op_desc.GetAttr<float>("leaky_relu_alpha");
-      } else {
-        CHECK(false)
-            << "The fused conv only supports fuse with relu and leaky relu";
-      }
+      param_.fuse_relu = act_type == "relu";
+      CHECK(ParseFusedActivation(op_desc, act_type, &param_.activation_param))
+          << "The fused conv only supports fuse with relu, relu6, leaky relu, "
+             "sigmoid, swish, hard sigmoid and hard swish";
     }
 
     if (op_desc.HasAttr("padding_algorithm")) {
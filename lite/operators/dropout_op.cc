@@ -29,7 +29,7 @@ bool DropoutOp::CheckShape() const {
 bool DropoutOp::InferShape() const {
   const auto x_dims = param_.x->dims();
   param_.output->Resize(x_dims);
-  if (param_.is_test == false) {
+  if (param_.is_test == false && param_.mask) {
     param_.mask->Resize(x_dims);
   }
   // share LoD
@@ -41,11 +41,15 @@ bool DropoutOp::InferShape() const {
 bool DropoutOp::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   auto input = op_desc.Input("X").front();
   auto out = op_desc.Output("Out").front();
-  auto Mask = op_desc.Output("Mask").front();
 
   param_.x = GetVar<lite::Tensor>(scope, input);
   param_.output = GetMutableVar<lite::Tensor>(scope, out);
-  param_.mask = GetMutableVar<lite::Tensor>(scope, Mask);
+  // Mask is removed by dead_code_elimination_pass when it is not used.
+  param_.mask = nullptr;
+  if (op_desc.HasOutput("Mask")) {
+    auto Mask = op_desc.Output("Mask").front();
+    param_.mask = GetMutableVar<lite::Tensor>(scope, Mask);
+  }
 
   param_.dropout_prob = op_desc.GetAttr<float>("dropout_prob");
   param_.is_test = true;
@@ -43,6 +43,20 @@ bool ElementwiseOp::AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) {
   param_.Y = GetVar<lite::Tensor>(scope, Y_name);
   param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
   param_.axis = opdesc.GetAttr<int>("axis");
+  // For Int8
+  if (opdesc.HasAttr("enable_int8")) {
+    param_.enable_int8 = opdesc.GetAttr<bool>("enable_int8");
+    if (opdesc.HasAttr("input_scale"))
+      param_.input_scale = opdesc.GetAttr<float>("input_scale");
+    if (opdesc.HasAttr("output_scale"))
+      param_.output_scale = opdesc.GetAttr<float>("output_scale");
+    param_.x_input_scale = opdesc.HasAttr("x_input_scale")
+                               ? opdesc.GetAttr<float>("x_input_scale")
+                               : param_.input_scale;
+    param_.y_input_scale = opdesc.HasAttr("y_input_scale")
+                               ? opdesc.GetAttr<float>("y_input_scale")
+                               : param_.input_scale;
+  }
   return true;
 }
 
@@ -27,14 +27,17 @@ bool FcOpLite::CheckShape() const {
 
   const auto input_dims = param_.input->dims();
   const auto w_dims = param_.w->dims();
+  // The packed int4 weight stores two values in a byte.
+  const int64_t w_cols =
+      param_.weight_only_quant_bits == 4 ? w_dims[1] * 2 : w_dims[1];
 
   if (param_.bias) {
     const auto bias_dims = param_.bias->dims();
     if (bias_dims.size() == 2) {
       CHECK_EQ_OR_FALSE(bias_dims[0], 1);
-      CHECK_EQ_OR_FALSE(bias_dims[1], w_dims[1]);
+      CHECK_EQ_OR_FALSE(bias_dims[1], w_cols);
     } else if (bias_dims.size() == 1) {
-      CHECK_EQ_OR_FALSE(bias_dims[0], w_dims[1]);
+      CHECK_EQ_OR_FALSE(bias_dims[0], w_cols);
     }
   }
 
@@ -57,7 +60,8 @@ bool FcOpLite::InferShape() const {
   for (int i = 0; i < param_.in_num_col_dims; ++i) {
     output_dims[i] = input_dims[i];
   }
-  output_dims.back() = w_dims[1];
+  output_dims.back() =
+      param_.weight_only_quant_bits == 4 ? w_dims[1] * 2 : w_dims[1];
   param_.output->Resize(lite::DDim(output_dims));
 
   // share LoD
@@ -87,9 +91,23 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.output = scope->FindVar(out)->GetMutable<lite::Tensor>();
   param_.in_num_col_dims = op_desc.GetAttr<int>("in_num_col_dims");
 
+  if (std::find(input_arg_names.begin(),
+                input_arg_names.end(),
+                "ResidualData") != input_arg_names.end() &&
+      !op_desc.Input("ResidualData").empty()) {
+    auto residual = op_desc.Input("ResidualData").front();
+    param_.residualData = scope->FindVar(residual)->GetMutable<lite::Tensor>();
+  }
+
   if (op_desc.HasAttr("activation_type")) {
     param_.activation_type = op_desc.GetAttr<std::string>("activation_type");
   }
+  if (op_desc.HasAttr("leaky_relu_alpha")) {
+    param_.leaky_relu_alpha = op_desc.GetAttr<float>("leaky_relu_alpha");
+  }
+  if (op_desc.HasAttr("relu6_threshold")) {
+    param_.relu6_threshold = op_desc.GetAttr<float>("relu6_threshold");
+  }
 
   // For Int8
   if (op_desc.HasAttr("enable_int8")) {
@@ -101,6 +119,16 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
     if (op_desc.HasAttr("output_scale"))
       param_.output_scale = op_desc.GetAttr<float>("output_scale");
   }
+
+  if (op_desc.HasAttr("weight_only_quant_bits")) {
+    param_.weight_only_quant_bits =
+        op_desc.GetAttr<int>("weight_only_quant_bits");
+    auto scale = op_desc.Input("WeightScale").front();
+    param_.weight_only_scale =
+        scope->FindVar(scale)->GetMutable<lite::Tensor>();
+    param_.dynamic_quant = op_desc.HasAttr("dynamic_quant") &&
+                           op_desc.GetAttr<bool>("dynamic_quant");
+  }
   return true;
 }
 
@@ -67,12 +67,12 @@ bool FlattenOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
 
 bool Flatten2Op::CheckShape() const {
   FlattenOp::CheckShape();
-  CHECK_OR_FALSE(param_.xshape);
   return true;
 }
 
 bool Flatten2Op::InferShape() const {
   FlattenOp::InferShape();
+  if (param_.xshape == nullptr) return true;
   auto x_dims = param_.x->dims();
   std::vector<DDim::value_type> xshape_dims(x_dims.size() + 1, 0);
   for (size_t i = 0; i < x_dims.size(); i++) {
@@ -84,10 +84,13 @@ bool Flatten2Op::InferShape() const {
 
 bool Flatten2Op::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   FlattenOp::AttachImpl(opdesc, scope);
-  auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
-  CHECK(xshape_var);
-  param_.xshape = xshape_var->GetMutable<lite::Tensor>();
-  CHECK(param_.xshape) << "Output(XShape) of FlattenOp should not be null.";
+  // XShape is removed by dead_code_elimination_pass when it is not used.
+  param_.xshape = nullptr;
+  if (opdesc.HasOutput("XShape")) {
+    auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
+    CHECK(xshape_var);
+    param_.xshape = xshape_var->GetMutable<lite::Tensor>();
+  }
   return true;
 }
 
@@ -0,0 +1,90 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_box_coder_nms_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionBoxCoderNmsOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.prior_box);
+  CHECK_OR_FALSE(param_.target_box);
+  CHECK_OR_FALSE(param_.scores);
+  CHECK_OR_FALSE(param_.out);
+
+  auto prior_box_dims = param_.prior_box->dims();
+  auto target_box_dims = param_.target_box->dims();
+  auto score_dims = param_.scores->dims();
+  CHECK_OR_FALSE(prior_box_dims.size() == 2);
+  CHECK_OR_FALSE(prior_box_dims[1] == 4);
+  if (param_.prior_box_var != nullptr) {
+    CHECK_OR_FALSE(param_.prior_box_var->dims() == prior_box_dims);
+  }
+  CHECK_OR_FALSE(target_box_dims.size() == 3);
+  CHECK_OR_FALSE(target_box_dims[1] == prior_box_dims[0]);
+  CHECK_OR_FALSE(target_box_dims[2] == 4);
+  CHECK_OR_FALSE(score_dims.size() == 3);
+  CHECK_OR_FALSE(score_dims[0] == target_box_dims[0]);
+  CHECK_OR_FALSE(score_dims[2] == target_box_dims[1]);
+  return true;
+}
+
+bool FusionBoxCoderNmsOpLite::InferShape() const {
+  auto target_box_dims = param_.target_box->dims();
+  param_.out->Resize({target_box_dims[1], target_box_dims[2], 3});
+  return true;
+}
+
+bool FusionBoxCoderNmsOpLite::AttachImpl(const cpp::OpDesc& opdesc,
+                                         lite::Scope* scope) {
+  auto prior_box_name = opdesc.Input("PriorBox").front();
+  auto target_box_name = opdesc.Input("TargetBox").front();
+  auto scores_name = opdesc.Input("Scores").front();
+  auto out_name = opdesc.Output("Out").front();
+  param_.prior_box = GetVar<lite::Tensor>(scope, prior_box_name);
+  param_.target_box = GetVar<lite::Tensor>(scope, target_box_name);
+  param_.scores = GetVar<lite::Tensor>(scope, scores_name);
+  param_.out = GetMutableVar<lite::Tensor>(scope, out_name);
+  // optional params
+  if (opdesc.HasInput("PriorBoxVar") && !opdesc.Input("PriorBoxVar").empty()) {
+    auto* box_var = scope->FindVar(opdesc.Input("PriorBoxVar").front());
+    if (box_var != nullptr) {
+      param_.prior_box_var = box_var->GetMutable<Tensor>();
+    }
+  }
+  param_.box_normalized = opdesc.GetAttr<bool>("box_normalized");
+  if (opdesc.HasAttr("variance")) {
+    param_.variance = opdesc.GetAttr<std::vector<float>>("variance");
+  }
+
+  param_.background_label = opdesc.GetAttr<int>("background_label");
+  param_.keep_top_k = opdesc.GetAttr<int>("keep_top_k");
+  param_.nms_top_k = opdesc.GetAttr<int>("nms_top_k");
+  param_.score_threshold = opdesc.GetAttr<float>("score_threshold");
+  param_.nms_threshold = opdesc.GetAttr<float>("nms_threshold");
+  param_.nms_eta = opdesc.GetAttr<float>("nms_eta");
+  if (opdesc.HasAttr("normalized")) {
+    param_.normalized = opdesc.GetAttr<bool>("normalized");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_box_coder_nms,
+                 paddle::lite::operators::FusionBoxCoderNmsOpLite);
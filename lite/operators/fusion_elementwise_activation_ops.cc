@@ -15,6 +15,7 @@
 #include "lite/operators/fusion_elementwise_activation_ops.h"
 #include <string>
 #include "lite/core/op_registry.h"
+#include "lite/operators/activation_ops.h"
 
 namespace paddle {
 namespace lite {
@@ -44,8 +45,23 @@ bool FusionElementwiseActivationOp::AttachImpl(const cpp::OpDesc& opdesc,
   param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
   param_.axis = opdesc.GetAttr<int>("axis");
   param_.act_type = opdesc.GetAttr<std::string>("act_type");
-  // TODO(sangoly): support more activation types.
-  CHECK(param_.act_type == "relu") << "Only relu activation be supported now";
+  CHECK(ParseFusedActivation(
+      opdesc, param_.act_type, &param_.activation_param))
+      << "unsupported activation " << param_.act_type;
+  // For Int8
+  if (opdesc.HasAttr("enable_int8")) {
+    param_.enable_int8 = opdesc.GetAttr<bool>("enable_int8");
+    if (opdesc.HasAttr("input_scale"))
+      param_.input_scale = opdesc.GetAttr<float>("input_scale");
+    if (opdesc.HasAttr("output_scale"))
+      param_.output_scale = opdesc.GetAttr<float>("output_scale");
+    param_.x_input_scale = opdesc.HasAttr("x_input_scale")
+                               ? opdesc.GetAttr<float>("x_input_scale")
+                               : param_.input_scale;
+    param_.y_input_scale = opdesc.HasAttr("y_input_scale")
+                               ? opdesc.GetAttr<float>("y_input_scale")
+                               : param_.input_scale;
+  }
 
   return true;
 }
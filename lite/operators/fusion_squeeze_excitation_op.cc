@@ -0,0 +1,104 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_squeeze_excitation_op.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/activation_ops.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionSqueezeExcitationOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.squeeze_weight);
+  CHECK_OR_FALSE(param_.excite_weight);
+  CHECK_OR_FALSE(param_.out);
+
+  auto x_dims = param_.x->dims();
+  auto squeeze_dims = param_.squeeze_weight->dims();
+  auto excite_dims = param_.excite_weight->dims();
+  CHECK_OR_FALSE(x_dims.size() == 4);
+  const int64_t channels = x_dims[1];
+  int64_t hidden = 0;
+  if (param_.conv_weight) {
+    CHECK_OR_FALSE(squeeze_dims.size() == 4 && excite_dims.size() == 4);
+    CHECK_OR_FALSE(squeeze_dims[2] * squeeze_dims[3] == 1);
+    CHECK_OR_FALSE(excite_dims[2] * excite_dims[3] == 1);
+    hidden = squeeze_dims[0];
+    CHECK_OR_FALSE(squeeze_dims[1] == channels);
+    CHECK_OR_FALSE(excite_dims[0] == channels && excite_dims[1] == hidden);
+  } else {
+    CHECK_OR_FALSE(squeeze_dims.size() == 2 && excite_dims.size() == 2);
+    hidden = squeeze_dims[1];
+    CHECK_OR_FALSE(squeeze_dims[0] == channels);
+    CHECK_OR_FALSE(excite_dims[0] == hidden && excite_dims[1] == channels);
+  }
+  if (param_.squeeze_bias) {
+    CHECK_OR_FALSE(param_.squeeze_bias->numel() == hidden);
+  }
+  if (param_.excite_bias) {
+    CHECK_OR_FALSE(param_.excite_bias->numel() == channels);
+  }
+  return true;
+}
+
+bool FusionSqueezeExcitationOpLite::InferShape() const {
+  param_.out->Resize(param_.x->dims());
+  *param_.out->mutable_lod() = param_.x->lod();
+  return true;
+}
+
+bool FusionSqueezeExcitationOpLite::AttachImpl(const cpp::OpDesc& opdesc,
+                                               lite::Scope* scope) {
+  auto x_name = opdesc.Input("X").front();
+  auto squeeze_weight_name = opdesc.Input("SqueezeWeight").front();
+  auto excite_weight_name = opdesc.Input("ExciteWeight").front();
+  auto out_name = opdesc.Output("Out").front();
+  param_.x = GetVar<lite::Tensor>(scope, x_name);
+  param_.squeeze_weight = GetVar<lite::Tensor>(scope, squeeze_weight_name);
+  param_.excite_weight = GetVar<lite::Tensor>(scope, excite_weight_name);
+  param_.out = GetMutableVar<lite::Tensor>(scope, out_name);
+  // optional params
+  if (opdesc.HasInput("SqueezeBias") && !opdesc.Input("SqueezeBias").empty()) {
+    auto* bias = scope->FindVar(opdesc.Input("SqueezeBias").front());
+    if (bias != nullptr) {
+      param_.squeeze_bias = &bias->Get<lite::Tensor>();
+    }
+  }
+  if (opdesc.HasInput("ExciteBias") && !opdesc.Input("ExciteBias").empty()) {
+    auto* bias = scope->FindVar(opdesc.Input("ExciteBias").front());
+    if (bias != nullptr) {
+      param_.excite_bias = &bias->Get<lite::Tensor>();
+    }
+  }
+  param_.conv_weight = opdesc.GetAttr<bool>("conv_weight");
+  // The coefficients of the two activations have different attrs, as the
+  // squeeze is relu, relu6, leaky_relu, swish or hard_swish, and the excite
+  // is sigmoid or hard_sigmoid.
+  auto squeeze_act_type = opdesc.GetAttr<std::string>("squeeze_act_type");
+  auto excite_act_type = opdesc.GetAttr<std::string>("excite_act_type");
+  CHECK(ParseFusedActivation(opdesc, squeeze_act_type, &param_.squeeze_act))
+      << "unsupported squeeze activation " << squeeze_act_type;
+  CHECK(ParseFusedActivation(opdesc, excite_act_type, &param_.excite_act))
+      << "unsupported excite activation " << excite_act_type;
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_squeeze_excitation,
+                 paddle::lite::operators::FusionSqueezeExcitationOpLite);
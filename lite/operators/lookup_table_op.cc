@@ -48,7 +48,12 @@ bool LookupTableOpLite::InferShape() const {
   for (int i = 0; i < ids_rank - 1; ++i) {
     out_dims.push_back(ids_dims[i]);
   }
-  out_dims.push_back(table_dims[1]);
+  // The packed int4 table stores two values in a byte.
+  int64_t width = table_dims[1];
+  if (param_.weight_only_quant_bits == 4) {
+    width *= 2;
+  }
+  out_dims.push_back(width);
   param_.Out->Resize(lite::DDim{out_dims});
   param_.Out->set_lod(param_.Ids->lod());
   return true;
@@ -66,6 +71,14 @@ bool LookupTableOpLite::AttachImpl(const cpp::OpDesc &op_desc,
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
 
+  if (op_desc.HasAttr("weight_only_quant_bits")) {
+    param_.weight_only_quant_bits =
+        op_desc.GetAttr<int>("weight_only_quant_bits");
+    auto scale = op_desc.Input("WeightScale").front();
+    param_.weight_only_scale =
+        scope->FindVar(scale)->GetMutable<lite::Tensor>();
+  }
+
   return true;
 }
 
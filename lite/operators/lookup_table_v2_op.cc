@@ -40,7 +40,12 @@ bool LookupTableV2OpLite::InferShape() const {
   for (int i = 0; i < ids_dims.size(); ++i) {
     out_dims.push_back(ids_dims[i]);
   }
-  out_dims.push_back(table_dims[1]);
+  // The packed int4 table stores two values in a byte.
+  int64_t width = table_dims[1];
+  if (param_.weight_only_quant_bits == 4) {
+    width *= 2;
+  }
+  out_dims.push_back(width);
   param_.Out->Resize(lite::DDim{out_dims});
   param_.Out->set_lod(param_.Ids->lod());
   return true;
@@ -58,6 +63,14 @@ bool LookupTableV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
 
+  if (op_desc.HasAttr("weight_only_quant_bits")) {
+    param_.weight_only_quant_bits =
+        op_desc.GetAttr<int>("weight_only_quant_bits");
+    auto scale = op_desc.Input("WeightScale").front();
+    param_.weight_only_scale =
+        scope->FindVar(scale)->GetMutable<lite::Tensor>();
+  }
+
   return true;
 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/operators/matmul_op.h"
+#include <algorithm>
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -34,9 +35,13 @@ bool MatMulOpLite::InferShape() const {
   bool y_transpose = param_.transpose_Y;
   std::vector<int64_t> dim_out_vec;
 
-  if (x_dims.size() > 2 && y_dims.size() >= 2) {
+  if ((x_dims.size() > 2 && y_dims.size() >= 2) ||
+      (x_dims.size() == 2 && y_dims.size() > 2)) {
     // x: [B, ..., M, K], y: [B, ..., K, N], out: [B, ..., M, N]
     // x: [B, M, K], y: [K, N], out: [B, M, N]
+    // x: [M, K], y: [B, K, N], out: [B, M, N]
+    // The batch dims are broadcast as in numpy, x: [B1, 1, M, K] and
+    // y: [B2, K, N] give out: [B1, B2, M, N].
     if (!x_transpose && !y_transpose) {
       CHECK_EQ(x_dims[x_dims.size() - 1], y_dims[y_dims.size() - 2])
           << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
@@ -55,22 +60,34 @@ bool MatMulOpLite::InferShape() const {
           << ")";
     }
 
-    dim_out_vec.resize(x_dims.size());
-    for (size_t i = 0; i < x_dims.size() - 2; ++i) {
-      dim_out_vec[i] = x_dims[i];
+    size_t out_rank = std::max(x_dims.size(), y_dims.size());
+    dim_out_vec.resize(out_rank);
+    for (size_t i = 0; i < out_rank - 2; ++i) {
+      int64_t x_dim = 1;
+      int64_t y_dim = 1;
+      if (i + x_dims.size() >= out_rank) {
+        x_dim = x_dims[i + x_dims.size() - out_rank];
+      }
+      if (i + y_dims.size() >= out_rank) {
+        y_dim = y_dims[i + y_dims.size() - out_rank];
+      }
+      CHECK(x_dim == y_dim || x_dim == 1 || y_dim == 1)
+          << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
+          << "), the batch dims can not be broadcast";
+      dim_out_vec[i] = std::max(x_dim, y_dim);
     }
     if (!x_transpose && !y_transpose) {
-      dim_out_vec[x_dims.size() - 2] = x_dims[x_dims.size() - 2];
-      dim_out_vec[x_dims.size() - 1] = y_dims[y_dims.size() - 1];
+      dim_out_vec[out_rank - 2] = x_dims[x_dims.size() - 2];
+      dim_out_vec[out_rank - 1] = y_dims[y_dims.size() - 1];
     } else if (!x_transpose && y_transpose) {
-      dim_out_vec[x_dims.size() - 2] = x_dims[x_dims.size() - 2];
-      dim_out_vec[x_dims.size() - 1] = y_dims[y_dims.size() - 2];
+      dim_out_vec[out_rank - 2] = x_dims[x_dims.size() - 2];
+      dim_out_vec[out_rank - 1] = y_dims[y_dims.size() - 2];
     } else if (x_transpose && !y_transpose) {
-      dim_out_vec[x_dims.size() - 2] = x_dims[x_dims.size() - 1];
-      dim_out_vec[x_dims.size() - 1] = y_dims[y_dims.size() - 1];
+      dim_out_vec[out_rank - 2] = x_dims[x_dims.size() - 1];
+      dim_out_vec[out_rank - 1] = y_dims[y_dims.size() - 1];
     } else {
-      dim_out_vec[x_dims.size() - 2] = x_dims[x_dims.size() - 1];
-      dim_out_vec[x_dims.size() - 1] = y_dims[y_dims.size() - 2];
+      dim_out_vec[out_rank - 2] = x_dims[x_dims.size() - 1];
+      dim_out_vec[out_rank - 1] = y_dims[y_dims.size() - 2];
     }
   } else if (x_dims.size() == 2 && y_dims.size() == 2) {
     // x: [M, K], y: [K, N], out: [M, N]
@@ -155,6 +172,15 @@ bool MatMulOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.transpose_X = op_desc.GetAttr<bool>("transpose_X");
   param_.transpose_Y = op_desc.GetAttr<bool>("transpose_Y");
   param_.alpha = op_desc.GetAttr<float>("alpha");
+  if (op_desc.HasAttr("weight_only_quant_bits")) {
+    param_.weight_only_quant_bits =
+        op_desc.GetAttr<int>("weight_only_quant_bits");
+    auto scale = op_desc.Input("WeightScale").front();
+    param_.weight_only_scale =
+        scope->FindVar(scale)->GetMutable<lite::Tensor>();
+    param_.dynamic_quant = op_desc.HasAttr("dynamic_quant") &&
+                           op_desc.GetAttr<bool>("dynamic_quant");
+  }
   return true;
 }
 
@@ -64,6 +64,10 @@ bool MulOpLite::InferShape() const {
        ++i) {
     out_dims.push_back(y_dims[i]);
   }
+  // The packed int4 weight stores two values in a byte.
+  if (param_.weight_only_quant_bits == 4) {
+    out_dims.back() *= 2;
+  }
   param_.output->Resize(lite::DDim(out_dims));
   auto out_lod = param_.output->mutable_lod();
   *out_lod = param_.x->lod();
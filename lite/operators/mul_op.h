@@ -57,6 +57,16 @@ class MulOpLite : public OpLite {
     param_.x_num_col_dims = op_desc.GetAttr<int>("x_num_col_dims");
     param_.y_num_col_dims = op_desc.GetAttr<int>("y_num_col_dims");
 
+    if (op_desc.HasAttr("weight_only_quant_bits")) {
+      param_.weight_only_quant_bits =
+          op_desc.GetAttr<int>("weight_only_quant_bits");
+      auto scale = op_desc.Input("WeightScale").front();
+      param_.weight_only_scale =
+          scope->FindVar(scale)->GetMutable<lite::Tensor>();
+      param_.dynamic_quant = op_desc.HasAttr("dynamic_quant") &&
+                             op_desc.GetAttr<bool>("dynamic_quant");
+    }
+
     return true;
   }
 
@@ -39,6 +39,17 @@ using param_t = Any;
   float output_scale{1.0};           \
   int bit_length{8};
 
+/*
+ * For the weight-only quantization, the weight is stored in int8 or packed
+ * int4 and dequantized with `weight_only_scale` by the kernels. With
+ * `dynamic_quant` the int8 weight is used as is and the activation is
+ * quantized per row at runtime, so the product runs in an int8 GEMM.
+ */
+#define WITH_WEIGHT_ONLY_QUANT_CONFIG              \
+  const lite::Tensor* weight_only_scale{nullptr}; \
+  int weight_only_quant_bits{0};                  \
+  bool dynamic_quant{false};
+
 /// ----------------------- Functional operators ------------------------------
 struct FeedParam {
   std::vector<lite::Tensor>* feed_list{};
@@ -85,8 +96,13 @@ struct FcParam {
   lite::DDim in_mat_dims;
   int in_num_col_dims{1};
   std::string activation_type{""};
+  float leaky_relu_alpha{0.f};
+  float relu6_threshold{6.f};
+  // Added to the output before the activation.
+  lite::Tensor* residualData{nullptr};
   // for int8
   WITH_INT8_CONFIG
+  WITH_WEIGHT_ONLY_QUANT_CONFIG
 };
 
 // For Interpolate Op
@@ -116,6 +132,7 @@ struct MulParam {
   int y_num_col_dims{1};
   // for int8
   WITH_INT8_CONFIG
+  WITH_WEIGHT_ONLY_QUANT_CONFIG
 };
 
 struct MulGradParam {
@@ -211,6 +228,10 @@ struct ConcatParam {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  // The inputs are views of the output, see BufferViewPass.
+  bool use_buffer_view{false};
+  // for int8
+  WITH_INT8_CONFIG
 };
 
 /// ----------------------- activation operators ----------------------
@@ -221,12 +242,18 @@ struct ActivationParam {
   std::string Prelu_mode{
       "channel"};  // prelu param, can be "all", "channel" or "element"
   lite::Tensor* Prelu_alpha{};  // prelu param
-  float Swish_beta;             // swish param
+  float Swish_beta{1.0};        // swish param
   float hard_sigmoid_slope{0.2};
   float hard_sigmoid_offset{0.5};
+  // hard_swish param
+  float hard_swish_threshold{6.0};
+  float hard_swish_scale{6.0};
+  float hard_swish_offset{3.0};
   lite::Tensor* Out{};
   bool has_active{false};
   lite_api::ActivationType active_type;
+  // for int8
+  WITH_INT8_CONFIG
 };
 
 struct ActivationGradParam {
@@ -323,6 +350,8 @@ struct SplitParam {
   int axis{-1};
   int num{0};
   std::vector<int> sections;
+  // The outputs are views of the input, see BufferViewPass.
+  bool use_buffer_view{false};
 };
 
 // For Transpose op
@@ -358,6 +387,8 @@ struct ElementwiseGradParam {
 
 struct FusionElementwiseActivationParam : public ElementwiseParam {
   std::string act_type;
+  // The activation named by act_type, with its coefficients.
+  ActivationParam activation_param;
 };
 
 struct FusionElementwiseActivationGradParam : public ElementwiseGradParam {
@@ -564,6 +595,34 @@ struct MulticlassNmsParam {
   bool normalized{true};
 };
 
+/// ----------------------- fusion_box_coder_nms operators -----------------
+// box_coder (decode_center_size, axis 0) fused into multiclass_nms; the
+// decoded boxes replace bboxes.
+struct FusionBoxCoderNmsParam : public MulticlassNmsParam {
+  const lite::Tensor* prior_box{};
+  const lite::Tensor* prior_box_var{};
+  const lite::Tensor* target_box{};
+  bool box_normalized{true};
+  std::vector<float> variance{};
+};
+
+/// ----------------------- fusion_squeeze_excitation operators -------------
+// pool2d (global avg) -> 1x1 conv or fc -> act -> 1x1 conv or fc -> act,
+// scaling the channels of x by the result.
+struct FusionSqueezeExcitationParam {
+  const lite::Tensor* x{};
+  const lite::Tensor* squeeze_weight{};
+  const lite::Tensor* squeeze_bias{};
+  const lite::Tensor* excite_weight{};
+  const lite::Tensor* excite_bias{};
+  lite::Tensor* out{};
+  // The weights are the [out, in, 1, 1] filters of conv2d, or the [in, out]
+  // weights of fc.
+  bool conv_weight{true};
+  ActivationParam squeeze_act;
+  ActivationParam excite_act;
+};
+
 /// ----------------------- priorbox operators ----------------------
 struct PriorBoxParam {
   lite::Tensor* input{};
@@ -626,6 +685,7 @@ struct LookupTableParam {
   lite::Tensor* Ids{nullptr};
   lite::Tensor* Out{nullptr};
   int64_t padding_idx{-1};
+  WITH_WEIGHT_ONLY_QUANT_CONFIG
 };
 
 struct Im2SequenceParam {
@@ -814,6 +874,8 @@ struct SliceParam {
   std::vector<lite::Tensor*> EndsTensorList{};
   lite::Tensor* StartsTensor{nullptr};
   lite::Tensor* EndsTensor{nullptr};
+  // The output is a view of the input, see BufferViewPass.
+  bool use_buffer_view{false};
 };
 
 struct AffineChannelParam {
@@ -887,6 +949,7 @@ struct MatMulParam {
   bool transpose_X{false};
   bool transpose_Y{false};
   float alpha{1.0f};
+  WITH_WEIGHT_ONLY_QUANT_CONFIG
 };
 
 struct GatherParam {
@@ -66,6 +66,14 @@ class PoolOpLite : public OpLite {
       param_.use_quantizer = op_desc.GetAttr<bool>("use_quantizer");
     }
     // param_.data_format = op_desc.GetAttr<bool>("data_format");
+    // For Int8
+    if (op_desc.HasAttr("enable_int8")) {
+      param_.enable_int8 = op_desc.GetAttr<bool>("enable_int8");
+      if (op_desc.HasAttr("input_scale"))
+        param_.input_scale = op_desc.GetAttr<float>("input_scale");
+      if (op_desc.HasAttr("output_scale"))
+        param_.output_scale = op_desc.GetAttr<float>("output_scale");
+    }
     return true;
   }
 
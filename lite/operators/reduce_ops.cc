@@ -87,3 +87,5 @@ bool ReduceOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
 }  // namespace paddle
 
 REGISTER_LITE_OP(reduce_sum, paddle::lite::operators::ReduceOp);
+REGISTER_LITE_OP(reduce_min, paddle::lite::operators::ReduceOp);
+REGISTER_LITE_OP(reduce_prod, paddle::lite::operators::ReduceOp);
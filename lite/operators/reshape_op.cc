@@ -92,12 +92,12 @@ bool ReshapeOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
 
 bool Reshape2Op::CheckShape() const {
   ReshapeOp::CheckShape();
-  CHECK_OR_FALSE(param_.xshape);
   return true;
 }
 
 bool Reshape2Op::InferShape() const {
   ReshapeOp::InferShape();
+  if (param_.xshape == nullptr) return true;
   auto x_dims = param_.x->dims();
   std::vector<DDim::value_type> xshape_dims(x_dims.size() + 1, 0);
   for (size_t i = 0; i < x_dims.size(); i++) {
@@ -111,8 +111,12 @@ bool Reshape2Op::InferShape() const {
 
 bool Reshape2Op::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   ReshapeOp::AttachImpl(opdesc, scope);
-  auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
-  param_.xshape = xshape_var->GetMutable<lite::Tensor>();
+  // XShape is removed by dead_code_elimination_pass when it is not used.
+  param_.xshape = nullptr;
+  if (opdesc.HasOutput("XShape")) {
+    auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
+    param_.xshape = xshape_var->GetMutable<lite::Tensor>();
+  }
   return true;
 }
 
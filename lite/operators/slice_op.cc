@@ -106,6 +106,9 @@ bool SliceOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   if (opdesc.HasAttr("decrease_axis")) {
     param_.decrease_axis = opdesc.GetAttr<std::vector<int>>("decrease_axis");
   }
+  if (opdesc.HasAttr("use_buffer_view")) {
+    param_.use_buffer_view = opdesc.GetAttr<bool>("use_buffer_view");
+  }
 
   // The priority: StartsTensor > StartsTensorList > attr(starts).
   // The priority: EndsTensor > EndsTensorList > attr(ends).
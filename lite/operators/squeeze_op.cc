@@ -101,12 +101,12 @@ bool SqueezeOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
 
 bool Squeeze2Op::CheckShape() const {
   SqueezeOp::CheckShape();
-  CHECK_OR_FALSE(param_.XShape);
   return true;
 }
 
 bool Squeeze2Op::InferShape() const {
   SqueezeOp::InferShape();
+  if (param_.XShape == nullptr) return true;
   auto x_dims = param_.X->dims();
   std::vector<DDim::value_type> xshape_dims(x_dims.size() + 1, 1);
   for (size_t i = 0; i < x_dims.size(); i++) {
@@ -118,10 +118,13 @@ bool Squeeze2Op::InferShape() const {
 
 bool Squeeze2Op::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   SqueezeOp::AttachImpl(opdesc, scope);
-  auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
-  CHECK(xshape_var);
-  param_.XShape = xshape_var->GetMutable<lite::Tensor>();
-  CHECK(param_.XShape) << "Output(XShape) of SqueezeOp should not be null.";
+  // XShape is removed by dead_code_elimination_pass when it is not used.
+  param_.XShape = nullptr;
+  if (opdesc.HasOutput("XShape")) {
+    auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
+    CHECK(xshape_var);
+    param_.XShape = xshape_var->GetMutable<lite::Tensor>();
+  }
   return true;
 }
 
@@ -125,12 +125,12 @@ bool UnsqueezeOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
 
 bool Unsqueeze2Op::CheckShape() const {
   UnsqueezeOp::CheckShape();
-  CHECK_OR_FALSE(param_.XShape);
   return true;
 }
 
 bool Unsqueeze2Op::InferShape() const {
   UnsqueezeOp::InferShape();
+  if (param_.XShape == nullptr) return true;
   auto x_dims = param_.X->dims();
   std::vector<DDim::value_type> xshape_dims(x_dims.size() + 1, 1);
   for (size_t i = 0; i < x_dims.size(); i++) {
@@ -142,10 +142,13 @@ bool Unsqueeze2Op::InferShape() const {
 
 bool Unsqueeze2Op::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   UnsqueezeOp::AttachImpl(opdesc, scope);
-  auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
-  CHECK(xshape_var);
-  param_.XShape = xshape_var->GetMutable<lite::Tensor>();
-  CHECK(param_.XShape) << "Output(XShape) of Unsqueeze2Op should not be null.";
+  // XShape is removed by dead_code_elimination_pass when it is not used.
+  param_.XShape = nullptr;
+  if (opdesc.HasOutput("XShape")) {
+    auto xshape_var = scope->FindVar(opdesc.Output("XShape").front());
+    CHECK(xshape_var);
+    param_.XShape = xshape_var->GetMutable<lite::Tensor>();
+  }
   return true;
 }
 
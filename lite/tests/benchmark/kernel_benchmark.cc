@@ -0,0 +1,428 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/roofline.h"
+#include "lite/tests/utils/timer.h"
+#include "lite/utils/string.h"
+
+DEFINE_string(ops,
+              "",
+              "the op types to run, separated by commas, all if empty");
+DEFINE_string(grid, "1,2,4", "the scales of the shapes, separated by commas");
+DEFINE_int32(warmup, 2, "warmup times");
+DEFINE_int32(repeats, 20, "repeats times");
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_double(peak_gflops, 0., "the peak GFLOP/s, measured if not positive");
+DEFINE_double(peak_gbps, 0., "the peak GB/s, measured if not positive");
+DEFINE_string(json_path, "", "the path of the JSON report, none if empty");
+
+namespace paddle {
+namespace lite {
+
+// A problem to run a kernel on: the input tensors with random data, the
+// output vars, the attrs, and the flops of one run. The bytes are counted as
+// the sizes of the inputs and the outputs, i.e. the compulsory traffic.
+struct BenchProblem {
+  std::string shape;
+  std::vector<std::tuple<std::string, std::string, DDim>> inputs;
+  std::vector<std::pair<std::string, std::string>> outputs;
+  std::function<void(cpp::OpDesc*)> set_attrs;
+  double flops{0.};
+};
+
+using BenchProblemMaker = std::function<BenchProblem(int64_t scale)>;
+
+std::string DimsToString(const std::vector<DDim>& dims) {
+  std::stringstream ss;
+  for (size_t i = 0; i < dims.size(); i++) {
+    if (i) ss << ";";
+    ss << dims[i].repr();
+  }
+  return ss.str();
+}
+
+BenchProblem GemmProblem(const std::string& op_type, int64_t scale) {
+  int64_t m = 64 * scale, n = 256 * scale, k = 256 * scale;
+  BenchProblem problem;
+  DDim x({m, k}), w({k, n});
+  if (op_type == "fc") {
+    problem.inputs = {std::make_tuple("Input", "x", x),
+                      std::make_tuple("W", "w", w),
+                      std::make_tuple("Bias", "b", DDim({n}))};
+    problem.set_attrs = [](cpp::OpDesc* desc) {
+      desc->SetAttr<int>("in_num_col_dims", 1);
+    };
+  } else if (op_type == "mul") {
+    problem.inputs = {std::make_tuple("X", "x", x),
+                      std::make_tuple("Y", "w", w)};
+    problem.set_attrs = [](cpp::OpDesc* desc) {
+      desc->SetAttr<int>("x_num_col_dims", 1);
+      desc->SetAttr<int>("y_num_col_dims", 1);
+    };
+  } else {
+    problem.inputs = {std::make_tuple("X", "x", x),
+                      std::make_tuple("Y", "w", w)};
+    problem.set_attrs = [](cpp::OpDesc* desc) {
+      desc->SetAttr<bool>("transpose_X", false);
+      desc->SetAttr<bool>("transpose_Y", false);
+      desc->SetAttr<float>("alpha", 1.f);
+    };
+  }
+  problem.outputs = {{"Out", "out"}};
+  problem.shape = DimsToString({x, w});
+  problem.flops = 2. * m * n * k;
+  return problem;
+}
+
+BenchProblem ConvProblem(bool depthwise, int64_t scale) {
+  int64_t c = 32 * scale;
+  int64_t h = depthwise ? 112 : 56;
+  int64_t groups = depthwise ? c : 1;
+  DDim x({1, c, h, h}), w({c, c / groups, 3, 3});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("Input", "x", x),
+                    std::make_tuple("Filter", "w", w)};
+  problem.outputs = {{"Output", "out"}};
+  problem.set_attrs = [=](cpp::OpDesc* desc) {
+    desc->SetAttr<std::vector<int>>("strides", {1, 1});
+    desc->SetAttr<std::vector<int>>("paddings", {1, 1});
+    desc->SetAttr<std::vector<int>>("dilations", {1, 1});
+    desc->SetAttr<int>("groups", static_cast<int>(groups));
+  };
+  problem.shape = DimsToString({x, w});
+  problem.flops = 2. * c * h * h * (c / groups) * 9;
+  return problem;
+}
+
+BenchProblem PoolProblem(int64_t scale) {
+  int64_t c = 32 * scale;
+  DDim x({1, c, 112, 112});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("X", "x", x)};
+  problem.outputs = {{"Out", "out"}};
+  problem.set_attrs = [](cpp::OpDesc* desc) {
+    desc->SetAttr<std::string>("pooling_type", "max");
+    desc->SetAttr<std::vector<int>>("ksize", {2, 2});
+    desc->SetAttr<std::vector<int>>("strides", {2, 2});
+    desc->SetAttr<std::vector<int>>("paddings", {0, 0});
+    desc->SetAttr<bool>("global_pooling", false);
+  };
+  problem.shape = DimsToString({x});
+  // One comparison for every input element.
+  problem.flops = static_cast<double>(x.production());
+  return problem;
+}
+
+BenchProblem ElementwiseProblem(int64_t scale) {
+  DDim x({1, 32 * scale, 56, 56});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("X", "x", x), std::make_tuple("Y", "y", x)};
+  problem.outputs = {{"Out", "out"}};
+  problem.set_attrs = [](cpp::OpDesc* desc) { desc->SetAttr<int>("axis", -1); };
+  problem.shape = DimsToString({x, x});
+  problem.flops = static_cast<double>(x.production());
+  return problem;
+}
+
+BenchProblem ActivationProblem(int64_t scale) {
+  DDim x({1, 32 * scale, 56, 56});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("X", "x", x)};
+  problem.outputs = {{"Out", "out"}};
+  problem.set_attrs = [](cpp::OpDesc* desc) {};
+  problem.shape = DimsToString({x});
+  problem.flops = static_cast<double>(x.production());
+  return problem;
+}
+
+BenchProblem SoftmaxProblem(int64_t scale) {
+  DDim x({64 * scale, 1000});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("X", "x", x)};
+  problem.outputs = {{"Out", "out"}};
+  problem.set_attrs = [](cpp::OpDesc* desc) { desc->SetAttr<int>("axis", -1); };
+  problem.shape = DimsToString({x});
+  // max, sub, exp, sum and div for every element.
+  problem.flops = 5. * x.production();
+  return problem;
+}
+
+BenchProblem ConcatProblem(int64_t scale) {
+  DDim x({1, 16 * scale, 56, 56});
+  BenchProblem problem;
+  problem.inputs = {std::make_tuple("X", "x0", x),
+                    std::make_tuple("X", "x1", x)};
+  problem.outputs = {{"Out", "out"}};
+  problem.set_attrs = [](cpp::OpDesc* desc) { desc->SetAttr<int>("axis", 1); };
+  problem.shape = DimsToString({x, x});
+  return problem;
+}
+
+// The op types with a shape grid. The kernels of the other op types in the
+// registry are reported as skipped.
+const std::map<std::string, BenchProblemMaker>& BenchProblemMakers() {
+  using std::placeholders::_1;
+  static const std::map<std::string, BenchProblemMaker> makers{
+      {"fc", std::bind(GemmProblem, "fc", _1)},
+      {"mul", std::bind(GemmProblem, "mul", _1)},
+      {"matmul", std::bind(GemmProblem, "matmul", _1)},
+      {"conv2d", std::bind(ConvProblem, false, _1)},
+      {"depthwise_conv2d", std::bind(ConvProblem, true, _1)},
+      {"pool2d", PoolProblem},
+      {"elementwise_add", ElementwiseProblem},
+      {"elementwise_mul", ElementwiseProblem},
+      {"relu", ActivationProblem},
+      {"sigmoid", ActivationProblem},
+      {"tanh", ActivationProblem},
+      {"softmax", SoftmaxProblem},
+      {"concat", ConcatProblem},
+  };
+  return makers;
+}
+
+struct BenchResult {
+  std::string op_type;
+  std::string kernel;
+  Place place;
+  std::string shape;
+  float avg_ms{0.f};
+  float min_ms{0.f};
+  float median_ms{0.f};
+  double flops{0.};
+  double bytes{0.};
+};
+
+std::unique_ptr<KernelContext> NewBenchContext(TargetType target) {
+  auto ctx = ContextScheduler::Global().NewContext(target);
+#ifdef LITE_WITH_ARM
+  if (target == TARGET(kARM)) {
+    ctx->As<ARMContext>().SetRunMode(
+        static_cast<lite_api::PowerMode>(FLAGS_power_mode), FLAGS_threads);
+  }
+#endif  // LITE_WITH_ARM
+  return ctx;
+}
+
+// Run all the kernels registered for the place on the problem.
+std::vector<BenchResult> RunProblem(const std::string& op_type,
+                                    const Place& place,
+                                    const BenchProblem& problem) {
+  std::vector<BenchResult> results;
+  auto kernels = KernelRegistry::Global().Create(
+      op_type, place.target, place.precision, place.layout);
+  for (auto& kernel : kernels) {
+    Scope scope;
+    cpp::OpDesc desc;
+    desc.SetType(op_type);
+    std::map<std::string, std::vector<std::string>> inputs;
+    double bytes = 0.;
+    for (auto& input : problem.inputs) {
+      const auto& dims = std::get<2>(input);
+      auto* tensor = scope.NewTensor(std::get<1>(input));
+      tensor->Resize(dims);
+      fill_data_rand(tensor->mutable_data<float>(),
+                     -1.f,
+                     1.f,
+                     static_cast<size_t>(dims.production()));
+      inputs[std::get<0>(input)].push_back(std::get<1>(input));
+      bytes += tensor->memory_size();
+    }
+    for (auto& item : inputs) {
+      desc.SetInput(item.first, item.second);
+    }
+    for (auto& output : problem.outputs) {
+      scope.NewTensor(output.second);
+      desc.SetOutput(output.first, {output.second});
+    }
+    problem.set_attrs(&desc);
+
+    auto op = LiteOpRegistry::Global().Create(op_type);
+    CHECK(op) << "no op for " << op_type;
+    op->Attach(desc, &scope);
+    op->AttachKernel(kernel.get());
+    kernel->SetContext(NewBenchContext(place.target));
+    CHECK(op->CheckShape()) << "check shape failed for " << op_type;
+    op->InferShape();
+
+    // The first run prepares the kernel.
+    for (int i = 0; i < std::max(FLAGS_warmup, 1); i++) {
+      kernel->Launch();
+    }
+    Timer timer;
+    for (int i = 0; i < FLAGS_repeats; i++) {
+      timer.start();
+      kernel->Launch();
+      timer.end();
+    }
+    for (auto& output : problem.outputs) {
+      bytes += scope.FindTensor(output.second)->memory_size();
+    }
+
+    BenchResult result;
+    result.op_type = op_type;
+    result.kernel = kernel->key_with_alias();
+    result.place = place;
+    result.shape = problem.shape;
+    result.avg_ms = timer.get_average_ms();
+    result.median_ms = timer.get_tile_time(50);
+    result.min_ms = timer.get_min_time();
+    result.flops = problem.flops;
+    result.bytes = bytes;
+    results.push_back(result);
+  }
+  return results;
+}
+
+bool IsBenchTarget(TargetType target) {
+  return target == TARGET(kHost) || target == TARGET(kX86) ||
+         target == TARGET(kARM);
+}
+
+std::string JsonString(const std::string& str) { return "\"" + str + "\""; }
+
+void WriteJson(const std::string& path,
+               const MachinePeaks& peaks,
+               const std::vector<BenchResult>& results,
+               const std::vector<std::pair<std::string, Place>>& skipped) {
+  std::ofstream os(path);
+  CHECK(os.is_open()) << "failed to open " << path;
+  os << std::setprecision(6);
+  os << "{\n";
+  os << "  \"machine\": {\"peak_gflops\": " << peaks.gflops
+     << ", \"peak_gbps\": " << peaks.gbps << ", \"threads\": " << FLAGS_threads
+     << "},\n";
+  os << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    double seconds = r.median_ms * 1e-3;
+    double gflops = r.flops / seconds * 1e-9;
+    double gbps = r.bytes / seconds * 1e-9;
+    double intensity = r.flops / r.bytes;
+    double roof = r.flops > 0. ? AttainableGflops(peaks, intensity) : 0.;
+    // The kernels without flops are bound by the memory bandwidth.
+    double efficiency = r.flops > 0. ? gflops / roof : gbps / peaks.gbps;
+    os << (i ? "," : "") << "\n    {";
+    os << "\"op\": " << JsonString(r.op_type)
+       << ", \"kernel\": " << JsonString(r.kernel)
+       << ", \"target\": " << JsonString(TargetToStr(r.place.target))
+       << ", \"precision\": " << JsonString(PrecisionToStr(r.place.precision))
+       << ", \"layout\": " << JsonString(DataLayoutToStr(r.place.layout))
+       << ", \"shape\": " << JsonString(r.shape) << ", \"avg_ms\": " << r.avg_ms
+       << ", \"median_ms\": " << r.median_ms << ", \"min_ms\": " << r.min_ms
+       << ", \"gflops\": " << gflops << ", \"gbps\": " << gbps
+       << ", \"intensity\": " << intensity
+       << ", \"attainable_gflops\": " << roof
+       << ", \"roofline_efficiency\": " << efficiency << "}";
+  }
+  os << "\n  ],\n";
+  os << "  \"skipped\": [";
+  for (size_t i = 0; i < skipped.size(); i++) {
+    const auto& place = skipped[i].second;
+    os << (i ? "," : "") << "\n    {";
+    os << "\"op\": " << JsonString(skipped[i].first)
+       << ", \"target\": " << JsonString(TargetToStr(place.target))
+       << ", \"precision\": " << JsonString(PrecisionToStr(place.precision))
+       << ", \"layout\": " << JsonString(DataLayoutToStr(place.layout)) << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+TEST(kernel_benchmark, all_kernels) {
+#ifdef LITE_WITH_ARM
+  DeviceInfo::Init();
+#endif  // LITE_WITH_ARM
+  MachinePeaks peaks = MeasureMachinePeaks();
+  if (FLAGS_peak_gflops > 0.) peaks.gflops = FLAGS_peak_gflops;
+  if (FLAGS_peak_gbps > 0.) peaks.gbps = FLAGS_peak_gbps;
+  LOG(INFO) << "peak GFLOP/s: " << peaks.gflops
+            << ", peak GB/s: " << peaks.gbps;
+
+  std::set<std::string> ops;
+  for (auto& op : Split(FLAGS_ops, ",")) {
+    if (!op.empty()) ops.insert(op);
+  }
+  std::vector<int64_t> scales;
+  for (auto& scale : Split(FLAGS_grid, ",")) {
+    if (!scale.empty()) scales.push_back(std::stoll(scale));
+  }
+
+  std::vector<BenchResult> results;
+  std::vector<std::pair<std::string, Place>> skipped;
+  const auto& makers = BenchProblemMakers();
+  for (auto& item : KernelRegistry::Global().kernel_info_map()) {
+    const auto& op_type = item.first;
+    if (!ops.empty() && !ops.count(op_type)) continue;
+    // A place appears once for every alias registered to it.
+    std::set<std::tuple<TargetType, PrecisionType, DataLayoutType>> places(
+        item.second.begin(), item.second.end());
+    for (auto& kernel_place : places) {
+      Place place(std::get<0>(kernel_place),
+                  std::get<1>(kernel_place),
+                  std::get<2>(kernel_place));
+      if (!IsBenchTarget(place.target)) continue;
+      // The problems are all filled with float data.
+      bool runnable = makers.count(op_type) &&
+                      (place.precision == PRECISION(kFloat) ||
+                       place.precision == PRECISION(kAny));
+      if (!runnable) {
+        skipped.emplace_back(op_type, place);
+        continue;
+      }
+      for (auto scale : scales) {
+        auto problem = makers.at(op_type)(scale);
+        for (auto& r : RunProblem(op_type, place, problem)) {
+          double gflops = r.flops / (r.median_ms * 1e-3) * 1e-9;
+          double gbps = r.bytes / (r.median_ms * 1e-3) * 1e-9;
+          LOG(INFO) << r.kernel << " " << place.DebugString() << " "
+                    << r.shape << ": " << r.median_ms << " ms, " << gflops
+                    << " GFLOP/s, " << gbps << " GB/s";
+          results.push_back(r);
+        }
+      }
+    }
+  }
+  LOG(INFO) << results.size() << " runs, " << skipped.size()
+            << " kernels skipped";
+  if (!FLAGS_json_path.empty()) {
+    WriteJson(FLAGS_json_path, peaks, results, skipped);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
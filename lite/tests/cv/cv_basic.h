@@ -464,8 +464,8 @@ void image_resize_basic(const uint8_t* in_data,
     memcpy(out_data, in_data, sizeof(uint8_t) * size);
     return;
   }
-  double scale_x = static_cast<double>(srcw / dstw);
-  double scale_y = static_cast<double>(srch / dsth);
+  double scale_x = static_cast<double>(srcw) / dstw;
+  double scale_y = static_cast<double>(srch) / dsth;
 
   int* buf = new int[dstw + dsth];
 
@@ -759,12 +759,12 @@ void bgr_to_tensor_chw_basic(const uint8_t* bgr,
                              float* scales,
                              int num) {
   int size = width * height;
-  float r_means = means[0];
+  float b_means = means[0];
   float g_means = means[1];
-  float b_means = means[2];
-  float r_scales = scales[0];
+  float r_means = means[2];
+  float b_scales = scales[0];
   float g_scales = scales[1];
-  float b_scales = scales[2];
+  float r_scales = scales[2];
 
   for (int h = 0; h < height; h++) {
     const uint8_t* ptr_bgr = bgr + h * width * num;
@@ -788,16 +788,16 @@ void bgr_to_tensor_hwc_basic(const uint8_t* bgr,
                              float* scales,
                              int num) {
   int size = width * height;
-  float r_means = means[0];
+  float b_means = means[0];
   float g_means = means[1];
-  float b_means = means[2];
-  float r_scales = scales[0];
+  float r_means = means[2];
+  float b_scales = scales[0];
   float g_scales = scales[1];
-  float b_scales = scales[2];
+  float r_scales = scales[2];
 
   for (int h = 0; h < height; h++) {
     const uint8_t* ptr_bgr = bgr + h * width * num;
-    float* out_bgr = output + h * width * num;
+    float* out_bgr = output + h * width * 3;
     for (int i = 0; i < width; i++) {
       *out_bgr++ = (ptr_bgr[0] - b_means) * b_scales;
       *out_bgr++ = (ptr_bgr[1] - g_means) * g_scales;
@@ -0,0 +1,171 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/cv/cv_basic.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+typedef paddle::lite::utils::cv::TransParam TransParam;
+typedef paddle::lite::utils::cv::ImagePreprocess ImagePreprocess;
+
+int image_size(ImageFormat format, int w, int h) {
+  if (format == ImageFormat::NV12 || format == ImageFormat::NV21) {
+    return w * (h + (h + 1) / 2);
+  } else if (format == ImageFormat::BGR || format == ImageFormat::RGB) {
+    return w * h * 3;
+  } else if (format == ImageFormat::BGRA || format == ImageFormat::RGBA) {
+    return w * h * 4;
+  }
+  return w * h;
+}
+
+// the weights of the bilinear resize, the border is replicated
+void resize_coef(
+    int src_size, int dst_size, int d, int* s0, int* s1, float* f) {
+  double scale = static_cast<double>(src_size) / dst_size;
+  float fx = static_cast<float>((d + 0.5) * scale - 0.5);
+  int s = floor(fx);
+  fx -= s;
+  if (s < 0) {
+    s = 0;
+    fx = 0.f;
+  }
+  if (s >= src_size - 1) {
+    s = src_size - 1;
+    fx = 0.f;
+  }
+  *s0 = s;
+  *s1 = std::min(s + 1, src_size - 1);
+  *f = fx;
+}
+
+void fuse_basic(const uint8_t* src,
+                float* dst,
+                ImageFormat srcFormat,
+                ImageFormat dstFormat,
+                int srcw,
+                int srch,
+                int dstw,
+                int dsth,
+                LayoutType layout,
+                const float* means,
+                const float* scales) {
+  int in_c = image_size(dstFormat, 1, 1);
+  std::vector<uint8_t> img(srcw * srch * in_c);
+  image_convert_basic(
+      src, img.data(), srcFormat, dstFormat, srcw, srch, img.size());
+  int c = std::min(in_c, 3);
+  for (int dy = 0; dy < dsth; dy++) {
+    int y0, y1;
+    float fy;
+    resize_coef(srch, dsth, dy, &y0, &y1, &fy);
+    for (int dx = 0; dx < dstw; dx++) {
+      int x0, x1;
+      float fx;
+      resize_coef(srcw, dstw, dx, &x0, &x1, &fx);
+      for (int k = 0; k < c; k++) {
+        float tl = img[(y0 * srcw + x0) * in_c + k];
+        float tr = img[(y0 * srcw + x1) * in_c + k];
+        float bl = img[(y1 * srcw + x0) * in_c + k];
+        float br = img[(y1 * srcw + x1) * in_c + k];
+        float v = (tl * (1.f - fx) + tr * fx) * (1.f - fy) +
+                  (bl * (1.f - fx) + br * fx) * fy;
+        int idx = layout == LayoutType::kNCHW
+                      ? (k * dsth + dy) * dstw + dx
+                      : (dy * dstw + dx) * c + k;
+        dst[idx] = (v - means[k]) * scales[k];
+      }
+    }
+  }
+}
+
+void test_fuse(int srcw,
+               int srch,
+               int dstw,
+               int dsth,
+               ImageFormat srcFormat,
+               ImageFormat dstFormat,
+               LayoutType layout) {
+  std::vector<uint8_t> src(image_size(srcFormat, srcw, srch));
+  unsigned int seed = 256;
+  for (auto& v : src) {
+    v = rand_r(&seed) % 256;
+  }
+  float means[3] = {127.5f, 120.f, 110.f};
+  float scales[3] = {1.f / 127.5f, 1.f / 60.f, 1.f / 58.f};
+
+  TransParam param;
+  param.iw = srcw;
+  param.ih = srch;
+  param.ow = dstw;
+  param.oh = dsth;
+  ImagePreprocess preprocess(srcFormat, dstFormat, param);
+  paddle::lite::Tensor tensor;
+  paddle::lite_api::Tensor api_tensor(&tensor);
+  preprocess.image2TensorFused(src.data(), &api_tensor, layout, means, scales);
+
+  int c = std::min(image_size(dstFormat, 1, 1), 3);
+  ASSERT_EQ(tensor.numel(), c * dstw * dsth);
+  std::vector<float> ref(tensor.numel());
+  fuse_basic(src.data(),
+             ref.data(),
+             srcFormat,
+             dstFormat,
+             srcw,
+             srch,
+             dstw,
+             dsth,
+             layout,
+             means,
+             scales);
+  const float* out = tensor.data<float>();
+  for (int i = 0; i < tensor.numel(); i++) {
+    ASSERT_NEAR(out[i], ref[i], 1e-4f)
+        << "srcw: " << srcw << ", srch: " << srch << ", dstw: " << dstw
+        << ", dsth: " << dsth << ", srcFormat: " << srcFormat
+        << ", dstFormat: " << dstFormat << ", i: " << i;
+  }
+}
+
+TEST(TestImageFuse, convert_resize_to_tensor) {
+  std::vector<std::pair<ImageFormat, ImageFormat>> formats{
+      {ImageFormat::NV12, ImageFormat::BGR},
+      {ImageFormat::NV21, ImageFormat::RGB},
+      {ImageFormat::NV21, ImageFormat::BGRA},
+      {ImageFormat::BGR, ImageFormat::BGR},
+      {ImageFormat::BGR, ImageFormat::RGB},
+      {ImageFormat::RGBA, ImageFormat::BGR},
+      {ImageFormat::BGRA, ImageFormat::BGRA},
+      {ImageFormat::BGR, ImageFormat::GRAY},
+      {ImageFormat::GRAY, ImageFormat::BGR},
+      {ImageFormat::GRAY, ImageFormat::GRAY}};
+  for (auto& format : formats) {
+    for (auto w : {2, 16, 98, 224}) {
+      for (auto h : {2, 15, 112}) {
+        for (auto ww : {1, 7, 32, 300}) {
+          for (auto hh : {1, 9, 64, 250}) {
+            for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+              test_fuse(w, h, ww, hh, format.first, format.second, layout);
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/cv/cv_basic.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+typedef paddle::lite::utils::cv::TransParam TransParam;
+typedef paddle::lite::utils::cv::ImagePreprocess ImagePreprocess;
+
+// Compares the ImagePreprocess functions of the build target against the
+// scalar references in cv_basic.h.
+
+int image_size(ImageFormat format, int w, int h) {
+  if (format == ImageFormat::NV12 || format == ImageFormat::NV21) {
+    return w * (h + (h + 1) / 2);
+  } else if (format == ImageFormat::BGR || format == ImageFormat::RGB) {
+    return w * h * 3;
+  } else if (format == ImageFormat::BGRA || format == ImageFormat::RGBA) {
+    return w * h * 4;
+  }
+  return w * h;
+}
+
+std::vector<uint8_t> rand_image(ImageFormat format, int w, int h) {
+  std::vector<uint8_t> image(image_size(format, w, h));
+  unsigned int seed = 256;
+  for (auto& v : image) {
+    v = rand_r(&seed) % 256;
+  }
+  return image;
+}
+
+TransParam trans_param(int srcw, int srch, int dstw, int dsth) {
+  TransParam param;
+  param.iw = srcw;
+  param.ih = srch;
+  param.ow = dstw;
+  param.oh = dsth;
+  return param;
+}
+
+const std::vector<ImageFormat> kFormats{
+    ImageFormat::GRAY, ImageFormat::BGR, ImageFormat::BGRA};
+
+TEST(TestImagePreprocess, resize) {
+  // image_resize_basic does not resize the uv plane of NV12/NV21 yet.
+  for (auto format : kFormats) {
+    for (auto w : {2, 15, 224}) {
+      for (auto h : {2, 16, 113}) {
+        for (auto ww : {1, 7, 32, 300}) {
+          for (auto hh : {2, 9, 64, 250}) {
+            auto src = rand_image(format, w, h);
+            std::vector<uint8_t> dst(image_size(format, ww, hh));
+            std::vector<uint8_t> ref(dst.size());
+            ImagePreprocess preprocess(
+                format, format, trans_param(w, h, ww, hh));
+            preprocess.imageResize(src.data(), dst.data());
+            image_resize_basic(src.data(), ref.data(), format, w, h, ww, hh);
+            // The resize weights are in fixed point.
+            for (size_t i = 0; i < dst.size(); i++) {
+              ASSERT_NEAR(dst[i], ref[i], 1)
+                  << "format: " << format << ", " << w << "x" << h << " -> "
+                  << ww << "x" << hh << ", i: " << i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestImagePreprocess, rotate) {
+  for (auto format : kFormats) {
+    for (auto w : {1, 8, 17, 224}) {
+      for (auto h : {1, 9, 16, 113}) {
+        for (auto degree : {90, 180, 270}) {
+          auto src = rand_image(format, w, h);
+          std::vector<uint8_t> dst(src.size());
+          std::vector<uint8_t> ref(src.size());
+          auto param = trans_param(w, h, w, h);
+          param.rotate_param = degree;
+          ImagePreprocess preprocess(format, format, param);
+          preprocess.imageRotate(src.data(), dst.data());
+          image_rotate_basic(src.data(), ref.data(), format, w, h, degree);
+          ASSERT_EQ(dst, ref) << "format: " << format << ", " << w << "x" << h
+                              << ", degree: " << degree;
+        }
+      }
+    }
+  }
+}
+
+TEST(TestImagePreprocess, flip) {
+  for (auto format : kFormats) {
+    for (auto w : {1, 8, 17, 224}) {
+      for (auto h : {1, 9, 16, 113}) {
+        for (auto flip : {FlipParam::X, FlipParam::Y, FlipParam::XY}) {
+          auto src = rand_image(format, w, h);
+          std::vector<uint8_t> dst(src.size());
+          std::vector<uint8_t> ref(src.size());
+          auto param = trans_param(w, h, w, h);
+          param.flip_param = flip;
+          ImagePreprocess preprocess(format, format, param);
+          preprocess.imageFlip(src.data(), dst.data());
+          image_flip_basic(src.data(), ref.data(), format, w, h, flip);
+          ASSERT_EQ(dst, ref) << "format: " << format << ", " << w << "x" << h
+                              << ", flip: " << flip;
+        }
+      }
+    }
+  }
+}
+
+TEST(TestImagePreprocess, image2tensor) {
+  float means[3] = {127.5f, 120.f, 110.f};
+  float scales[3] = {1.f / 127.5f, 1.f / 60.f, 1.f / 58.f};
+  for (auto format : {ImageFormat::BGR, ImageFormat::BGRA}) {
+    for (auto layout : {LayoutType::kNCHW, LayoutType::kNHWC}) {
+      for (auto w : {1, 8, 17, 224}) {
+        for (auto h : {1, 9, 113}) {
+          auto src = rand_image(format, w, h);
+          std::vector<int64_t> shape =
+              layout == LayoutType::kNCHW ? std::vector<int64_t>{1, 3, h, w}
+                                          : std::vector<int64_t>{1, h, w, 3};
+          Tensor tensor;
+          Tensor tensor_ref;
+          tensor.Resize(shape);
+          tensor_ref.Resize(shape);
+          paddle::lite_api::Tensor api_tensor(&tensor);
+          ImagePreprocess preprocess(format, format, trans_param(w, h, w, h));
+          preprocess.image2Tensor(
+              src.data(), &api_tensor, layout, means, scales);
+          image_to_tensor_basic(
+              src.data(), &tensor_ref, format, layout, w, h, means, scales);
+          const float* out = tensor.data<float>();
+          const float* ref = tensor_ref.data<float>();
+          for (int i = 0; i < tensor.numel(); i++) {
+            ASSERT_NEAR(out[i], ref[i], 1e-5f)
+                << "format: " << format
+                << ", layout: " << static_cast<int>(layout) << ", " << w << "x"
+                << h << ", i: " << i;
+          }
+        }
+      }
+    }
+  }
+}
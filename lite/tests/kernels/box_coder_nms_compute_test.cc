@@ -0,0 +1,261 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/arena/framework.h"
+
+namespace paddle {
+namespace lite {
+
+// box_coder decode_center_size with axis 0. `variances` is the PriorBoxVar
+// tensor, or nullptr to use the 4 values of `variance`.
+static void box_coder_decode_ref(const Tensor* prior_box,
+                                 const Tensor* prior_box_var,
+                                 const std::vector<float>& variance,
+                                 const Tensor* target_box,
+                                 bool box_normalized,
+                                 Tensor* output_box) {
+  const int64_t row = target_box->dims()[0];
+  const int64_t col = target_box->dims()[1];
+  const float* prior_data = prior_box->data<float>();
+  const float* var_data =
+      prior_box_var ? prior_box_var->data<float>() : variance.data();
+  const float* target_data = target_box->data<float>();
+  output_box->Resize(target_box->dims());
+  float* output_data = output_box->mutable_data<float>();
+  float normalized = box_normalized ? 0.f : 1.f;
+  for (int64_t i = 0; i < row; ++i) {
+    for (int64_t j = 0; j < col; ++j) {
+      const float* prior = prior_data + j * 4;
+      const float* var = prior_box_var ? var_data + j * 4 : var_data;
+      const float* target = target_data + (i * col + j) * 4;
+      float* output = output_data + (i * col + j) * 4;
+      float prior_w = prior[2] - prior[0] + normalized;
+      float prior_h = prior[3] - prior[1] + normalized;
+      float prior_cx = prior[0] + 0.5f * prior_w;
+      float prior_cy = prior[1] + 0.5f * prior_h;
+      float cx = var[0] * target[0] * prior_w + prior_cx;
+      float cy = var[1] * target[1] * prior_h + prior_cy;
+      float w = std::exp(var[2] * target[2]) * prior_w;
+      float h = std::exp(var[3] * target[3]) * prior_h;
+      output[0] = cx - w / 2;
+      output[1] = cy - h / 2;
+      output[2] = cx + w / 2 - normalized;
+      output[3] = cy + h / 2 - normalized;
+    }
+  }
+}
+
+class BoxCoderNmsComputeTester : public arena::TestCase {
+ protected:
+  std::string prior_box_ = "PriorBox";
+  std::string prior_box_var_ = "PriorBoxVar";
+  std::string target_box_ = "TargetBox";
+  std::string scores_ = "Scores";
+  std::string out_ = "Out";
+
+  int batch_size_;
+  int class_num_;
+  int num_boxes_;
+  bool with_prior_box_var_;
+  bool box_normalized_;
+  int background_label_;
+  float score_threshold_;
+  int nms_top_k_;
+  float nms_threshold_;
+  float nms_eta_;
+  int keep_top_k_;
+  std::vector<float> variance_{0.1f, 0.1f, 0.2f, 0.2f};
+
+ public:
+  BoxCoderNmsComputeTester(const Place& place,
+                           const std::string& alias,
+                           int batch_size,
+                           int class_num,
+                           int num_boxes,
+                           bool with_prior_box_var,
+                           bool box_normalized,
+                           int background_label,
+                           float score_threshold,
+                           int nms_top_k,
+                           float nms_threshold,
+                           float nms_eta,
+                           int keep_top_k)
+      : TestCase(place, alias),
+        batch_size_(batch_size),
+        class_num_(class_num),
+        num_boxes_(num_boxes),
+        with_prior_box_var_(with_prior_box_var),
+        box_normalized_(box_normalized),
+        background_label_(background_label),
+        score_threshold_(score_threshold),
+        nms_top_k_(nms_top_k),
+        nms_threshold_(nms_threshold),
+        nms_eta_(nms_eta),
+        keep_top_k_(keep_top_k) {}
+
+  // Decode the boxes, then run the unfused multiclass_nms kernel, which is
+  // checked against a scalar implementation in
+  // lite/kernels/host/multiclass_nms_compute_test.cc.
+  void RunBaseline(Scope* scope) override {
+    auto* prior_box = scope->FindTensor(prior_box_);
+    auto* prior_box_var =
+        with_prior_box_var_ ? scope->FindTensor(prior_box_var_) : nullptr;
+    auto* target_box = scope->FindTensor(target_box_);
+    auto* scores = scope->FindTensor(scores_);
+    auto* out = scope->NewTensor(out_);
+    CHECK(out);
+
+    Tensor decoded_box;
+    box_coder_decode_ref(prior_box,
+                         prior_box_var,
+                         variance_,
+                         target_box,
+                         box_normalized_,
+                         &decoded_box);
+
+    auto kernels = KernelRegistry::Global().Create(
+        "multiclass_nms", TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW));
+    ASSERT_FALSE(kernels.empty());
+    auto& nms = kernels.front();
+    operators::MulticlassNmsParam param;
+    param.bboxes = &decoded_box;
+    param.scores = scores;
+    param.out = out;
+    param.background_label = background_label_;
+    param.score_threshold = score_threshold_;
+    param.nms_top_k = nms_top_k_;
+    param.nms_threshold = nms_threshold_;
+    param.nms_eta = nms_eta_;
+    param.keep_top_k = keep_top_k_;
+    param.normalized = box_normalized_;
+    nms->SetParam(param);
+    nms->Launch();
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("fusion_box_coder_nms");
+    op_desc->SetInput("PriorBox", {prior_box_});
+    if (with_prior_box_var_) {
+      op_desc->SetInput("PriorBoxVar", {prior_box_var_});
+    } else {
+      op_desc->SetAttr("variance", variance_);
+    }
+    op_desc->SetInput("TargetBox", {target_box_});
+    op_desc->SetInput("Scores", {scores_});
+    op_desc->SetOutput("Out", {out_});
+    op_desc->SetAttr("box_normalized", box_normalized_);
+    op_desc->SetAttr("background_label", background_label_);
+    op_desc->SetAttr("score_threshold", score_threshold_);
+    op_desc->SetAttr("nms_top_k", nms_top_k_);
+    op_desc->SetAttr("nms_threshold", nms_threshold_);
+    op_desc->SetAttr("nms_eta", nms_eta_);
+    op_desc->SetAttr("keep_top_k", keep_top_k_);
+    op_desc->SetAttr("normalized", box_normalized_);
+  }
+
+  void PrepareData() override {
+    // Overlapping priors on a grid, so NMS suppresses some of them.
+    float scale = box_normalized_ ? 1.f / num_boxes_ : 4.f;
+    std::vector<float> prior_box_data(num_boxes_ * 4);
+    for (int i = 0; i < num_boxes_; i++) {
+      float x = (i % 7) * scale;
+      float y = (i / 7) * scale;
+      float size = (2 + i % 3) * scale;
+      prior_box_data[i * 4] = x;
+      prior_box_data[i * 4 + 1] = y;
+      prior_box_data[i * 4 + 2] = x + size;
+      prior_box_data[i * 4 + 3] = y + size;
+    }
+    std::vector<float> prior_box_var_data(num_boxes_ * 4);
+    for (int i = 0; i < num_boxes_ * 4; i++) {
+      prior_box_var_data[i] = variance_[i % 4] * (1.f + (i % 5) * 0.1f);
+    }
+    std::vector<float> target_box_data(batch_size_ * num_boxes_ * 4);
+    for (int i = 0; i < target_box_data.size(); i++) {
+      target_box_data[i] = std::sin(i * 0.37f) * 0.5f;
+    }
+    std::vector<float> scores_data(batch_size_ * class_num_ * num_boxes_);
+    for (int i = 0; i < scores_data.size(); i++) {
+      scores_data[i] = std::fmod(i * 0.618034f, 1.f);
+    }
+
+    SetCommonTensor(
+        prior_box_, DDim({num_boxes_, 4}), prior_box_data.data());
+    if (with_prior_box_var_) {
+      SetCommonTensor(
+          prior_box_var_, DDim({num_boxes_, 4}), prior_box_var_data.data());
+    }
+    SetCommonTensor(target_box_,
+                    DDim({batch_size_, num_boxes_, 4}),
+                    target_box_data.data());
+    SetCommonTensor(scores_,
+                    DDim({batch_size_, class_num_, num_boxes_}),
+                    scores_data.data());
+  }
+};
+
+void test_box_coder_nms(Place place) {
+  for (int batch_size : {1, 3}) {
+    for (int class_num : {1, 4, 21}) {
+      for (int num_boxes : {1, 10, 64}) {
+        for (bool with_prior_box_var : {true, false}) {
+          for (bool box_normalized : {true, false}) {
+            for (int nms_top_k : {-1, 5}) {
+              for (int keep_top_k : {-1, 8}) {
+                for (float nms_eta : {1.f, 0.9f}) {
+                  std::unique_ptr<arena::TestCase> tester(
+                      new BoxCoderNmsComputeTester(place,
+                                                   "def",
+                                                   batch_size,
+                                                   class_num,
+                                                   num_boxes,
+                                                   with_prior_box_var,
+                                                   box_normalized,
+                                                   0,
+                                                   0.3f,
+                                                   nms_top_k,
+                                                   0.45f,
+                                                   nms_eta,
+                                                   keep_top_k));
+                  auto* test_case = tester.get();
+                  arena::Arena arena(std::move(tester), place, 2e-5);
+                  arena.TestPrecision();
+                  EXPECT_EQ(test_case->inst_scope()->FindTensor("Out")->lod(),
+                            test_case->baseline_scope()
+                                ->FindTensor("Out")
+                                ->lod());
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(BoxCoderNms, precision) {
+  Place place(TARGET(kHost), PRECISION(kFloat));
+  test_box_coder_nms(place);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/core/arena/framework.h"
@@ -50,11 +52,17 @@ class FcOPTest : public arena::TestCase {
   std::string input_ = "x";
   std::string weight_ = "w";
   std::string bias_ = "b";
+  std::string residual_ = "residual";
   std::string out_ = "out";
   DDim dims_{{1, 128}};
   DDim wdims_{{128, 4}};
   DDim bdims_{{4}};
   int in_num_col_dims_{1};
+  // The activation and the residual add fused into fc.
+  std::string act_type_;
+  bool with_residual_{false};
+  float leaky_relu_alpha_{0.1f};
+  float relu6_threshold_{6.f};
 
  public:
   FcOPTest(const Place& place,
@@ -69,6 +77,21 @@ class FcOPTest : public arena::TestCase {
         bdims_(dim_b),
         in_num_col_dims_(in_num_col_dims) {}
 
+  FcOPTest(const Place& place,
+           const std::string& alias,
+           DDim dim_in,
+           DDim dim_w,
+           DDim dim_b,
+           int in_num_col_dims,
+           const std::string& act_type,
+           bool with_residual,
+           float relu6_threshold = 6.f)
+      : FcOPTest(place, alias, dim_in, dim_w, dim_b, in_num_col_dims) {
+    act_type_ = act_type;
+    with_residual_ = with_residual;
+    relu6_threshold_ = relu6_threshold;
+  }
+
   void RunBaseline(Scope* scope) override {
     auto x = scope->FindTensor(input_);
     auto w = scope->FindTensor(weight_);
@@ -129,6 +152,25 @@ class FcOPTest : public arena::TestCase {
         fill_bias_fc(out_data, b_data, m, n);
       }
     }
+    if (with_residual_) {
+      auto residual_data = scope->FindTensor(residual_)->data<float>();
+      for (int i = 0; i < m * n; ++i) {
+        out_data[i] += residual_data[i];
+      }
+    }
+    for (int i = 0; i < m * n; ++i) {
+      float v = out_data[i];
+      if (act_type_ == "relu") {
+        v = std::max(v, 0.f);
+      } else if (act_type_ == "relu6") {
+        v = std::min(std::max(v, 0.f), relu6_threshold_);
+      } else if (act_type_ == "leaky_relu") {
+        v = v > 0.f ? v : v * leaky_relu_alpha_;
+      } else if (act_type_ == "sigmoid") {
+        v = 1.f / (1.f + std::exp(-v));
+      }
+      out_data[i] = v;
+    }
   }
 
   void PrepareOpDesc(cpp::OpDesc* op_desc) {
@@ -140,6 +182,14 @@ class FcOPTest : public arena::TestCase {
     }
     op_desc->SetOutput("Out", {out_});
     op_desc->SetAttr<int>("in_num_col_dims", in_num_col_dims_);
+    if (with_residual_) {
+      op_desc->SetInput("ResidualData", {residual_});
+    }
+    if (!act_type_.empty()) {
+      op_desc->SetAttr("activation_type", act_type_);
+      op_desc->SetAttr("leaky_relu_alpha", leaky_relu_alpha_);
+      op_desc->SetAttr("relu6_threshold", relu6_threshold_);
+    }
   }
 
   void PrepareData() override {
@@ -158,6 +208,12 @@ class FcOPTest : public arena::TestCase {
     if (flag_bias) {
       SetCommonTensor(bias_, bdims_, bin.data());
     }
+    if (with_residual_) {
+      DDim rdims = compute_out_dim(dims_, wdims_, in_num_col_dims_);
+      std::vector<float> rin(rdims.production());
+      fill_data_rand(rin.data(), -2.f, 2.f, rdims.production());
+      SetCommonTensor(residual_, rdims, rin.data());
+    }
   }
 };
 
@@ -187,6 +243,41 @@ void test_fc(Place place) {
   }
 }
 
+void test_fc_activation(Place place) {
+  for (auto& m : {1, 3, 16}) {
+    for (auto& n : {4, 33}) {
+      for (auto& act_type : {"relu", "relu6", "leaky_relu", "sigmoid"}) {
+        for (auto& with_residual : {false, true}) {
+          DDim dim_in{{m, 64}};
+          DDim wdim{{64, n}};
+          DDim bdim{{n}};
+          // A small relu6 threshold so that the clipping is reached.
+          std::unique_ptr<arena::TestCase> tester(new FcOPTest(place,
+                                                               "def",
+                                                               dim_in,
+                                                               wdim,
+                                                               bdim,
+                                                               1,
+                                                               act_type,
+                                                               with_residual,
+                                                               0.5f));
+#ifdef LITE_WITH_ARM
+          auto& ctx = tester->context()->As<ARMContext>();
+          ctx.SetRunMode(lite_api::LITE_POWER_HIGH, 1);
+#endif
+          arena::Arena arena(std::move(tester), place, 2e-5);
+          if (!arena.TestPrecision()) {
+            LOG(ERROR) << "run m: " << m << ", n: " << n
+                       << ", act: " << act_type
+                       << ", residual: " << with_residual << " failed";
+            return;
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(FcOP, precision) {
 #ifdef LITE_WITH_X86
   Place place(TARGET(kX86));
@@ -197,5 +288,14 @@ TEST(FcOP, precision) {
 #endif
 }
 
+TEST(FcOP, activation) {
+#ifdef LITE_WITH_X86
+  test_fc_activation(Place(TARGET(kX86)));
+#endif
+#ifdef LITE_WITH_ARM
+  test_fc_activation(Place(TARGET(kARM)));
+#endif
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/core/arena/framework.h"
@@ -153,60 +154,70 @@ class MatMulComputeTester : public arena::TestCase {
     CHECK(out);
 
     std::vector<int64_t> dim_out_vec;
-    if (x_dims_.size() > 2 && y_dims_.size() >= 2) {
+    if ((x_dims_.size() > 2 && y_dims_.size() >= 2) ||
+        (x_dims_.size() == 2 && y_dims_.size() > 2)) {
       // x: [B, ..., M, K], y: [B, ..., K, N], out: [B, ..., M, N]
       // x: [B, M, K], y: [K, N], out: [B, M, N]
-      dim_out_vec.resize(x_dims_.size());
-      for (size_t i = 0; i < x_dims_.size() - 2; ++i) {
-        dim_out_vec[i] = x_dims_[i];
+      // x: [M, K], y: [B, K, N], out: [B, M, N]
+      // the batch dims of x and y are broadcast.
+      size_t out_rank = std::max(x_dims_.size(), y_dims_.size());
+      size_t x_pad = out_rank - x_dims_.size();
+      size_t y_pad = out_rank - y_dims_.size();
+      dim_out_vec.resize(out_rank);
+      for (size_t i = 0; i < out_rank - 2; ++i) {
+        int64_t x_dim = i < x_pad ? 1 : x_dims_[i - x_pad];
+        int64_t y_dim = i < y_pad ? 1 : y_dims_[i - y_pad];
+        dim_out_vec[i] = std::max(x_dim, y_dim);
       }
       if (!x_transpose_ && !y_transpose_) {
-        dim_out_vec[x_dims_.size() - 2] = x_dims_[x_dims_.size() - 2];
-        dim_out_vec[x_dims_.size() - 1] = y_dims_[y_dims_.size() - 1];
+        dim_out_vec[out_rank - 2] = x_dims_[x_dims_.size() - 2];
+        dim_out_vec[out_rank - 1] = y_dims_[y_dims_.size() - 1];
       } else if (!x_transpose_ && y_transpose_) {
-        dim_out_vec[x_dims_.size() - 2] = x_dims_[x_dims_.size() - 2];
-        dim_out_vec[x_dims_.size() - 1] = y_dims_[y_dims_.size() - 2];
+        dim_out_vec[out_rank - 2] = x_dims_[x_dims_.size() - 2];
+        dim_out_vec[out_rank - 1] = y_dims_[y_dims_.size() - 2];
       } else if (x_transpose_ && !y_transpose_) {
-        dim_out_vec[x_dims_.size() - 2] = x_dims_[x_dims_.size() - 1];
-        dim_out_vec[x_dims_.size() - 1] = y_dims_[y_dims_.size() - 1];
+        dim_out_vec[out_rank - 2] = x_dims_[x_dims_.size() - 1];
+        dim_out_vec[out_rank - 1] = y_dims_[y_dims_.size() - 1];
       } else {
-        dim_out_vec[x_dims_.size() - 2] = x_dims_[x_dims_.size() - 1];
-        dim_out_vec[x_dims_.size() - 1] = y_dims_[y_dims_.size() - 2];
+        dim_out_vec[out_rank - 2] = x_dims_[x_dims_.size() - 1];
+        dim_out_vec[out_rank - 1] = y_dims_[y_dims_.size() - 2];
       }
 
       out->Resize(dim_out_vec);
       auto* out_data = out->mutable_data<float>();
-      int x_inner = x_dims_[x_dims_.size() - 2] * x_dims_[x_dims_.size() - 1];
-
-      if (y_dims_.size() > 2) {
-        int y_inner = y_dims_[y_dims_.size() - 2] * y_dims_[y_dims_.size() - 1];
-        int o_inner =
-            dim_out_vec[x_dims_.size() - 2] * dim_out_vec[x_dims_.size() - 1];
-        for (size_t i = 0; i < x_dims_.count(0, x_dims_.size() - 2); ++i) {
-          mul_low_efficiency(
-              DDim({x_dims_[x_dims_.size() - 2], x_dims_[x_dims_.size() - 1]}),
-              DDim({y_dims_[y_dims_.size() - 2], y_dims_[y_dims_.size() - 1]}),
-              x_transpose_,
-              y_transpose_,
-              alpha_,
-              x_data + i * x_inner,
-              y_data + i * y_inner,
-              out_data + i * o_inner);
-        }
-      } else {
-        int o_inner =
-            dim_out_vec[x_dims_.size() - 2] * dim_out_vec[x_dims_.size() - 1];
-        for (size_t i = 0; i < x_dims_.count(0, x_dims_.size() - 2); ++i) {
-          mul_low_efficiency(
-              DDim({x_dims_[x_dims_.size() - 2], x_dims_[x_dims_.size() - 1]}),
-              y_dims_,
-              x_transpose_,
-              y_transpose_,
-              alpha_,
-              x_data + i * x_inner,
-              y_data,
-              out_data + i * o_inner);
+      DDim out_dims(dim_out_vec);
+      DDim x_mat({x_dims_[x_dims_.size() - 2], x_dims_[x_dims_.size() - 1]});
+      DDim y_mat({y_dims_[y_dims_.size() - 2], y_dims_[y_dims_.size() - 1]});
+      int o_inner = dim_out_vec[out_rank - 2] * dim_out_vec[out_rank - 1];
+      for (int64_t i = 0; i < out_dims.count(0, out_rank - 2); ++i) {
+        // find the matrices of x and y of the batch i of out.
+        int64_t x_index = 0;
+        int64_t y_index = 0;
+        int64_t x_stride = 1;
+        int64_t y_stride = 1;
+        int64_t remain = i;
+        for (int d = static_cast<int>(out_rank) - 3; d >= 0; --d) {
+          int64_t index = remain % dim_out_vec[d];
+          remain /= dim_out_vec[d];
+          if (d >= static_cast<int>(x_pad)) {
+            int64_t x_dim = x_dims_[d - x_pad];
+            x_index += (x_dim == 1 ? 0 : index) * x_stride;
+            x_stride *= x_dim;
+          }
+          if (d >= static_cast<int>(y_pad)) {
+            int64_t y_dim = y_dims_[d - y_pad];
+            y_index += (y_dim == 1 ? 0 : index) * y_stride;
+            y_stride *= y_dim;
+          }
         }
+        mul_low_efficiency(x_mat,
+                           y_mat,
+                           x_transpose_,
+                           y_transpose_,
+                           alpha_,
+                           x_data + x_index * x_mat.production(),
+                           y_data + y_index * y_mat.production(),
+                           out_data + i * o_inner);
       }
     } else if (x_dims_.size() == 2 && y_dims_.size() == 2) {
       // x: [M, K], y: [K, N], out: [M, N]
@@ -501,6 +512,27 @@ void test_matmulnxn_transpose(Place place) {
   }
 }
 
+void test_matmul_broadcast(Place place) {
+  std::vector<DDim> x_dims(
+      {DDim({2, 1, 5, 3}), DDim({4, 3}), DDim({3, 1, 4, 6, 4})});
+  std::vector<DDim> y_dims(
+      {DDim({4, 3, 6}), DDim({2, 3, 4, 5}), DDim({2, 1, 5, 6})});
+  std::vector<bool> x_transposes({false, true, true});
+  std::vector<bool> y_transposes({false, false, true});
+  for (int i = 0; i < x_dims.size(); ++i) {
+    std::unique_ptr<arena::TestCase> tester(
+        new MatMulComputeTester(place,
+                                "def",
+                                x_transposes[i],
+                                y_transposes[i],
+                                1.5f,
+                                x_dims[i],
+                                y_dims[i]));
+    arena::Arena arena(std::move(tester), place, 1e-3);
+    arena.TestPrecision();
+  }
+}
+
 TEST(Matmul2x2, precision) {
 #ifdef LITE_WITH_X86
   Place place(TARGET(kX86));
@@ -588,5 +620,16 @@ TEST(Matmulnxn, precision) {
 #endif
 }
 
+TEST(Matmul_broadcast, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86));
+  test_matmul_broadcast(place);
+#endif
+#ifdef LITE_WITH_ARM
+  Place place(TARGET(kARM));
+  test_matmul_broadcast(place);
+#endif
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -20,7 +20,16 @@
 namespace paddle {
 namespace lite {
 
-void reduce_n(const float* src,
+// The references of reduce_max, reduce_min and reduce_prod only differ in
+// how two values are combined.
+typedef float (*ReduceFunc)(float, float);
+
+float reduce_max_func(float a, float b) { return a > b ? a : b; }
+float reduce_min_func(float a, float b) { return a < b ? a : b; }
+float reduce_prod_func(float a, float b) { return a * b; }
+
+void reduce_n(ReduceFunc op,
+              const float* src,
               float* dst,
               int num_in,
               int channel_in,
@@ -36,15 +45,15 @@ void reduce_n(const float* src,
         dst[data_index] = src[data_index];
         for (int n = 1; n < num_in; ++n) {
           src_index = n * chw_size + data_index;
-          dst[data_index] = dst[data_index] > src[src_index] ? dst[data_index]
-                                                             : src[src_index];
+          dst[data_index] = op(dst[data_index], src[src_index]);
         }
       }
     }
   }
 }
 
-void reduce_c(const float* src,
+void reduce_c(ReduceFunc op,
+              const float* src,
               float* dst,
               int num_in,
               int channel_in,
@@ -61,15 +70,15 @@ void reduce_c(const float* src,
         dst[data_index] = src[src_index0];
         for (int c = 1; c < channel_in; ++c) {
           src_index = src_index0 + c * hw_size;
-          dst[data_index] = dst[data_index] > src[src_index] ? dst[data_index]
-                                                             : src[src_index];
+          dst[data_index] = op(dst[data_index], src[src_index]);
         }
       }
     }
   }
 }
 
-void reduce_h(const float* src,
+void reduce_h(ReduceFunc op,
+              const float* src,
               float* dst,
               int num_in,
               int channel_in,
@@ -87,15 +96,15 @@ void reduce_h(const float* src,
         dst[data_index] = src[src_index0];
         for (int h = 1; h < height_in; ++h) {
           src_index = src_index0 + h * width_in;
-          dst[data_index] = dst[data_index] > src[src_index] ? dst[data_index]
-                                                             : src[src_index];
+          dst[data_index] = op(dst[data_index], src[src_index]);
         }
       }
     }
   }
 }
 
-void reduce_w(const float* src,
+void reduce_w(ReduceFunc op,
+              const float* src,
               float* dst,
               int num_in,
               int channel_in,
@@ -113,39 +122,30 @@ void reduce_w(const float* src,
         dst[data_index] = src[src_index0];
         for (int w = 1; w < width_in; ++w) {
           src_index = src_index0 + w;
-          dst[data_index] = dst[data_index] > src[src_index] ? dst[data_index]
-                                                             : src[src_index];
+          dst[data_index] = op(dst[data_index], src[src_index]);
         }
       }
     }
   }
 }
 
-void reduce_all(const float* src,
+void reduce_all(ReduceFunc op,
+                const float* src,
                 float* dst,
                 int num_in,
                 int channel_in,
                 int height_in,
                 int width_in) {
-  float max = src[0];
-  int src_index;
-  int n_id, c_id;
-  for (int n = 0; n < num_in; ++n) {
-    n_id = n * channel_in * height_in * width_in;
-    for (int c = 0; c < channel_in; ++c) {
-      c_id = c * height_in * width_in;
-      for (int h = 0; h < height_in; ++h) {
-        for (int w = 0; w < width_in; ++w) {
-          src_index = n_id + c_id + h * width_in + w;
-          max = src[src_index] > max ? src[src_index] : max;
-        }
-      }
-    }
+  int size = num_in * channel_in * height_in * width_in;
+  float result = src[0];
+  for (int i = 1; i < size; ++i) {
+    result = op(result, src[i]);
   }
-  dst[0] = max;
+  dst[0] = result;
 }
 
-void reduce_nc(const float* src,
+void reduce_nc(ReduceFunc op,
+               const float* src,
                float* dst,
                int num_in,
                int channel_in,
@@ -156,11 +156,12 @@ void reduce_nc(const float* src,
   lite::Tensor tensor_tmp;
   tensor_tmp.Resize(ddimA);
   float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_n(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_c(tmp_out, dst, 1, channel_in, height_in, width_in);
+  reduce_n(op, src, tmp_out, num_in, channel_in, height_in, width_in);
+  reduce_c(op, tmp_out, dst, 1, channel_in, height_in, width_in);
 }
 
-void reduce_ch(const float* src,
+void reduce_ch(ReduceFunc op,
+               const float* src,
                float* dst,
                int num_in,
                int channel_in,
@@ -171,11 +172,12 @@ void reduce_ch(const float* src,
   lite::Tensor tensor_tmp;
   tensor_tmp.Resize(ddimA);
   float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_c(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_h(tmp_out, dst, num_in, 1, height_in, width_in);
+  reduce_c(op, src, tmp_out, num_in, channel_in, height_in, width_in);
+  reduce_h(op, tmp_out, dst, num_in, 1, height_in, width_in);
 }
 
-void reduce_hw(const float* src,
+void reduce_hw(ReduceFunc op,
+               const float* src,
                float* dst,
                int num_in,
                int channel_in,
@@ -186,8 +188,8 @@ void reduce_hw(const float* src,
   lite::Tensor tensor_tmp;
   tensor_tmp.Resize(ddimA);
   float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_h(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_w(tmp_out, dst, num_in, channel_in, 1, width_in);
+  reduce_h(op, src, tmp_out, num_in, channel_in, height_in, width_in);
+  reduce_w(op, tmp_out, dst, num_in, channel_in, 1, width_in);
 }
 
 class ReduceMaxComputeTester : public arena::TestCase {
@@ -195,6 +197,7 @@ class ReduceMaxComputeTester : public arena::TestCase {
   // common attributes for this op.
   std::string input_ = "x";
   std::string output_ = "out";
+  std::string op_type_ = "reduce_max";
   std::vector<int> dim_{0};
   bool keep_dim_ = false;
   bool reduce_all_ = false;
@@ -203,10 +206,12 @@ class ReduceMaxComputeTester : public arena::TestCase {
  public:
   ReduceMaxComputeTester(const Place& place,
                          const std::string& alias,
+                         const std::string& op_type,
                          std::vector<int> dim,
                          bool keep_dim,
                          DDim x_dims)
       : TestCase(place, alias),
+        op_type_(op_type),
         dim_(dim),
         keep_dim_(keep_dim),
         x_dims_(x_dims) {}
@@ -255,6 +260,12 @@ class ReduceMaxComputeTester : public arena::TestCase {
       out->Resize(DDim(out_dims));
     }
 
+    ReduceFunc op = reduce_max_func;
+    if (op_type_ == "reduce_min") {
+      op = reduce_min_func;
+    } else if (op_type_ == "reduce_prod") {
+      op = reduce_prod_func;
+    }
     auto* out_data = out->mutable_data<float>();
     int in_n = x_dims_[0];
     int in_c = x_dims_[1];
@@ -262,31 +273,31 @@ class ReduceMaxComputeTester : public arena::TestCase {
     int in_w = x_dims_[3];
 
     if (dim_.size() == 0) {
-      reduce_all(x_data, out_data, in_n, in_c, in_h, in_w);
+      reduce_all(op, x_data, out_data, in_n, in_c, in_h, in_w);
     } else if (dim_.size() == 1) {
       switch (dim_[0]) {
         case 0:
-          reduce_n(x_data, out_data, in_n, in_c, in_h, in_w);
+          reduce_n(op, x_data, out_data, in_n, in_c, in_h, in_w);
           break;
         case 1:
-          reduce_c(x_data, out_data, in_n, in_c, in_h, in_w);
+          reduce_c(op, x_data, out_data, in_n, in_c, in_h, in_w);
           break;
         case 2:
-          reduce_h(x_data, out_data, in_n, in_c, in_h, in_w);
+          reduce_h(op, x_data, out_data, in_n, in_c, in_h, in_w);
           break;
         case 3:
-          reduce_w(x_data, out_data, in_n, in_c, in_h, in_w);
+          reduce_w(op, x_data, out_data, in_n, in_c, in_h, in_w);
           break;
         default:
           LOG(FATAL) << "error!!!";
       }
     } else if (dim_.size() == 2) {
       if (dim_[0] == 0 && dim_[1] == 1) {
-        reduce_nc(x_data, out_data, in_n, in_c, in_h, in_w);
+        reduce_nc(op, x_data, out_data, in_n, in_c, in_h, in_w);
       } else if (dim_[0] == 1 && dim_[1] == 2) {
-        reduce_ch(x_data, out_data, in_n, in_c, in_h, in_w);
+        reduce_ch(op, x_data, out_data, in_n, in_c, in_h, in_w);
       } else if (dim_[0] == 2 && dim_[1] == 3) {
-        reduce_hw(x_data, out_data, in_n, in_c, in_h, in_w);
+        reduce_hw(op, x_data, out_data, in_n, in_c, in_h, in_w);
       } else {
         LOG(FATAL) << "invalid dims_!!";
       }
@@ -294,23 +305,25 @@ class ReduceMaxComputeTester : public arena::TestCase {
   }
 
   void PrepareOpDesc(cpp::OpDesc* op_desc) {
-    op_desc->SetType("reduce_max");
+    op_desc->SetType(op_type_);
     op_desc->SetInput("X", {input_});
     op_desc->SetOutput("Out", {output_});
     op_desc->SetAttr("dim", dim_);
     op_desc->SetAttr("keep_dim", keep_dim_);
+    op_desc->SetAttr("reduce_all", reduce_all_);
   }
 
   void PrepareData() override {
     std::vector<float> data(x_dims_.production());
     for (int i = 0; i < x_dims_.production(); i++) {
-      data[i] = i * 1.0;
+      // Keep the products around 1.
+      data[i] = op_type_ == "reduce_prod" ? 1.f + 0.01f * (i % 7 - 3) : i * 1.0;
     }
     SetCommonTensor(input_, x_dims_, data.data());
   }
 };
 
-void test_reduce_max(Place place) {
+void test_reduce(Place place, const std::string& op_type) {
   std::vector<std::vector<int>> reduce_dim{
       {0}, {1}, {2}, {3}, {0, 1}, {1, 2}, {2, 3}, {-2, -1}};
   for (auto n : {1, 3}) {
@@ -322,7 +335,7 @@ void test_reduce_max(Place place) {
               auto x_dims = DDim(std::vector<int64_t>({n, c, h, w}));
               std::unique_ptr<arena::TestCase> tester(
                   new ReduceMaxComputeTester(
-                      place, "def", dim, keep_dim, x_dims));
+                      place, "def", op_type, dim, keep_dim, x_dims));
               arena::Arena arena(std::move(tester), place, 2e-5);
               arena.TestPrecision();
             }
@@ -334,12 +347,27 @@ void test_reduce_max(Place place) {
 }
 
 TEST(ReduceMax, precision) {
-// #ifdef LITE_WITH_X86
-//   Place place(TARGET(kX86));
-// #endif
+#ifdef LITE_WITH_X86
+  test_reduce(Place(TARGET(kX86)), "reduce_max");
+#endif
 #ifdef LITE_WITH_ARM
   Place place(TARGET(kARM));
-  test_reduce_max(place);
+  test_reduce(place, "reduce_max");
+#endif
+}
+
+// reduce_min and reduce_prod have host and x86 kernels only.
+TEST(ReduceMin, precision) {
+  test_reduce(Place(TARGET(kHost)), "reduce_min");
+#ifdef LITE_WITH_X86
+  test_reduce(Place(TARGET(kX86)), "reduce_min");
+#endif
+}
+
+TEST(ReduceProd, precision) {
+  test_reduce(Place(TARGET(kHost)), "reduce_prod");
+#ifdef LITE_WITH_X86
+  test_reduce(Place(TARGET(kX86)), "reduce_prod");
 #endif
 }
 
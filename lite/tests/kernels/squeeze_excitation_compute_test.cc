@@ -0,0 +1,201 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/arena/framework.h"
+
+namespace paddle {
+namespace lite {
+
+float se_act(const std::string& type, float v) {
+  if (type == "relu") return std::max(v, 0.f);
+  if (type == "swish") return v / (1.f + std::exp(-v));
+  if (type == "hard_swish") {
+    return v * std::min(std::max(v + 3.f, 0.f), 6.f) / 6.f;
+  }
+  if (type == "sigmoid") return 1.f / (1.f + std::exp(-v));
+  if (type == "hard_sigmoid") {
+    return std::min(std::max(v * 0.2f + 0.5f, 0.f), 1.f);
+  }
+  LOG(FATAL) << "unknown activation " << type;
+  return v;
+}
+
+class SqueezeExcitationComputeTester : public arena::TestCase {
+ protected:
+  // common attributes for this op.
+  std::string input_ = "x";
+  std::string squeeze_weight_ = "squeeze_weight";
+  std::string squeeze_bias_ = "squeeze_bias";
+  std::string excite_weight_ = "excite_weight";
+  std::string excite_bias_ = "excite_bias";
+  std::string output_ = "out";
+  DDim dims_;
+  int hidden_;
+  bool conv_weight_;
+  std::string squeeze_act_type_;
+  std::string excite_act_type_;
+
+ public:
+  SqueezeExcitationComputeTester(const Place& place,
+                                 const std::string& alias,
+                                 DDim dims,
+                                 int hidden,
+                                 bool conv_weight,
+                                 const std::string& squeeze_act_type,
+                                 const std::string& excite_act_type)
+      : TestCase(place, alias),
+        dims_(dims),
+        hidden_(hidden),
+        conv_weight_(conv_weight),
+        squeeze_act_type_(squeeze_act_type),
+        excite_act_type_(excite_act_type) {}
+
+  // The weight from the input i to the output o of a layer.
+  float weight(const Tensor* w, int in, int out, int i, int o) {
+    return conv_weight_ ? w->data<float>()[o * in + i]
+                        : w->data<float>()[i * out + o];
+  }
+
+  void RunBaseline(Scope* scope) override {
+    auto* out = scope->NewTensor(output_);
+    CHECK(out);
+    out->Resize(dims_);
+    auto* out_data = out->mutable_data<float>();
+    auto* x_data = scope->FindTensor(input_)->data<float>();
+    auto* w1 = scope->FindTensor(squeeze_weight_);
+    auto* b1 = scope->FindTensor(squeeze_bias_)->data<float>();
+    auto* w2 = scope->FindTensor(excite_weight_);
+    auto* b2 = scope->FindTensor(excite_bias_)->data<float>();
+
+    int channels = dims_[1];
+    int size = dims_[2] * dims_[3];
+    for (int n = 0; n < dims_[0]; ++n) {
+      const float* x = x_data + n * channels * size;
+      float* y = out_data + n * channels * size;
+      std::vector<float> pooled(channels, 0.f);
+      for (int c = 0; c < channels; ++c) {
+        for (int i = 0; i < size; ++i) {
+          pooled[c] += x[c * size + i];
+        }
+        pooled[c] /= size;
+      }
+      std::vector<float> hidden(hidden_);
+      for (int o = 0; o < hidden_; ++o) {
+        float v = b1[o];
+        for (int c = 0; c < channels; ++c) {
+          v += pooled[c] * weight(w1, channels, hidden_, c, o);
+        }
+        hidden[o] = se_act(squeeze_act_type_, v);
+      }
+      for (int c = 0; c < channels; ++c) {
+        float v = b2[c];
+        for (int i = 0; i < hidden_; ++i) {
+          v += hidden[i] * weight(w2, hidden_, channels, i, c);
+        }
+        float gate = se_act(excite_act_type_, v);
+        for (int i = 0; i < size; ++i) {
+          y[c * size + i] = x[c * size + i] * gate;
+        }
+      }
+    }
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("fusion_squeeze_excitation");
+    op_desc->SetInput("X", {input_});
+    op_desc->SetInput("SqueezeWeight", {squeeze_weight_});
+    op_desc->SetInput("SqueezeBias", {squeeze_bias_});
+    op_desc->SetInput("ExciteWeight", {excite_weight_});
+    op_desc->SetInput("ExciteBias", {excite_bias_});
+    op_desc->SetOutput("Out", {output_});
+    op_desc->SetAttr("conv_weight", conv_weight_);
+    op_desc->SetAttr("squeeze_act_type", squeeze_act_type_);
+    op_desc->SetAttr("excite_act_type", excite_act_type_);
+    op_desc->SetAttr("swish_beta", 1.f);
+    op_desc->SetAttr("hard_swish_threshold", 6.f);
+    op_desc->SetAttr("hard_swish_scale", 6.f);
+    op_desc->SetAttr("hard_swish_offset", 3.f);
+    op_desc->SetAttr("hard_sigmoid_slope", 0.2f);
+    op_desc->SetAttr("hard_sigmoid_offset", 0.5f);
+  }
+
+  void PrepareData() override {
+    auto fill = [](int64_t size, float scale) {
+      std::vector<float> data(size);
+      for (int64_t i = 0; i < size; ++i) {
+        float sign = i % 3 == 0 ? -1.f : 1.f;
+        data[i] = sign * static_cast<float>(i % 17) * scale;
+      }
+      return data;
+    };
+    int channels = dims_[1];
+    auto x = fill(dims_.production(), 0.13f);
+    SetCommonTensor(input_, dims_, x.data());
+
+    std::vector<int64_t> squeeze_shape{channels, hidden_};
+    std::vector<int64_t> excite_shape{hidden_, channels};
+    if (conv_weight_) {
+      squeeze_shape = {hidden_, channels, 1, 1};
+      excite_shape = {channels, hidden_, 1, 1};
+    }
+    DDim squeeze_dims(squeeze_shape);
+    DDim excite_dims(excite_shape);
+    auto w1 = fill(squeeze_dims.production(), 0.05f);
+    auto b1 = fill(hidden_, 0.1f);
+    auto w2 = fill(excite_dims.production(), 0.07f);
+    auto b2 = fill(channels, 0.1f);
+    SetCommonTensor(squeeze_weight_, squeeze_dims, w1.data());
+    SetCommonTensor(squeeze_bias_, DDim({hidden_}), b1.data());
+    SetCommonTensor(excite_weight_, excite_dims, w2.data());
+    SetCommonTensor(excite_bias_, DDim({channels}), b2.data());
+  }
+};
+
+TEST(SqueezeExcitation, precision) {
+  Place place(TARGET(kHost));
+  for (auto conv_weight : {true, false}) {
+    for (auto acts : std::vector<std::vector<std::string>>{
+             {"relu", "hard_sigmoid"},
+             {"swish", "sigmoid"},
+             {"hard_swish", "hard_sigmoid"}}) {
+      for (auto n : {1, 2}) {
+        for (auto c : {8, 24}) {
+          for (auto hw : {1, 7, 14}) {
+            std::unique_ptr<arena::TestCase> tester(
+                new SqueezeExcitationComputeTester(
+                    place,
+                    "def",
+                    DDim(std::vector<int64_t>({n, c, hw, hw})),
+                    c / 4,
+                    conv_weight,
+                    acts[0],
+                    acts[1]));
+            arena::Arena arena(std::move(tester), place, 2e-5);
+            arena.TestPrecision();
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,127 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/gemm_epilogue.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/tests/utils/fill_data.h"
+
+namespace paddle {
+namespace lite {
+
+using host::math::GemmEpilogue;
+using lite_api::ActivationType;
+
+// The epilogue of one value, written out without the template dispatch.
+float ref_epilogue(const GemmEpilogue& ep, float v, int i, int j) {
+  const int c = ep.channel_is_row ? i : j;
+  if (ep.scale) v *= ep.scale[c];
+  if (ep.bias) v += ep.bias[c];
+  if (ep.residual) v += ep.residual[i * ep.ldr + j];
+  switch (ep.act) {
+    case ActivationType::kRelu:
+      return v > 0.f ? v : 0.f;
+    case ActivationType::kRelu6:
+      return std::min(std::max(v, 0.f), ep.relu6_threshold);
+    case ActivationType::kLeakyRelu:
+      return v > 0.f ? v : v * ep.leaky_alpha;
+    case ActivationType::kSigmoid:
+      return 1.f / (1.f + std::exp(-v));
+    case ActivationType::kSwish:
+      return v / (1.f + std::exp(-ep.swish_beta * v));
+    case ActivationType::kHardSigmoid:
+      return std::min(
+          std::max(v * ep.hard_sigmoid_slope + ep.hard_sigmoid_offset, 0.f),
+          1.f);
+    case ActivationType::kHardSwish:
+      return v *
+             std::min(std::max(v + ep.hard_swish_offset, 0.f),
+                      ep.hard_swish_threshold) /
+             ep.hard_swish_scale;
+    default:
+      return v;
+  }
+}
+
+TEST(GemmEpilogue, precision) {
+  const int m = 7;
+  const int n = 13;
+  const int ldc = n + 3;
+  const int ldr = n + 5;
+  std::vector<float> c(m * ldc);
+  std::vector<float> scale(std::max(m, n));
+  std::vector<float> bias(std::max(m, n));
+  std::vector<float> residual(m * ldr);
+  fill_data_rand(c.data(), -4.f, 4.f, c.size());
+  fill_data_rand(scale.data(), 0.5f, 1.5f, scale.size());
+  fill_data_rand(bias.data(), -1.f, 1.f, bias.size());
+  fill_data_rand(residual.data(), -2.f, 2.f, residual.size());
+
+  for (auto act : {ActivationType::kIndentity,
+                   ActivationType::kRelu,
+                   ActivationType::kRelu6,
+                   ActivationType::kLeakyRelu,
+                   ActivationType::kSigmoid,
+                   ActivationType::kSwish,
+                   ActivationType::kHardSigmoid,
+                   ActivationType::kHardSwish}) {
+    for (bool channel_is_row : {true, false}) {
+      for (bool with_scale : {false, true}) {
+        for (bool with_residual : {false, true}) {
+          GemmEpilogue ep;
+          ep.scale = with_scale ? scale.data() : nullptr;
+          ep.bias = bias.data();
+          ep.channel_is_row = channel_is_row;
+          ep.residual = with_residual ? residual.data() : nullptr;
+          ep.ldr = ldr;
+          ep.act = act;
+          ep.leaky_alpha = 0.2f;
+          ep.relu6_threshold = 1.5f;
+          ep.swish_beta = 0.8f;
+
+          // Only the block [m0, m1) x [n0, n1) is changed.
+          const int m0 = 1, m1 = 6, n0 = 2, n1 = 11;
+          std::vector<float> out(c);
+          host::math::apply_gemm_epilogue(ep, m0, m1, n0, n1, out.data(), ldc);
+          for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < ldc; ++j) {
+              const bool inside = i >= m0 && i < m1 && j >= n0 && j < n1;
+              float ref = inside ? ref_epilogue(ep, c[i * ldc + j], i, j)
+                                 : c[i * ldc + j];
+              ASSERT_NEAR(out[i * ldc + j], ref, 1e-5f)
+                  << "act: " << static_cast<int>(act) << ", row channels: "
+                  << channel_is_row << ", scale: " << with_scale
+                  << ", residual: " << with_residual << ", at " << i << ", "
+                  << j;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(GemmEpilogue, empty) {
+  GemmEpilogue ep;
+  EXPECT_TRUE(ep.empty());
+  ep.act = host::math::epilogue_act_type("relu6");
+  EXPECT_EQ(ep.act, ActivationType::kRelu6);
+  EXPECT_FALSE(ep.empty());
+  EXPECT_EQ(host::math::epilogue_act_type(""), ActivationType::kIndentity);
+}
+
+}  // namespace lite
+}  // namespace paddle
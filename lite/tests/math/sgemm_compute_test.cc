@@ -14,11 +14,18 @@
 
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 #include "lite/tests/utils/fill_data.h"
 #include "lite/tests/utils/naive_math_impl.h"
 #ifdef LITE_WITH_ARM
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/gemm_epilogue.h"
 #endif  // LITE_WITH_ARM
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/math/packed_sgemm.h"
+#endif  // LITE_WITH_X86
 #include "lite/core/context.h"
 #include "lite/core/tensor.h"
 #include "lite/tests/utils/tensor_utils.h"
@@ -196,7 +203,35 @@ bool test_sgemm(bool tra,
             << " ms, mean GOPs: " << ops * 1e-6f / t0.get_average_ms()
             << " GOPs, max GOPs: " << ops * 1e-6f / t0.get_min_time()
             << " GOPs";
+#elif defined(LITE_WITH_X86)
+  // The x86 sgemm has no bias and relu, they are fused by the kernels.
+  if (has_bias || has_relu) {
+    return true;
+  }
+  double ops = 2.0 * m * n * k;
+  paddle::lite::DeviceInfo::Global().SetRunMode(
+      static_cast<paddle::lite_api::PowerMode>(cls), ths);
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    paddle::lite::x86::math::sgemm(
+        tra, trb, m, n, k, alpha, da, lda, db, ldb, beta, dc, ldc);
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    if (i == FLAGS_repeats - 1) {
+      memcpy(dc, dc_backup, sizeof(float) * m * ldc);
+    }
+    t0.start();
+    paddle::lite::x86::math::sgemm(
+        tra, trb, m, n, k, alpha, da, lda, db, ldb, beta, dc, ldc);
+    t0.end();
+  }
+  LOG(INFO) << "M: " << m << ", N: " << n << ", K: " << k
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", avg time: " << t0.get_average_ms()
+            << " ms, mean GOPs: " << ops * 1e-6f / t0.get_average_ms()
+            << " GOPs";
+#endif
 
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
   if (FLAGS_check_result) {
     double max_ratio = 0;
     double max_diff = 0;
@@ -227,9 +262,127 @@ bool test_sgemm(bool tra,
   return true;
 }
 
+#ifdef LITE_WITH_ARM
+// sgemm_prepack with an epilogue against basic_gemm followed by the host
+// epilogue. The bias and relu alone go to the inner kernels, the rest is
+// applied to each block of C.
+bool test_sgemm_epilogue(int m,
+                         int n,
+                         int k,
+                         float beta,
+                         bool has_scale,
+                         bool has_residual,
+                         paddle::lite_api::ActivationType act,
+                         int ths) {
+  std::vector<float> a(m * k);
+  std::vector<float> b(k * n);
+  std::vector<float> c(m * n);
+  std::vector<float> scale(m);
+  std::vector<float> bias(m);
+  std::vector<float> residual(m * (n + 2));
+  fill_data_rand(a.data(), -1.f, 1.f, a.size());
+  fill_data_rand(b.data(), -1.f, 1.f, b.size());
+  fill_data_rand(c.data(), -1.f, 1.f, c.size());
+  fill_data_rand(scale.data(), 0.5f, 1.5f, scale.size());
+  fill_data_rand(bias.data(), -1.f, 1.f, bias.size());
+  fill_data_rand(residual.data(), -1.f, 1.f, residual.size());
+
+  paddle::lite::host::math::GemmEpilogue ep;
+  ep.scale = has_scale ? scale.data() : nullptr;
+  ep.bias = bias.data();
+  ep.residual = has_residual ? residual.data() : nullptr;
+  ep.ldr = n + 2;
+  ep.act = act;
+  ep.leaky_alpha = 0.1f;
+  ep.relu6_threshold = 1.f;
+
+  std::vector<float> c_basic(c);
+  basic_gemm(false,
+             false,
+             m,
+             n,
+             k,
+             1.f,
+             a.data(),
+             k,
+             b.data(),
+             n,
+             beta,
+             c_basic.data(),
+             n,
+             static_cast<float*>(nullptr),
+             false,
+             false);
+  paddle::lite::host::math::apply_gemm_epilogue(
+      ep, 0, m, 0, n, c_basic.data(), n);
+
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(paddle::lite_api::LITE_POWER_NO_BIND, ths);
+  int hblock = paddle::lite::arm::math::get_hblock(&ctx);
+  int round_up_a = ((hblock + m - 1) / hblock) * hblock;
+  std::vector<float> packed_a(round_up_a * k);
+  paddle::lite::arm::math::prepackA(
+      packed_a.data(), a.data(), 1.f, k, 0, m, 0, k, false, &ctx);
+  paddle::lite::arm::math::sgemm_prepack(false,
+                                         m,
+                                         n,
+                                         k,
+                                         packed_a.data(),
+                                         b.data(),
+                                         n,
+                                         beta,
+                                         c.data(),
+                                         n,
+                                         ep,
+                                         &ctx);
+  for (int i = 0; i < m * n; ++i) {
+    if (std::abs(c[i] - c_basic[i]) > 1e-4f * std::max(1.f, std::abs(c[i]))) {
+      LOG(INFO) << "at " << i << ", lite: " << c[i]
+                << ", basic: " << c_basic[i];
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestSgemm, test_func_sgemm_prepacked_epilogue) {
+  paddle::lite::DeviceInfo::Init();
+  using paddle::lite_api::ActivationType;
+  for (auto& m : {1, 5, 13}) {
+    for (auto& n : {3, 17, 40}) {
+      for (auto& k : {7, 33}) {
+        for (auto& beta : {0.f, 0.5f}) {
+          for (auto& has_scale : {false, true}) {
+            for (auto& has_residual : {false, true}) {
+              for (auto act : {ActivationType::kIndentity,
+                               ActivationType::kRelu,
+                               ActivationType::kRelu6,
+                               ActivationType::kLeakyRelu,
+                               ActivationType::kSigmoid}) {
+                for (auto& th : {1, 2}) {
+                  EXPECT_TRUE(test_sgemm_epilogue(
+                      m, n, k, beta, has_scale, has_residual, act, th))
+                      << "m: " << m << ", n: " << n << ", k: " << k
+                      << ", beta: " << beta << ", scale: " << has_scale
+                      << ", residual: " << has_residual
+                      << ", act: " << static_cast<int>(act)
+                      << ", threads: " << th;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif  // LITE_WITH_ARM
+
 TEST(TestSgemm, test_func_sgemm_prepacked) {
   if (FLAGS_basic_test) {
-#ifdef LITE_WITH_ARM
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
     paddle::lite::DeviceInfo::Init();
 #endif
     LOG(INFO) << "run basic sgemm test";
@@ -301,7 +454,7 @@ TEST(TestSgemm, test_func_sgemm_prepacked) {
 }
 
 TEST(TestSgemmCustom, test_func_sgemm_prepacked_custom) {
-#ifdef LITE_WITH_ARM
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
   paddle::lite::DeviceInfo::Init();
 #endif
   int lda = FLAGS_K + FLAGS_offset_a;
@@ -0,0 +1,99 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// The peaks of one core measured with simple loops, which the compiler
+// vectorizes with the instruction set the library is built with. They are the
+// roofs the kernels are compared against, not the hardware specifications.
+struct MachinePeaks {
+  double gflops{0.};
+  double gbps{0.};
+};
+
+inline double ElapsedSeconds(
+    const std::chrono::high_resolution_clock::time_point& start) {
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+// Multiply-adds on independent accumulators, so they are not bound by the
+// latency of the instructions.
+inline double MeasurePeakGflops(int repeats = 5) {
+  const int kLanes = 128;
+  const int kIters = 1 << 20;
+  std::vector<float> acc(kLanes, 1.f);
+  float* data = acc.data();
+  const float a = 0.999999f;
+  const float b = 1e-6f;
+  double best = 0.;
+  for (int r = 0; r < repeats; r++) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kIters; i++) {
+      for (int j = 0; j < kLanes; j++) {
+        data[j] = data[j] * a + b;
+      }
+    }
+    double seconds = ElapsedSeconds(start);
+    best = std::max(best, 2. * kLanes * kIters / seconds * 1e-9);
+  }
+  // Keep the result alive.
+  volatile float sink = acc[0];
+  (void)sink;
+  return best;
+}
+
+// STREAM triad on the buffers larger than the last level cache.
+inline double MeasurePeakGbps(int repeats = 5) {
+  const size_t kSize = 8 << 20;
+  std::vector<float> a(kSize, 0.f);
+  std::vector<float> b(kSize, 1.f);
+  std::vector<float> c(kSize, 2.f);
+  const float scale = 3.f;
+  double best = 0.;
+  for (int r = 0; r < repeats; r++) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < kSize; i++) {
+      a[i] = b[i] + scale * c[i];
+    }
+    double seconds = ElapsedSeconds(start);
+    best = std::max(best, 3. * sizeof(float) * kSize / seconds * 1e-9);
+  }
+  volatile float sink = a[kSize / 2];
+  (void)sink;
+  return best;
+}
+
+inline MachinePeaks MeasureMachinePeaks() {
+  MachinePeaks peaks;
+  peaks.gflops = MeasurePeakGflops();
+  peaks.gbps = MeasurePeakGbps();
+  return peaks;
+}
+
+// The performance the roofline model allows for a kernel with the given
+// arithmetic intensity (flops per byte).
+inline double AttainableGflops(const MachinePeaks& peaks, double intensity) {
+  return std::min(peaks.gflops, intensity * peaks.gbps);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,175 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// x86 implementation of image2tensor.cc, the SIMD paths use SSSE3 and the
+// other targets fall back to plain loops.
+#include "lite/utils/cv/image2tensor.h"
+#include <string.h>
+#include "lite/utils/cv/image_sse.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+/*
+ * normalize the first three channels of an interleaved image,
+ * out = (in - means) * scales, the alpha channel of a 4-channel image is
+ * dropped
+ */
+template <int kIn>
+void hwc_to_tensor_chw(const uint8_t* src,
+                       float* output,
+                       int width,
+                       int height,
+                       float* means,
+                       float* scales) {
+  int size = width * height;
+  float* ptr_c0 = output;
+  float* ptr_c1 = ptr_c0 + size;
+  float* ptr_c2 = ptr_c1 + size;
+  int i = 0;
+#ifdef __SSSE3__
+  const __m128 vmean0 = _mm_set1_ps(means[0]);
+  const __m128 vmean1 = _mm_set1_ps(means[1]);
+  const __m128 vmean2 = _mm_set1_ps(means[2]);
+  const __m128 vscale0 = _mm_set1_ps(scales[0]);
+  const __m128 vscale1 = _mm_set1_ps(scales[1]);
+  const __m128 vscale2 = _mm_set1_ps(scales[2]);
+  if (kIn == 3) {
+    for (; i + 8 <= size; i += 8) {
+      __m128i c0, c1, c2;
+      sse_load_hwc3_8(src + i * 3, &c0, &c1, &c2);
+      for (int k = 0; k < 8; k += 4) {
+        _mm_storeu_ps(ptr_c0 + i + k,
+                      _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c0, k), vmean0),
+                                 vscale0));
+        _mm_storeu_ps(ptr_c1 + i + k,
+                      _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c1, k), vmean1),
+                                 vscale1));
+        _mm_storeu_ps(ptr_c2 + i + k,
+                      _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c2, k), vmean2),
+                                 vscale2));
+      }
+    }
+  } else {
+    for (; i + 4 <= size; i += 4) {
+      __m128i c = sse_load_hwc4_4(src + i * 4);
+      _mm_storeu_ps(
+          ptr_c0 + i,
+          _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c, 0), vmean0), vscale0));
+      _mm_storeu_ps(
+          ptr_c1 + i,
+          _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c, 4), vmean1), vscale1));
+      _mm_storeu_ps(
+          ptr_c2 + i,
+          _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(c, 8), vmean2), vscale2));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    const uint8_t* p = src + i * kIn;
+    ptr_c0[i] = (p[0] - means[0]) * scales[0];
+    ptr_c1[i] = (p[1] - means[1]) * scales[1];
+    ptr_c2[i] = (p[2] - means[2]) * scales[2];
+  }
+}
+
+template <int kIn>
+void hwc_to_tensor_hwc(const uint8_t* src,
+                       float* output,
+                       int width,
+                       int height,
+                       float* means,
+                       float* scales) {
+  int size = width * height;
+  int i = 0;
+#ifdef __SSSE3__
+  if (kIn == 3) {
+    // 4 pixels are 12 values, the means and scales repeat every 3 vectors
+    const __m128 vmean0 = _mm_setr_ps(means[0], means[1], means[2], means[0]);
+    const __m128 vmean1 = _mm_setr_ps(means[1], means[2], means[0], means[1]);
+    const __m128 vmean2 = _mm_setr_ps(means[2], means[0], means[1], means[2]);
+    const __m128 vscale0 =
+        _mm_setr_ps(scales[0], scales[1], scales[2], scales[0]);
+    const __m128 vscale1 =
+        _mm_setr_ps(scales[1], scales[2], scales[0], scales[1]);
+    const __m128 vscale2 =
+        _mm_setr_ps(scales[2], scales[0], scales[1], scales[2]);
+    // 16 bytes are loaded for 12 values, stop before reading past the end
+    for (; i + 6 <= size; i += 4) {
+      __m128i v =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+      float* out = output + i * 3;
+      _mm_storeu_ps(
+          out, _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(v, 0), vmean0), vscale0));
+      _mm_storeu_ps(
+          out + 4,
+          _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(v, 4), vmean1), vscale1));
+      _mm_storeu_ps(
+          out + 8,
+          _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(v, 8), vmean2), vscale2));
+    }
+  } else {
+    const __m128 vmean = _mm_setr_ps(means[0], means[1], means[2], 0.f);
+    const __m128 vscale = _mm_setr_ps(scales[0], scales[1], scales[2], 0.f);
+    // one pixel per vector, the fourth lane is overwritten by the next pixel
+    for (; i + 2 <= size; i++) {
+      int32_t pixel;
+      memcpy(&pixel, src + i * 4, sizeof(pixel));
+      __m128i v = _mm_cvtsi32_si128(pixel);
+      _mm_storeu_ps(output + i * 3,
+                    _mm_mul_ps(_mm_sub_ps(sse_u8_to_f32(v, 0), vmean), vscale));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    const uint8_t* p = src + i * kIn;
+    float* out = output + i * 3;
+    out[0] = (p[0] - means[0]) * scales[0];
+    out[1] = (p[1] - means[1]) * scales[1];
+    out[2] = (p[2] - means[2]) * scales[2];
+  }
+}
+
+void Image2Tensor::choose(const uint8_t* src,
+                          Tensor* dst,
+                          ImageFormat srcFormat,
+                          LayoutType layout,
+                          int srcw,
+                          int srch,
+                          float* means,
+                          float* scales) {
+  float* output = dst->mutable_data<float>();
+  if (layout == LayoutType::kNCHW && (srcFormat == BGR || srcFormat == RGB)) {
+    impl_ = hwc_to_tensor_chw<3>;
+  } else if (layout == LayoutType::kNHWC &&
+             (srcFormat == BGR || srcFormat == RGB)) {
+    impl_ = hwc_to_tensor_hwc<3>;
+  } else if (layout == LayoutType::kNCHW &&
+             (srcFormat == BGRA || srcFormat == RGBA)) {
+    impl_ = hwc_to_tensor_chw<4>;
+  } else if (layout == LayoutType::kNHWC &&
+             (srcFormat == BGRA || srcFormat == RGBA)) {
+    impl_ = hwc_to_tensor_hwc<4>;
+  } else {
+    printf("this layout: %d or image format: %d not support \n",
+           static_cast<int>(layout),
+           srcFormat);
+    return;
+  }
+  impl_(src, output, srcw, srch, means, scales);
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,273 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// x86 implementation of image_convert.cc, the SIMD paths use SSSE3 and the
+// other targets fall back to plain loops.
+#include <math.h>
+#include <string.h>
+#include "lite/utils/cv/image_convert.h"
+#include "lite/utils/cv/image_sse.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+void nv21_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv21_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv12_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+void nv12_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// bgr rgb to gray
+void hwc3_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+// gray to bgr rgb
+void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch);
+
+/*
+ * copy the first three channels of every pixel, optionally swapping the
+ * first and the third one, and fill the alpha channel with 255 if the input
+ * has none
+ */
+template <int kIn, int kOut, bool kSwap>
+void hwc_copy(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  int size = srcw * srch;
+  for (int i = 0; i < size; i++) {
+    dst[0] = kSwap ? src[2] : src[0];
+    dst[1] = src[1];
+    dst[2] = kSwap ? src[0] : src[2];
+    if (kOut == 4) {
+      dst[3] = kIn == 4 ? src[3] : 255;
+    }
+    src += kIn;
+    dst += kOut;
+  }
+}
+
+void ImageConvert::choose(const uint8_t* src,
+                          uint8_t* dst,
+                          ImageFormat srcFormat,
+                          ImageFormat dstFormat,
+                          int srcw,
+                          int srch) {
+  if (srcFormat == dstFormat) {
+    // copy
+    int size = srcw * srch;
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (ceil(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  } else {
+    if (srcFormat == NV12 && (dstFormat == BGR || dstFormat == RGB)) {
+      impl_ = nv12_to_bgr;
+    } else if (srcFormat == NV21 && (dstFormat == BGR || dstFormat == RGB)) {
+      impl_ = nv21_to_bgr;
+    } else if (srcFormat == NV12 && (dstFormat == BGRA || dstFormat == RGBA)) {
+      impl_ = nv12_to_bgra;
+    } else if (srcFormat == NV21 && (dstFormat == BGRA || dstFormat == RGBA)) {
+      impl_ = nv21_to_bgra;
+    } else if ((srcFormat == RGBA && dstFormat == RGB) ||
+               (srcFormat == BGRA && dstFormat == BGR)) {
+      impl_ = hwc_copy<4, 3, false>;
+    } else if ((srcFormat == RGB && dstFormat == RGBA) ||
+               (srcFormat == BGR && dstFormat == BGRA)) {
+      impl_ = hwc_copy<3, 4, false>;
+    } else if ((srcFormat == RGB && dstFormat == BGR) ||
+               (srcFormat == BGR && dstFormat == RGB)) {
+      impl_ = hwc_copy<3, 3, true>;
+    } else if ((srcFormat == RGBA && dstFormat == BGRA) ||
+               (srcFormat == BGRA && dstFormat == RGBA)) {
+      impl_ = hwc_copy<4, 4, true>;
+    } else if ((srcFormat == RGB && dstFormat == GRAY) ||
+               (srcFormat == BGR && dstFormat == GRAY)) {
+      impl_ = hwc3_to_hwc1;
+    } else if ((srcFormat == GRAY && dstFormat == RGB) ||
+               (srcFormat == GRAY && dstFormat == BGR)) {
+      impl_ = hwc1_to_hwc3;
+    } else if ((srcFormat == RGBA && dstFormat == BGR) ||
+               (srcFormat == BGRA && dstFormat == RGB)) {
+      impl_ = hwc_copy<4, 3, true>;
+    } else if ((srcFormat == RGB && dstFormat == BGRA) ||
+               (srcFormat == BGR && dstFormat == RGBA)) {
+      impl_ = hwc_copy<3, 4, true>;
+    } else {
+      printf("srcFormat: %d, dstFormat: %d does not support! \n",
+             srcFormat,
+             dstFormat);
+      return;
+    }
+  }
+  impl_(src, dst, srcw, srch);
+}
+
+/*
+ * nv12(yuv) and nv21(yvu) to BGR(A), see image_convert.cc for the 7-bit
+ * fixed-point formula
+ * x_num: the offset of v in a uv pair, y_num: the offset of u
+ */
+template <int kOut>
+void nv_to_hwc(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               int x_num,
+               int y_num) {
+  const uint8_t* y = src;
+  const uint8_t* vu = src + srch * srcw;
+  int wout = srcw * kOut;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < srch; i++) {
+    const uint8_t* ptr_y = y + i * srcw;
+    const uint8_t* ptr_vu = vu + (i / 2) * srcw;
+    uint8_t* ptr_out = dst + i * wout;
+    int j = 0;
+#ifdef __SSSE3__
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i ra = _mm_set1_epi16(179);
+    const __m128i ga = _mm_set1_epi16(44);
+    const __m128i gb = _mm_set1_epi16(91);
+    const __m128i ba = _mm_set1_epi16(227);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi8(-1);
+    // duplicate v (or u) of a pair to the two pixels it covers
+    const __m128i v_idx = _mm_setr_epi8(x_num * 2,
+                                        x_num * 2 + 1,
+                                        x_num * 2,
+                                        x_num * 2 + 1,
+                                        x_num * 2 + 4,
+                                        x_num * 2 + 5,
+                                        x_num * 2 + 4,
+                                        x_num * 2 + 5,
+                                        x_num * 2 + 8,
+                                        x_num * 2 + 9,
+                                        x_num * 2 + 8,
+                                        x_num * 2 + 9,
+                                        x_num * 2 + 12,
+                                        x_num * 2 + 13,
+                                        x_num * 2 + 12,
+                                        x_num * 2 + 13);
+    const __m128i u_idx =
+        _mm_add_epi8(v_idx, _mm_set1_epi8((y_num - x_num) * 2));
+    for (; j + 8 <= srcw; j += 8) {
+      __m128i vy = _mm_unpacklo_epi8(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr_y + j)), zero);
+      __m128i vvu = _mm_sub_epi16(
+          _mm_unpacklo_epi8(
+              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr_vu + j)),
+              zero),
+          bias);
+      __m128i v = _mm_shuffle_epi8(vvu, v_idx);
+      __m128i u = _mm_shuffle_epi8(vvu, u_idx);
+      __m128i r = _mm_add_epi16(vy, _mm_srai_epi16(_mm_mullo_epi16(ra, v), 7));
+      __m128i g = _mm_sub_epi16(
+          vy,
+          _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(ga, u),
+                                       _mm_mullo_epi16(gb, v)),
+                         7));
+      __m128i b = _mm_add_epi16(vy, _mm_srai_epi16(_mm_mullo_epi16(ba, u), 7));
+      b = _mm_packus_epi16(b, b);
+      g = _mm_packus_epi16(g, g);
+      r = _mm_packus_epi16(r, r);
+      if (kOut == 4) {
+        sse_store_hwc4_8(b, g, r, alpha, ptr_out + j * 4);
+      } else {
+        sse_store_hwc3_8(b, g, r, ptr_out + j * 3);
+      }
+    }
+#endif
+    for (; j < srcw; j++) {
+      const uint8_t* ptr_uv = ptr_vu + (j & ~1);
+      int v = ptr_uv[x_num] - 128;
+      int u = ptr_uv[y_num] - 128;
+      int ra = (179 * v) >> 7;
+      int ga = (44 * u + 91 * v) >> 7;
+      int ba = (227 * u) >> 7;
+      int r = ptr_y[j] + ra;
+      int g = ptr_y[j] - ga;
+      int b = ptr_y[j] + ba;
+      uint8_t* out = ptr_out + j * kOut;
+      out[0] = b < 0 ? 0 : (b > 255 ? 255 : b);
+      out[1] = g < 0 ? 0 : (g > 255 ? 255 : g);
+      out[2] = r < 0 ? 0 : (r > 255 ? 255 : r);
+      if (kOut == 4) out[3] = 255;
+    }
+  }
+}
+
+void nv21_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_hwc<3>(src, dst, srcw, srch, 0, 1);
+}
+
+void nv12_to_bgr(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_hwc<3>(src, dst, srcw, srch, 1, 0);
+}
+
+void nv21_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_hwc<4>(src, dst, srcw, srch, 0, 1);
+}
+
+void nv12_to_bgra(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  nv_to_hwc<4>(src, dst, srcw, srch, 1, 0);
+}
+
+// Gray = (15 * c0 + 75 * c1 + 38 * c2) >> 7, see image_convert.cc
+void hwc3_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  int size = srcw * srch;
+  int i = 0;
+#ifdef __SSSE3__
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i w0 = _mm_set1_epi16(15);
+  const __m128i w1 = _mm_set1_epi16(75);
+  const __m128i w2 = _mm_set1_epi16(38);
+  for (; i + 8 <= size; i += 8) {
+    __m128i c0, c1, c2;
+    sse_load_hwc3_8(src + i * 3, &c0, &c1, &c2);
+    // the weighted sum is at most 128 * 255 and fits in uint16
+    __m128i sum = _mm_add_epi16(
+        _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c0, zero), w0),
+                      _mm_mullo_epi16(_mm_unpacklo_epi8(c1, zero), w1)),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(c2, zero), w2));
+    sum = _mm_srli_epi16(sum, 7);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(sum, sum));
+  }
+#endif
+  for (; i < size; i++) {
+    const uint8_t* p = src + i * 3;
+    dst[i] = (p[0] * 15 + p[1] * 75 + p[2] * 38) >> 7;
+  }
+}
+
+void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
+  int size = srcw * srch;
+  int i = 0;
+#ifdef __SSSE3__
+  for (; i + 8 <= size; i += 8) {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+    sse_store_hwc3_8(v, v, v, dst + i * 3);
+  }
+#endif
+  for (; i < size; i++) {
+    dst[i * 3] = src[i];
+    dst[i * 3 + 1] = src[i];
+    dst[i * 3 + 2] = src[i];
+  }
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
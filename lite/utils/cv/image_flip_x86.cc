@@ -0,0 +1,106 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// x86 implementation of image_flip.cc, the SIMD paths use SSSE3 and the
+// other targets fall back to plain loops.
+#include <string.h>
+#include "lite/utils/cv/image_flip.h"
+#include "lite/utils/cv/image_sse.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// reverse the order of the pixels of a row
+template <int kChannels>
+void reverse_row(const uint8_t* src, uint8_t* dst, int w_in) {
+  int j = 0;
+#ifdef __SSSE3__
+  if (kChannels == 1 || kChannels == 4) {
+    const __m128i idx =
+        kChannels == 1
+            ? _mm_setr_epi8(
+                  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+            : _mm_setr_epi8(
+                  12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const int step = 16 / kChannels;
+    for (; j + step <= w_in; j += step) {
+      const uint8_t* in = src + (w_in - j - step) * kChannels;
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j * kChannels),
+                       _mm_shuffle_epi8(v, idx));
+    }
+  }
+#endif
+  for (; j < w_in; j++) {
+    const uint8_t* p = src + (w_in - 1 - j) * kChannels;
+    for (int k = 0; k < kChannels; k++) {
+      dst[j * kChannels + k] = p[k];
+    }
+  }
+}
+
+/*
+ * X: flip along the X axis, the rows are reversed
+ * Y: flip along the Y axis, the pixels of every row are reversed
+ * XY: both
+ */
+template <int kChannels>
+void flip_hwc(const uint8_t* src,
+              uint8_t* dst,
+              int w_in,
+              int h_in,
+              FlipParam flip_param) {
+  int row_size = w_in * kChannels;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < h_in; i++) {
+    const uint8_t* in = src + i * row_size;
+    int out_row = flip_param == Y ? i : h_in - 1 - i;
+    uint8_t* out = dst + out_row * row_size;
+    if (flip_param == X) {
+      memcpy(out, in, row_size);
+    } else {
+      reverse_row<kChannels>(in, out, w_in);
+    }
+  }
+}
+
+void flip_hwc1(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<1>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc3(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<3>(src, dst, srcw, srch, flip_param);
+}
+
+void flip_hwc4(const uint8_t* src,
+               uint8_t* dst,
+               int srcw,
+               int srch,
+               FlipParam flip_param) {
+  flip_hwc<4>(src, dst, srcw, srch, flip_param);
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
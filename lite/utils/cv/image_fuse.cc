@@ -0,0 +1,262 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/image_fuse.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "lite/utils/cv/image_convert.h"
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// the number of interleaved channels of an image format, 1 for nv12/nv21
+static int image_channels(ImageFormat format) {
+  if (format == BGR || format == RGB) {
+    return 3;
+  } else if (format == BGRA || format == RGBA) {
+    return 4;
+  }
+  return 1;
+}
+
+int tensor_channels(ImageFormat format) {
+  return std::min(image_channels(format), 3);
+}
+
+static bool convert_supported(ImageFormat srcFormat, ImageFormat dstFormat) {
+  if (dstFormat == NV12 || dstFormat == NV21) {
+    return false;
+  }
+  if (srcFormat == dstFormat) {
+    return true;
+  }
+  if (dstFormat == GRAY) {
+    return image_channels(srcFormat) == 3;
+  }
+  if (srcFormat == GRAY) {
+    return image_channels(dstFormat) == 3;
+  }
+  return true;
+}
+
+// the source indices and the weights of every output position, the border
+// is replicated
+static void compute_fuse_coef(
+    int src_size, int dst_size, int* ofs, float* coef) {
+  double scale = static_cast<double>(src_size) / dst_size;
+  for (int d = 0; d < dst_size; d++) {
+    float f = static_cast<float>((d + 0.5) * scale - 0.5);
+    int s = floor(f);
+    f -= s;
+    if (s < 0) {
+      s = 0;
+      f = 0.f;
+    }
+    if (s >= src_size - 1) {
+      s = src_size - 1;
+      f = 0.f;
+    }
+    ofs[d * 2] = s;
+    ofs[d * 2 + 1] = std::min(s + 1, src_size - 1);
+    coef[d * 2] = 1.f - f;
+    coef[d * 2 + 1] = f;
+  }
+}
+
+// the rows and the buffers of one block of output rows
+struct FuseRows {
+  std::vector<uint8_t> nv;         // the y and uv rows of a nv12/nv21 image
+  std::vector<uint8_t> converted;  // a source row in dstFormat
+  std::vector<float> rows;         // two resized rows, channel-major
+};
+
+// convert the source row `sy` to dstFormat and resize it horizontally
+static void fuse_row(const uint8_t* src,
+                     ImageFormat srcFormat,
+                     ImageFormat dstFormat,
+                     int srcw,
+                     int srch,
+                     int sy,
+                     int dstw,
+                     const int* xofs,
+                     const float* ialpha,
+                     FuseRows* buf,
+                     float* row) {
+  int in_c = image_channels(srcFormat);
+  int out_c = image_channels(dstFormat);
+  const uint8_t* in = src + sy * srcw * in_c;
+  if (srcFormat == NV12 || srcFormat == NV21) {
+    // the converters expect the uv row right after the y row
+    memcpy(buf->nv.data(), src + sy * srcw, srcw);
+    memcpy(buf->nv.data() + srcw, src + (srch + sy / 2) * srcw, srcw);
+    in = buf->nv.data();
+  }
+  if (srcFormat != dstFormat) {
+    ImageConvert convert;
+    convert.choose(in, buf->converted.data(), srcFormat, dstFormat, srcw, 1);
+    in = buf->converted.data();
+  }
+  int channels = std::min(out_c, 3);
+  for (int k = 0; k < channels; k++) {
+    float* out = row + k * dstw;
+    for (int dx = 0; dx < dstw; dx++) {
+      out[dx] = in[xofs[dx * 2] * out_c + k] * ialpha[dx * 2] +
+                in[xofs[dx * 2 + 1] * out_c + k] * ialpha[dx * 2 + 1];
+    }
+  }
+}
+
+// out = (rows0 * b0 + rows1 * b1 - mean) * scale
+static void blend_normalize(const float* rows0,
+                            const float* rows1,
+                            float b0,
+                            float b1,
+                            float mean,
+                            float scale,
+                            float* out,
+                            int size) {
+  int i = 0;
+#ifdef __SSE__
+  const __m128 vb0 = _mm_set1_ps(b0);
+  const __m128 vb1 = _mm_set1_ps(b1);
+  const __m128 vmean = _mm_set1_ps(mean);
+  const __m128 vscale = _mm_set1_ps(scale);
+  for (; i + 4 <= size; i += 4) {
+    __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(rows0 + i), vb0),
+                          _mm_mul_ps(_mm_loadu_ps(rows1 + i), vb1));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sub_ps(v, vmean), vscale));
+  }
+#endif
+  for (; i < size; i++) {
+    out[i] = (rows0[i] * b0 + rows1[i] * b1 - mean) * scale;
+  }
+}
+
+void convert_resize_to_tensor(const uint8_t* src,
+                              float* dst,
+                              ImageFormat srcFormat,
+                              ImageFormat dstFormat,
+                              int srcw,
+                              int srch,
+                              int dstw,
+                              int dsth,
+                              LayoutType layout,
+                              const float* means,
+                              const float* scales) {
+  if (layout != LayoutType::kNCHW && layout != LayoutType::kNHWC) {
+    printf("this layout: %d not support \n", static_cast<int>(layout));
+    return;
+  }
+  if (!convert_supported(srcFormat, dstFormat)) {
+    printf("srcFormat: %d, dstFormat: %d does not support! \n",
+           srcFormat,
+           dstFormat);
+    return;
+  }
+  std::vector<int> xofs(dstw * 2);
+  std::vector<int> yofs(dsth * 2);
+  std::vector<float> ialpha(dstw * 2);
+  std::vector<float> ibeta(dsth * 2);
+  compute_fuse_coef(srcw, dstw, xofs.data(), ialpha.data());
+  compute_fuse_coef(srch, dsth, yofs.data(), ibeta.data());
+
+  int channels = tensor_channels(dstFormat);
+  int row_size = channels * dstw;
+  int plane_size = dstw * dsth;
+  const int block = 16;
+  int num_blocks = (dsth + block - 1) / block;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int n = 0; n < num_blocks; n++) {
+    FuseRows buf;
+    buf.nv.resize(srcw * 2);
+    buf.converted.resize(srcw * image_channels(dstFormat));
+    buf.rows.resize(row_size * 2);
+    std::vector<float> nhwc(layout == LayoutType::kNHWC ? row_size : 0);
+    float* rows0 = buf.rows.data();
+    float* rows1 = rows0 + row_size;
+    int prev_sy0 = -1;
+    int prev_sy1 = -1;
+    int end = std::min(dsth, (n + 1) * block);
+    for (int dy = n * block; dy < end; dy++) {
+      int sy0 = yofs[dy * 2];
+      int sy1 = yofs[dy * 2 + 1];
+      // consecutive output rows mostly share their source rows
+      if (sy0 == prev_sy1 && sy0 != prev_sy0) {
+        std::swap(rows0, rows1);
+      } else if (sy0 != prev_sy0) {
+        fuse_row(src,
+                 srcFormat,
+                 dstFormat,
+                 srcw,
+                 srch,
+                 sy0,
+                 dstw,
+                 xofs.data(),
+                 ialpha.data(),
+                 &buf,
+                 rows0);
+      }
+      if (sy1 != prev_sy1 || sy0 == prev_sy1) {
+        fuse_row(src,
+                 srcFormat,
+                 dstFormat,
+                 srcw,
+                 srch,
+                 sy1,
+                 dstw,
+                 xofs.data(),
+                 ialpha.data(),
+                 &buf,
+                 rows1);
+      }
+      prev_sy0 = sy0;
+      prev_sy1 = sy1;
+      float b0 = ibeta[dy * 2];
+      float b1 = ibeta[dy * 2 + 1];
+      for (int k = 0; k < channels; k++) {
+        float* out = layout == LayoutType::kNCHW
+                         ? dst + k * plane_size + dy * dstw
+                         : nhwc.data() + k * dstw;
+        blend_normalize(rows0 + k * dstw,
+                        rows1 + k * dstw,
+                        b0,
+                        b1,
+                        means[k],
+                        scales[k],
+                        out,
+                        dstw);
+      }
+      if (layout == LayoutType::kNHWC) {
+        float* out = dst + dy * row_size;
+        for (int dx = 0; dx < dstw; dx++) {
+          for (int k = 0; k < channels; k++) {
+            *out++ = nhwc[k * dstw + dx];
+          }
+        }
+      }
+    }
+  }
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
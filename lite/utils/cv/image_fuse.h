@@ -0,0 +1,54 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/utils/cv/paddle_image_preprocess.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+// the number of tensor channels of an image format, alpha is dropped
+int tensor_channels(ImageFormat format);
+
+/*
+ * color convert, bilinear resize and normalize in one pass
+ * only the source rows the resize samples are converted, and the resized
+ * rows go straight to the tensor without intermediate images
+ * param src: input image data
+ * param dst: output tensor data, of size tensor_channels(dstFormat) * dstw *
+ * dsth
+ * param srcFormat: input image format, support GRAY, NV12(NV21), BGR(RGB) and
+ * BGRA(RGBA)
+ * param dstFormat: output image format, support GRAY, BGR(RGB) and BGRA(RGBA)
+ * param layout: output tensor layout, support NHWC and NCHW
+ * param means: means of the tensor channels
+ * param scales: scales of the tensor channels
+ */
+void convert_resize_to_tensor(const uint8_t* src,
+                              float* dst,
+                              ImageFormat srcFormat,
+                              ImageFormat dstFormat,
+                              int srcw,
+                              int srch,
+                              int dstw,
+                              int dsth,
+                              LayoutType layout,
+                              const float* means,
+                              const float* scales);
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
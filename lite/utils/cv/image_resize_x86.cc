@@ -0,0 +1,226 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// x86 implementation of image_resize.cc, the SIMD paths use SSE2 and the
+// other targets fall back to plain loops.
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "lite/utils/cv/image_resize.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+const int resize_coef_bits = 11;
+const int resize_coef_scale = 1 << resize_coef_bits;
+
+inline int16_t saturate_cast_short(float x) {
+  int v = static_cast<int>(x + (x >= 0.f ? 0.5f : -0.5f));
+  return static_cast<int16_t>(std::min(std::max(v, SHRT_MIN), SHRT_MAX));
+}
+
+/*
+ * compute the two source indices and the fixed-point weights of every
+ * output position along one axis, the border is replicated
+ */
+void compute_resize_coef(
+    int src_size, int dst_size, int* ofs, int16_t* coef) {
+  double scale = static_cast<double>(src_size) / dst_size;
+  for (int d = 0; d < dst_size; d++) {
+    float f = static_cast<float>((d + 0.5) * scale - 0.5);
+    int s = floor(f);
+    f -= s;
+    if (s < 0) {
+      s = 0;
+      f = 0.f;
+    }
+    if (s >= src_size - 1) {
+      s = src_size - 1;
+      f = 0.f;
+    }
+    ofs[d * 2] = s;
+    ofs[d * 2 + 1] = std::min(s + 1, src_size - 1);
+    coef[d * 2] = saturate_cast_short((1.f - f) * resize_coef_scale);
+    coef[d * 2 + 1] = saturate_cast_short(f * resize_coef_scale);
+  }
+}
+
+// horizontally resize one row into 16-bit fixed point, >> 4 keeps it in int16
+void resize_row(const uint8_t* src,
+                int16_t* row,
+                int channels,
+                int dstw,
+                const int* xofs,
+                const int16_t* ialpha) {
+  for (int dx = 0; dx < dstw; dx++) {
+    const uint8_t* sl = src + xofs[dx * 2] * channels;
+    const uint8_t* sr = src + xofs[dx * 2 + 1] * channels;
+    int a0 = ialpha[dx * 2];
+    int a1 = ialpha[dx * 2 + 1];
+    for (int k = 0; k < channels; k++) {
+      *row++ = (sl[k] * a0 + sr[k] * a1) >> 4;
+    }
+  }
+}
+
+// blend two horizontally resized rows, D = (r0 * b0 + r1 * b1) >> 22
+void blend_rows(const int16_t* rows0,
+                const int16_t* rows1,
+                int16_t b0,
+                int16_t b1,
+                uint8_t* dst,
+                int size) {
+  int i = 0;
+#ifdef __SSE2__
+  const __m128i vb0 = _mm_set1_epi16(b0);
+  const __m128i vb1 = _mm_set1_epi16(b1);
+  const __m128i v2 = _mm_set1_epi16(2);
+  for (; i + 16 <= size; i += 16) {
+    __m128i r00 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows0 + i));
+    __m128i r01 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows0 + i + 8));
+    __m128i r10 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows1 + i));
+    __m128i r11 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows1 + i + 8));
+    __m128i d0 = _mm_add_epi16(_mm_mulhi_epi16(r00, vb0),
+                               _mm_mulhi_epi16(r10, vb1));
+    __m128i d1 = _mm_add_epi16(_mm_mulhi_epi16(r01, vb0),
+                               _mm_mulhi_epi16(r11, vb1));
+    d0 = _mm_srai_epi16(_mm_add_epi16(d0, v2), 2);
+    d1 = _mm_srai_epi16(_mm_add_epi16(d1, v2), 2);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(d0, d1));
+  }
+#endif
+  for (; i < size; i++) {
+    dst[i] = static_cast<uint8_t>(
+        ((static_cast<int16_t>((b0 * rows0[i]) >> 16) +
+          static_cast<int16_t>((b1 * rows1[i]) >> 16) + 2) >>
+         2));
+  }
+}
+
+// bilinear resize of an interleaved plane with `channels` channels
+void resize_plane(const uint8_t* src,
+                  uint8_t* dst,
+                  int channels,
+                  int srcw,
+                  int srch,
+                  int dstw,
+                  int dsth) {
+  std::vector<int> xofs(dstw * 2);
+  std::vector<int> yofs(dsth * 2);
+  std::vector<int16_t> ialpha(dstw * 2);
+  std::vector<int16_t> ibeta(dsth * 2);
+  compute_resize_coef(srcw, dstw, xofs.data(), ialpha.data());
+  compute_resize_coef(srch, dsth, yofs.data(), ibeta.data());
+
+  int w_in = srcw * channels;
+  int w_out = dstw * channels;
+  // every block of rows resizes its source rows once and reuses them
+  const int block = 16;
+  int num_blocks = (dsth + block - 1) / block;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int n = 0; n < num_blocks; n++) {
+    std::vector<int16_t> buf(w_out * 2);
+    int16_t* rows0 = buf.data();
+    int16_t* rows1 = rows0 + w_out;
+    int prev_sy0 = -1;
+    int prev_sy1 = -1;
+    int end = std::min(dsth, (n + 1) * block);
+    for (int dy = n * block; dy < end; dy++) {
+      int sy0 = yofs[dy * 2];
+      int sy1 = yofs[dy * 2 + 1];
+      if (sy0 == prev_sy1 && sy0 != prev_sy0) {
+        std::swap(rows0, rows1);
+      } else if (sy0 != prev_sy0) {
+        resize_row(src + sy0 * w_in,
+                   rows0,
+                   channels,
+                   dstw,
+                   xofs.data(),
+                   ialpha.data());
+      }
+      if (sy1 != prev_sy1 || sy0 == prev_sy1) {
+        resize_row(src + sy1 * w_in,
+                   rows1,
+                   channels,
+                   dstw,
+                   xofs.data(),
+                   ialpha.data());
+      }
+      prev_sy0 = sy0;
+      prev_sy1 = sy1;
+      blend_rows(rows0,
+                 rows1,
+                 ibeta[dy * 2],
+                 ibeta[dy * 2 + 1],
+                 dst + dy * w_out,
+                 w_out);
+    }
+  }
+}
+
+// use bilinear method to resize
+void resize(const uint8_t* src,
+            uint8_t* dst,
+            ImageFormat srcFormat,
+            int srcw,
+            int srch,
+            int dstw,
+            int dsth) {
+  int size = srcw * srch;
+  if (srcw == dstw && srch == dsth) {
+    if (srcFormat == NV12 || srcFormat == NV21) {
+      size = srcw * (floor(1.5 * srch));
+    } else if (srcFormat == BGR || srcFormat == RGB) {
+      size = 3 * srcw * srch;
+    } else if (srcFormat == BGRA || srcFormat == RGBA) {
+      size = 4 * srcw * srch;
+    }
+    memcpy(dst, src, sizeof(uint8_t) * size);
+    return;
+  }
+  if (srcFormat == GRAY) {
+    resize_plane(src, dst, 1, srcw, srch, dstw, dsth);
+  } else if (srcFormat == NV12 || srcFormat == NV21) {
+    // the y plane, then the interleaved uv plane at half resolution
+    resize_plane(src, dst, 1, srcw, srch, dstw, dsth);
+    resize_plane(src + srcw * srch,
+                 dst + dstw * dsth,
+                 2,
+                 srcw / 2,
+                 srch / 2,
+                 dstw / 2,
+                 dsth / 2);
+  } else if (srcFormat == BGR || srcFormat == RGB) {
+    resize_plane(src, dst, 3, srcw, srch, dstw, dsth);
+  } else if (srcFormat == BGRA || srcFormat == RGBA) {
+    resize_plane(src, dst, 4, srcw, srch, dstw, dsth);
+  } else {
+    printf("this srcFormat: %d does not support! \n", srcFormat);
+  }
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,88 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// x86 implementation of image_rotate.cc, the images are rotated in tiles
+// that stay in the cache.
+#include <algorithm>
+#include "lite/utils/cv/image_rotate.h"
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+/*
+ * rotate clockwise by kDegree
+ * 90:  dst(j, h_in - 1 - i) = src(i, j)
+ * 180: dst(h_in - 1 - i, w_in - 1 - j) = src(i, j)
+ * 270: dst(w_in - 1 - j, i) = src(i, j)
+ */
+template <int kChannels, int kDegree>
+void rotate_tiled(const uint8_t* src, uint8_t* dst, int w_in, int h_in) {
+  const int tile = 64;
+  int w_out = kDegree == 180 ? w_in : h_in;
+  int num_tiles = (h_in + tile - 1) / tile;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int t = 0; t < num_tiles; t++) {
+    int i_end = std::min(h_in, (t + 1) * tile);
+    for (int j0 = 0; j0 < w_in; j0 += tile) {
+      int j_end = std::min(w_in, j0 + tile);
+      for (int i = t * tile; i < i_end; i++) {
+        const uint8_t* in = src + (i * w_in + j0) * kChannels;
+        for (int j = j0; j < j_end; j++) {
+          int oi = kDegree == 90 ? j : (kDegree == 180 ? h_in - 1 - i
+                                                       : w_in - 1 - j);
+          int oj = kDegree == 90 ? h_in - 1 - i
+                                 : (kDegree == 180 ? w_in - 1 - j : i);
+          uint8_t* out = dst + (oi * w_out + oj) * kChannels;
+          for (int k = 0; k < kChannels; k++) {
+            out[k] = in[k];
+          }
+          in += kChannels;
+        }
+      }
+    }
+  }
+}
+
+template <int kChannels>
+void rotate_hwc(
+    const uint8_t* src, uint8_t* dst, int w_in, int h_in, float degree) {
+  if (degree == 90) {
+    rotate_tiled<kChannels, 90>(src, dst, w_in, h_in);
+  } else if (degree == 180) {
+    rotate_tiled<kChannels, 180>(src, dst, w_in, h_in);
+  } else if (degree == 270) {
+    rotate_tiled<kChannels, 270>(src, dst, w_in, h_in);
+  }
+}
+
+void rotate_hwc1(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<1>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc3(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<3>(src, dst, srcw, srch, degree);
+}
+
+void rotate_hwc4(
+    const uint8_t* src, uint8_t* dst, int srcw, int srch, float degree) {
+  rotate_hwc<4>(src, dst, srcw, srch, degree);
+}
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,117 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+#ifdef __SSSE3__
+/*
+ * split 8 interleaved 3-channel pixels into three channel vectors
+ * the 8 values of each channel are in the low 8 bytes
+ * param src: 24 bytes of input, c0c1c2c0c1c2...
+ */
+inline void sse_load_hwc3_8(const uint8_t* src,
+                            __m128i* c0,
+                            __m128i* c1,
+                            __m128i* c2) {
+  const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i hi =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 16));
+  const char z = -128;
+  *c0 = _mm_or_si128(
+      _mm_shuffle_epi8(
+          lo, _mm_setr_epi8(0, 3, 6, 9, 12, 15, z, z, z, z, z, z, z, z, z, z)),
+      _mm_shuffle_epi8(
+          hi, _mm_setr_epi8(z, z, z, z, z, z, 2, 5, z, z, z, z, z, z, z, z)));
+  *c1 = _mm_or_si128(
+      _mm_shuffle_epi8(
+          lo, _mm_setr_epi8(1, 4, 7, 10, 13, z, z, z, z, z, z, z, z, z, z, z)),
+      _mm_shuffle_epi8(
+          hi, _mm_setr_epi8(z, z, z, z, z, 0, 3, 6, z, z, z, z, z, z, z, z)));
+  *c2 = _mm_or_si128(
+      _mm_shuffle_epi8(
+          lo, _mm_setr_epi8(2, 5, 8, 11, 14, z, z, z, z, z, z, z, z, z, z, z)),
+      _mm_shuffle_epi8(
+          hi, _mm_setr_epi8(z, z, z, z, z, 1, 4, 7, z, z, z, z, z, z, z, z)));
+}
+
+/*
+ * split 4 interleaved 4-channel pixels, c0 is in the bytes 0-3, c1 in the
+ * bytes 4-7, c2 in the bytes 8-11 and c3 in the bytes 12-15
+ */
+inline __m128i sse_load_hwc4_4(const uint8_t* src) {
+  const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  return _mm_shuffle_epi8(
+      v, _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15));
+}
+
+/*
+ * interleave the low 8 bytes of three channel vectors into 24 bytes
+ */
+inline void sse_store_hwc3_8(__m128i c0, __m128i c1, __m128i c2, uint8_t* dst) {
+  const char z = -128;
+  // c0 in the bytes 0-7, c1 in the bytes 8-15
+  const __m128i c01 = _mm_unpacklo_epi64(c0, c1);
+  const __m128i lo_idx01 =
+      _mm_setr_epi8(0, 8, z, 1, 9, z, 2, 10, z, 3, 11, z, 4, 12, z, 5);
+  const __m128i lo_idx2 =
+      _mm_setr_epi8(z, z, 0, z, z, 1, z, z, 2, z, z, 3, z, z, 4, z);
+  const __m128i hi_idx01 =
+      _mm_setr_epi8(13, z, 6, 14, z, 7, 15, z, z, z, z, z, z, z, z, z);
+  const __m128i hi_idx2 =
+      _mm_setr_epi8(z, 5, z, z, 6, z, z, 7, z, z, z, z, z, z, z, z);
+  const __m128i lo = _mm_or_si128(_mm_shuffle_epi8(c01, lo_idx01),
+                                  _mm_shuffle_epi8(c2, lo_idx2));
+  const __m128i hi = _mm_or_si128(_mm_shuffle_epi8(c01, hi_idx01),
+                                  _mm_shuffle_epi8(c2, hi_idx2));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), lo);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), hi);
+}
+
+/*
+ * interleave the low 8 bytes of four channel vectors into 32 bytes
+ */
+inline void sse_store_hwc4_8(
+    __m128i c0, __m128i c1, __m128i c2, __m128i c3, uint8_t* dst) {
+  const __m128i c01 = _mm_unpacklo_epi8(c0, c1);
+  const __m128i c23 = _mm_unpacklo_epi8(c2, c3);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm_unpacklo_epi16(c01, c23));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16),
+                   _mm_unpackhi_epi16(c01, c23));
+}
+
+/*
+ * widen the 4 bytes at `offset` of v to floats
+ */
+inline __m128 sse_u8_to_f32(__m128i v, int offset) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i v16 = _mm_unpacklo_epi8(v, zero);
+  if (offset >= 8) v16 = _mm_unpackhi_epi8(v, zero);
+  const __m128i v32 = (offset & 4) ? _mm_unpackhi_epi16(v16, zero)
+                                   : _mm_unpacklo_epi16(v16, zero);
+  return _mm_cvtepi32_ps(v32);
+}
+#endif  // __SSSE3__
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
@@ -19,6 +19,7 @@
 #include "lite/utils/cv/image2tensor.h"
 #include "lite/utils/cv/image_convert.h"
 #include "lite/utils/cv/image_flip.h"
+#include "lite/utils/cv/image_fuse.h"
 #include "lite/utils/cv/image_resize.h"
 #include "lite/utils/cv/image_rotate.h"
 namespace paddle {
@@ -401,6 +402,32 @@ void ImagePreprocess::image2Tensor(const uint8_t* src,
                     scales);
 }
 
+void ImagePreprocess::image2TensorFused(const uint8_t* src,
+                                        Tensor* dstTensor,
+                                        LayoutType layout,
+                                        float* means,
+                                        float* scales) {
+  int64_t c = tensor_channels(this->dstFormat_);
+  int64_t h = this->transParam_.oh;
+  int64_t w = this->transParam_.ow;
+  if (layout == LayoutType::kNHWC) {
+    dstTensor->Resize({1, h, w, c});
+  } else {
+    dstTensor->Resize({1, c, h, w});
+  }
+  convert_resize_to_tensor(src,
+                           dstTensor->mutable_data<float>(),
+                           this->srcFormat_,
+                           this->dstFormat_,
+                           this->transParam_.iw,
+                           this->transParam_.ih,
+                           this->transParam_.ow,
+                           this->transParam_.oh,
+                           layout,
+                           means,
+                           scales);
+}
+
 }  // namespace cv
 }  // namespace utils
 }  // namespace lite
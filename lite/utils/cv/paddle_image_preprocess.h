@@ -205,6 +205,25 @@ class ImagePreprocess {
                     LayoutType layout,
                     float* means,
                     float* scales);
+  /*
+  * color convert, resize and change image data to tensor data in one pass,
+  * without intermediate images
+  * convert the srcFormat image of size (iw, ih) to dstFormat, resize it to
+  * (ow, oh) with the bilinear method, normalize it and write it to
+  * dstTensor, which is resized to the output shape
+  * support srcFormat GRAY, NV12(NV21), BGR(RGB) and BGRA(RGBA), dstFormat
+  * GRAY, BGR(RGB) and BGRA(RGBA), the alpha channel is dropped
+  * param src: input image data
+  * param dstTensor: output tensor data
+  * param layout: output tensor layout，support NHWC and NCHW
+  * param means: means of image
+  * param scales: scales of image
+  */
+  void image2TensorFused(const uint8_t* src,
+                         Tensor* dstTensor,
+                         LayoutType layout,
+                         float* means,
+                         float* scales);
 
  private:
   ImageFormat srcFormat_;
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include <dirent.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include <fstream>
 #include <string>
+#include <vector>
 #include "lite/utils/cp_logging.h"
 #include "lite/utils/string.h"
 
@@ -52,5 +55,22 @@ static std::string ReadFile(const std::string& filename) {
   return buf.str();
 }
 
+// list the names of the regular files in a directory, sorted
+static std::vector<std::string> ListDir(const std::string& path) {
+  std::vector<std::string> names;
+  DIR* dir = opendir(path.c_str());
+  CHECK(dir) << "Cann't open dir " << path;
+  while (struct dirent* entry = readdir(dir)) {
+    struct stat info;
+    std::string file = path + "/" + entry->d_name;
+    if (stat(file.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+      names.push_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
 }  // namespace lite
 }  // namespace paddle